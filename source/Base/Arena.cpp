@@ -0,0 +1,101 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+namespace
+{
+    std::atomic<uint64_t> nextArenaId{1};
+
+    //unused part of the chunk the thread currently allocates from
+    struct ThreadChunk
+    {
+        uint64_t arenaId = 0;
+        uint64_t generation = 0;
+        std::byte* pos = nullptr;
+        std::byte* end = nullptr;
+    };
+    thread_local ThreadChunk threadChunk;
+
+    std::byte* alignUp(std::byte* pos, size_t alignment)
+    {
+        auto address = reinterpret_cast<uintptr_t>(pos);
+        return pos + ((alignment - address % alignment) % alignment);
+    }
+}
+
+Arena::Arena(size_t chunkSize)
+    : _chunkSize(chunkSize)
+    , _id(nextArenaId++)
+{}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    auto generation = _generation.load(std::memory_order_relaxed);
+    auto& chunk = threadChunk;
+    if (chunk.arenaId == _id && chunk.generation == generation) {
+        auto result = alignUp(chunk.pos, alignment);
+        if (result <= chunk.end && size <= static_cast<size_t>(chunk.end - result)) {
+            chunk.pos = result + size;
+            return result;
+        }
+    }
+
+    //chunk memory is only aligned to the default alignment of new
+    auto sizeWithPadding = size + alignment - 1;
+
+    std::lock_guard lock(_mutex);
+    if (sizeWithPadding > _chunkSize / 4) {
+        auto& ownChunk = _usedChunks.emplace_back(acquireChunk(sizeWithPadding));
+        return alignUp(ownChunk.memory.get(), alignment);
+    }
+    auto& newChunk = _usedChunks.emplace_back(acquireChunk(_chunkSize));
+    auto result = alignUp(newChunk.memory.get(), alignment);
+    chunk = {_id, generation, result + size, newChunk.memory.get() + newChunk.size};
+    return result;
+}
+
+void Arena::reset()
+{
+    std::lock_guard lock(_mutex);
+    for (auto& chunk : _usedChunks) {
+        _freeChunks.emplace_back(std::move(chunk));
+    }
+    _usedChunks.clear();
+    ++_generation;
+}
+
+uint64_t Arena::getGeneration() const
+{
+    return _generation.load();
+}
+
+int Arena::getNumChunks() const
+{
+    std::lock_guard lock(_mutex);
+    return static_cast<int>(_usedChunks.size());
+}
+
+size_t Arena::getNumReservedBytes() const
+{
+    std::lock_guard lock(_mutex);
+    size_t result = 0;
+    for (auto const& chunk : _usedChunks) {
+        result += chunk.size;
+    }
+    for (auto const& chunk : _freeChunks) {
+        result += chunk.size;
+    }
+    return result;
+}
+
+Arena::Chunk Arena::acquireChunk(size_t minSize)
+{
+    auto findResult = std::find_if(_freeChunks.rbegin(), _freeChunks.rend(), [&](auto const& chunk) { return chunk.size >= minSize; });
+    if (findResult != _freeChunks.rend()) {
+        auto result = std::move(*findResult);
+        _freeChunks.erase(std::next(findResult).base());
+        return result;
+    }
+    auto size = std::max(minSize, _chunkSize);
+    return Chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size};
+}
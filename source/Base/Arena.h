@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Thread-safe bump allocator for temporary objects which are released all at once, e.g. at the end of a time step.
+ * Each thread allocates from its own chunk without synchronization, only the acquisition of chunks is synchronized.
+ * reset() starts a new generation: the memory of the previous generation becomes invalid and its chunks are reused.
+ * Memory is not initialized and no destructors are called, hence only trivially destructible types can be allocated.
+ * reset() must not be called concurrently to allocations.
+ */
+class Arena
+{
+public:
+    static size_t constexpr DefaultChunkSize = 1 << 20;
+
+    Arena(size_t chunkSize = DefaultChunkSize);
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    //alignment must be a power of 2; allocations larger than a quarter of the chunk size get a chunk of their own
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocateArray(size_t numElements)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is released without calling destructors");
+        if (numElements == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(sizeof(T) * numElements, alignof(T)));
+    }
+
+    void reset();
+    uint64_t getGeneration() const;
+
+    int getNumChunks() const;  //chunks used in the current generation
+    size_t getNumReservedBytes() const;  //including the unused chunks kept for the next generations
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size = 0;
+    };
+    Chunk acquireChunk(size_t minSize);  //requires locked _mutex
+
+    size_t const _chunkSize;
+    uint64_t const _id;  //identifies the arena in the chunk caches of the threads
+    std::atomic<uint64_t> _generation{0};
+
+    mutable std::mutex _mutex;
+    std::vector<Chunk> _usedChunks;
+    std::vector<Chunk> _freeChunks;
+};
@@ -27,3 +27,11 @@ public:
         : std::runtime_error(what.c_str())
     {}
 };
+
+class UnsupportedOperationException : public std::runtime_error
+{
+public:
+    UnsupportedOperationException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
@@ -1,7 +1,22 @@
 #include "Physics.h"
 
+#include <cmath>
+
 #include "Math.h"
 
+float Physics::angularMomentum(RealVector2D const& positionFromCenter, RealVector2D const& velocityAroundCenter)
+{
+    return positionFromCenter.x * velocityAroundCenter.y - positionFromCenter.y * velocityAroundCenter.x;
+}
+
+float Physics::angularVelocity(float angularMomentum, float angularMass)
+{
+    if (std::abs(angularMass) < NEAR_ZERO) {
+        return 0;
+    }
+    return angularMomentum / angularMass * Const::RadToDeg;
+}
+
 RealVector2D Physics::tangentialVelocity(RealVector2D const& positionFromCenter, RealVector2D const& vel, double angularVel)
 {
     return vel - Math::rotateQuarterCounterClockwise(positionFromCenter) * toFloat(angularVel * Const::DegToRad);
@@ -6,6 +6,9 @@ class Physics
 {
 public:
 
+    static float angularMomentum(RealVector2D const& positionFromCenter, RealVector2D const& velocityAroundCenter);
+    static float angularVelocity(float angularMomentum, float angularMass);  //in degrees
+
     static RealVector2D
     tangentialVelocity(RealVector2D const& positionFromCenter, RealVector2D const& vel, double angularVel);
 
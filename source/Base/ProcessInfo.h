@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+class ProcessInfo
+{
+public:
+    static std::optional<uint64_t> getPeakResidentMemory();  //in bytes, nullopt if not available on the platform
+};
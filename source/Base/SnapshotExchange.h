@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+/**
+ * Exchanges snapshots between a producing and a consuming thread via two slots. The producer writes into the slot which
+ * is neither published nor being read and publishes it afterwards. The consumer reads the last published slot while
+ * the producer may already write the next snapshot into the other slot. If the consumer still reads the slot which would
+ * be written next, 'beginWrite()' fails and the producer should skip this snapshot.
+ */
+template <typename T>
+class SnapshotExchange
+{
+public:
+    static int constexpr NumSlots = 2;
+
+    T& getSlot(int slot) { return _slots[slot]; }
+    T const& getSlot(int slot) const { return _slots[slot]; }
+
+    std::optional<int> beginWrite()
+    {
+        std::lock_guard lock(_mutex);
+        auto slot = _publishedSlot ? 1 - *_publishedSlot : 0;
+        if (_writing || _numReaders[slot] > 0) {
+            return std::nullopt;
+        }
+        _writing = true;
+        return slot;
+    }
+
+    void endWrite(int slot)
+    {
+        std::lock_guard lock(_mutex);
+        _writing = false;
+        _publishedSlot = slot;
+        _isPublishedSlotRead = false;
+        ++_version;
+    }
+
+    void cancelWrite()
+    {
+        std::lock_guard lock(_mutex);
+        _writing = false;
+    }
+
+    std::optional<int> beginRead()
+    {
+        std::lock_guard lock(_mutex);
+        if (!_publishedSlot) {
+            return std::nullopt;
+        }
+        ++_numReaders[*_publishedSlot];
+        _isPublishedSlotRead = true;
+        return *_publishedSlot;
+    }
+
+    void endRead(int slot)
+    {
+        std::lock_guard lock(_mutex);
+        --_numReaders[slot];
+    }
+
+    //true if there is no published snapshot or it has already been read
+    bool isNextSnapshotRequired() const
+    {
+        std::lock_guard lock(_mutex);
+        return !_publishedSlot || _isPublishedSlotRead;
+    }
+
+    uint64_t getVersion() const
+    {
+        std::lock_guard lock(_mutex);
+        return _version;
+    }
+
+private:
+    T _slots[NumSlots];
+
+    mutable std::mutex _mutex;
+    std::optional<int> _publishedSlot;
+    bool _isPublishedSlotRead = false;
+    bool _writing = false;
+    int _numReaders[NumSlots] = {0, 0};
+    uint64_t _version = 0;
+};
@@ -0,0 +1,186 @@
+#include "SpatialHashGrid.h"
+
+#include <limits>
+
+#include "ThreadPool.h"
+
+namespace
+{
+    //the counting sort first distributes the objects to at most 2^MaxBlockBits blocks of consecutive slot keys
+    //and then sorts each block independently
+    int constexpr MaxBlockBits = 10;
+    int constexpr MinChunkSize = 4096;
+    uint32_t constexpr ExcludedKey = std::numeric_limits<uint32_t>::max();
+
+    template <typename Func>
+    void parallelFor(ThreadPool* threadPool, int numItems, int chunkSize, Func const& func)
+    {
+        if (threadPool) {
+            threadPool->parallelFor(numItems, chunkSize, func);
+        } else {
+            for (int begin = 0; begin < numItems; begin += chunkSize) {
+                func(begin, std::min(begin + chunkSize, numItems));
+            }
+        }
+    }
+}
+
+void SpatialHashGrid::build(
+    std::vector<RealVector2D> const& positions,
+    RealVector2D const& worldSize,
+    float slotSize,
+    ThreadPool* threadPool,
+    std::vector<uint8_t> const* excluded)
+{
+    _periodic = true;
+    _origin = {0, 0};
+    _worldSize = worldSize;
+    _numSlots = {std::max(1, toInt(worldSize.x / slotSize)), std::max(1, toInt(worldSize.y / slotSize))};
+    _slotSize = {worldSize.x / toFloat(_numSlots.x), worldSize.y / toFloat(_numSlots.y)};
+    buildIntern(positions, threadPool, excluded);
+}
+
+void SpatialHashGrid::buildBounded(std::vector<RealVector2D> const& positions, float slotSize, ThreadPool* threadPool)
+{
+    RealVector2D lowerBound;
+    RealVector2D upperBound;
+    if (!positions.empty()) {
+        lowerBound = upperBound = positions.front();
+    }
+    for (auto const& pos : positions) {
+        lowerBound = {std::min(lowerBound.x, pos.x), std::min(lowerBound.y, pos.y)};
+        upperBound = {std::max(upperBound.x, pos.x), std::max(upperBound.y, pos.y)};
+    }
+    _periodic = false;
+    _origin = lowerBound;
+    _worldSize = upperBound - lowerBound;
+    _numSlots = {toInt(_worldSize.x / slotSize) + 1, toInt(_worldSize.y / slotSize) + 1};
+    _slotSize = {slotSize, slotSize};
+    buildIntern(positions, threadPool, nullptr);
+}
+
+int SpatialHashGrid::getFirstIndex(RealVector2D const& pos) const
+{
+    if (_sortedIndices.empty()) {
+        return -1;
+    }
+    auto key = getSlotKey(
+        toSlotCoordinate(pos.x, _origin.x, _worldSize.x, _slotSize.x, _numSlots.x), toSlotCoordinate(pos.y, _origin.y, _worldSize.y, _slotSize.y, _numSlots.y));
+    return _slotOffsets[key] < _slotOffsets[key + 1] ? _sortedIndices[_slotOffsets[key]] : -1;
+}
+
+std::vector<int> SpatialHashGrid::getIndicesWithinRadius(RealVector2D const& pos, float radius) const
+{
+    std::vector<int> result;
+    executeForEachWithinRadius(pos, radius, [&](int index, RealVector2D const&) { result.emplace_back(index); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void SpatialHashGrid::buildIntern(std::vector<RealVector2D> const& positions, ThreadPool* threadPool, std::vector<uint8_t> const* excluded)
+{
+    _numTilesX = (_numSlots.x + TileSize - 1) / TileSize;
+    auto numTilesY = (_numSlots.y + TileSize - 1) / TileSize;
+    auto numKeys = _numTilesX * numTilesY * TileSize * TileSize;
+
+    int blockBits = 0;
+    while ((numKeys >> blockBits) > (1 << MaxBlockBits)) {
+        ++blockBits;
+    }
+    auto numBlocks = ((numKeys - 1) >> blockBits) + 1;
+
+    auto numObjects = toInt(positions.size());
+    auto numChunks = 1;
+    if (threadPool) {
+        numChunks = std::clamp((numObjects + MinChunkSize - 1) / MinChunkSize, 1, 4 * (threadPool->getNumThreads() + 1));
+    }
+    auto chunkSize = std::max(1, (numObjects + numChunks - 1) / numChunks);
+
+    //pass 1: calculate slot keys and count the objects per chunk and block
+    _keys.resize(numObjects);
+    std::vector<int> blockOffsetsByChunk(numChunks * numBlocks, 0);
+    parallelFor(threadPool, numObjects, chunkSize, [&](int begin, int end) {
+        auto blockCounts = &blockOffsetsByChunk[begin / chunkSize * numBlocks];
+        for (int index = begin; index < end; ++index) {
+            if (excluded && (*excluded)[index]) {
+                _keys[index] = ExcludedKey;
+                continue;
+            }
+            auto const& pos = positions[index];
+            auto key = getSlotKey(
+                toSlotCoordinate(pos.x, _origin.x, _worldSize.x, _slotSize.x, _numSlots.x),
+                toSlotCoordinate(pos.y, _origin.y, _worldSize.y, _slotSize.y, _numSlots.y));
+            _keys[index] = key;
+            ++blockCounts[key >> blockBits];
+        }
+    });
+
+    //blocks are ordered by key and the chunks within a block by object index, which keeps the sort stable
+    std::vector<int> blockBegins(numBlocks + 1);
+    int numInsertedObjects = 0;
+    for (int block = 0; block < numBlocks; ++block) {
+        blockBegins[block] = numInsertedObjects;
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            auto count = blockOffsetsByChunk[chunk * numBlocks + block];
+            blockOffsetsByChunk[chunk * numBlocks + block] = numInsertedObjects;
+            numInsertedObjects += count;
+        }
+    }
+    blockBegins[numBlocks] = numInsertedObjects;
+
+    //pass 2: distribute the objects to the blocks
+    _blockSortedIndices.resize(numInsertedObjects);
+    parallelFor(threadPool, numObjects, chunkSize, [&](int begin, int end) {
+        auto blockOffsets = &blockOffsetsByChunk[begin / chunkSize * numBlocks];
+        for (int index = begin; index < end; ++index) {
+            if (_keys[index] != ExcludedKey) {
+                _blockSortedIndices[blockOffsets[_keys[index] >> blockBits]++] = index;
+            }
+        }
+    });
+
+    //pass 3: sort each block by slot key, the slot offsets of a block are only written by the thread processing the block
+    if (toInt(_slotOffsets.size()) != numKeys + 1) {
+        _slotOffsets.resize(numKeys + 1);
+        _emptyBlockOffsets.assign(numBlocks, -1);
+    }
+    _sortedIndices.resize(numInsertedObjects);
+    _sortedPositions.resize(numInsertedObjects);
+    parallelFor(threadPool, numBlocks, 1, [&](int beginBlock, int endBlock) {
+        for (int block = beginBlock; block < endBlock; ++block) {
+            auto beginKey = block << blockBits;
+            auto endKey = std::min(numKeys, (block + 1) << blockBits);
+            if (blockBegins[block] == blockBegins[block + 1]) {
+                if (_emptyBlockOffsets[block] != blockBegins[block]) {
+                    std::fill(_slotOffsets.begin() + beginKey, _slotOffsets.begin() + endKey, blockBegins[block]);
+                    _emptyBlockOffsets[block] = blockBegins[block];
+                }
+                continue;
+            }
+            _emptyBlockOffsets[block] = -1;
+            std::fill(_slotOffsets.begin() + beginKey, _slotOffsets.begin() + endKey, 0);
+            for (int i = blockBegins[block]; i < blockBegins[block + 1]; ++i) {
+                ++_slotOffsets[_keys[_blockSortedIndices[i]]];
+            }
+            auto offset = blockBegins[block];
+            for (int key = beginKey; key < endKey; ++key) {
+                auto count = _slotOffsets[key];
+                _slotOffsets[key] = offset;
+                offset += count;
+            }
+
+            //slot offsets are advanced to the slot ends while scattering and shifted back afterwards
+            for (int i = blockBegins[block]; i < blockBegins[block + 1]; ++i) {
+                auto index = _blockSortedIndices[i];
+                auto target = _slotOffsets[_keys[index]]++;
+                _sortedIndices[target] = index;
+                _sortedPositions[target] = _periodic ? getCorrectedPosition(positions[index]) : positions[index];
+            }
+            for (int key = endKey - 1; key > beginKey; --key) {
+                _slotOffsets[key] = _slotOffsets[key - 1];
+            }
+            _slotOffsets[beginKey] = blockBegins[block];
+        }
+    });
+    _slotOffsets[numKeys] = numInsertedObjects;
+}
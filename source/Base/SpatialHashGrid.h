@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Definitions.h"
+
+class ThreadPool;
+
+/**
+ * Spatial index for neighbor queries on the host. The objects are sorted by slot into a compact cell list: the indices and positions
+ * of the objects of a slot are stored contiguously and in ascending index order, an offset array refers to the begin of each slot.
+ * Slots are numbered along a Morton curve within tiles of 16x16 slots so that neighboring slots are also close in memory.
+ * The construction is a counting sort which runs in parallel on a thread pool if given; the result does not depend on the number of threads.
+ */
+class SpatialHashGrid
+{
+public:
+    //positions are mapped periodically into the world [0, worldSize.x) x [0, worldSize.y) and distances are measured on the torus
+    void build(
+        std::vector<RealVector2D> const& positions,
+        RealVector2D const& worldSize,
+        float slotSize,
+        ThreadPool* threadPool = nullptr,
+        std::vector<uint8_t> const* excluded = nullptr);  //objects with nonzero entries are not inserted
+
+    //the grid covers the bounding box of the positions and distances are Euclidean
+    void buildBounded(std::vector<RealVector2D> const& positions, float slotSize, ThreadPool* threadPool = nullptr);
+
+    int getNumObjects() const { return toInt(_sortedIndices.size()); }
+
+    int getFirstIndex(RealVector2D const& pos) const;  //lowest index in the slot containing pos, -1 if empty
+
+    //calls func(index, delta) for all objects with |delta| <= radius, where delta is the (corrected) vector from pos to the object
+    template <typename Func>
+    void executeForEachWithinRadius(RealVector2D pos, float radius, Func const& func) const;
+
+    std::vector<int> getIndicesWithinRadius(RealVector2D const& pos, float radius) const;  //in ascending order
+
+    //the object indices in slot order, i.e. objects close to each other are close in this list
+    std::vector<int> const& getSortedIndices() const { return _sortedIndices; }
+
+private:
+    void buildIntern(std::vector<RealVector2D> const& positions, ThreadPool* threadPool, std::vector<uint8_t> const* excluded);
+
+    RealVector2D getCorrectedDirection(RealVector2D direction) const
+    {
+        if (_periodic) {
+            direction.x -= std::round(direction.x / _worldSize.x) * _worldSize.x;
+            direction.y -= std::round(direction.y / _worldSize.y) * _worldSize.y;
+        }
+        return direction;
+    }
+
+    RealVector2D getCorrectedPosition(RealVector2D pos) const
+    {
+        pos.x -= std::floor(pos.x / _worldSize.x) * _worldSize.x;
+        pos.y -= std::floor(pos.y / _worldSize.y) * _worldSize.y;
+        return pos;
+    }
+
+    int toSlotCoordinate(float value, float origin, float worldSize, float slotSize, int numSlots) const
+    {
+        if (_periodic) {
+            value -= std::floor(value / worldSize) * worldSize;
+        } else {
+            value -= origin;
+        }
+        return std::clamp(static_cast<int>(value / slotSize), 0, numSlots - 1);
+    }
+
+    static int constexpr TileBits = 4;
+    static int constexpr TileSize = 1 << TileBits;
+
+    uint32_t getSlotKey(int x, int y) const
+    {
+        auto spreadBits = [](uint32_t value) {
+            value = (value | (value << 2)) & 0x33;
+            value = (value | (value << 1)) & 0x55;
+            return value;
+        };
+        auto tileIndex = static_cast<uint32_t>((y >> TileBits) * _numTilesX + (x >> TileBits));
+        return (tileIndex << (2 * TileBits)) | spreadBits(x & (TileSize - 1)) | (spreadBits(y & (TileSize - 1)) << 1);
+    }
+
+    bool _periodic = true;
+    RealVector2D _origin;
+    RealVector2D _worldSize;
+    RealVector2D _slotSize;  //in the periodic case slightly enlarged such that the slots tile the world
+    IntVector2D _numSlots;
+    int _numTilesX = 0;
+
+    std::vector<int> _slotOffsets;  //slot key -> begin in _sortedIndices, one additional entry for the end
+    std::vector<int> _sortedIndices;
+    std::vector<RealVector2D> _sortedPositions;  //mapped into the world in the periodic case
+    std::vector<uint32_t> _keys;  //buffers for construction
+    std::vector<int> _blockSortedIndices;
+    std::vector<int> _emptyBlockOffsets;  //offset of all slots of a block if it was empty in the last construction, -1 otherwise
+};
+
+template <typename Func>
+void SpatialHashGrid::executeForEachWithinRadius(RealVector2D pos, float radius, Func const& func) const
+{
+    if (_sortedIndices.empty()) {
+        return;
+    }
+    auto radiusSquared = radius * radius;
+
+    //nearest images of the objects are only unique if the radius is less than half of the world size
+    if (_periodic && 2 * radius >= std::min(_worldSize.x, _worldSize.y)) {
+        for (int i = 0; i < toInt(_sortedIndices.size()); ++i) {
+            auto delta = getCorrectedDirection(_sortedPositions[i] - pos);
+            if (delta.x * delta.x + delta.y * delta.y <= radiusSquared) {
+                func(_sortedIndices[i], delta);
+            }
+        }
+        return;
+    }
+
+    //in the periodic case the stored positions lie within the world and a slot outside the world is mapped to its image inside
+    //together with the offset by which its objects have to be shifted, which saves the correction of each single distance
+    if (_periodic) {
+        pos = getCorrectedPosition(pos);
+    }
+    auto getSlotRange = [&](float value, float origin, float worldSize, float slotSize, int numSlots) -> std::pair<int, int> {
+        if (_periodic) {
+            auto begin = static_cast<int>(std::floor((value - radius) / slotSize));
+            auto end = static_cast<int>(std::floor((value + radius) / slotSize));
+            return {begin, std::min(end, begin + numSlots - 1)};
+        }
+        return {
+            toSlotCoordinate(value - radius, origin, worldSize, slotSize, numSlots), toSlotCoordinate(value + radius, origin, worldSize, slotSize, numSlots)};
+    };
+    auto getSlotImage = [](int slot, int numSlots, float worldSize) -> std::pair<int, float> {
+        if (slot < 0) {
+            return {slot + numSlots, -worldSize};
+        }
+        if (slot >= numSlots) {
+            return {slot - numSlots, worldSize};
+        }
+        return {slot, 0.0f};
+    };
+    auto [beginX, endX] = getSlotRange(pos.x, _origin.x, _worldSize.x, _slotSize.x, _numSlots.x);
+    auto [beginY, endY] = getSlotRange(pos.y, _origin.y, _worldSize.y, _slotSize.y, _numSlots.y);
+    for (int y = beginY; y <= endY; ++y) {
+        auto [slotY, offsetY] = getSlotImage(y, _numSlots.y, _worldSize.y);
+        for (int x = beginX; x <= endX; ++x) {
+            auto [slotX, offsetX] = getSlotImage(x, _numSlots.x, _worldSize.x);
+            auto key = getSlotKey(slotX, slotY);
+            RealVector2D slotPos(pos.x - offsetX, pos.y - offsetY);
+            for (auto i = _slotOffsets[key], slotEnd = _slotOffsets[key + 1]; i < slotEnd; ++i) {
+                auto delta = _sortedPositions[i] - slotPos;
+                if (delta.x * delta.x + delta.y * delta.y <= radiusSquared) {
+                    func(_sortedIndices[i], delta);
+                }
+            }
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include "StringHelper.h"
 
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 std::string StringHelper::format(uint64_t n)
 {
@@ -48,3 +50,21 @@ void StringHelper::copy(char* target, int targetSize, std::string const& source)
         target[0] = 0;
     }
 }
+
+std::string StringHelper::toJsonString(std::string const& value)
+{
+    std::string result = "\"";
+    for (auto const& c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::stringstream stream;
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            result += stream.str();
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
@@ -9,4 +9,6 @@ public:
     static std::string format(float v, int decimalsAfterPoint);
 
     static void copy(char* target, int targetSize, std::string const& source);
+
+    static std::string toJsonString(std::string const& value);  //quoted and escaped
 };
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <set>
+
+#include "ThreadPool.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double getMicroseconds(Clock::time_point const& startTime)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - startTime).count();
+    }
+
+    std::string escape(std::string const& name)
+    {
+        std::string result;
+        for (auto c : name) {
+            if (c == '"' || c == '\\') {
+                result.push_back('\\');
+            }
+            result.push_back(c);
+        }
+        return result;
+    }
+}
+
+int TaskGraph::addTask(
+    std::string const& name,
+    std::vector<std::string> const& reads,
+    std::vector<std::string> const& writes,
+    std::function<void()> const& func)
+{
+    auto task = static_cast<int>(_tasks.size());
+    std::vector<int> dependencies;
+    for (auto const& resource : reads) {
+        auto& accesses = _resourceAccesses[resource];
+        if (accesses.lastWriter != -1) {
+            dependencies.emplace_back(accesses.lastWriter);
+        }
+        accesses.readersSinceLastWrite.emplace_back(task);
+    }
+    for (auto const& resource : writes) {
+        auto& accesses = _resourceAccesses[resource];
+        if (accesses.lastWriter != -1 && accesses.lastWriter != task) {
+            dependencies.emplace_back(accesses.lastWriter);
+        }
+        for (auto reader : accesses.readersSinceLastWrite) {
+            if (reader != task) {
+                dependencies.emplace_back(reader);
+            }
+        }
+        accesses.lastWriter = task;
+        accesses.readersSinceLastWrite.clear();
+    }
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+    for (auto dependency : dependencies) {
+        _tasks[dependency].dependents.emplace_back(task);
+    }
+    _tasks.emplace_back(Task{name, func, dependencies, {}});
+    return task;
+}
+
+void TaskGraph::clear()
+{
+    _tasks.clear();
+    _resourceAccesses.clear();
+    _traceEvents.clear();
+}
+
+int TaskGraph::getNumTasks() const
+{
+    return static_cast<int>(_tasks.size());
+}
+
+std::string const& TaskGraph::getName(int task) const
+{
+    return _tasks.at(task).name;
+}
+
+std::vector<int> const& TaskGraph::getDependencies(int task) const
+{
+    return _tasks.at(task).dependencies;
+}
+
+void TaskGraph::run(ThreadPool* threadPool)
+{
+    _traceEvents.clear();
+    if (!threadPool || threadPool->getNumThreads() == 0) {
+        runSequentially();
+    } else {
+        runConcurrently(threadPool);
+    }
+    std::sort(_traceEvents.begin(), _traceEvents.end(), [](auto const& event1, auto const& event2) {
+        return event1.startTime != event2.startTime ? event1.startTime < event2.startTime : event1.task < event2.task;
+    });
+}
+
+bool TaskGraph::isTracingEnabled() const
+{
+    return _tracingEnabled;
+}
+
+void TaskGraph::setTracingEnabled(bool value)
+{
+    _tracingEnabled = value;
+}
+
+std::vector<TaskGraph::TraceEvent> const& TaskGraph::getTraceEvents() const
+{
+    return _traceEvents;
+}
+
+void TaskGraph::writeTrace(std::ostream& stream) const
+{
+    stream << "{\"traceEvents\": [";
+    for (size_t i = 0; i < _traceEvents.size(); ++i) {
+        auto const& event = _traceEvents[i];
+        stream << (i > 0 ? "," : "") << "\n    {\"name\": \"" << escape(_tasks.at(event.task).name) << "\", \"ph\": \"X\", \"ts\": " << event.startTime
+               << ", \"dur\": " << event.endTime - event.startTime << ", \"pid\": 0, \"tid\": " << event.threadIndex << "}";
+    }
+    stream << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+void TaskGraph::writeDot(std::ostream& stream) const
+{
+    stream << "digraph TaskGraph {" << std::endl;
+    for (size_t task = 0; task < _tasks.size(); ++task) {
+        stream << "    task" << task << " [label=\"" << escape(_tasks[task].name) << "\"];" << std::endl;
+    }
+    for (size_t task = 0; task < _tasks.size(); ++task) {
+        for (auto dependency : _tasks[task].dependencies) {
+            stream << "    task" << dependency << " -> task" << task << ";" << std::endl;
+        }
+    }
+    stream << "}" << std::endl;
+}
+
+void TaskGraph::runSequentially()
+{
+    auto startTime = Clock::now();
+    for (size_t task = 0; task < _tasks.size(); ++task) {
+        TraceEvent event;
+        event.task = static_cast<int>(task);
+        event.startTime = getMicroseconds(startTime);
+        _tasks[task].func();
+        if (_tracingEnabled) {
+            event.endTime = getMicroseconds(startTime);
+            _traceEvents.emplace_back(event);
+        }
+    }
+}
+
+void TaskGraph::runConcurrently(ThreadPool* threadPool)
+{
+    auto numTasks = static_cast<int>(_tasks.size());
+    if (numTasks == 0) {
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable stateChanged;
+    std::vector<int> numPendingDependencies(numTasks);
+    std::set<int> readyTasks;  //ordered to start the tasks in the order of addition
+    for (int task = 0; task < numTasks; ++task) {
+        numPendingDependencies[task] = static_cast<int>(_tasks[task].dependencies.size());
+        if (numPendingDependencies[task] == 0) {
+            readyTasks.insert(task);
+        }
+    }
+    int numFinishedTasks = 0;
+    std::exception_ptr exception;
+    auto startTime = Clock::now();
+
+    auto runTasks = [&](int threadIndex) {
+        std::unique_lock lock(mutex);
+        while (true) {
+            stateChanged.wait(lock, [&] { return !readyTasks.empty() || numFinishedTasks == numTasks || exception; });
+            if (numFinishedTasks == numTasks || exception) {
+                return;
+            }
+            auto task = *readyTasks.begin();
+            readyTasks.erase(readyTasks.begin());
+            lock.unlock();
+
+            TraceEvent event;
+            event.task = task;
+            event.threadIndex = threadIndex;
+            event.startTime = getMicroseconds(startTime);
+            std::exception_ptr taskException;
+            try {
+                _tasks[task].func();
+            } catch (...) {
+                taskException = std::current_exception();
+            }
+            event.endTime = getMicroseconds(startTime);
+
+            lock.lock();
+            if (taskException) {
+                if (!exception) {
+                    exception = taskException;
+                }
+                stateChanged.notify_all();
+                continue;
+            }
+            if (_tracingEnabled) {
+                _traceEvents.emplace_back(event);
+            }
+            ++numFinishedTasks;
+            for (auto dependent : _tasks[task].dependents) {
+                if (--numPendingDependencies[dependent] == 0) {
+                    readyTasks.insert(dependent);
+                }
+            }
+            stateChanged.notify_all();
+        }
+    };
+
+    auto numRunners = std::min(threadPool->getNumThreads(), numTasks - 1);
+    for (int i = 1; i <= numRunners; ++i) {
+        threadPool->submit([&runTasks, i] { runTasks(i); });
+    }
+    runTasks(0);
+    threadPool->waitForAll();
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Runs tasks which declare the resources they read and write. A task depends on each previously added task with a conflicting access
+ * (read after write, write after read and write after write). Independent tasks run concurrently on the threads of a thread pool and
+ * the calling thread, hence the results equal those of the sequential execution in the order of addition if the declared accesses are complete.
+ * Ready tasks are started in the order of addition. The tasks may parallelize their work with ThreadPool::parallelFor on a further thread pool
+ * since it only waits for the chunks of the respective call.
+ */
+class TaskGraph
+{
+public:
+    int addTask(std::string const& name, std::vector<std::string> const& reads, std::vector<std::string> const& writes, std::function<void()> const& func);
+    void clear();
+
+    int getNumTasks() const;
+    std::string const& getName(int task) const;
+    std::vector<int> const& getDependencies(int task) const;  //direct dependencies in ascending order
+
+    //threadPool = nullptr: executes the tasks sequentially in the order of addition
+    //the first exception thrown by a task is rethrown after the running tasks have finished, the remaining tasks are skipped
+    void run(ThreadPool* threadPool = nullptr);
+
+    //trace of the last run
+    struct TraceEvent
+    {
+        int task = 0;
+        int threadIndex = 0;  //0 = calling thread
+        double startTime = 0;  //in microseconds since the start of the run
+        double endTime = 0;
+    };
+    bool isTracingEnabled() const;
+    void setTracingEnabled(bool value);
+    std::vector<TraceEvent> const& getTraceEvents() const;  //sorted by start time
+
+    void writeTrace(std::ostream& stream) const;  //in the Chrome trace event format, can be viewed in chrome://tracing or Perfetto
+    void writeDot(std::ostream& stream) const;  //dependency graph in the Graphviz format
+
+private:
+    void runSequentially();
+    void runConcurrently(ThreadPool* threadPool);
+
+    struct Task
+    {
+        std::string name;
+        std::function<void()> func;
+        std::vector<int> dependencies;
+        std::vector<int> dependents;
+    };
+    std::vector<Task> _tasks;
+
+    struct ResourceAccesses
+    {
+        int lastWriter = -1;
+        std::vector<int> readersSinceLastWrite;
+    };
+    std::unordered_map<std::string, ResourceAccesses> _resourceAccesses;
+
+    bool _tracingEnabled = false;
+    std::vector<TraceEvent> _traceEvents;
+};
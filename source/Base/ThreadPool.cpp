@@ -0,0 +1,135 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&ThreadPool::runWorkerThread, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    waitForAll();
+    {
+        std::lock_guard lock(_mutex);
+        _isShutdown = true;
+    }
+    _taskAvailable.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> const& task)
+{
+    {
+        std::lock_guard lock(_mutex);
+        _tasks.emplace_back(task);
+    }
+    _taskAvailable.notify_one();
+}
+
+void ThreadPool::waitForAll()
+{
+    std::unique_lock lock(_mutex);
+    _allTasksFinished.wait(lock, [this] { return _tasks.empty() && _numRunningTasks == 0; });
+}
+
+void ThreadPool::parallelFor(int numItems, int chunkSize, std::function<void(int begin, int end)> const& func)
+{
+    if (numItems <= 0) {
+        return;
+    }
+
+    //shared with the submitted tasks since they may start after the call has returned, they access 'func' only for claimed chunks
+    struct ParallelForState
+    {
+        std::function<void(int begin, int end)> const* func;
+        int numItems;
+        int chunkSize;
+        int numChunks;
+        std::atomic<int> nextChunkBegin{0};
+        std::atomic<int> numFinishedChunks{0};
+        std::mutex mutex;
+        std::condition_variable allChunksFinished;
+        std::exception_ptr exception;  //first exception thrown by 'func', protected by 'mutex'
+        std::atomic<bool> hasFailed{false};
+    };
+    auto state = std::make_shared<ParallelForState>();
+    state->func = &func;
+    state->numItems = numItems;
+    state->chunkSize = chunkSize;
+    state->numChunks = (numItems + chunkSize - 1) / chunkSize;
+
+    auto processChunks = [state] {
+        for (auto begin = state->nextChunkBegin.fetch_add(state->chunkSize); begin < state->numItems;
+             begin = state->nextChunkBegin.fetch_add(state->chunkSize)) {
+            //remaining chunks are only counted after a failure
+            if (!state->hasFailed) {
+                try {
+                    (*state->func)(begin, std::min(begin + state->chunkSize, state->numItems));
+                } catch (...) {
+                    std::lock_guard lock(state->mutex);
+                    if (!state->exception) {
+                        state->exception = std::current_exception();
+                    }
+                    state->hasFailed = true;
+                }
+            }
+            if (++state->numFinishedChunks == state->numChunks) {
+                std::lock_guard lock(state->mutex);
+                state->allChunksFinished.notify_all();
+            }
+        }
+    };
+    auto numTasks = std::min(static_cast<int>(_threads.size()), state->numChunks - 1);
+    for (int i = 0; i < numTasks; ++i) {
+        submit(processChunks);
+    }
+    processChunks();
+
+    std::unique_lock lock(state->mutex);
+    state->allChunksFinished.wait(lock, [&] { return state->numFinishedChunks == state->numChunks; });
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(_threads.size());
+}
+
+int ThreadPool::getNumPendingTasks() const
+{
+    std::lock_guard lock(_mutex);
+    return static_cast<int>(_tasks.size()) + _numRunningTasks;
+}
+
+void ThreadPool::runWorkerThread()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(_mutex);
+            _taskAvailable.wait(lock, [this] { return _isShutdown || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+            ++_numRunningTasks;
+        }
+        task();
+        {
+            std::lock_guard lock(_mutex);
+            --_numRunningTasks;
+        }
+        _allTasksFinished.notify_all();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//executes tasks on a fixed number of threads in the order of submission (which is also the execution order in case of one thread)
+class ThreadPool
+{
+public:
+    ThreadPool(int numThreads);
+    ~ThreadPool();  //waits for all submitted tasks
+
+    void submit(std::function<void()> const& task);
+    void waitForAll();
+
+    //processes the index range [0, numItems) in chunks which are claimed dynamically by the worker threads and the calling thread,
+    //so that threads finishing early take over remaining chunks; returns when all chunks are processed without waiting for other tasks,
+    //hence several threads can call it concurrently (submitted tasks which found no chunk left may still be pending afterwards)
+    //if 'func' throws, no further chunks are started and the first exception is rethrown after the claimed chunks have finished
+    void parallelFor(int numItems, int chunkSize, std::function<void(int begin, int end)> const& func);
+    int getNumThreads() const;
+
+    int getNumPendingTasks() const;  //including running tasks
+
+private:
+    void runWorkerThread();
+
+    std::vector<std::thread> _threads;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _taskAvailable;
+    std::condition_variable _allTasksFinished;
+    std::deque<std::function<void()>> _tasks;
+    int _numRunningTasks = 0;
+    bool _isShutdown = false;
+};
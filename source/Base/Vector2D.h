@@ -39,11 +39,24 @@ struct RealVector2D
     float y = 0.0f;
 
     RealVector2D() = default;
-    RealVector2D(float x_, float y_);
+    RealVector2D(float x_, float y_)
+        : x(x_)
+        , y(y_)
+    {}
     RealVector2D(std::initializer_list<float> l);
     bool operator==(RealVector2D const& other) const;
-    void operator+=(RealVector2D const& vec);
-    void operator-=(RealVector2D const& vec);
+
+    //arithmetic operators are defined inline since they are used in hot loops of the host engine
+    void operator+=(RealVector2D const& vec)
+    {
+        x += vec.x;
+        y += vec.y;
+    }
+    void operator-=(RealVector2D const& vec)
+    {
+        x -= vec.x;
+        y -= vec.y;
+    }
     template <typename T>
     void operator*=(T factor)
     {
@@ -61,11 +74,11 @@ struct RealVector2D
     {
         return RealVector2D{x * factor, y * factor};
     }
-    RealVector2D operator+(RealVector2D const& other) const;
-    RealVector2D operator-(RealVector2D const& other) const;
-    RealVector2D operator-() const;
-    RealVector2D operator*(float factor) const;
-    RealVector2D operator/(float divisor) const;
+    RealVector2D operator+(RealVector2D const& other) const { return RealVector2D{x + other.x, y + other.y}; }
+    RealVector2D operator-(RealVector2D const& other) const { return RealVector2D{x - other.x, y - other.y}; }
+    RealVector2D operator-() const { return RealVector2D{-x, -y}; }
+    RealVector2D operator*(float factor) const { return RealVector2D{x * factor, y * factor}; }
+    RealVector2D operator/(float divisor) const { return RealVector2D{x / divisor, y / divisor}; }
 };
 
 inline IntVector2D toIntVector2D(RealVector2D const& v)
@@ -1,91 +1,973 @@
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <thread>
 
 #include "CLI/CLI.hpp"
 
 #include "Base/GlobalSettings.h"
 #include "Base/LoggingService.h"
+#include "Base/ProcessInfo.h"
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
+#include "Base/ThreadPool.h"
 #include "Base/FileLogger.h"
-#include "EngineImpl/SimulationControllerImpl.h"
+#include "EngineCpu/CpuFluidPhysics.h"
+#include "EngineCpu/CpuNeuronEvaluator.h"
+#include "EngineCpu/CpuSensorScanner.h"
+#include "EngineImpl/SimulationControllerFactory.h"
+#include "EngineInterface/BatchJobs.h"
+#include "EngineInterface/Benchmark.h"
+#include "EngineInterface/CheckpointStore.h"
+#include "EngineInterface/ControlServer.h"
+#include "EngineInterface/EnsembleStatistics.h"
+#include "EngineInterface/EventSchedule.h"
+#include "EngineInterface/FrameEncoder.h"
+#include "EngineInterface/ParameterSweep.h"
+#include "EngineInterface/ProfilingDataExporter.h"
 #include "EngineInterface/Serializer.h"
+#include "EngineInterface/SimulationBackend.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/SoftwareRasterizer.h"
+#include "EngineInterface/StatisticsExporter.h"
+#include "EngineInterface/StatisticsTimeSeriesWriter.h"
+#include "EngineInterface/StopConditions.h"
 
 namespace
 {
+    auto constexpr ProfilingInterval = 1000;
+    auto constexpr MaxPendingFramesPerThread = 2;  //stepping waits for the encoding if more frames are pending
+    auto constexpr ControlInterval = 10;  //time steps between the processing of control requests
+    auto constexpr PausePollingInterval = std::chrono::milliseconds(20);
+
+    //action which is executed every 'interval' time steps of a run and after its last time step
+    struct PeriodicAction
+    {
+        int interval;
+        std::function<void()> action;
+    };
+
+    struct StopOptions
+    {
+        bool untilExtinct = false;
+        std::vector<std::string> untilExpressions;
+        std::vector<std::string> untilPlateau;  //metric, window, tolerance
+        double maxSeconds = 0;
+        int checkInterval = 100;
+    };
+
+    void addStopOptions(CLI::App* app, StopOptions& options)
+    {
+        app->add_flag("--until-extinct", options.untilExtinct, "Stops the run when no self-replicators are left.");
+        app->add_option(
+            "--until",
+            options.untilExpressions,
+            "Stops the run when the given condition on the statistics holds, e.g. \"numSelfReplicators[0] > 10000\". Metrics without color index are summed "
+            "over all colors. Comparisons can be combined by '&&' and '||'.");
+        app->add_option(
+               "--until-plateau",
+               options.untilPlateau,
+               "Stops the run when the given metric varies by at most the given relative tolerance over the given number of checks, e.g. numCells 20 0.01.")
+            ->expected(3);
+        app->add_option("--max-seconds", options.maxSeconds, "Stops the run after the given wall-clock time.")->check(CLI::PositiveNumber);
+        app->add_option("--check-every", options.checkInterval, "Specifies the number of time steps between the evaluations of the stop conditions.")
+            ->check(CLI::PositiveNumber);
+    }
+
+    //throws InvalidStopConditionException
+    StopConditions createStopConditions(StopOptions const& options)
+    {
+        StopConditions result;
+        if (options.untilExtinct) {
+            result.addExtinction();
+        }
+        for (auto const& expression : options.untilExpressions) {
+            result.addExpression(expression);
+        }
+        if (!options.untilPlateau.empty()) {
+            try {
+                result.addPlateau(options.untilPlateau.at(0), std::stoi(options.untilPlateau.at(1)), std::stod(options.untilPlateau.at(2)));
+            } catch (std::logic_error const&) {
+                throw InvalidStopConditionException("Invalid window or tolerance for '--until-plateau'.");
+            }
+        }
+        if (options.maxSeconds > 0) {
+            result.setMaxDuration(std::chrono::milliseconds(static_cast<int64_t>(options.maxSeconds * 1000)));
+        }
+        return result;
+    }
+
+    DeserializedSimulation getSimulationData(SimulationController const& simController, AuxiliaryData const& auxiliaryData)
+    {
+        DeserializedSimulation result;
+        result.auxiliaryData = auxiliaryData;
+        result.auxiliaryData.timestep = simController->getCurrentTimestep();
+        result.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+        result.mainData = simController->getClusteredSimulationData();
+        return result;
+    }
+
+    //failures are reported but do not abort the run
+    void applyEvent(SimulationController const& simController, ScheduledEvent const& event)
+    {
+        auto timestep = simController->getCurrentTimestep();
+        auto success = true;
+        switch (event.type) {
+        case ScheduledEventType_Parameters: {
+            simController->setSimulationParameters(ParameterPatch::apply(simController->getSimulationParameters(), event.parameterValues));
+        } break;
+        case ScheduledEventType_Cataclysm: {
+            simController->applyCataclysm(event.power);
+        } break;
+        case ScheduledEventType_InjectSimulation: {
+            ClusteredDataDescription content;
+            success = Serializer::deserializeContentFromFile(content, event.filename);
+            if (success) {
+                if (event.position) {
+                    content.setCenter(*event.position);
+                }
+                simController->addAndSelectSimulationData(DataDescription(content));
+                simController->removeSelection();
+            }
+        } break;
+        case ScheduledEventType_InjectGenome: {
+            std::vector<uint8_t> genome;
+            success = Serializer::deserializeGenomeFromFile(genome, event.filename);
+            if (success) {
+                auto worldSize = simController->getWorldSize();
+                auto position = event.position.value_or(RealVector2D(toFloat(worldSize.x) / 2, toFloat(worldSize.y) / 2));
+                simController->addAndSelectSimulationData(EventSchedule::createSpore(genome, position, event.color, simController->getSimulationParameters()));
+                simController->removeSelection();
+            }
+        } break;
+        case ScheduledEventType_Snapshot: {
+            AuxiliaryData auxiliaryData;
+            auxiliaryData.generalSettings = simController->getGeneralSettings();
+            success = Serializer::serializeSimulationToFiles(
+                EventSchedule::getSnapshotFilename(event.filename, timestep), getSimulationData(simController, auxiliaryData));
+        } break;
+        }
+        if (!success) {
+            std::cout << "Event at time step " << StringHelper::format(timestep) << " failed: could not access '" << event.filename << "'." << std::endl;
+        }
+    }
+
+    //pause state and TPS limit of a run, which can be changed via the control server
+    class RunControl : public ControlTarget
+    {
+    public:
+        RunControl(SimulationController const& simController, AuxiliaryData const& auxiliaryData)
+            : _simController(simController)
+            , _auxiliaryData(auxiliaryData)
+        {
+            resetMeasurement();
+        }
+
+        ControlStatus getStatus() override
+        {
+            ControlStatus result;
+            result.timestep = _simController->getCurrentTimestep();
+            result.tps = _tps;
+            result.paused = _paused;
+            result.tpsLimit = _tpsLimit;
+            result.statistics = _simController->getStatistics().timeline;
+            return result;
+        }
+
+        bool saveSnapshot(std::string const& filename) override
+        {
+            auto timestep = _simController->getCurrentTimestep();
+            return Serializer::serializeSimulationToFiles(EventSchedule::getSnapshotFilename(filename, timestep), getSimulationData(_simController, _auxiliaryData));
+        }
+
+        void setPaused(bool value) override
+        {
+            _paused = value;
+            resetMeasurement();
+        }
+
+        void setTpsLimit(std::optional<int> const& value) override
+        {
+            _tpsLimit = value;
+            resetMeasurement();
+        }
+
+        void setParameters(std::vector<ParameterValue> const& values) override
+        {
+            _simController->setSimulationParameters(ParameterPatch::apply(_simController->getSimulationParameters(), values));
+        }
+
+        //executes the pending requests, blocks while the run is paused and sleeps if the TPS limit is exceeded
+        void process(ControlServer& server)
+        {
+            server.processPendingJobs();
+            while (_paused) {
+                std::this_thread::sleep_for(PausePollingInterval);
+                server.processPendingJobs();
+            }
+
+            auto timesteps = _simController->getCurrentTimestep() - _measurementTimestep;
+            auto elapsedTime = std::chrono::steady_clock::now() - _measurementTimepoint;
+            if (_tpsLimit) {
+                auto targetTime = std::chrono::duration<double>(toDouble(timesteps) / *_tpsLimit);
+                if (targetTime > elapsedTime) {
+                    std::this_thread::sleep_for(targetTime - elapsedTime);
+                    elapsedTime = std::chrono::steady_clock::now() - _measurementTimepoint;
+                }
+            }
+            auto seconds = std::chrono::duration<double>(elapsedTime).count();
+            if (seconds >= 1.0) {
+                _tps = toFloat(toDouble(timesteps) / seconds);
+                resetMeasurement();
+            }
+        }
+
+    private:
+        void resetMeasurement()
+        {
+            _measurementTimestep = _simController->getCurrentTimestep();
+            _measurementTimepoint = std::chrono::steady_clock::now();
+        }
+
+        SimulationController _simController;
+        AuxiliaryData const& _auxiliaryData;
+        bool _paused = false;
+        std::optional<int> _tpsLimit;
+        float _tps = 0;
+        uint64_t _measurementTimestep = 0;
+        std::chrono::steady_clock::time_point _measurementTimepoint;
+    };
+
+    //returns the reason if the run has been stopped by a stop condition
+    std::optional<std::string> runSimulation(
+        SimulationController const& simController,
+        int timesteps,
+        std::vector<PeriodicAction> periodicActions,
+        StopConditions& stopConditions,
+        int stopCheckInterval,
+        EventSchedule* eventSchedule = nullptr)
+    {
+        std::optional<std::string> result;
+        auto startTimestep = simController->getCurrentTimestep();
+        if (!stopConditions.isEmpty()) {
+            auto startTimepoint = std::chrono::steady_clock::now();
+            periodicActions.emplace_back(PeriodicAction{stopCheckInterval, [&] {
+                auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+                result = stopConditions.evaluate(simController->getStatistics().timeline, elapsedTime);
+            }});
+        }
+        for (int calculatedTimesteps = 0; calculatedTimesteps < timesteps;) {
+            auto nextTimesteps = timesteps - calculatedTimesteps;
+            for (auto const& periodicAction : periodicActions) {
+                nextTimesteps = std::min(nextTimesteps, periodicAction.interval - calculatedTimesteps % periodicAction.interval);
+            }
+            if (auto nextEventTimestep = eventSchedule ? eventSchedule->getNextTimestep() : std::nullopt) {
+                nextTimesteps = toInt(std::clamp<uint64_t>(*nextEventTimestep - std::min(*nextEventTimestep, startTimestep + calculatedTimesteps), 1, nextTimesteps));
+            }
+            simController->calcTimesteps(nextTimesteps);
+            calculatedTimesteps += nextTimesteps;
+
+            //events are applied before the periodic actions of the same time step
+            if (eventSchedule) {
+                for (auto const& event : eventSchedule->popDueEvents(startTimestep + calculatedTimesteps)) {
+                    applyEvent(simController, event);
+                }
+            }
+
+            std::vector<bool> executed(periodicActions.size(), false);
+            for (size_t i = 0; i < periodicActions.size(); ++i) {
+                if (calculatedTimesteps % periodicActions[i].interval == 0 || calculatedTimesteps == timesteps) {
+                    periodicActions[i].action();
+                    executed[i] = true;
+                }
+            }
+
+            //last time step of a stopped run
+            if (result) {
+                for (size_t i = 0; i < periodicActions.size(); ++i) {
+                    if (!executed[i]) {
+                        periodicActions[i].action();
+                    }
+                }
+                break;
+            }
+        }
+        return result;
+    }
+
+    std::optional<IntVector2D> parseFrameSize(std::string const& value)
+    {
+        IntVector2D result;
+        char separator;
+        std::stringstream stream(value);
+        if (!(stream >> result.x >> separator >> result.y) || separator != 'x' || result.x <= 0 || result.y <= 0 || !stream.eof()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    std::string getFrameFilename(std::string const& directory, uint64_t timestep)
+    {
+        std::stringstream stream;
+        stream << "frame_" << std::setw(12) << std::setfill('0') << timestep << ".png";
+        return (std::filesystem::path(directory) / stream.str()).string();
+    }
 
     bool writeStatistics(SimulationController const& simController, std::string const& statisticsFilename)
     {
-        auto statistics = simController->getStatistics();
         std::ofstream file;
         file.open(statisticsFilename, std::ios_base::out);
         if (!file) {
             return false;
         }
+        StatisticsExporter::writeCsvHeader(file);
+        StatisticsExporter::writeCsvRow(file, simController->getCurrentTimestep(), simController->getStatistics().timeline);
+        file.close();
+        return true;
+    }
+
+    struct SweepOptions
+    {
+        std::string inputFilename;
+        std::string specFilename;
+        std::string outputDirectory;
+        int timesteps = 0;  //0 = taken from spec
+        int numParallelRuns = 0;  //0 = taken from spec
+        StopOptions stopOptions;
+        SimulationBackend backend = SimulationBackend_Gpu;
+    };
 
-        auto writeLabelAllColors = [&file](auto const& name) {
-            for (int i = 0; i < MAX_COLORS; ++i) {
-                file << ", " << name << " (color " << i << ")";
+    //runs all parameter combinations of the sweep spec with the same loaded simulation, each worker thread reuses its simulation controller
+    int runSweep(SweepOptions const& options)
+    {
+        SweepSpec spec;
+        try {
+            spec = ParameterSweep::parseSpecFromFile(options.specFilename);
+        } catch (InvalidSweepSpecException const& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+        auto timesteps = options.timesteps > 0 ? options.timesteps : spec.timesteps.value_or(0);
+        auto numParallelRuns = options.numParallelRuns > 0 ? options.numParallelRuns : spec.numParallelRuns;
+        if (numParallelRuns > 1 && options.backend == SimulationBackend_Gpu) {
+            //concurrent GPU simulations would overwrite each other's parameters in the process-wide constant memory
+            std::cout << "Parallel runs are only supported by the CPU backend." << std::endl;
+            return 1;
+        }
+        try {
+            if (timesteps == 0 && !createStopConditions(options.stopOptions).isEmpty()) {
+                timesteps = std::numeric_limits<int>::max();
             }
-        };
-        file << "Time step";
-        writeLabelAllColors("Cells");
-        writeLabelAllColors("Self-replicators");
-        writeLabelAllColors("Viruses");
-        writeLabelAllColors("Cell connections");
-        writeLabelAllColors("Energy particles");
-        writeLabelAllColors("Total energy");
-        writeLabelAllColors("Total genome cells");
-        writeLabelAllColors("Created cells");
-        writeLabelAllColors("Attacks");
-        writeLabelAllColors("Muscle activities");
-        writeLabelAllColors("Transmitter activities");
-        writeLabelAllColors("Defender activities");
-        writeLabelAllColors("Injection activities");
-        writeLabelAllColors("Completed injections");
-        writeLabelAllColors("Nerve pulses");
-        writeLabelAllColors("Neuron activities");
-        writeLabelAllColors("Sensor activities");
-        writeLabelAllColors("Sensor matches");
-        file << std::endl;
-
-        auto writeIntValueAllColors = [&file](ColorVector<int> const& values) {
-            for (int i = 0; i < MAX_COLORS; ++i) {
-                file << ", " << static_cast<uint64_t>(values[i]);
+        } catch (InvalidStopConditionException const& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Reading input" << std::endl;
+        DeserializedSimulation simData;
+        if (options.inputFilename.empty() || !Serializer::deserializeSimulationFromFiles(simData, options.inputFilename)) {
+            std::cout << "Could not read from input files." << std::endl;
+            return 1;
+        }
+        std::error_code error;
+        std::filesystem::create_directories(options.outputDirectory, error);
+        if (options.outputDirectory.empty() || !std::filesystem::is_directory(options.outputDirectory, error)) {
+            std::cout << "Could not create output directory." << std::endl;
+            return 1;
+        }
+
+        auto runs = ParameterSweep::expand(spec);
+        std::cout << "Start sweep: " << runs.size() << " runs, " << StringHelper::format(timesteps) << " time steps each" << std::endl;
+
+        std::vector<SweepRunResult> results(runs.size());
+        std::atomic<int> nextRunIndex{0};
+        std::mutex outputMutex;
+        auto processRuns = [&] {
+            auto simController = SimulationControllerFactory::create(options.backend);
+            for (auto runIndex = nextRunIndex++; runIndex < toInt(runs.size()); runIndex = nextRunIndex++) {
+                auto const& run = runs.at(runIndex);
+                auto runName = ParameterSweep::getRunName(run);
+                auto& result = results.at(runIndex);
+                auto isSimulationCreated = false;
+                try {
+                    auto auxiliaryData = simData.auxiliaryData;
+                    auxiliaryData.simulationParameters = ParameterSweep::applyRun(simData.auxiliaryData.simulationParameters, spec, run);
+                    simController->newSimulation(auxiliaryData.timestep, auxiliaryData.generalSettings, auxiliaryData.simulationParameters);
+                    isSimulationCreated = true;
+                    simController->setClusteredSimulationData(simData.mainData);
+
+                    //dead configurations can be abandoned early by stop conditions
+                    auto stopConditions = createStopConditions(options.stopOptions);
+                    auto startTimepoint = std::chrono::steady_clock::now();
+                    result.stopReason = runSimulation(simController, timesteps, {}, stopConditions, options.stopOptions.checkInterval).value_or("");
+                    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+                    result.timestep = simController->getCurrentTimestep();
+                    result.tps = ms != 0 ? 1000.0f * toFloat(result.timestep - auxiliaryData.timestep) / toFloat(ms) : 0.0f;
+                    result.statistics = simController->getStatistics().timeline;
+
+                    auto outputFilename = (std::filesystem::path(options.outputDirectory) / runName).string();
+                    result.succeeded = Serializer::serializeSimulationToFiles(outputFilename + ".sim", getSimulationData(simController, auxiliaryData))
+                        && writeStatistics(simController, outputFilename + ".statistics.csv");
+                } catch (std::exception const& e) {
+                    std::lock_guard lock(outputMutex);
+                    std::cout << runName << " failed: " << e.what() << std::endl;
+                }
+                if (isSimulationCreated) {
+                    simController->closeSimulation();
+                }
+                std::lock_guard lock(outputMutex);
+                std::cout << runName << " finished: " << StringHelper::format(result.tps, 1) << " TPS" << std::endl;
             }
         };
-        auto writeInt64ValueAllColors = [&file](ColorVector<uint64_t> const& values) {
-            for (int i = 0; i < MAX_COLORS; ++i) {
-                file << ", " << values[i];
+        std::vector<std::thread> threads;
+        for (int i = 0; i < std::min(numParallelRuns, toInt(runs.size())); ++i) {
+            threads.emplace_back(processRuns);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::ofstream summaryFile((std::filesystem::path(options.outputDirectory) / "summary.csv").string(), std::ios_base::out);
+        if (!summaryFile) {
+            std::cout << "Could not write to summary file." << std::endl;
+            return 1;
+        }
+        ParameterSweep::writeSummaryCsv(summaryFile, spec, runs, results);
+
+        auto numFailedRuns = std::count_if(results.begin(), results.end(), [](auto const& result) { return !result.succeeded; });
+        std::cout << "Sweep finished: " << runs.size() - numFailedRuns << " of " << runs.size() << " runs succeeded" << std::endl;
+        return numFailedRuns == 0 ? 0 : 1;
+    }
+
+    struct ReplicaOptions
+    {
+        std::string inputFilename;
+        std::string outputFilename;
+        std::string statisticsFilename;
+        int timesteps = 0;
+        int statisticsInterval = 0;
+        StatisticsFormat statisticsFormat = StatisticsFormat_Csv;
+        int numReplicas = 1;
+        uint32_t seed = 0;
+        StopOptions stopOptions;
+        EventSchedule eventSchedule;
+        SimulationBackend backend = SimulationBackend_Gpu;
+    };
+
+    //runs seeded copies of the input one after another on the same device, the aggregated statistics are written to the statistics file and
+    //the statistics of each replica to its own file
+    int runReplicas(ReplicaOptions const& options)
+    {
+        StopConditions stopConditions;
+        try {
+            stopConditions = createStopConditions(options.stopOptions);
+        } catch (InvalidStopConditionException const& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+        auto timesteps = options.timesteps == 0 && !stopConditions.isEmpty() ? std::numeric_limits<int>::max() : options.timesteps;
+        if (options.statisticsInterval > 0 && options.statisticsFilename.empty()) {
+            std::cout << "No statistics file given." << std::endl;
+            return 1;
+        }
+
+        std::cout << "Reading input" << std::endl;
+        DeserializedSimulation simData;
+        if (options.inputFilename.empty() || !Serializer::deserializeSimulationFromFiles(simData, options.inputFilename)) {
+            std::cout << "Could not read from input files." << std::endl;
+            return 1;
+        }
+
+        auto baseSeed = options.seed != 0 ? options.seed : 1;
+        std::cout << "Start " << options.numReplicas << " replicas with seeds " << baseSeed << " to " << baseSeed + options.numReplicas - 1 << std::endl;
+
+        EnsembleStatistics ensembleStatistics;
+        auto simController = SimulationControllerFactory::create(options.backend);
+        for (int replica = 0; replica < options.numReplicas; ++replica) {
+            auto auxiliaryData = simData.auxiliaryData;
+            auxiliaryData.generalSettings.randomSeed = baseSeed + replica;
+            simController->newSimulation(auxiliaryData.timestep, auxiliaryData.generalSettings, auxiliaryData.simulationParameters);
+            simController->setClusteredSimulationData(simData.mainData);
+
+            std::vector<PeriodicAction> periodicActions;
+            StatisticsTimeSeriesWriter statisticsWriter;
+            auto addStatistics = [&] {
+                auto statistics = simController->getStatistics().timeline;
+                ensembleStatistics.add(simController->getCurrentTimestep(), statistics);
+                statisticsWriter.add(simController->getCurrentTimestep(), statistics);
+            };
+            if (options.statisticsInterval > 0) {
+                if (!statisticsWriter.open(EnsembleStatistics::getReplicaFilename(options.statisticsFilename, replica), options.statisticsFormat)) {
+                    std::cout << "Could not write to statistics file." << std::endl;
+                    return 1;
+                }
+                addStatistics();
+                periodicActions.emplace_back(PeriodicAction{options.statisticsInterval, addStatistics});
+            }
+
+            auto replicaStopConditions = stopConditions;
+            auto replicaEventSchedule = options.eventSchedule;
+            for (auto const& event : replicaEventSchedule.popDueEvents(auxiliaryData.timestep)) {
+                applyEvent(simController, event);
+            }
+            auto startTimepoint = std::chrono::steady_clock::now();
+            auto stopReason =
+                runSimulation(simController, timesteps, periodicActions, replicaStopConditions, options.stopOptions.checkInterval, &replicaEventSchedule);
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+            statisticsWriter.close();
+            if (options.statisticsInterval == 0) {
+                ensembleStatistics.add(simController->getCurrentTimestep(), simController->getStatistics().timeline);
+            }
+
+            auto calculatedTimesteps = simController->getCurrentTimestep() - auxiliaryData.timestep;
+            auto tps = ms != 0 ? 1000.0f * toFloat(calculatedTimesteps) / toFloat(ms) : 0.0f;
+            std::cout << "Replica " << replica << " finished: " << StringHelper::format(calculatedTimesteps) << " time steps, "
+                      << StringHelper::format(tps, 1) << " TPS" << (stopReason ? ", stopped: " + *stopReason : std::string()) << std::endl;
+
+            if (!options.outputFilename.empty()
+                && !Serializer::serializeSimulationToFiles(
+                    EnsembleStatistics::getReplicaFilename(options.outputFilename, replica), getSimulationData(simController, auxiliaryData))) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+            simController->closeSimulation();
+        }
+
+        if (!options.statisticsFilename.empty()) {
+            std::ofstream statisticsFile(options.statisticsFilename, std::ios_base::out);
+            if (!statisticsFile) {
+                std::cout << "Could not write to statistics file." << std::endl;
+                return 1;
+            }
+            ensembleStatistics.writeCsv(statisticsFile);
+        }
+        std::cout << "Finished" << std::endl;
+        return 0;
+    }
+
+    struct BenchmarkOptions
+    {
+        std::string inputFilename;  //reference world is used if empty
+        std::string referenceWorld = "medium";
+        std::string reportFilename;  //report is printed if empty
+        int warmupTimesteps = 1000;
+        int numIntervals = 5;
+        int intervalTimesteps = 1000;
+        bool phaseTimings = true;  //not supported by the CPU backend
+        SimulationBackend backend = SimulationBackend_Gpu;
+    };
+
+    double getMilliseconds(std::chrono::steady_clock::time_point const& startTimepoint)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTimepoint).count();
+    }
+
+    //measures the throughput after a warm-up phase and reports it together with phase durations of an additional profiled interval,
+    //host-side durations and memory as JSON
+    int runBenchmark(BenchmarkOptions const& options)
+    {
+        BenchmarkReport report;
+        DeserializedSimulation simData;
+        std::optional<BenchmarkWorld> referenceWorld;
+        if (!options.inputFilename.empty()) {
+            if (!Serializer::deserializeSimulationFromFiles(simData, options.inputFilename)) {
+                std::cout << "Could not read from input files." << std::endl;
+                return 1;
+            }
+            report.world = options.inputFilename;
+        } else {
+            referenceWorld = Benchmark::createReferenceWorld(options.referenceWorld);
+            if (!referenceWorld) {
+                std::cout << "Unknown reference world." << std::endl;
+                return 1;
+            }
+            simData.auxiliaryData.generalSettings.worldSizeX = referenceWorld->worldSize.x;
+            simData.auxiliaryData.generalSettings.worldSizeY = referenceWorld->worldSize.y;
+            report.world = options.referenceWorld;
+        }
+        simData.auxiliaryData.generalSettings.randomSeed = 1;  //reproducible runs
+
+        auto simController = SimulationControllerFactory::create(options.backend);
+        simController->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
+        report.gpuName = simController->getGpuName();
+        report.worldSize = simController->getWorldSize();
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        if (referenceWorld) {
+            simController->setSimulationData(referenceWorld->data);
+        } else {
+            simController->setClusteredSimulationData(simData.mainData);
+        }
+        report.uploadDuration = getMilliseconds(startTimepoint);
+
+        std::cout << "Warm-up: " << StringHelper::format(options.warmupTimesteps) << " time steps" << std::endl;
+        simController->calcTimesteps(options.warmupTimesteps);
+        report.warmupTimesteps = options.warmupTimesteps;
+
+        for (int i = 0; i < options.numIntervals; ++i) {
+            startTimepoint = std::chrono::steady_clock::now();
+            simController->calcTimesteps(options.intervalTimesteps);
+            BenchmarkInterval interval{options.intervalTimesteps, getMilliseconds(startTimepoint)};
+            report.intervals.emplace_back(interval);
+            std::cout << "Interval " << i + 1 << ": " << StringHelper::format(toFloat(Benchmark::calcTps(interval)), 1) << " TPS" << std::endl;
+        }
+
+        //profiling synchronizes after each phase and would distort the throughput, hence the phase durations are measured in a separate pass
+        if (options.phaseTimings) {
+            std::cout << "Phase durations: " << StringHelper::format(options.intervalTimesteps) << " time steps" << std::endl;
+            simController->setProfilingEnabled(true);
+            simController->calcTimesteps(options.intervalTimesteps);
+            report.profilingData = simController->getProfilingData();
+            simController->setProfilingEnabled(false);
+        }
+
+        startTimepoint = std::chrono::steady_clock::now();
+        auto resultData = getSimulationData(simController, simData.auxiliaryData);
+        report.downloadDuration = getMilliseconds(startTimepoint);
+
+        startTimepoint = std::chrono::steady_clock::now();
+        SerializedSimulation serializedData;
+        if (!Serializer::serializeSimulationToStrings(serializedData, resultData)) {
+            std::cout << "Could not serialize simulation." << std::endl;
+            return 1;
+        }
+        report.serializationDuration = getMilliseconds(startTimepoint);
+
+        auto statistics = simController->getStatistics().timeline.timestep;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            report.numCells += statistics.numCells[i];
+            report.numParticles += statistics.numParticles[i];
+        }
+        report.peakHostMemory = ProcessInfo::getPeakResidentMemory();
+        report.deviceMemoryData = simController->getDeviceMemoryData();
+        simController->closeSimulation();
+
+        if (options.reportFilename.empty()) {
+            Benchmark::writeJsonReport(std::cout, report);
+        } else {
+            std::ofstream reportFile(options.reportFilename, std::ios_base::out);
+            if (!reportFile) {
+                std::cout << "Could not write to report file." << std::endl;
+                return 1;
+            }
+            Benchmark::writeJsonReport(reportFile, report);
+        }
+        return 0;
+    }
+
+    struct NeuronBenchmarkOptions
+    {
+        int numNetworks = 100000;
+        int iterations = 100;
+        int numThreads = 1;
+    };
+
+    //measures the throughput of the host neuron evaluator with random networks for each instruction set supported by the processor
+    int runNeuronBenchmark(NeuronBenchmarkOptions const& options)
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        CpuNeuronEvaluator evaluator;
+        std::vector<std::vector<float>> weights(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS));
+        std::vector<float> biases(MAX_CHANNELS);
+        for (int i = 0; i < options.numNetworks; ++i) {
+            for (auto& row : weights) {
+                for (auto& weight : row) {
+                    weight = distribution(generator);
+                }
+            }
+            for (auto& bias : biases) {
+                bias = distribution(generator);
+            }
+            evaluator.addNetwork(weights, biases);
+        }
+        std::vector<float> inputs(static_cast<size_t>(options.numNetworks) * MAX_CHANNELS);
+        for (auto& input : inputs) {
+            input = distribution(generator);
+        }
+        std::vector<float> outputs(inputs.size());
+
+        auto threadPool = options.numThreads > 1 ? std::make_unique<ThreadPool>(options.numThreads - 1) : nullptr;
+        std::cout << "Evaluate " << StringHelper::format(static_cast<uint64_t>(options.numNetworks)) << " neuron cells " << options.iterations
+                  << " times on " << options.numThreads << " thread(s)" << std::endl;
+        for (NeuronInstructionSet instructionSet = NeuronInstructionSet_Scalar; instructionSet <= CpuNeuronEvaluator::getSupportedInstructionSet();
+             ++instructionSet) {
+            evaluator.setInstructionSet(instructionSet);
+            evaluator.evaluate(inputs.data(), outputs.data(), threadPool.get());  //warm-up
+
+            auto startTimepoint = std::chrono::steady_clock::now();
+            for (int i = 0; i < options.iterations; ++i) {
+                evaluator.evaluate(inputs.data(), outputs.data(), threadPool.get());
+            }
+            auto cellsPerSecond = toDouble(options.numNetworks) * options.iterations / std::max(getMilliseconds(startTimepoint) / 1000, 1e-9);
+            std::cout << CpuNeuronEvaluator::getInstructionSetName(instructionSet) << ": " << StringHelper::format(static_cast<uint64_t>(cellsPerSecond))
+                      << " cells per second" << std::endl;
+        }
+        return 0;
+    }
+
+    struct FluidBenchmarkOptions
+    {
+        int numCells = 1000000;
+        int timesteps = 10;
+        int numThreads = 1;
+    };
+
+    //measures the throughput of the host fluid physics for a jittered lattice of cells where pairs of neighboring cells are connected
+    int runFluidBenchmark(FluidBenchmarkOptions const& options)
+    {
+        auto latticeSize = toInt(std::ceil(std::sqrt(toDouble(options.numCells))));
+        CpuFluidParameters parameters;
+        parameters.worldSize = {toFloat(latticeSize), toFloat(latticeSize)};
+
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-0.2f, 0.2f);
+        CpuFluidCells cells;
+        for (int i = 0; i < options.numCells; ++i) {
+            RealVector2D pos{toFloat(i % latticeSize) + 0.5f + distribution(generator), toFloat(i / latticeSize) + 0.5f + distribution(generator)};
+            cells.addCell(pos, {distribution(generator) / 10, distribution(generator) / 10});
+            if (i % 2 == 1 && i % latticeSize != 0) {
+                cells.addConnection(i - 1, i, 1.0f);
+            }
+        }
+
+        auto threadPool = options.numThreads > 1 ? std::make_unique<ThreadPool>(options.numThreads - 1) : nullptr;
+        std::cout << "Calculate " << options.timesteps << " time steps for " << StringHelper::format(static_cast<uint64_t>(options.numCells))
+                  << " cells on " << options.numThreads << " thread(s)" << std::endl;
+        CpuFluidPhysics physics;
+        physics.calcTimestep(cells, parameters, threadPool.get());  //warm-up
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        for (int i = 0; i < options.timesteps; ++i) {
+            physics.calcTimestep(cells, parameters, threadPool.get());
+        }
+        auto milliseconds = std::max(getMilliseconds(startTimepoint), 1e-6);
+        auto cellsPerSecond = toDouble(options.numCells) * options.timesteps / milliseconds * 1000;
+        std::cout << StringHelper::format(static_cast<uint64_t>(cellsPerSecond)) << " cells per second, " << milliseconds / options.timesteps
+                  << " ms per time step" << std::endl;
+        return 0;
+    }
+
+    struct SensorBenchmarkOptions
+    {
+        int worldSize = 2048;
+        int numCells = 200000;
+        int numQueries = 100000;
+        int iterations = 10;
+        int numThreads = 1;
+    };
+
+    //measures the throughput of the host sensor scanner for randomly placed creatures of 50 cells and sensors at random positions
+    int runSensorBenchmark(SensorBenchmarkOptions const& options)
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> posDistribution(0, toFloat(options.worldSize));
+        std::uniform_real_distribution<float> offsetDistribution(-5.0f, 5.0f);
+        std::uniform_int_distribution<int> colorDistribution(0, MAX_COLORS - 1);
+        CpuDensityMap densityMap;
+        densityMap.init({options.worldSize, options.worldSize});
+        for (int i = 0; i < options.numCells; i += 50) {
+            RealVector2D center{posDistribution(generator), posDistribution(generator)};
+            auto color = colorDistribution(generator);
+            for (int j = i; j < std::min(i + 50, options.numCells); ++j) {
+                densityMap.addCell({center.x + offsetDistribution(generator), center.y + offsetDistribution(generator)}, color);
+            }
+        }
+        std::vector<CpuSensorQuery> queries(options.numQueries);
+        for (auto& query : queries) {
+            query.pos = {posDistribution(generator), posDistribution(generator)};
+            query.refAngle = posDistribution(generator);
+            query.cellColor = colorDistribution(generator);
+            query.scanColor = colorDistribution(generator);
+        }
+        std::vector<CpuSensorResult> results;
+
+        auto threadPool = options.numThreads > 1 ? std::make_unique<ThreadPool>(options.numThreads - 1) : nullptr;
+        std::cout << "Scan " << StringHelper::format(static_cast<uint64_t>(options.numQueries)) << " sensor queries " << options.iterations
+                  << " times in a world with " << StringHelper::format(static_cast<uint64_t>(options.numCells)) << " cells on " << options.numThreads
+                  << " thread(s)" << std::endl;
+        CpuSensorScanner scanner;
+        auto startTimepoint = std::chrono::steady_clock::now();
+        scanner.build(densityMap, threadPool.get());
+        std::cout << "Density pyramid built in " << getMilliseconds(startTimepoint) << " ms" << std::endl;
+
+        for (auto mode : {SensorScanMode_BruteForce, SensorScanMode_Pyramid}) {
+            scanner.setMode(mode);
+            scanner.scan(queries, results, threadPool.get());  //warm-up
+
+            startTimepoint = std::chrono::steady_clock::now();
+            for (int i = 0; i < options.iterations; ++i) {
+                scanner.scan(queries, results, threadPool.get());
+            }
+            auto queriesPerSecond = toDouble(options.numQueries) * options.iterations / std::max(getMilliseconds(startTimepoint) / 1000, 1e-9);
+            auto numFound = std::count_if(results.begin(), results.end(), [](auto const& result) { return result.found; });
+            std::cout << (mode == SensorScanMode_Pyramid ? "pyramid" : "brute force") << ": "
+                      << StringHelper::format(static_cast<uint64_t>(queriesPerSecond)) << " queries per second, " << numFound << " hits"
+                      << std::endl;
+        }
+        return 0;
+    }
+
+    struct ArenaBenchmarkOptions
+    {
+        int numAllocations = 50000;
+        int timesteps = 20;
+        int numThreads = 1;
+    };
+
+    //measures the temporary allocations of time steps with blocks of 8 to 128 bytes, once with malloc/free and once with the arena of the CPU engine
+    int runArenaBenchmark(ArenaBenchmarkOptions const& options)
+    {
+        auto threadPool = options.numThreads > 1 ? std::make_unique<ThreadPool>(options.numThreads - 1) : nullptr;
+        auto forEachAllocation = [&](std::function<void(int begin, int end)> const& func) {
+            if (threadPool) {
+                threadPool->parallelFor(options.numAllocations, 256, func);
+            } else {
+                func(0, options.numAllocations);
             }
         };
-        auto writeFloatValueAllColors = [&file](ColorVector<float> const& values) {
-            for (int i = 0; i < MAX_COLORS; ++i) {
-                file << ", " << values[i];
+        auto getSize = [](int index) { return static_cast<size_t>(8 + (index % 16) * 8); };
+        std::vector<void*> pointers(options.numAllocations);
+
+        std::cout << "Allocate " << StringHelper::format(static_cast<uint64_t>(options.numAllocations)) << " blocks in each of " << options.timesteps
+                  << " time steps on " << options.numThreads << " thread(s)" << std::endl;
+        auto startTimepoint = std::chrono::steady_clock::now();
+        for (int timestep = 0; timestep < options.timesteps; ++timestep) {
+            forEachAllocation([&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    pointers[i] = std::malloc(getSize(i));
+                    static_cast<uint8_t*>(pointers[i])[0] = 1;
+                }
+            });
+            forEachAllocation([&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    std::free(pointers[i]);
+                }
+            });
+        }
+        auto mallocDuration = getMilliseconds(startTimepoint);
+
+        Arena arena;
+        startTimepoint = std::chrono::steady_clock::now();
+        for (int timestep = 0; timestep < options.timesteps; ++timestep) {
+            forEachAllocation([&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    pointers[i] = arena.allocate(getSize(i));
+                    static_cast<uint8_t*>(pointers[i])[0] = 1;
+                }
+            });
+            arena.reset();
+        }
+        auto arenaDuration = getMilliseconds(startTimepoint);
+
+        std::cout << "malloc: " << mallocDuration << " ms" << std::endl;
+        std::cout << "arena: " << arenaDuration << " ms, " << StringHelper::format(toFloat(mallocDuration / std::max(arenaDuration, 1e-6)), 1)
+                  << "x faster" << std::endl;
+        return 0;
+    }
+
+    std::future<std::optional<DeserializedSimulation>> readSimulation_async(std::string const& filename)
+    {
+        return std::async(std::launch::async, [filename]() -> std::optional<DeserializedSimulation> {
+            DeserializedSimulation result;
+            if (!Serializer::deserializeSimulationFromFiles(result, filename)) {
+                return std::nullopt;
+            }
+            return result;
+        });
+    }
+
+    //the simulation is only recreated if the world size changes or a seed is given, otherwise the device arrays are reused
+    bool canReuseSimulation(GeneralSettings const& current, GeneralSettings const& next)
+    {
+        return current.worldSizeX == next.worldSizeX && current.worldSizeY == next.worldSizeY && current.randomSeed == 0 && next.randomSeed == 0;
+    }
+
+    //processes the jobs one after another in one simulation, reading the next input and writing the previous output overlap with
+    //the calculation of the current job
+    int runJobs(std::string const& jobsFilename, SimulationBackend backend)
+    {
+        std::vector<BatchJob> jobs;
+        try {
+            jobs = BatchJobs::parseFromFile(jobsFilename);
+        } catch (InvalidBatchJobsException const& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+
+        auto simController = SimulationControllerFactory::create(backend);
+        std::optional<GeneralSettings> currentSettings;
+        std::future<bool> pendingWrite;
+        std::string pendingWriteFilename;
+        int numFailedJobs = 0;
+        auto waitForPendingWrite = [&] {
+            if (pendingWrite.valid() && !pendingWrite.get()) {
+                std::cout << "Could not write to '" << pendingWriteFilename << "'." << std::endl;
+                ++numFailedJobs;
             }
         };
-        file << simController->getCurrentTimestep();
-        writeIntValueAllColors(statistics.timeline.timestep.numCells);
-        writeIntValueAllColors(statistics.timeline.timestep.numSelfReplicators);
-        writeIntValueAllColors(statistics.timeline.timestep.numViruses);
-        writeIntValueAllColors(statistics.timeline.timestep.numConnections);
-        writeIntValueAllColors(statistics.timeline.timestep.numParticles);
-        writeFloatValueAllColors(statistics.timeline.timestep.totalEnergy);
-        writeInt64ValueAllColors(statistics.timeline.timestep.numGenomeCells);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numCreatedCells);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numAttacks);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numMuscleActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numTransmitterActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numDefenderActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numInjectionActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numCompletedInjections);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numNervePulses);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numNeuronActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numSensorActivities);
-        writeInt64ValueAllColors(statistics.timeline.accumulated.numSensorMatches);
-        file << std::endl;
-        file.close();
-        return true;
+
+        auto nextInput = readSimulation_async(jobs.front().inputFilename);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            auto const& job = jobs.at(i);
+            auto simData = nextInput.get();
+            if (i + 1 < jobs.size()) {
+                nextInput = readSimulation_async(jobs.at(i + 1).inputFilename);
+            }
+            if (!simData) {
+                std::cout << "Job " << i + 1 << ": could not read from '" << job.inputFilename << "'." << std::endl;
+                ++numFailedJobs;
+                continue;
+            }
+
+            auto const& auxiliaryData = simData->auxiliaryData;
+            if (currentSettings && canReuseSimulation(*currentSettings, auxiliaryData.generalSettings)) {
+                simController->clear();
+                simController->setCurrentTimestep(auxiliaryData.timestep);
+                simController->setSimulationParameters(auxiliaryData.simulationParameters);
+                simController->setOriginalSimulationParameters(auxiliaryData.simulationParameters);
+            } else {
+                if (currentSettings) {
+                    simController->closeSimulation();
+                }
+                simController->newSimulation(auxiliaryData.timestep, auxiliaryData.generalSettings, auxiliaryData.simulationParameters);
+                currentSettings = auxiliaryData.generalSettings;
+            }
+            simController->setClusteredSimulationData(simData->mainData);
+
+            auto startTimepoint = std::chrono::steady_clock::now();
+            simController->calcTimesteps(job.timesteps);
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+            auto tps = ms != 0 ? 1000.0f * toFloat(job.timesteps) / toFloat(ms) : 0.0f;
+            std::cout << "Job " << i + 1 << " of " << jobs.size() << " finished: " << job.inputFilename << ", " << StringHelper::format(job.timesteps)
+                      << " time steps, " << StringHelper::format(tps, 1) << " TPS" << std::endl;
+
+            waitForPendingWrite();
+            pendingWriteFilename = job.outputFilename;
+            pendingWrite = std::async(std::launch::async, [data = getSimulationData(simController, auxiliaryData), filename = job.outputFilename] {
+                return Serializer::serializeSimulationToFiles(filename, data);
+            });
+        }
+        waitForPendingWrite();
+        if (currentSettings) {
+            simController->closeSimulation();
+        }
+
+        std::cout << "Jobs finished: " << toInt(jobs.size()) - numFailedJobs << " of " << jobs.size() << " jobs succeeded" << std::endl;
+        return numFailedJobs == 0 ? 0 : 1;
     }
 }
 
@@ -100,46 +982,411 @@ int main(int argc, char** argv)
         std::string inputFilename;
         std::string outputFilename;
         std::string statisticsFilename;
+        std::string profilingFilename;
         int timesteps = 0;
+        int statisticsInterval = 0;
+        std::string statisticsFormat = "csv";
+        int checkpointInterval = 0;
+        std::string checkpointDirectory;
+        int numKeptCheckpoints = 3;
+        std::string resumeDirectory;
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding .settings.json should also be available.");
         app.add_option("-o", outputFilename, "Specifies the name of the output file for the simulation.");
         app.add_option("-t", timesteps, "The number of time steps to be calculated.");
         app.add_option("-s", statisticsFilename, "Specifies the name of the csv-file containing the statistics.");
+        app.add_option(
+            "--stats-interval",
+            statisticsInterval,
+            "Samples the statistics every given number of time steps into the statistics file. Otherwise only the statistics after the last time step "
+            "are written.")
+            ->check(CLI::PositiveNumber);
+        app.add_option("--stats-format", statisticsFormat, "Specifies the format of the statistics file in case of '--stats-interval': csv or binary.")
+            ->check(CLI::IsMember({"csv", "binary"}));
+        app.add_option(
+            "--profile",
+            profilingFilename,
+            "Specifies the name of a csv-file to which the GPU durations of the phases of the time steps are written every "
+                + std::to_string(ProfilingInterval) + " time steps.");
+        app.add_option("--checkpoint-every", checkpointInterval, "Writes a checkpoint of the simulation every given number of time steps.")
+            ->check(CLI::PositiveNumber);
+        app.add_option("--checkpoint-dir", checkpointDirectory, "Specifies the directory for the checkpoints.");
+        app.add_option("--keep", numKeptCheckpoints, "The number of most recent checkpoints to be kept.")->check(CLI::PositiveNumber);
+        app.add_option(
+            "--resume",
+            resumeDirectory,
+            "Continues the run from the latest valid checkpoint in the given directory until the originally requested time step is reached. The input "
+            "file is only read if there is no valid checkpoint. An existing statistics file is continued after the rows before the checkpoint.");
+        int framesInterval = 0;
+        std::string frameSizeString = "1280x720";
+        std::string framesDirectory = "frames";
+        std::string framesFormat = "png";
+        app.add_option("--frames-every", framesInterval, "Renders a frame of the whole world every given number of time steps.")->check(CLI::PositiveNumber);
+        app.add_option("--frame-size", frameSizeString, "Specifies the size of the frames in the format <width>x<height>.");
+        app.add_option("--frames-dir", framesDirectory, "Specifies the directory for the frames.");
+        app.add_option(
+            "--frames-format",
+            framesFormat,
+            "png: one file per frame, raw: a single file 'frames.raw' containing all frames in rgb24 format, which can be converted by e.g. 'ffmpeg -f "
+            "rawvideo -pix_fmt rgb24 -video_size <width>x<height> -i frames.raw video.mp4'.")
+            ->check(CLI::IsMember({"png", "raw"}));
+        StopOptions stopOptions;
+        addStopOptions(&app, stopOptions);
+        int numReplicas = 1;
+        uint32_t seed = 0;
+        app.add_option(
+               "--replicas",
+               numReplicas,
+               "Runs the given number of copies of the input with different seeds one after another. The statistics file then contains the mean and "
+               "standard deviation over the replicas, the statistics and output files of the replicas are suffixed by '_replica_<index>'.")
+            ->check(CLI::PositiveNumber);
+        app.add_option(
+            "--seed",
+            seed,
+            "Seeds the random numbers of the simulation. Without this option a single run is unseeded (0). With --replicas, replica i uses the "
+            "given seed + i, starting from 1 if no seed is given.");
+        std::string jobsFilename;
+        app.add_option(
+            "--jobs",
+            jobsFilename,
+            "Specifies a text file with one job per line consisting of an input file, a number of time steps and an output file. The jobs are "
+            "processed one after another in a single simulation.");
+        int controlPort = 0;
+        app.add_option(
+               "--control-port",
+               controlPort,
+               "Starts a local HTTP server on the given port for querying the statistics, writing snapshots, pausing, limiting the TPS and changing "
+               "the simulation parameters during the run.")
+            ->check(CLI::Range(1, 65535));
+        std::string eventsFilename;
+        app.add_option(
+            "--events",
+            eventsFilename,
+            "Specifies a JSON file with events (parameter changes, cataclysms, injections and snapshots) to be applied at given time steps.");
+        std::string backendString = "gpu";
+        app.add_option(
+               "--backend",
+               backendString,
+               "gpu: CUDA engine, cpu: multithreaded host engine for machines without CUDA device, it executes only the nerve, neuron and sensor cell "
+               "functions. Applies to all subcommands. "
+               "The cpu backend does not support profiling, cataclysm events and the phase durations of the benchmark.")
+            ->check(CLI::IsMember({"gpu", "cpu"}));
+
+        BenchmarkOptions benchmarkOptions;
+        auto benchmarkCommand = app.add_subcommand(
+            "benchmark", "Measures the throughput of the input simulation or a built-in reference world and writes a JSON report.");
+        benchmarkCommand->add_option("-i", benchmarkOptions.inputFilename, "Specifies the name of the input file. A reference world is used otherwise.");
+        benchmarkCommand->add_option("--world", benchmarkOptions.referenceWorld, "Specifies the reference world.")
+            ->check(CLI::IsMember(Benchmark::getReferenceWorldNames()));
+        benchmarkCommand->add_option("-o", benchmarkOptions.reportFilename, "Specifies the name of the JSON report file. The report is printed otherwise.");
+        benchmarkCommand->add_option("--warmup", benchmarkOptions.warmupTimesteps, "The number of time steps before the measurement.")
+            ->check(CLI::NonNegativeNumber);
+        benchmarkCommand->add_option("--intervals", benchmarkOptions.numIntervals, "The number of measured intervals.")->check(CLI::PositiveNumber);
+        benchmarkCommand->add_option("--interval-steps", benchmarkOptions.intervalTimesteps, "The number of time steps of each measured interval.")
+            ->check(CLI::PositiveNumber);
+        bool noPhases = false;
+        benchmarkCommand->add_flag("--no-phases", noPhases, "Omits the GPU durations of the phases from the report. Required for '--backend cpu'.");
+
+        NeuronBenchmarkOptions neuronBenchmarkOptions;
+        auto neuronBenchmarkCommand =
+            app.add_subcommand("neuron-benchmark", "Measures the throughput of the host neuron evaluator for each supported instruction set.");
+        neuronBenchmarkCommand->add_option("--networks", neuronBenchmarkOptions.numNetworks, "The number of evaluated neuron cells.")
+            ->check(CLI::PositiveNumber);
+        neuronBenchmarkCommand->add_option("--iterations", neuronBenchmarkOptions.iterations, "The number of evaluations of all neuron cells.")
+            ->check(CLI::PositiveNumber);
+        neuronBenchmarkCommand->add_option("--threads", neuronBenchmarkOptions.numThreads, "The number of threads.")->check(CLI::PositiveNumber);
+
+        FluidBenchmarkOptions fluidBenchmarkOptions;
+        auto fluidBenchmarkCommand = app.add_subcommand("fluid-benchmark", "Measures the throughput of the host fluid physics.");
+        fluidBenchmarkCommand->add_option("--cells", fluidBenchmarkOptions.numCells, "The number of cells.")->check(CLI::PositiveNumber);
+        fluidBenchmarkCommand->add_option("-t", fluidBenchmarkOptions.timesteps, "The number of measured time steps.")->check(CLI::PositiveNumber);
+        fluidBenchmarkCommand->add_option("--threads", fluidBenchmarkOptions.numThreads, "The number of threads.")->check(CLI::PositiveNumber);
+
+        SensorBenchmarkOptions sensorBenchmarkOptions;
+        auto sensorBenchmarkCommand =
+            app.add_subcommand("sensor-benchmark", "Measures the throughput of the host sensor scanner with and without the density pyramid.");
+        sensorBenchmarkCommand->add_option("--world-size", sensorBenchmarkOptions.worldSize, "The width and height of the world.")
+            ->check(CLI::PositiveNumber);
+        sensorBenchmarkCommand->add_option("--cells", sensorBenchmarkOptions.numCells, "The number of cells.")->check(CLI::PositiveNumber);
+        sensorBenchmarkCommand->add_option("--queries", sensorBenchmarkOptions.numQueries, "The number of sensor queries.")->check(CLI::PositiveNumber);
+        sensorBenchmarkCommand->add_option("--iterations", sensorBenchmarkOptions.iterations, "The number of scans of all sensor queries.")
+            ->check(CLI::PositiveNumber);
+        sensorBenchmarkCommand->add_option("--threads", sensorBenchmarkOptions.numThreads, "The number of threads.")->check(CLI::PositiveNumber);
+
+        ArenaBenchmarkOptions arenaBenchmarkOptions;
+        auto arenaBenchmarkCommand =
+            app.add_subcommand("arena-benchmark", "Measures the temporary allocations of time steps with malloc/free and with the arena of the CPU engine.");
+        arenaBenchmarkCommand->add_option("--allocations", arenaBenchmarkOptions.numAllocations, "The number of allocations per time step.")
+            ->check(CLI::PositiveNumber);
+        arenaBenchmarkCommand->add_option("-t", arenaBenchmarkOptions.timesteps, "The number of measured time steps.")->check(CLI::PositiveNumber);
+        arenaBenchmarkCommand->add_option("--threads", arenaBenchmarkOptions.numThreads, "The number of threads.")->check(CLI::PositiveNumber);
+
+        SweepOptions sweepOptions;
+        auto sweepCommand = app.add_subcommand("sweep", "Runs every combination of the parameter values given in a sweep spec on the same input simulation.");
+        sweepCommand->add_option("-i", sweepOptions.inputFilename, "Specifies the name of the input file for the simulations.")->required();
+        sweepCommand->add_option("--spec", sweepOptions.specFilename, "Specifies the name of the JSON file containing the sweep spec.")->required();
+        sweepCommand->add_option("-o", sweepOptions.outputDirectory, "Specifies the directory for the output and statistics files of the runs.")->required();
+        sweepCommand->add_option("-t", sweepOptions.timesteps, "The number of time steps to be calculated for each run (overrides the spec).");
+        sweepCommand->add_option("--parallel", sweepOptions.numParallelRuns, "The number of concurrent runs (overrides the spec). Values > 1 require '--backend cpu'.");
+        addStopOptions(sweepCommand, sweepOptions.stopOptions);
         CLI11_PARSE(app, argc, argv);
 
-        //read input
-        std::cout << "Reading input" << std::endl;
-        if (inputFilename.empty()) {
-            std::cout << "No input file given." << std::endl;
+        auto backend = backendString == "cpu" ? SimulationBackend_Cpu : SimulationBackend_Gpu;
+        sweepOptions.backend = backend;
+        benchmarkOptions.backend = backend;
+        benchmarkOptions.phaseTimings = !noPhases;
+        if (*sweepCommand) {
+            return runSweep(sweepOptions);
+        }
+        if (*benchmarkCommand) {
+            if (backend == SimulationBackend_Cpu && benchmarkOptions.phaseTimings) {
+                std::cout << "The CPU backend does not provide phase durations, use '--no-phases'." << std::endl;
+                return 1;
+            }
+            return runBenchmark(benchmarkOptions);
+        }
+        if (*neuronBenchmarkCommand) {
+            return runNeuronBenchmark(neuronBenchmarkOptions);
+        }
+        if (*fluidBenchmarkCommand) {
+            return runFluidBenchmark(fluidBenchmarkOptions);
+        }
+        if (*sensorBenchmarkCommand) {
+            return runSensorBenchmark(sensorBenchmarkOptions);
+        }
+        if (*arenaBenchmarkCommand) {
+            return runArenaBenchmark(arenaBenchmarkOptions);
+        }
+        if (!jobsFilename.empty()) {
+            return runJobs(jobsFilename, backend);
+        }
+        EventSchedule eventSchedule;
+        if (!eventsFilename.empty()) {
+            try {
+                eventSchedule = EventSchedule::parseFromFile(eventsFilename);
+            } catch (InvalidEventScheduleException const& e) {
+                std::cout << e.what() << std::endl;
+                return 1;
+            }
+        }
+        if (backend == SimulationBackend_Cpu) {
+            if (!profilingFilename.empty()) {
+                std::cout << "Profiling is not supported by the CPU backend." << std::endl;
+                return 1;
+            }
+            if (eventSchedule.contains(ScheduledEventType_Cataclysm)) {
+                std::cout << "Cataclysm events are not supported by the CPU backend." << std::endl;
+                return 1;
+            }
+        }
+        if (numReplicas > 1) {
+            if (!resumeDirectory.empty() || checkpointInterval > 0 || framesInterval > 0 || !profilingFilename.empty() || controlPort > 0) {
+                std::cout << "Replicas cannot be combined with checkpoints, frames, profiling or the control server." << std::endl;
+                return 1;
+            }
+            auto format = statisticsFormat == "binary" ? StatisticsFormat_Binary : StatisticsFormat_Csv;
+            return runReplicas(
+                {inputFilename, outputFilename, statisticsFilename, timesteps, statisticsInterval, format, numReplicas, seed, stopOptions, eventSchedule, backend});
+        }
+
+        StopConditions stopConditions;
+        try {
+            stopConditions = createStopConditions(stopOptions);
+        } catch (InvalidStopConditionException const& e) {
+            std::cout << e.what() << std::endl;
             return 1;
         }
+        if (timesteps == 0 && !stopConditions.isEmpty()) {
+            timesteps = std::numeric_limits<int>::max();  //run until a stop condition holds
+        }
+
+        //read input
         DeserializedSimulation simData;
-        if (!Serializer::deserializeSimulationFromFiles(simData, inputFilename)) {
-            std::cout << "Could not read from input files." << std::endl;
-            return 1;
+        uint64_t targetTimestep;
+        std::optional<Checkpoint> checkpoint;
+        if (!resumeDirectory.empty()) {
+            std::cout << "Reading checkpoint" << std::endl;
+            checkpoint = CheckpointStore::loadLatest(resumeDirectory);
+            if (!checkpoint) {
+                std::cout << "No valid checkpoint found." << std::endl;
+            }
         }
+        if (checkpoint) {
+            std::cout << "Resuming from time step " << StringHelper::format(checkpoint->header.timestep) << std::endl;
+            simData = std::move(checkpoint->data);
+            targetTimestep = checkpoint->header.targetTimestep;
+            eventSchedule.skipUntil(checkpoint->header.timestep);  //the effects of these events are contained in the checkpoint
+        } else {
+            std::cout << "Reading input" << std::endl;
+            if (inputFilename.empty()) {
+                std::cout << "No input file given." << std::endl;
+                return 1;
+            }
+            if (!Serializer::deserializeSimulationFromFiles(simData, inputFilename)) {
+                std::cout << "Could not read from input files." << std::endl;
+                return 1;
+            }
+            targetTimestep = simData.auxiliaryData.timestep + timesteps;
+            simData.auxiliaryData.generalSettings.randomSeed = seed;
+        }
+        timesteps = toInt(std::min<uint64_t>(targetTimestep - std::min(targetTimestep, simData.auxiliaryData.timestep), std::numeric_limits<int>::max()));
 
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
-        auto simController = std::make_shared<_SimulationControllerImpl>();
+        auto simController = SimulationControllerFactory::create(backend);
         simController->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
         simController->setClusteredSimulationData(simData.mainData);
 
         std::cout << "Device: " << simController->getGpuName() << std::endl;
         std::cout << "Start simulation" << std::endl;
-        simController->calcTimesteps(timesteps);
+        std::vector<PeriodicAction> periodicActions;
+
+        std::ofstream profilingFile;
+        if (!profilingFilename.empty()) {
+            profilingFile.open(profilingFilename, std::ios_base::out);
+            if (!profilingFile) {
+                std::cout << "Could not write to profiling file." << std::endl;
+                return 1;
+            }
+            ProfilingDataExporter::writeCsvHeader(profilingFile);
+            simController->setProfilingEnabled(true);
+            periodicActions.emplace_back(PeriodicAction{ProfilingInterval, [&] {
+                ProfilingDataExporter::writeCsvRows(profilingFile, simController->getCurrentTimestep(), simController->getProfilingData());
+            }});
+        }
+
+        StatisticsTimeSeriesWriter statisticsWriter;
+        if (statisticsInterval > 0) {
+            if (statisticsFilename.empty()) {
+                std::cout << "No statistics file given." << std::endl;
+                return 1;
+            }
+            auto format = statisticsFormat == "binary" ? StatisticsFormat_Binary : StatisticsFormat_Csv;
+            auto success = checkpoint ? statisticsWriter.openForResume(statisticsFilename, format, checkpoint->header.timestep)
+                                      : statisticsWriter.open(statisticsFilename, format);
+            if (!success) {
+                std::cout << "Could not write to statistics file." << std::endl;
+                return 1;
+            }
+            statisticsWriter.add(simController->getCurrentTimestep(), simController->getStatistics().timeline);
+            periodicActions.emplace_back(PeriodicAction{statisticsInterval, [&] {
+                statisticsWriter.add(simController->getCurrentTimestep(), simController->getStatistics().timeline);
+            }});
+        }
+
+        std::optional<CheckpointStore> checkpointStore;
+        if (checkpointInterval > 0) {
+            if (checkpointDirectory.empty()) {
+                checkpointDirectory = resumeDirectory;
+            }
+            if (checkpointDirectory.empty()) {
+                std::cout << "No checkpoint directory given." << std::endl;
+                return 1;
+            }
+            checkpointStore.emplace(checkpointDirectory, numKeptCheckpoints, targetTimestep);
+            if (!checkpointStore->init()) {
+                std::cout << "Could not create checkpoint directory." << std::endl;
+                return 1;
+            }
+            periodicActions.emplace_back(PeriodicAction{checkpointInterval, [&] {
+                if (!checkpointStore->waitForPendingSave()) {
+                    std::cout << "Could not write checkpoint." << std::endl;
+                }
+                checkpointStore->save_async(getSimulationData(simController, simData.auxiliaryData));
+            }});
+        }
+
+        //frames are rendered by the software rasterizer and encoded on a thread pool, raw frames are written by a single thread to preserve their order
+        std::ofstream rawFramesFile;
+        std::atomic<bool> frameEncodingFailed{false};
+        std::optional<ThreadPool> frameEncoderPool;
+        if (framesInterval > 0) {
+            auto frameSize = parseFrameSize(frameSizeString);
+            if (!frameSize) {
+                std::cout << "Invalid frame size." << std::endl;
+                return 1;
+            }
+            std::error_code error;
+            std::filesystem::create_directories(framesDirectory, error);
+            if (!std::filesystem::is_directory(framesDirectory, error)) {
+                std::cout << "Could not create frames directory." << std::endl;
+                return 1;
+            }
+            auto isRaw = framesFormat == "raw";
+            if (isRaw) {
+                rawFramesFile.open((std::filesystem::path(framesDirectory) / "frames.raw").string(), std::ios::binary);
+                if (!rawFramesFile) {
+                    std::cout << "Could not write to raw frames file." << std::endl;
+                    return 1;
+                }
+            }
+            auto numEncoderThreads = isRaw ? 1 : std::max(1, toInt(std::thread::hardware_concurrency()) / 2);
+            frameEncoderPool.emplace(numEncoderThreads);
+            periodicActions.emplace_back(PeriodicAction{framesInterval, [&, frameSize = *frameSize, isRaw, numEncoderThreads] {
+                if (frameEncoderPool->getNumPendingTasks() >= numEncoderThreads * MaxPendingFramesPerThread) {
+                    frameEncoderPool->waitForAll();
+                }
+                auto data = std::make_shared<DataDescription>(simController->getSimulationData());
+                auto timestep = simController->getCurrentTimestep();
+                auto worldSize = simController->getWorldSize();
+                auto parameters = simController->getSimulationParameters();
+                frameEncoderPool->submit([&, data, timestep, worldSize, parameters, frameSize, isRaw] {
+                    auto frame = SoftwareRasterizer::draw(*data, worldSize, frameSize, parameters);
+                    auto success = isRaw ? FrameEncoder::appendRaw(rawFramesFile, frame) : FrameEncoder::writePng(getFrameFilename(framesDirectory, timestep), frame);
+                    if (!success) {
+                        frameEncodingFailed = true;
+                    }
+                });
+            }});
+        }
+
+        std::unique_ptr<RunControl> runControl;
+        std::unique_ptr<ControlServer> controlServer;
+        if (controlPort > 0) {
+            runControl = std::make_unique<RunControl>(simController, simData.auxiliaryData);
+            controlServer = std::make_unique<ControlServer>(*runControl);
+            auto started = false;
+            try {
+                started = controlServer->start("127.0.0.1", controlPort);
+            } catch (std::runtime_error const& e) {
+                std::cout << e.what() << std::endl;
+            }
+            if (!started) {
+                std::cout << "Could not start the control server on port " << controlPort << "." << std::endl;
+                return 1;
+            }
+            std::cout << "Control server listening on http://127.0.0.1:" << controlServer->getPort() << std::endl;
+            periodicActions.emplace_back(PeriodicAction{ControlInterval, [&] { runControl->process(*controlServer); }});
+        }
+
+        for (auto const& event : eventSchedule.popDueEvents(simData.auxiliaryData.timestep)) {
+            applyEvent(simController, event);
+        }
+        if (auto stopReason = runSimulation(simController, timesteps, periodicActions, stopConditions, stopOptions.checkInterval, &eventSchedule)) {
+            std::cout << "Run stopped: " << *stopReason << std::endl;
+        }
+
+        controlServer.reset();
+        simController->setProfilingEnabled(false);
+        statisticsWriter.close();
+        frameEncoderPool.reset();
+        if (frameEncodingFailed) {
+            std::cout << "Could not write frames." << std::endl;
+        }
+        if (checkpointStore && !checkpointStore->waitForPendingSave()) {
+            std::cout << "Could not write checkpoint." << std::endl;
+        }
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
-        auto tps = ms != 0 ? 1000.0f * toFloat(timesteps) / toFloat(ms) : 0.0f; 
-        std::cout << "Simulation finished: " << StringHelper::format(timesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
+        auto calculatedTimesteps = simController->getCurrentTimestep() - simData.auxiliaryData.timestep;
+        auto tps = ms != 0 ? 1000.0f * toFloat(calculatedTimesteps) / toFloat(ms) : 0.0f;
+        std::cout << "Simulation finished: " << StringHelper::format(calculatedTimesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
                   << StringHelper::format(tps, 1) << " TPS" << std::endl;
         
 
         //write output simulation file
         std::cout << "Writing output" << std::endl;
-        simData.auxiliaryData.timestep = static_cast<uint32_t>(simController->getCurrentTimestep());
-        simData.mainData = simController->getClusteredSimulationData();
+        simData = getSimulationData(simController, simData.auxiliaryData);
         if (outputFilename.empty()) {
             std::cout << "No output file given." << std::endl;
             return 1;
@@ -150,7 +1397,7 @@ int main(int argc, char** argv)
         }
 
         //write output statistics file
-        if (!statisticsFilename.empty()) {
+        if (!statisticsFilename.empty() && statisticsInterval == 0) {
             if (!writeStatistics(simController, statisticsFilename)) {
                 std::cout << "Could not write to statistics file." << std::endl;
                 return 1;
@@ -0,0 +1,337 @@
+#include "CpuCellConnectionProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "Base/Math.h"
+
+#include "CpuParticleProcessor.h"
+#include "CpuRandom.h"
+
+void CpuCellConnectionProcessor::scheduleAddConnectionPair(CpuChunkBuffers& buffers, int cellIndex, int otherCellIndex)
+{
+    buffers.operations.emplace_back(CpuStructuralOperation{CpuStructuralOperation::Type::AddConnectionPair, cellIndex, otherCellIndex});
+}
+
+void CpuCellConnectionProcessor::scheduleDeleteAllConnections(CpuSimulationData const& data, CpuChunkBuffers& buffers, int cellIndex)
+{
+    auto const& cell = data.objects.cells[cellIndex];
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        buffers.operations.emplace_back(CpuStructuralOperation{CpuStructuralOperation::Type::DelConnection, connectedCellIndex, cellIndex});
+        buffers.operations.emplace_back(CpuStructuralOperation{CpuStructuralOperation::Type::DelConnection, cellIndex, connectedCellIndex});
+    }
+}
+
+void CpuCellConnectionProcessor::scheduleDeleteCell(CpuChunkBuffers& buffers, int cellIndex)
+{
+    buffers.operations.emplace_back(CpuStructuralOperation{CpuStructuralOperation::Type::DelCell, cellIndex, -1});
+}
+
+void CpuCellConnectionProcessor::processOperations(CpuSimulationData& data)
+{
+    using Type = CpuStructuralOperation::Type;
+    auto& objects = data.objects;
+    auto& operations = data.structuralOperations;
+    sortOperations(operations);
+
+    //additions modify two cells and read the connections of their neighbors, hence they are not partitioned
+    auto addEnd = std::find_if(operations.begin(), operations.end(), [](auto const& operation) { return operation.type != Type::AddConnectionPair; });
+    for (auto it = operations.begin(); it != addEnd; ++it) {
+        tryAddConnectionPair(data, it->cellIndex, it->otherCellIndex);
+    }
+
+    //deleted cells release their energy as particles and their connected cells are scheduled to remove the connections
+    auto delCellIt = std::find_if(addEnd, operations.end(), [](auto const& operation) { return operation.type == Type::DelCell; });
+    auto delCellBegin = toInt(delCellIt - operations.begin());
+    data.parallelFor(toInt(operations.size()) - delCellBegin, [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int i = begin; i < end; ++i) {
+            auto cellIndex = operations[delCellBegin + i].cellIndex;
+            auto const& cell = objects.cells[cellIndex];
+            objects.cellDeleted[cellIndex] = 1;
+
+            CpuRandom random(data.randomSeed, data.timestep, cellIndex, CpuRandomStage_CellDeletion);
+            CpuParticleProcessor::radiate(data, random, buffers, objects.cellPositions[cellIndex], objects.cellVelocities[cellIndex], cell.color, cell.energy);
+
+            for (int j = 0; j < cell.numConnections; ++j) {
+                buffers.operations.emplace_back(CpuStructuralOperation{Type::DelConnection, cell.connections[j].cellIndex, cellIndex});
+            }
+        }
+    });
+    data.commitChunkBuffers();
+
+    //connection deletions are grouped by the cell they belong to, so that each group can be executed independently
+    std::erase_if(operations, [](auto const& operation) { return operation.type != Type::DelConnection; });
+    sortOperations(operations);
+    auto groupBegins = data.arena.allocateArray<int>(operations.size() + 1);
+    int numGroups = 0;
+    for (int i = 0; i < toInt(operations.size()); ++i) {
+        if (i == 0 || operations[i].cellIndex != operations[i - 1].cellIndex) {
+            groupBegins[numGroups++] = i;
+        }
+    }
+    groupBegins[numGroups] = toInt(operations.size());
+    data.parallelFor(numGroups, [&](int begin, int end, CpuChunkBuffers&) {
+        for (int group = begin; group < end; ++group) {
+            auto cellIndex = operations[groupBegins[group]].cellIndex;
+            if (objects.cellDeleted[cellIndex]) {
+                continue;
+            }
+            for (int i = groupBegins[group]; i < groupBegins[group + 1]; ++i) {
+                deleteConnectionOneWay(objects.cells[cellIndex], operations[i].otherCellIndex);
+            }
+        }
+    });
+    operations.clear();
+}
+
+bool CpuCellConnectionProcessor::tryAddConnections(
+    CpuSimulationData& data,
+    int cellIndex1,
+    int cellIndex2,
+    float desiredAngleOnCell1,
+    float desiredAngleOnCell2,
+    float desiredDistance,
+    ConstructorAngleAlignment angleAlignment)
+{
+    auto& cell1 = data.objects.cells[cellIndex1];
+    auto posDelta = data.cellMap.getCorrectedDirection(data.objects.cellPositions[cellIndex2] - data.objects.cellPositions[cellIndex1]);
+
+    auto origCell1 = cell1;
+    if (!tryAddConnectionOneWay(data, cellIndex1, cellIndex2, posDelta, desiredDistance, desiredAngleOnCell1, angleAlignment)) {
+        return false;
+    }
+    if (!tryAddConnectionOneWay(data, cellIndex2, cellIndex1, -posDelta, desiredDistance, desiredAngleOnCell2, angleAlignment)) {
+        cell1.numConnections = origCell1.numConnections;
+        std::copy(std::begin(origCell1.connections), std::end(origCell1.connections), std::begin(cell1.connections));
+        return false;
+    }
+    return true;
+}
+
+void CpuCellConnectionProcessor::deleteConnectionOneWay(CellTO& cell1, int cellIndex2)
+{
+    for (int i = 0; i < cell1.numConnections; ++i) {
+        if (cell1.connections[i].cellIndex == cellIndex2) {
+            auto angleToAdd = cell1.connections[i].angleFromPrevious;
+            for (int j = i; j < cell1.numConnections - 1; ++j) {
+                cell1.connections[j] = cell1.connections[j + 1];
+            }
+            if (i < cell1.numConnections - 1) {
+                cell1.connections[i].angleFromPrevious += angleToAdd;
+            } else {
+                cell1.connections[0].angleFromPrevious += angleToAdd;
+            }
+            --cell1.numConnections;
+            return;
+        }
+    }
+}
+
+void CpuCellConnectionProcessor::sortOperations(std::vector<CpuStructuralOperation>& operations)
+{
+    //a connection pair is identified by its lower cell index
+    for (auto& operation : operations) {
+        if (operation.type == CpuStructuralOperation::Type::AddConnectionPair && operation.cellIndex > operation.otherCellIndex) {
+            std::swap(operation.cellIndex, operation.otherCellIndex);
+        }
+    }
+    auto toTuple = [](CpuStructuralOperation const& operation) { return std::make_tuple(operation.type, operation.cellIndex, operation.otherCellIndex); };
+    std::sort(operations.begin(), operations.end(), [&](auto const& operation1, auto const& operation2) { return toTuple(operation1) < toTuple(operation2); });
+    auto newEnd = std::unique(operations.begin(), operations.end(), [&](auto const& operation1, auto const& operation2) {
+        return toTuple(operation1) == toTuple(operation2);
+    });
+    operations.erase(newEnd, operations.end());
+}
+
+void CpuCellConnectionProcessor::tryAddConnectionPair(CpuSimulationData& data, int cellIndex1, int cellIndex2)
+{
+    auto const& cell1 = data.objects.cells[cellIndex1];
+    auto const& cell2 = data.objects.cells[cellIndex2];
+    for (int i = 0; i < cell1.numConnections; ++i) {
+        if (cell1.connections[i].cellIndex == cellIndex2) {
+            return;
+        }
+    }
+    if (cell1.numConnections < cell1.maxConnections && cell2.numConnections < cell2.maxConnections) {
+        tryAddConnections(data, cellIndex1, cellIndex2, 0, 0, 0);
+    }
+}
+
+bool CpuCellConnectionProcessor::tryAddConnectionOneWay(
+    CpuSimulationData& data,
+    int cellIndex1,
+    int cellIndex2,
+    RealVector2D const& posDelta,
+    float desiredDistance,
+    float desiredAngleOnCell1,
+    ConstructorAngleAlignment angleAlignment)
+{
+    auto const& positions = data.objects.cellPositions;
+    auto& cell1 = data.objects.cells[cellIndex1];
+    if (wouldResultInOverlappingConnection(data, cellIndex1, positions[cellIndex2])) {
+        return false;
+    }
+
+    angleAlignment %= ConstructorAngleAlignment_Count;
+
+    auto newAngle = Math::angleOfVector(posDelta);
+    if (desiredDistance == 0) {
+        desiredDistance = Math::length(posDelta);
+    }
+
+    if (0 == cell1.numConnections) {
+        cell1.numConnections++;
+        cell1.connections[0].cellIndex = cellIndex2;
+        cell1.connections[0].distance = desiredDistance;
+        cell1.connections[0].angleFromPrevious = 360.0f;
+        return true;
+    }
+    if (1 == cell1.numConnections) {
+        auto connectedCellDelta = data.cellMap.getCorrectedDirection(positions[cell1.connections[0].cellIndex] - positions[cellIndex1]);
+        auto prevAngle = Math::angleOfVector(connectedCellDelta);
+        auto angleDiff = newAngle - prevAngle;
+        if (0 != desiredAngleOnCell1) {
+            angleDiff = desiredAngleOnCell1;
+        }
+        angleDiff = alignAngle(angleDiff, angleAlignment);
+        if (angleDiff < 0) {
+            angleDiff += 360.0;
+        }
+        angleDiff = avoidAngleBoundaries(angleDiff, 360.0f, angleAlignment);
+        if (std::abs(angleDiff) < NEAR_ZERO || std::abs(angleDiff - 360.0f) < NEAR_ZERO || std::abs(angleDiff + 360.0f) < NEAR_ZERO) {
+            return false;
+        }
+
+        cell1.connections[1].angleFromPrevious = angleDiff;
+        cell1.connections[0].angleFromPrevious = 360.0f - angleDiff;
+
+        cell1.numConnections++;
+        cell1.connections[1].cellIndex = cellIndex2;
+        cell1.connections[1].distance = desiredDistance;
+        return true;
+    }
+
+    //find appropriate index for new connection
+    int index = 0;
+    float prevAngle = 0;
+    float nextAngle = 0;
+    for (; index < cell1.numConnections; ++index) {
+        auto prevIndex = (index + cell1.numConnections - 1) % cell1.numConnections;
+        prevAngle = Math::angleOfVector(data.cellMap.getCorrectedDirection(positions[cell1.connections[prevIndex].cellIndex] - positions[cellIndex1]));
+        nextAngle = Math::angleOfVector(data.cellMap.getCorrectedDirection(positions[cell1.connections[index].cellIndex] - positions[cellIndex1]));
+        if (Math::isAngleInBetween(prevAngle, nextAngle, newAngle)) {
+            break;
+        }
+    }
+
+    //create connection object
+    ConnectionTO newConnection;
+    newConnection.cellIndex = cellIndex2;
+    newConnection.distance = desiredDistance;
+    auto angleFromPrevious = 0.0f;
+    auto refAngle = cell1.connections[index].angleFromPrevious;
+    if (Math::isAngleInBetween(prevAngle, nextAngle, newAngle)) {
+        auto angleDiff1 = Math::subtractAngle(newAngle, prevAngle);
+        auto angleDiff2 = Math::subtractAngle(nextAngle, prevAngle);
+        auto factor = angleDiff2 != 0 ? angleDiff1 / angleDiff2 : 0.5f;
+        if (0 == desiredAngleOnCell1) {
+            angleFromPrevious = refAngle * factor;
+        } else {
+            angleFromPrevious = desiredAngleOnCell1;
+        }
+        angleFromPrevious = std::min(angleFromPrevious, refAngle);
+
+        angleFromPrevious = alignAngle(angleFromPrevious, angleAlignment);
+        angleFromPrevious = avoidAngleBoundaries(angleFromPrevious, refAngle, angleAlignment);
+    }
+    if (angleFromPrevious < NEAR_ZERO) {
+        return false;
+    }
+    newConnection.angleFromPrevious = angleFromPrevious;
+
+    //adjust reference angle of next connection
+    auto nextAngleFromPrevious = refAngle - angleFromPrevious;
+    auto nextAngleFromPreviousAligned = alignAngle(nextAngleFromPrevious, angleAlignment);
+    auto angleDiff = nextAngleFromPreviousAligned - nextAngleFromPrevious;
+
+    auto nextIndex = index % cell1.numConnections;
+    auto nextNextIndex = (index + 1) % cell1.numConnections;
+    auto nextNextAngleFromPrevious = cell1.connections[nextNextIndex].angleFromPrevious;
+    if (nextNextAngleFromPrevious - angleDiff >= 0.0f && nextNextAngleFromPrevious - angleDiff <= 360.0f) {
+        if (nextAngleFromPreviousAligned < NEAR_ZERO || nextNextAngleFromPrevious - angleDiff < NEAR_ZERO) {
+            return false;
+        }
+        cell1.connections[nextIndex].angleFromPrevious = nextAngleFromPreviousAligned;
+        cell1.connections[nextNextIndex].angleFromPrevious = nextNextAngleFromPrevious - angleDiff;
+    } else {
+        if (nextAngleFromPrevious < NEAR_ZERO) {
+            return false;
+        }
+        cell1.connections[nextIndex].angleFromPrevious = nextAngleFromPrevious;
+    }
+
+    //add connection
+    for (int j = cell1.numConnections; j > index; --j) {
+        cell1.connections[j] = cell1.connections[j - 1];
+    }
+    cell1.connections[index] = newConnection;
+    ++cell1.numConnections;
+
+    return true;
+}
+
+bool CpuCellConnectionProcessor::wouldResultInOverlappingConnection(CpuSimulationData const& data, int cellIndex1, RealVector2D const& otherCellPos)
+{
+    auto const& cells = data.objects.cells;
+    auto const& positions = data.objects.cellPositions;
+    auto const& cell1 = cells[cellIndex1];
+    auto const& n = cell1.numConnections;
+    if (n < 2) {
+        return false;
+    }
+    for (int i = 0; i < n; ++i) {
+        auto connectedCellIndex = cell1.connections[i].cellIndex;
+        auto nextConnectedCellIndex = cell1.connections[(i + 1) % n].cellIndex;
+        auto const& connectedCell = cells[connectedCellIndex];
+        bool bothConnected = false;
+        for (int j = 0; j < connectedCell.numConnections; ++j) {
+            if (connectedCell.connections[j].cellIndex == nextConnectedCellIndex) {
+                bothConnected = true;
+                break;
+            }
+        }
+        if (!bothConnected) {
+            continue;
+        }
+        if (Math::crossing(positions[cellIndex1], otherCellPos, positions[connectedCellIndex], positions[nextConnectedCellIndex])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float CpuCellConnectionProcessor::alignAngle(float angle, ConstructorAngleAlignment alignment)
+{
+    if (ConstructorAngleAlignment_None == alignment) {
+        return angle;
+    }
+    float unitAngle = 360.0f / (alignment + 1);
+    float factor = std::floor(angle / unitAngle + 0.5f);
+    return factor * unitAngle;
+}
+
+float CpuCellConnectionProcessor::avoidAngleBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment)
+{
+    if (alignment != ConstructorAngleAlignment_None) {
+        auto angleUnit = 360.0f / (alignment + 1);
+        if (angle < NEAR_ZERO && angleUnit < maxAngle - NEAR_ZERO) {
+            angle = angleUnit;
+        }
+        if (angle > maxAngle - NEAR_ZERO && maxAngle - angleUnit > NEAR_ZERO) {
+            angle = maxAngle - angleUnit;
+        }
+    }
+    return angle;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "EngineInterface/CellFunctionConstants.h"
+
+#include "CpuSimulationData.h"
+
+//host counterpart of CellConnectionProcessor: operations are scheduled during parallel processing into the chunk buffers and executed
+//afterwards in the order of (operation type, cell index, other cell index), hence the result does not depend on the scheduling order
+class CpuCellConnectionProcessor
+{
+public:
+    static void scheduleAddConnectionPair(CpuChunkBuffers& buffers, int cellIndex, int otherCellIndex);
+    static void scheduleDeleteAllConnections(CpuSimulationData const& data, CpuChunkBuffers& buffers, int cellIndex);
+    static void scheduleDeleteCell(CpuChunkBuffers& buffers, int cellIndex);
+
+    //executes the scheduled operations: additions sequentially, then cell deletions and connection deletions in parallel where
+    //each operation only modifies the cell it belongs to
+    static void processOperations(CpuSimulationData& data);
+
+    static bool tryAddConnections(
+        CpuSimulationData& data,
+        int cellIndex1,
+        int cellIndex2,
+        float desiredAngleOnCell1,
+        float desiredAngleOnCell2,
+        float desiredDistance,
+        ConstructorAngleAlignment angleAlignment = ConstructorAngleAlignment_None);
+    static void deleteConnectionOneWay(CellTO& cell1, int cellIndex2);
+
+private:
+    static void sortOperations(std::vector<CpuStructuralOperation>& operations);  //also removes duplicates
+
+    static void tryAddConnectionPair(CpuSimulationData& data, int cellIndex1, int cellIndex2);
+    static bool tryAddConnectionOneWay(
+        CpuSimulationData& data,
+        int cellIndex1,
+        int cellIndex2,
+        RealVector2D const& posDelta,
+        float desiredDistance,
+        float desiredAngleOnCell1,
+        ConstructorAngleAlignment angleAlignment);
+    static bool wouldResultInOverlappingConnection(CpuSimulationData const& data, int cellIndex1, RealVector2D const& otherCellPos);
+
+    static float alignAngle(float angle, ConstructorAngleAlignment alignment);
+    static float avoidAngleBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment);
+};
@@ -0,0 +1,113 @@
+#include "CpuCellFunctionProcessor.h"
+
+#include "Base/Math.h"
+
+void CpuCellFunctionProcessor::collectCellFunctionOperations(CpuSimulationData& data)
+{
+    for (auto& operations : data.cellFunctionOperations) {
+        operations.clear();
+    }
+
+    //sequential pass: the operation lists are in ascending index order independent of the number of threads
+    auto const& cells = data.objects.cells;
+    auto executionOrderNumber = toInt(data.timestep % data.parameters.cellNumExecutionOrderNumbers);
+    for (int index = 0; index < data.objects.getNumCells(); ++index) {
+        auto const& cell = cells[index];
+        if (cell.cellFunction != CellFunction_None && cell.executionOrderNumber == executionOrderNumber && cell.activationTime == 0
+            && cell.livingState == LivingState_Ready) {
+            data.cellFunctionOperations[cell.cellFunction].emplace_back(index);
+        }
+    }
+}
+
+void CpuCellFunctionProcessor::resetFetchedActivities(CpuSimulationData& data)
+{
+    auto& cells = data.objects.cells;
+    auto numExecutionOrderNumbers = data.parameters.cellNumExecutionOrderNumbers;
+    auto executionOrderNumber = toInt(data.timestep % numExecutionOrderNumbers);
+
+    //only the activities are written, which are not read
+    data.parallelForWithoutBuffers(data.objects.getNumCells(), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = cells[index];
+            if (cell.cellFunction == CellFunction_None) {
+                continue;
+            }
+            int maxOtherExecutionOrderNumber = -1;
+            if (!cell.outputBlocked) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto const& connectedCell = cells[cell.connections[i].cellIndex];
+                    auto otherExecutionOrderNumber = connectedCell.executionOrderNumber;
+                    if (connectedCell.inputExecutionOrderNumber != cell.executionOrderNumber) {
+                        continue;
+                    }
+                    if (maxOtherExecutionOrderNumber == -1) {
+                        maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                    } else if (
+                        (maxOtherExecutionOrderNumber > cell.executionOrderNumber
+                         && (otherExecutionOrderNumber > maxOtherExecutionOrderNumber || otherExecutionOrderNumber < cell.executionOrderNumber))
+                        || (maxOtherExecutionOrderNumber < cell.executionOrderNumber && otherExecutionOrderNumber > maxOtherExecutionOrderNumber
+                            && otherExecutionOrderNumber < cell.executionOrderNumber)) {
+                        maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                    }
+                }
+            }
+            if ((maxOtherExecutionOrderNumber == -1 && executionOrderNumber == (cell.executionOrderNumber + 1) % numExecutionOrderNumbers)
+                || (maxOtherExecutionOrderNumber != -1 && maxOtherExecutionOrderNumber == executionOrderNumber)) {
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    cell.activity.channels[i] = 0;
+                }
+            }
+        }
+    });
+}
+
+ActivityTO CpuCellFunctionProcessor::calcInputActivity(CpuObjects const& objects, int cellIndex)
+{
+    ActivityTO result;
+    for (int i = 0; i < MAX_CHANNELS; ++i) {
+        result.channels[i] = 0;
+    }
+
+    auto const& cell = objects.cells[cellIndex];
+    if (cell.inputExecutionOrderNumber == -1 || cell.inputExecutionOrderNumber == cell.executionOrderNumber) {
+        return result;
+    }
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedCell = objects.cells[cell.connections[i].cellIndex];
+        if (connectedCell.outputBlocked || connectedCell.livingState != LivingState_Ready) {
+            continue;
+        }
+        if (connectedCell.executionOrderNumber == cell.inputExecutionOrderNumber) {
+            for (int j = 0; j < MAX_CHANNELS; ++j) {
+                result.channels[j] += connectedCell.activity.channels[j];
+            }
+        }
+    }
+    return result;
+}
+
+void CpuCellFunctionProcessor::setActivity(CellTO& cell, ActivityTO const& newActivity)
+{
+    for (int i = 0; i < MAX_CHANNELS; ++i) {
+        cell.activity.channels[i] = newActivity.channels[i];
+    }
+}
+
+RealVector2D CpuCellFunctionProcessor::calcSignalDirection(CpuSimulationData const& data, int cellIndex)
+{
+    auto const& objects = data.objects;
+    auto const& cell = objects.cells[cellIndex];
+    RealVector2D result{0, 0};
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        auto const& connectedCell = objects.cells[connectedCellIndex];
+        if (connectedCell.executionOrderNumber == cell.inputExecutionOrderNumber && !connectedCell.outputBlocked) {
+            auto directionDelta = data.cellMap.getCorrectedDirection(objects.cellPositions[cellIndex] - objects.cellPositions[connectedCellIndex]);
+            Math::normalize(directionDelta);
+            result += directionDelta;
+        }
+    }
+    Math::normalize(result);
+    return result;
+}
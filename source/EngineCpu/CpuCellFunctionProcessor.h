@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of CellFunctionProcessor: a cell function only writes the processed cell and reads the connected cells
+//of the input execution order number, which differs from the processed one, hence the cells of an operation list can be processed in parallel
+class CpuCellFunctionProcessor
+{
+public:
+    static void collectCellFunctionOperations(CpuSimulationData& data);
+    static void resetFetchedActivities(CpuSimulationData& data);
+
+    static ActivityTO calcInputActivity(CpuObjects const& objects, int cellIndex);
+    static void setActivity(CellTO& cell, ActivityTO const& newActivity);
+
+    static RealVector2D calcSignalDirection(CpuSimulationData const& data, int cellIndex);
+};
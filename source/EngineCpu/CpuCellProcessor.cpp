@@ -0,0 +1,711 @@
+#include "CpuCellProcessor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "Base/Math.h"
+#include "EngineInterface/GenomeBytesDecoder.h"
+
+#include "CpuCellConnectionProcessor.h"
+#include "CpuFluidPhysics.h"
+#include "CpuParticleProcessor.h"
+#include "CpuRandom.h"
+#include "CpuSpotCalculator.h"
+
+namespace
+{
+    float dot(RealVector2D const& p, RealVector2D const& q) { return p.x * q.x + p.y * q.y; }
+
+    RealVector2D normalized(RealVector2D v)
+    {
+        Math::normalize(v);
+        return v;
+    }
+
+    RealVector2D rotateQuarterClockwise(RealVector2D const& v) { return {-v.y, v.x}; }
+
+    bool isConnected(CellTO const& cell, int otherCellIndex)
+    {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            if (cell.connections[i].cellIndex == otherCellIndex) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //constructors which build copies of their own creature survive dying neighbors
+    bool isSelfReplicatingAndNotSeparating(CpuObjects const& objects, ConstructorTO const& constructor)
+    {
+        if (constructor.genomeDataIndex + constructor.genomeSize > objects.auxiliaryData.size()) {
+            return false;
+        }
+        auto genome = objects.auxiliaryData.data() + constructor.genomeDataIndex;
+        return GenomeBytesDecoder::containsSelfReplication(genome, constructor.genomeSize)
+            && !GenomeBytesDecoder::isSeparating(genome, constructor.genomeSize);
+    }
+
+    float getHeight(CpuSimulationData const& data, RealVector2D const& pos, SimulationParametersSpot const& spot)
+    {
+        auto dist = data.cellMap.getDistance(pos, RealVector2D{spot.posX, spot.posY});
+        if (Orientation_Clockwise == spot.flowData.radialFlow.orientation) {
+            return std::sqrt(dist) * spot.flowData.radialFlow.strength;
+        } else {
+            return -std::sqrt(dist) * spot.flowData.radialFlow.strength;
+        }
+    }
+
+    RealVector2D calcAcceleration(CpuSimulationData const& data, RealVector2D const& pos, SimulationParametersSpot const& spot)
+    {
+        switch (spot.flowType) {
+        case FlowType_Radial: {
+            auto baseValue = getHeight(data, pos, spot);
+            auto downValue = getHeight(data, pos + RealVector2D{0, 1}, spot);
+            auto rightValue = getHeight(data, pos + RealVector2D{1, 0}, spot);
+            RealVector2D result{rightValue - baseValue, downValue - baseValue};
+            return Math::rotateClockwise(result, 90.0f + spot.flowData.radialFlow.driftAngle);
+        }
+        case FlowType_Central: {
+            auto centerDirection = data.cellMap.getCorrectedDirection(RealVector2D{spot.posX, spot.posY} - pos);
+            return centerDirection * spot.flowData.centralFlow.strength / (dot(centerDirection, centerDirection) + 50.0f);
+        }
+        case FlowType_Linear: {
+            return Math::unitVectorOfAngle(spot.flowData.linearFlow.angle) * spot.flowData.linearFlow.strength;
+        }
+        default:
+            return {0, 0};
+        }
+    }
+}
+
+void CpuCellProcessor::updateMap(CpuSimulationData& data)
+{
+    data.cellMap.set(data.objects.cellPositions, data.objects.cellDeleted, data.threadPool.get());
+}
+
+void CpuCellProcessor::radiation(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = objects.cells[index];
+            if (cell.barrier) {
+                continue;
+            }
+            CpuRandom random(data.randomSeed, data.timestep, index, CpuRandomStage_Radiation);
+            if (random.random() >= parameters.radiationProb) {
+                continue;
+            }
+            auto const& pos = objects.cellPositions[index];
+            auto radiationFactor = 0.0f;
+            if (cell.energy > parameters.highRadiationMinCellEnergy[cell.color]) {
+                radiationFactor += parameters.highRadiationFactor[cell.color];
+            }
+            if (cell.age > parameters.radiationMinCellAge[cell.color]) {
+                radiationFactor += CpuSpotCalculator::calcParameter(
+                    &SimulationParametersSpotValues::radiationCellAgeStrength,
+                    &SimulationParametersSpotActivatedValues::radiationCellAgeStrength,
+                    data,
+                    pos,
+                    cell.color);
+            }
+            if (radiationFactor <= 0) {
+                continue;
+            }
+
+            auto energyLoss = cell.energy * radiationFactor;
+            energyLoss = energyLoss / parameters.radiationProb;
+            energyLoss = 2 * energyLoss * random.random();
+            if (cell.energy > 1) {
+                auto particleVel = objects.cellVelocities[index] * parameters.radiationVelocityMultiplier
+                    + Math::unitVectorOfAngle(random.random() * 360) * parameters.radiationVelocityPerturbation;
+                auto particlePos = pos + normalized(particleVel) * 1.5f - particleVel;  //"- particleVel" because particle will still be moved in current time step
+                data.cellMap.correctPosition(particlePos);
+                if (energyLoss > cell.energy - 1) {
+                    energyLoss = cell.energy - 1;
+                }
+                CpuParticleProcessor::radiate(data, random, buffers, particlePos, particleVel, cell.color, energyLoss);
+                cell.energy -= energyLoss;
+            }
+        }
+    });
+}
+
+void CpuCellProcessor::calcCollisions_correctOverlap(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    auto const& collisionMotion = parameters.motionData.collisionMotion;
+    auto const& positions = objects.cellPositions;
+    auto const& velocities = objects.cellVelocities;
+
+    //force acting on the first cell of a colliding pair as it is calculated from the perspective of this cell
+    auto calcCollisionForce = [&](int index, int otherIndex, RealVector2D const& posDelta, float distance) {
+        auto velDelta = velocities[index] - velocities[otherIndex];
+        auto barrierFactor = objects.cells[index].barrier ? 2.0f : 1.0f;
+        if (Math::length(velocities[index]) > 0.5f && dot(posDelta, velDelta) < 0) {
+            auto distanceSquared = distance * distance + 0.25f;
+            return posDelta * dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+        }
+        return normalized(posDelta) * (collisionMotion.cellMaxCollisionDistance - distance) * collisionMotion.cellRepulsionStrength * barrierFactor;
+    };
+
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            auto const& cell = objects.cells[index];
+            auto const& pos = positions[index];
+            auto& force = data.cellForces[index];
+            auto& posCorrection = data.cellPosDeltas[index];
+
+            float cellMaxBindingEnergy = 0;
+            float cellFusionVelocity = 0;
+            bool fusionParametersCalculated = false;
+
+            data.cellMap.executeForEach(pos, collisionMotion.cellMaxCollisionDistance, [&](int otherIndex) {
+                if (otherIndex == index) {
+                    return;
+                }
+                auto const& otherCell = objects.cells[otherIndex];
+                auto posDelta = data.cellMap.getCorrectedDirection(pos - positions[otherIndex]);
+                auto distance = Math::length(posDelta);
+
+                //overlap correction
+                if (!cell.barrier && distance < parameters.cellMinDistance) {
+                    posCorrection += posDelta * parameters.cellMinDistance / 5;
+                }
+
+                //collision forces: each pair is considered from both perspectives as in the GPU engine
+                if (!isConnected(otherCell, index)) {
+                    force -= calcCollisionForce(otherIndex, index, -posDelta, distance);
+                }
+                if (isConnected(cell, otherIndex)) {
+                    return;
+                }
+                force += calcCollisionForce(index, otherIndex, posDelta, distance);
+
+                //fusion
+                if (!fusionParametersCalculated) {
+                    cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                        &SimulationParametersSpotValues::cellMaxBindingEnergy, &SimulationParametersSpotActivatedValues::cellMaxBindingEnergy, data, pos);
+                    cellFusionVelocity = CpuSpotCalculator::calcParameter(
+                        &SimulationParametersSpotValues::cellFusionVelocity, &SimulationParametersSpotActivatedValues::cellFusionVelocity, data, pos);
+                    fusionParametersCalculated = true;
+                }
+                auto velDelta = velocities[index] - velocities[otherIndex];
+                if (cell.numConnections < cell.maxConnections && otherCell.numConnections < otherCell.maxConnections
+                    && Math::length(velDelta) >= cellFusionVelocity && dot(posDelta, velDelta) < 0 && cell.energy <= cellMaxBindingEnergy
+                    && otherCell.energy <= cellMaxBindingEnergy && !cell.barrier && !otherCell.barrier) {
+                    CpuCellConnectionProcessor::scheduleAddConnectionPair(buffers, index, otherIndex);
+                }
+            });
+        }
+    });
+
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto& pos = objects.cellPositions[index];
+            pos += data.cellPosDeltas[index];
+            data.cellMap.correctPosition(pos);
+        }
+    });
+}
+
+void CpuCellProcessor::calcFluidForces_correctOverlap(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    auto const& fluidMotion = parameters.motionData.fluidMotion;
+    auto const& smoothingLength = fluidMotion.smoothingLength;
+    auto const& positions = objects.cellPositions;
+    auto const& velocities = objects.cellVelocities;
+    auto const& densities = objects.cellDensities;
+
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            auto const& cell = objects.cells[index];
+            auto const& pos = positions[index];
+            auto cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::cellMaxBindingEnergy, &SimulationParametersSpotActivatedValues::cellMaxBindingEnergy, data, pos);
+            auto cellFusionVelocity = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::cellFusionVelocity, &SimulationParametersSpotActivatedValues::cellFusionVelocity, data, pos);
+
+            RealVector2D F_pressure{0, 0};
+            RealVector2D F_viscosity{0, 0};
+            float density = 0;
+            int closestBarrierIndex = -1;
+            float closestBarrierDistance = 0;
+
+            data.cellMap.executeForEach(pos, smoothingLength * 2, [&](int otherIndex) {
+                auto const& otherCell = objects.cells[otherIndex];
+                auto posDelta = data.cellMap.getCorrectedDirection(pos - positions[otherIndex]);
+                auto distance = Math::length(posDelta);
+
+                if (otherCell.barrier) {
+                    if (closestBarrierIndex == -1 || distance < closestBarrierDistance) {
+                        closestBarrierIndex = otherIndex;
+                        closestBarrierDistance = distance;
+                    }
+                    return;
+                }
+
+                //calc density
+                density += CpuFluidPhysics::calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength);
+                if (otherIndex == index) {
+                    return;
+                }
+
+                //overlap correction
+                if (!cell.barrier && distance < parameters.cellMinDistance) {
+                    data.cellPosDeltas[index] += posDelta * parameters.cellMinDistance / 5;
+                }
+                if (isConnected(cell, otherIndex)) {
+                    return;
+                }
+
+                //calc forces: for simplicity pressure = density
+                auto velDelta = velocities[index] - velocities[otherIndex];
+                auto const& cellPressure = densities[index];  //optimization: using the density from last time step
+                auto const& otherCellPressure = densities[otherIndex];
+                auto factor = cellPressure / (densities[index] * densities[index]) + otherCellPressure / (densities[otherIndex] * densities[otherIndex]);
+                if (std::abs(distance) > NEAR_ZERO) {
+                    auto kernel_d = CpuFluidPhysics::calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
+                    F_pressure += posDelta / (-distance) * factor * kernel_d;
+                    F_viscosity += velDelta / densities[otherIndex] * distance * kernel_d / (distance * distance + 0.25f);
+                }
+
+                //fusion
+                if (Math::length(velDelta) >= cellFusionVelocity && cell.numConnections < cell.maxConnections
+                    && otherCell.numConnections < otherCell.maxConnections && cell.energy <= cellMaxBindingEnergy
+                    && otherCell.energy <= cellMaxBindingEnergy && !cell.barrier) {
+                    CpuCellConnectionProcessor::scheduleAddConnectionPair(buffers, index, otherIndex);
+                }
+            });
+
+            //barrier forces: reflection at the closest barrier cell
+            auto& force = data.cellForces[index];
+            if (closestBarrierIndex != -1) {
+                auto const& barrierCell = objects.cells[closestBarrierIndex];
+                auto const& barrierPos = positions[closestBarrierIndex];
+                RealVector2D r{0, 0};
+                if (barrierCell.numConnections <= 1) {
+                    r = data.cellMap.getCorrectedDirection(pos - barrierPos);
+                } else {
+                    auto angleToCell = Math::angleOfVector(data.cellMap.getCorrectedDirection(pos - barrierPos));
+                    auto numConnections = barrierCell.numConnections;
+                    for (int i = 0; i < numConnections; ++i) {
+                        auto const& otherPos1 = positions[barrierCell.connections[i].cellIndex];
+                        auto const& otherPos2 = positions[barrierCell.connections[(i + 1) % numConnections].cellIndex];
+                        auto angleToOtherCell1 = Math::angleOfVector(data.cellMap.getCorrectedDirection(otherPos1 - barrierPos));
+                        auto angleToOtherCell2 = Math::angleOfVector(data.cellMap.getCorrectedDirection(otherPos2 - barrierPos));
+                        if (Math::isAngleInBetween(angleToOtherCell1, angleToOtherCell2, angleToCell)) {
+                            r = Math::rotateQuarterCounterClockwise(data.cellMap.getCorrectedDirection(otherPos2 - otherPos1));
+                            break;
+                        }
+                    }
+                }
+                auto const& barrierVel = velocities[closestBarrierIndex];
+                auto vr = velocities[index] - barrierVel;
+                auto dot_vr_r = dot(vr, r);
+                if (dot_vr_r < 0) {
+                    auto truncated_r_squared = std::max(0.05f, dot(r, r));
+                    auto truncated_distance = std::max(0.05f, closestBarrierDistance);
+                    force += (vr - r * 2 * dot_vr_r / truncated_r_squared + barrierVel - velocities[index]) / truncated_distance;
+                }
+            }
+
+            force += F_pressure * fluidMotion.pressureStrength + F_viscosity * fluidMotion.viscosityStrength;
+            data.cellNewDensities[index] = density;
+        }
+    });
+
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto& pos = objects.cellPositions[index];
+            pos += data.cellPosDeltas[index];
+            data.cellMap.correctPosition(pos);
+            objects.cellDensities[index] = data.cellNewDensities[index];
+        }
+    });
+}
+
+void CpuCellProcessor::applyFlowFields(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        RealVector2D accelerations[MAX_SPOTS];
+        for (int index = begin; index < end; ++index) {
+            if (objects.cells[index].barrier) {
+                continue;
+            }
+            auto const& pos = objects.cellPositions[index];
+            int numFlowFields = 0;
+            for (int i = 0; i < parameters.numSpots; ++i) {
+                if (parameters.spots[i].flowType != FlowType_None) {
+                    accelerations[numFlowFields++] = calcAcceleration(data, pos, parameters.spots[i]);
+                }
+            }
+            data.cellForces[index] += CpuSpotCalculator::calcResultingFlowField(data, pos, accelerations);
+        }
+    });
+}
+
+void CpuCellProcessor::checkForces(CpuSimulationData& data)
+{
+    auto const& objects = data.objects;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            if (objects.cells[index].barrier) {
+                continue;
+            }
+            auto cellMaxForce = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::cellMaxForce, &SimulationParametersSpotActivatedValues::cellMaxForce, data, objects.cellPositions[index]);
+            if (Math::length(data.cellForces[index]) > cellMaxForce) {
+                CpuRandom random(data.randomSeed, data.timestep, index, CpuRandomStage_CheckForces);
+                if (random.random() < data.parameters.cellMaxForceDecayProb) {
+                    CpuCellConnectionProcessor::scheduleDeleteAllConnections(data, buffers, index);
+                }
+            }
+        }
+    });
+}
+
+void CpuCellProcessor::applyForces(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto cellMaxVelocity = data.parameters.cellMaxVelocity;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            if (objects.cells[index].barrier) {
+                continue;
+            }
+            auto& vel = objects.cellVelocities[index];
+            vel += data.cellForces[index];
+            if (Math::length(vel) > cellMaxVelocity) {
+                vel = normalized(vel) * cellMaxVelocity;
+            }
+            data.cellForces[index] = {0, 0};
+        }
+    });
+}
+
+void CpuCellProcessor::calcConnectionForces(CpuSimulationData& data, bool considerAngles)
+{
+    auto const& objects = data.objects;
+    auto const& cells = objects.cells;
+    auto const& positions = objects.cellPositions;
+    auto cellMinDistance = data.parameters.cellMinDistance;
+
+    //first pass: forces acting on the cell itself and angular forces acting on the connected cells (stored per connection)
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto const& cell = cells[index];
+            auto connectionForces = &data.cellConnectionForces[static_cast<size_t>(index) * MAX_CELL_BONDS];
+            std::fill(connectionForces, connectionForces + MAX_CELL_BONDS, RealVector2D{0, 0});
+            if (0 == cell.numConnections || cell.barrier) {
+                continue;
+            }
+            RealVector2D force{0, 0};
+            auto const& pos = positions[index];
+            auto prevDisplacement = data.cellMap.getCorrectedDirection(positions[cell.connections[cell.numConnections - 1].cellIndex] - pos);
+            auto cellStiffnessSquared = cell.stiffness * cell.stiffness;
+
+            auto numConnections = cell.numConnections;
+            for (int i = 0; i < numConnections; ++i) {
+                auto connectedCellIndex = cell.connections[i].cellIndex;
+                auto const& connectedCell = cells[connectedCellIndex];
+                auto connectedCellStiffnessSquared = connectedCell.stiffness * connectedCell.stiffness;
+
+                auto displacement = data.cellMap.getCorrectedDirection(positions[connectedCellIndex] - pos);
+                auto actualDistance = Math::length(displacement);
+                auto deviation = actualDistance - cell.connections[i].distance;
+                force += normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+
+                if (considerAngles && (numConnections > 2 || (numConnections == 2 && i == 0))) {
+                    auto lastIndex = (i + numConnections - 1) % numConnections;
+                    auto lastConnectedCellIndex = cell.connections[lastIndex].cellIndex;
+
+                    //angle forces in case of no triangular connections
+                    if (!isConnected(connectedCell, lastConnectedCellIndex)) {
+                        auto angle = Math::angleOfVector(displacement);
+                        auto prevAngle = Math::angleOfVector(prevDisplacement);
+                        auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                        auto referenceAngleFromPrevious = cell.connections[i].angleFromPrevious;
+
+                        auto strength = std::abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellStiffnessSquared;
+
+                        auto force1 = rotateQuarterClockwise(normalized(displacement) / std::max(Math::length(displacement), cellMinDistance) * strength);
+                        auto force2 = Math::rotateQuarterCounterClockwise(
+                            normalized(prevDisplacement) / std::max(Math::length(prevDisplacement), cellMinDistance) * strength);
+
+                        if (referenceAngleFromPrevious < actualAngleFromPrevious) {
+                            force1 = -force1;
+                            force2 = -force2;
+                        }
+                        if (!connectedCell.barrier) {
+                            connectionForces[i] += force1;
+                        }
+                        if (!cells[lastConnectedCellIndex].barrier) {
+                            connectionForces[lastIndex] += force2;
+                        }
+                        force -= force1 + force2;
+                    }
+                }
+                prevDisplacement = displacement;
+            }
+            data.cellForces[index] += force;
+        }
+    });
+
+    //second pass: gather the angular forces from the connected cells
+    if (considerAngles) {
+        data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+            for (int index = begin; index < end; ++index) {
+                auto const& cell = cells[index];
+                if (cell.barrier) {
+                    continue;
+                }
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto connectedCellIndex = cell.connections[i].cellIndex;
+                    auto const& connectedCell = cells[connectedCellIndex];
+                    for (int j = 0; j < connectedCell.numConnections; ++j) {
+                        if (connectedCell.connections[j].cellIndex == index) {
+                            data.cellForces[index] += data.cellConnectionForces[static_cast<size_t>(connectedCellIndex) * MAX_CELL_BONDS + j];
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+void CpuCellProcessor::checkConnections(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = objects.cells[index];
+            if (cell.barrier) {
+                continue;
+            }
+            bool scheduleForDestruction = false;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto connectedCellIndex = cell.connections[i].cellIndex;
+                if (data.cellMap.getDistance(objects.cellPositions[index], objects.cellPositions[connectedCellIndex]) > parameters.cellMaxBindingDistance) {
+                    scheduleForDestruction = true;
+                    if (parameters.clusterDecay) {
+                        //the state is only set to dying in this phase, hence the result does not depend on the execution order
+                        std::atomic_ref(objects.cells[connectedCellIndex].livingState).store(LivingState_Dying, std::memory_order_relaxed);
+                        std::atomic_ref(cell.livingState).store(LivingState_Dying, std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (scheduleForDestruction) {
+                CpuCellConnectionProcessor::scheduleDeleteAllConnections(data, buffers, index);
+            }
+        }
+    });
+}
+
+void CpuCellProcessor::verletPositionUpdate(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto timestepSize = data.parameters.timestepSize;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto& pos = objects.cellPositions[index];
+            auto const& vel = objects.cellVelocities[index];
+            if (objects.cells[index].barrier) {
+                pos += vel * timestepSize;
+            } else {
+                auto& force = data.cellForces[index];
+                pos += vel * timestepSize + force * timestepSize * timestepSize / 2;
+                data.cellPrevForces[index] = force;
+                force = {0, 0};
+            }
+            data.cellMap.correctPosition(pos);
+        }
+    });
+}
+
+void CpuCellProcessor::verletVelocityUpdate(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto timestepSize = data.parameters.timestepSize;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            if (objects.cells[index].barrier) {
+                continue;
+            }
+            auto acceleration = (data.cellForces[index] + data.cellPrevForces[index]) / 2;
+            objects.cellVelocities[index] += acceleration * timestepSize;
+        }
+    });
+}
+
+void CpuCellProcessor::aging(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = objects.cells[index];
+            if (cell.barrier) {
+                continue;
+            }
+            auto color = ((cell.color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS;
+            auto spotIndex = CpuSpotCalculator::getFirstMatchingSpotOrBase(
+                data, objects.cellPositions[index], &SimulationParametersSpotActivatedValues::cellColorTransition);
+            auto const& values = spotIndex == -1 ? parameters.baseValues : parameters.spots[spotIndex].values;
+            auto transitionDuration = values.cellColorTransitionDuration[color];
+            auto targetColor = values.cellColorTransitionTargetColor[color];
+
+            ++cell.age;
+            if (transitionDuration > 0 && cell.age > transitionDuration) {
+                cell.color = targetColor;
+                cell.age = 0;
+            }
+            if (cell.livingState == LivingState_Ready && cell.activationTime > 0) {
+                --cell.activationTime;
+            }
+        }
+    });
+}
+
+void CpuCellProcessor::livingStateTransition(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto& cells = objects.cells;
+
+    //new states are derived from the old states of the cell and its neighbors
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = cells[index];
+            auto newLivingState = cell.livingState;
+            if (newLivingState == LivingState_Activating) {
+                newLivingState = LivingState_Ready;
+            }
+            bool neighborActivating = false;
+            bool neighborDying = false;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto connectedLivingState = cells[cell.connections[i].cellIndex].livingState;
+                neighborActivating |= connectedLivingState == LivingState_Activating;
+                neighborDying |= connectedLivingState == LivingState_Dying;
+            }
+            if (neighborActivating && newLivingState == LivingState_UnderConstruction) {
+                newLivingState = LivingState_Activating;
+            }
+            if (neighborDying) {
+                auto& constructor = cell.cellFunctionData.constructor;
+                if (cell.cellFunction != CellFunction_Constructor || !isSelfReplicatingAndNotSeparating(objects, constructor)) {
+                    newLivingState = LivingState_Dying;
+                } else {
+                    constructor.genomeCurrentNodeIndex = 0;
+                    constructor.isConstructionBuilt = true;
+                }
+            }
+            data.cellNewLivingStates[index] = newLivingState;
+        }
+    });
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            cells[index].livingState = data.cellNewLivingStates[index];
+        }
+    });
+}
+
+void CpuCellProcessor::applyInnerFriction(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& cells = objects.cells;
+    auto const& velocities = objects.cellVelocities;
+
+    //each connection pair exchanges momentum once per time step (as in the GPU engine), based on the velocities before this phase
+    auto innerFriction = data.parameters.innerFriction / 2;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto const& cell = cells[index];
+            auto newVel = velocities[index];
+            if (!cell.barrier) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto connectedCellIndex = cell.connections[i].cellIndex;
+                    if (cells[connectedCellIndex].barrier) {
+                        continue;
+                    }
+                    newVel += (velocities[connectedCellIndex] - velocities[index]) * innerFriction;
+                }
+            }
+            data.cellNewVelocities[index] = newVel;
+        }
+    });
+    objects.cellVelocities.swap(data.cellNewVelocities);
+}
+
+void CpuCellProcessor::applyFriction(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            if (objects.cells[index].barrier) {
+                continue;
+            }
+            auto friction = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::friction, &SimulationParametersSpotActivatedValues::friction, data, objects.cellPositions[index]);
+            objects.cellVelocities[index] = objects.cellVelocities[index] * (1.0f - friction);
+        }
+    });
+}
+
+void CpuCellProcessor::decay(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers& buffers) {
+        for (int index = begin; index < end; ++index) {
+            auto& cell = objects.cells[index];
+            if (cell.barrier) {
+                continue;
+            }
+            auto const& pos = objects.cellPositions[index];
+            auto cellMinEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::cellMinEnergy, &SimulationParametersSpotActivatedValues::cellMinEnergy, data, pos, cell.color);
+            auto cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersSpotValues::cellMaxBindingEnergy, &SimulationParametersSpotActivatedValues::cellMaxBindingEnergy, data, pos);
+
+            if (cell.livingState == LivingState_Dying) {
+                CpuRandom random(data.randomSeed, data.timestep, index, CpuRandomStage_Decay);
+                if (random.random() < parameters.clusterDecayProb[cell.color]) {
+                    CpuCellConnectionProcessor::scheduleDeleteCell(buffers, index);
+                }
+            }
+
+            bool cellDestruction = false;
+            if (cell.energy < cellMinEnergy) {
+                cellDestruction = true;
+            } else if (cell.energy > cellMaxBindingEnergy) {
+                CpuCellConnectionProcessor::scheduleDeleteAllConnections(data, buffers, index);
+            }
+
+            auto cellMaxAge = parameters.cellMaxAge[cell.color];
+            if (cellMaxAge > 0 && cell.age > cellMaxAge) {
+                if (data.timestep % 20 == static_cast<uint64_t>(index % 20)) {  //slow down destruction process to avoid too many deletion jobs
+                    cellDestruction = true;
+                }
+            }
+
+            if (cellDestruction) {
+                if (parameters.clusterDecay) {
+                    cell.livingState = LivingState_Dying;
+                } else {
+                    if (data.timestep % 20 == static_cast<uint64_t>(index % 20)) {  //slow down destruction process to avoid too many deletion jobs
+                        CpuCellConnectionProcessor::scheduleDeleteCell(buffers, index);
+                    }
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of CellProcessor: each phase only writes data of the processed cell (or to chunk buffers),
+//forces between cells are gathered from the perspective of the receiving cell
+class CpuCellProcessor
+{
+public:
+    static void updateMap(CpuSimulationData& data);
+    static void radiation(CpuSimulationData& data);
+
+    static void calcCollisions_correctOverlap(CpuSimulationData& data);
+    static void calcFluidForces_correctOverlap(CpuSimulationData& data);
+    static void applyFlowFields(CpuSimulationData& data);
+    static void checkForces(CpuSimulationData& data);
+    static void applyForces(CpuSimulationData& data);
+
+    static void calcConnectionForces(CpuSimulationData& data, bool considerAngles);
+    static void checkConnections(CpuSimulationData& data);
+    static void verletPositionUpdate(CpuSimulationData& data);
+    static void verletVelocityUpdate(CpuSimulationData& data);
+
+    static void aging(CpuSimulationData& data);
+    static void livingStateTransition(CpuSimulationData& data);
+
+    static void applyInnerFriction(CpuSimulationData& data);
+    static void applyFriction(CpuSimulationData& data);
+    static void decay(CpuSimulationData& data);
+};
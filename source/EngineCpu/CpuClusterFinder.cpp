@@ -0,0 +1,278 @@
+#include "CpuClusterFinder.h"
+
+#include <algorithm>
+
+#include "Base/Physics.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    int constexpr SampleSize = 1024;
+
+    struct PosAndVelPartial
+    {
+        int clusterIndex = 0;
+        int numCells = 0;
+        int numCellsInRightThird = 0;
+        int numCellsInLowerThird = 0;
+        int boundaries = 0;
+        RealVector2D posSum;
+        RealVector2D velSum;
+    };
+
+    struct AngularPartial
+    {
+        int clusterIndex = 0;
+        float angularMass = 0;
+        float angularMomentum = 0;
+    };
+}
+
+void CpuClusterFinder::calcClusterProperties(
+    std::vector<RealVector2D> const& positions,
+    std::vector<RealVector2D> const& velocities,
+    RealVector2D const& worldSize,
+    ThreadPool* threadPool)
+{
+    //accumulates the cells of each chunk into partials for runs of consecutive cells of the same cluster,
+    //the partials are merged in chunk order afterwards
+    auto reduceByCluster = [&]<typename Partial>(std::vector<std::vector<Partial>>& partialsByChunk, auto const& accumulate, auto const& merge) {
+        partialsByChunk.resize((_numCells + ChunkSize - 1) / ChunkSize);
+        parallelFor(threadPool, _numCells, [&](int begin, int end) {
+            auto& partials = partialsByChunk[begin / ChunkSize];
+            partials.clear();
+            for (int index = begin; index < end; ++index) {
+                auto clusterIndex = _clusterIndices[index];
+                if (partials.empty() || partials.back().clusterIndex != clusterIndex) {
+                    partials.emplace_back().clusterIndex = clusterIndex;
+                }
+                accumulate(partials.back(), index);
+            }
+        });
+        for (auto const& partials : partialsByChunk) {
+            for (auto const& partial : partials) {
+                merge(partial);
+            }
+        }
+    };
+
+    _properties.numCells.assign(_numClusters, 0);
+    _properties.centers.assign(_numClusters, RealVector2D());
+    _properties.velocities.assign(_numClusters, RealVector2D());
+    _properties.angularMasses.assign(_numClusters, 0.0f);
+    _properties.angularMomenta.assign(_numClusters, 0.0f);
+    _properties.boundaries.assign(_numClusters, 0);
+
+    //the positions are corrected after the summation since the boundaries of a cluster are only known in the end
+    std::vector<std::vector<PosAndVelPartial>> posAndVelPartials;
+    std::vector<int> numCellsInRightThird(_numClusters, 0);
+    std::vector<int> numCellsInLowerThird(_numClusters, 0);
+    reduceByCluster(
+        posAndVelPartials,
+        [&](PosAndVelPartial& partial, int index) {
+            auto const& pos = positions[index];
+            ++partial.numCells;
+            partial.posSum += pos;
+            partial.velSum += velocities[index];
+            if (pos.x < worldSize.x / 3) {
+                partial.boundaries |= 1;
+            }
+            if (pos.y < worldSize.y / 3) {
+                partial.boundaries |= 2;
+            }
+            if (pos.x > worldSize.x * 2 / 3) {
+                ++partial.numCellsInRightThird;
+            }
+            if (pos.y > worldSize.y * 2 / 3) {
+                ++partial.numCellsInLowerThird;
+            }
+        },
+        [&](PosAndVelPartial const& partial) {
+            auto clusterIndex = partial.clusterIndex;
+            _properties.numCells[clusterIndex] += partial.numCells;
+            _properties.centers[clusterIndex] += partial.posSum;
+            _properties.velocities[clusterIndex] += partial.velSum;
+            _properties.boundaries[clusterIndex] |= partial.boundaries;
+            numCellsInRightThird[clusterIndex] += partial.numCellsInRightThird;
+            numCellsInLowerThird[clusterIndex] += partial.numCellsInLowerThird;
+        });
+    parallelFor(threadPool, _numClusters, [&](int begin, int end) {
+        for (int clusterIndex = begin; clusterIndex < end; ++clusterIndex) {
+            auto& center = _properties.centers[clusterIndex];
+            if ((_properties.boundaries[clusterIndex] & 1) == 1) {
+                center.x -= worldSize.x * toFloat(numCellsInRightThird[clusterIndex]);
+            }
+            if ((_properties.boundaries[clusterIndex] & 2) == 2) {
+                center.y -= worldSize.y * toFloat(numCellsInLowerThird[clusterIndex]);
+            }
+            auto numCells = toFloat(_properties.numCells[clusterIndex]);
+            center = center / numCells;
+            _properties.velocities[clusterIndex] = _properties.velocities[clusterIndex] / numCells;
+        }
+    });
+
+    std::vector<std::vector<AngularPartial>> angularPartials;
+    reduceByCluster(
+        angularPartials,
+        [&](AngularPartial& partial, int index) {
+            auto r = getPositionFromCenter(index, positions[index], worldSize);
+            partial.angularMass += r.x * r.x + r.y * r.y;
+            partial.angularMomentum += Physics::angularMomentum(r, velocities[index] - _properties.velocities[partial.clusterIndex]);
+        },
+        [&](AngularPartial const& partial) {
+            _properties.angularMasses[partial.clusterIndex] += partial.angularMass;
+            _properties.angularMomenta[partial.clusterIndex] += partial.angularMomentum;
+        });
+}
+
+RealVector2D CpuClusterFinder::getPositionFromCenter(int cellIndex, RealVector2D const& pos, RealVector2D const& worldSize) const
+{
+    auto clusterIndex = _clusterIndices[cellIndex];
+    return getCorrectedPosition(pos, _properties.boundaries[clusterIndex], worldSize) - _properties.centers[clusterIndex];
+}
+
+void CpuClusterFinder::parallelFor(ThreadPool* threadPool, int numItems, std::function<void(int begin, int end)> const& func)
+{
+    if (threadPool) {
+        threadPool->parallelFor(numItems, ChunkSize, func);
+    } else {
+        for (int begin = 0; begin < numItems; begin += ChunkSize) {
+            func(begin, std::min(begin + ChunkSize, numItems));
+        }
+    }
+}
+
+void CpuClusterFinder::initParents(int numCells)
+{
+    if (_parentsCapacity < numCells) {
+        _parentsCapacity = std::max(numCells, _parentsCapacity * 2);
+        _parents = std::make_unique<std::atomic<int>[]>(_parentsCapacity);
+    }
+    _numCells = numCells;
+    for (int index = 0; index < numCells; ++index) {
+        _parents[index].store(index, std::memory_order_relaxed);
+    }
+}
+
+//parents only decrease and always remain ancestors, hence stale values read by relaxed loads are still valid
+int CpuClusterFinder::findRoot(int index)
+{
+    while (true) {
+        auto parent = _parents[index].load(std::memory_order_relaxed);
+        if (parent == index) {
+            return index;
+        }
+        auto grandparent = _parents[parent].load(std::memory_order_relaxed);
+        if (grandparent != parent) {
+            _parents[index].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);  //path halving, may fail harmlessly
+        }
+        index = grandparent;
+    }
+}
+
+void CpuClusterFinder::unite(int index1, int index2)
+{
+    while (true) {
+        auto root1 = findRoot(index1);
+        auto root2 = findRoot(index2);
+        if (root1 == root2) {
+            return;
+        }
+        if (root1 < root2) {
+            std::swap(root1, root2);
+        }
+
+        //the higher root is linked to the lower one unless another thread has linked it in the meantime
+        auto expected = root1;
+        if (_parents[root1].compare_exchange_strong(expected, root2, std::memory_order_relaxed)) {
+            return;
+        }
+        index1 = root1;
+        index2 = root2;
+    }
+}
+
+int CpuClusterFinder::findLargestComponent(int numCells)
+{
+    if (numCells == 0) {
+        return -1;
+    }
+    std::vector<int> sampledRoots;
+    auto stride = std::max(1, numCells / SampleSize);
+    for (int index = 0; index < numCells; index += stride) {
+        sampledRoots.emplace_back(findRoot(index));
+    }
+    std::sort(sampledRoots.begin(), sampledRoots.end());
+
+    int result = sampledRoots.front();
+    int maxCount = 0;
+    for (int i = 0; i < toInt(sampledRoots.size());) {
+        auto j = i;
+        while (j < toInt(sampledRoots.size()) && sampledRoots[j] == sampledRoots[i]) {
+            ++j;
+        }
+        if (j - i > maxCount) {
+            maxCount = j - i;
+            result = sampledRoots[i];
+        }
+        i = j;
+    }
+    return result;
+}
+
+void CpuClusterFinder::compressParents(int numCells, ThreadPool* threadPool)
+{
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            _parents[index].store(findRoot(index), std::memory_order_relaxed);
+        }
+    });
+}
+
+void CpuClusterFinder::calcClusterIndices(int numCells, ThreadPool* threadPool)
+{
+    auto numChunks = (numCells + ChunkSize - 1) / ChunkSize;
+    std::vector<int> clusterOffsetsByChunk(numChunks + 1, 0);
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        auto& numRoots = clusterOffsetsByChunk[begin / ChunkSize + 1];
+        for (int index = begin; index < end; ++index) {
+            if (_parents[index].load(std::memory_order_relaxed) == index) {
+                ++numRoots;
+            }
+        }
+    });
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+        clusterOffsetsByChunk[chunk + 1] += clusterOffsetsByChunk[chunk];
+    }
+    _numClusters = clusterOffsetsByChunk[numChunks];
+
+    //roots are numbered first, the other cells refer to their root afterwards
+    _clusterIndices.resize(numCells);
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        auto clusterIndex = clusterOffsetsByChunk[begin / ChunkSize];
+        for (int index = begin; index < end; ++index) {
+            if (_parents[index].load(std::memory_order_relaxed) == index) {
+                _clusterIndices[index] = clusterIndex++;
+            }
+        }
+    });
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto root = _parents[index].load(std::memory_order_relaxed);
+            if (root != index) {
+                _clusterIndices[index] = _clusterIndices[root];
+            }
+        }
+    });
+}
+
+RealVector2D CpuClusterFinder::getCorrectedPosition(RealVector2D pos, int boundaries, RealVector2D const& worldSize) const
+{
+    if ((boundaries & 1) == 1 && pos.x > worldSize.x * 2 / 3) {
+        pos.x -= worldSize.x;
+    }
+    if ((boundaries & 2) == 2 && pos.y > worldSize.y * 2 / 3) {
+        pos.y -= worldSize.y;
+    }
+    return pos;
+}
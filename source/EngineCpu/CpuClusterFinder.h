@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Base/Definitions.h"
+
+class ThreadPool;
+
+//properties per cluster where each cell has unit mass, positions of clusters crossing the world boundary are taken
+//from the side of the lower coordinates as in ClusterProcessor
+struct CpuClusterProperties
+{
+    std::vector<int> numCells;
+    std::vector<RealVector2D> centers;
+    std::vector<RealVector2D> velocities;
+    std::vector<float> angularMasses;
+    std::vector<float> angularMomenta;
+    std::vector<int> boundaries;  //bit 0: cluster has cells in the left third of the world, bit 1: in the upper third
+};
+
+/**
+ * Exact connected components of the connection graph as a replacement for the iterative label propagation of ClusterProcessor.
+ * The components are found by a lock-free parallel union-find in the style of Afforest: the first connections of all cells are
+ * processed first, after which most cells typically belong to one large component whose cells can skip their remaining connections.
+ * Roots are always linked to the root with the lower index, hence each component is represented by its lowest cell index and
+ * the result does not depend on the scheduling. Connections must be symmetric.
+ * The cluster properties are accumulated by parallel reductions over chunks of fixed size which are merged in chunk order,
+ * so the sums are also independent of the number of threads.
+ */
+class CpuClusterFinder
+{
+public:
+    //getNumConnections(cellIndex) and getConnectedIndex(cellIndex, connectionIndex) describe the connection graph
+    template <typename GetNumConnections, typename GetConnectedIndex>
+    void findClusters(int numCells, GetNumConnections const& getNumConnections, GetConnectedIndex const& getConnectedIndex, ThreadPool* threadPool = nullptr);
+
+    int getNumClusters() const { return _numClusters; }
+    int getClusterIndex(int cellIndex) const { return _clusterIndices[cellIndex]; }  //clusters are ordered by their lowest cell index
+    std::vector<int> const& getClusterIndices() const { return _clusterIndices; }
+
+    //prerequisite: findClusters has been called for the same cells
+    void calcClusterProperties(
+        std::vector<RealVector2D> const& positions,
+        std::vector<RealVector2D> const& velocities,
+        RealVector2D const& worldSize,
+        ThreadPool* threadPool = nullptr);
+    CpuClusterProperties const& getClusterProperties() const { return _properties; }
+
+    //vector from the cluster center to the cell considering the world boundary, prerequisite: calcClusterProperties has been called
+    RealVector2D getPositionFromCenter(int cellIndex, RealVector2D const& pos, RealVector2D const& worldSize) const;
+
+private:
+    static int constexpr NeighborRounds = 2;
+    static int constexpr ChunkSize = 1024;
+
+    static void parallelFor(ThreadPool* threadPool, int numItems, std::function<void(int begin, int end)> const& func);
+
+    void initParents(int numCells);
+    int findRoot(int index);
+    void unite(int index1, int index2);
+    int findLargestComponent(int numCells);
+    void compressParents(int numCells, ThreadPool* threadPool);
+    void calcClusterIndices(int numCells, ThreadPool* threadPool);
+
+    RealVector2D getCorrectedPosition(RealVector2D pos, int boundaries, RealVector2D const& worldSize) const;
+
+    int _numCells = 0;
+    int _parentsCapacity = 0;
+    std::unique_ptr<std::atomic<int>[]> _parents;  //parent index <= index, roots refer to themselves
+
+    int _numClusters = 0;
+    std::vector<int> _clusterIndices;
+    CpuClusterProperties _properties;
+};
+
+template <typename GetNumConnections, typename GetConnectedIndex>
+void CpuClusterFinder::findClusters(
+    int numCells,
+    GetNumConnections const& getNumConnections,
+    GetConnectedIndex const& getConnectedIndex,
+    ThreadPool* threadPool)
+{
+    initParents(numCells);
+
+    //link each cell to its first connected cells, this usually forms the large components already
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto numConnections = std::min(NeighborRounds, getNumConnections(index));
+            for (int i = 0; i < numConnections; ++i) {
+                unite(index, getConnectedIndex(index, i));
+            }
+        }
+    });
+    compressParents(numCells, threadPool);
+
+    //the remaining connections of cells in the largest component are also covered from the other side
+    auto largestComponent = findLargestComponent(numCells);
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            if (findRoot(index) == largestComponent) {
+                continue;
+            }
+            for (int i = NeighborRounds, numConnections = getNumConnections(index); i < numConnections; ++i) {
+                unite(index, getConnectedIndex(index, i));
+            }
+        }
+    });
+    compressParents(numCells, threadPool);
+    calcClusterIndices(numCells, threadPool);
+}
@@ -0,0 +1,40 @@
+#include "CpuClusterProcessor.h"
+
+#include "Base/Physics.h"
+
+#include "CpuSpotCalculator.h"
+
+void CpuClusterProcessor::findClusters(CpuSimulationData& data)
+{
+    auto const& objects = data.objects;
+    auto const& cells = objects.cells;
+    data.clusterFinder.findClusters(
+        objects.getNumCells(),
+        [&](int index) { return cells[index].numConnections; },
+        [&](int index, int connectionIndex) { return cells[index].connections[connectionIndex].cellIndex; },
+        data.threadPool.get());
+    data.clusterFinder.calcClusterProperties(objects.cellPositions, objects.cellVelocities, data.cellMap.getWorldSize(), data.threadPool.get());
+}
+
+void CpuClusterProcessor::applyClusterData(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& clusterFinder = data.clusterFinder;
+    auto const& clusterProperties = clusterFinder.getClusterProperties();
+    auto worldSize = data.cellMap.getWorldSize();
+    data.parallelFor(objects.getNumCells(), [&](int begin, int end, CpuChunkBuffers&) {
+        for (int index = begin; index < end; ++index) {
+            auto const& pos = objects.cellPositions[index];
+            auto clusterIndex = clusterFinder.getClusterIndex(index);
+            auto r = clusterFinder.getPositionFromCenter(index, pos, worldSize);
+            auto angularVel = Physics::angularVelocity(clusterProperties.angularMomenta[clusterIndex], clusterProperties.angularMasses[clusterIndex]);
+
+            auto stiffness = objects.cells[index].stiffness;
+            auto rigidity =
+                CpuSpotCalculator::calcParameter(&SimulationParametersSpotValues::rigidity, &SimulationParametersSpotActivatedValues::rigidity, data, pos)
+                * stiffness * stiffness;
+            auto& vel = objects.cellVelocities[index];
+            vel = vel * (1.0f - rigidity) + Physics::tangentialVelocity(r, clusterProperties.velocities[clusterIndex], angularVel) * rigidity;
+        }
+    });
+}
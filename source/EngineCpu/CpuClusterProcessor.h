@@ -0,0 +1,11 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of ClusterProcessor: the clusters are the exact connected components instead of an approximation
+class CpuClusterProcessor
+{
+public:
+    static void findClusters(CpuSimulationData& data);
+    static void applyClusterData(CpuSimulationData& data);  //prerequisite: data from findClusters
+};
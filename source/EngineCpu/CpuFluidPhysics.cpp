@@ -0,0 +1,230 @@
+#include "CpuFluidPhysics.h"
+
+#include <cmath>
+
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    int constexpr ChunkSize = 1024;
+
+    template <typename Func>
+    void parallelFor(ThreadPool* threadPool, int numItems, Func const& func)
+    {
+        if (threadPool) {
+            threadPool->parallelFor(numItems, ChunkSize, func);
+        } else {
+            func(0, numItems);
+        }
+    }
+
+    void correctPosition(RealVector2D& pos, RealVector2D const& worldSize)
+    {
+        pos.x -= std::floor(pos.x / worldSize.x) * worldSize.x;
+        pos.y -= std::floor(pos.y / worldSize.y) * worldSize.y;
+        if (pos.x >= worldSize.x) {  //rounding errors for tiny negative values
+            pos.x = 0;
+        }
+        if (pos.y >= worldSize.y) {
+            pos.y = 0;
+        }
+    }
+
+    RealVector2D getCorrectedDirection(RealVector2D direction, RealVector2D const& worldSize)
+    {
+        direction.x -= std::round(direction.x / worldSize.x) * worldSize.x;
+        direction.y -= std::round(direction.y / worldSize.y) * worldSize.y;
+        return direction;
+    }
+}
+
+int CpuFluidCells::addCell(RealVector2D const& pos, RealVector2D const& vel, float stiffness)
+{
+    positions.emplace_back(pos);
+    velocities.emplace_back(vel);
+    forces.emplace_back(0.0f, 0.0f);
+    previousForces.emplace_back(0.0f, 0.0f);
+    densities.emplace_back(1.0f);
+    stiffnesses.emplace_back(stiffness);
+    numConnections.emplace_back(0);
+    connectedIndices.resize(connectedIndices.size() + MAX_CELL_BONDS, -1);
+    bondDistances.resize(bondDistances.size() + MAX_CELL_BONDS, 0.0f);
+    return getNumCells() - 1;
+}
+
+void CpuFluidCells::addConnection(int index1, int index2, float bondDistance)
+{
+    CHECK(numConnections[index1] < MAX_CELL_BONDS && numConnections[index2] < MAX_CELL_BONDS);
+    auto addDirectedConnection = [&](int from, int to) {
+        auto slot = from * MAX_CELL_BONDS + numConnections[from]++;
+        connectedIndices[slot] = to;
+        bondDistances[slot] = bondDistance;
+    };
+    addDirectedConnection(index1, index2);
+    addDirectedConnection(index2, index1);
+}
+
+void CpuFluidPhysics::calcTimestep(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool)
+{
+    verletPositionUpdate(cells, parameters, threadPool);
+    calcForces(cells, parameters, threadPool);
+    verletVelocityUpdate(cells, parameters, threadPool);
+}
+
+void CpuFluidPhysics::verletPositionUpdate(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool) const
+{
+    auto timestepSize = parameters.timestepSize;
+    parallelFor(threadPool, cells.getNumCells(), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto& pos = cells.positions[index];
+            auto& force = cells.forces[index];
+            pos += cells.velocities[index] * timestepSize + force * timestepSize * timestepSize / 2;
+            correctPosition(pos, parameters.worldSize);
+            cells.previousForces[index] = force;
+            force = {0, 0};
+        }
+    });
+}
+
+void CpuFluidPhysics::calcForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool)
+{
+    auto numCells = cells.getNumCells();
+    _grid.build(cells.positions, parameters.worldSize, parameters.fluidMotion.smoothingLength * 2, threadPool);
+    _densities.resize(numCells);
+    _posDeltas.resize(numCells);
+
+    parallelFor(threadPool, numCells, [&](int begin, int end) { calcFluidForces(cells, parameters, begin, end); });
+
+    //the densities and overlap corrections are applied after all cells have read the values of the last time step
+    parallelFor(threadPool, numCells, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            cells.densities[index] = _densities[index];
+            cells.positions[index] += _posDeltas[index];
+            correctPosition(cells.positions[index], parameters.worldSize);
+        }
+    });
+
+    parallelFor(threadPool, numCells, [&](int begin, int end) { calcConnectionForces(cells, parameters, begin, end); });
+}
+
+void CpuFluidPhysics::verletVelocityUpdate(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool) const
+{
+    auto timestepSize = parameters.timestepSize;
+    parallelFor(threadPool, cells.getNumCells(), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto acceleration = (cells.forces[index] + cells.previousForces[index]) / 2;
+            cells.velocities[index] += acceleration * timestepSize;
+        }
+    });
+}
+
+float CpuFluidPhysics::calcKernel(float q)
+{
+    float result;
+    if (q < 1) {
+        result = 2.0f / 3.0f - q * q + 0.5f * q * q * q;
+    } else if (q < 2) {
+        result = 2.0f - q;
+        result = result * result * result / 6;
+    } else {
+        result = 0;
+    }
+    result *= 3.0f / (2.0f * Const::Pi);
+    return result;
+}
+
+float CpuFluidPhysics::calcKernel_d(float q)
+{
+    float result;
+    if (q < 1) {
+        result = -2 * q + 3.0f / 2.0f * q * q;
+    } else if (q < 2) {
+        result = -0.5f * (2.0f - q) * (2.0f - q);
+    } else {
+        result = 0;
+    }
+    result *= 3.0f / (2.0f * Const::Pi);
+    return result;
+}
+
+void CpuFluidPhysics::calcFluidForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, int begin, int end)
+{
+    auto const& sortedIndices = _grid.getSortedIndices();
+    auto smoothingLength = parameters.fluidMotion.smoothingLength;
+    auto cellMinDistance = parameters.cellMinDistance;
+
+    for (int sortedIndex = begin; sortedIndex < end; ++sortedIndex) {
+        auto index = sortedIndices[sortedIndex];
+        auto const& vel = cells.velocities[index];
+        auto cellDensity = cells.densities[index];
+        auto connectedIndices = &cells.connectedIndices[index * MAX_CELL_BONDS];
+        auto numConnections = cells.numConnections[index];
+
+        RealVector2D F_pressure;
+        RealVector2D F_viscosity;
+        RealVector2D cellPosDelta;
+        float density = 0;
+        _grid.executeForEachWithinRadius(cells.positions[index], smoothingLength * 2, [&](int otherIndex, RealVector2D const& delta) {
+            auto posDelta = -delta;
+            auto distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+
+            //calc density
+            density += calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength);
+            if (otherIndex == index) {
+                return;
+            }
+
+            //overlap correction
+            if (distance < cellMinDistance) {
+                cellPosDelta += posDelta * cellMinDistance / 5;
+            }
+
+            for (int i = 0; i < numConnections; ++i) {
+                if (connectedIndices[i] == otherIndex) {
+                    return;
+                }
+            }
+
+            //calc forces: for simplicity pressure = density
+            auto velDelta = vel - cells.velocities[otherIndex];
+            auto const& cellPressure = cellDensity;  //optimization: using the density from last time step
+            auto otherCellDensity = cells.densities[otherIndex];
+            auto const& otherCellPressure = otherCellDensity;
+            auto factor = cellPressure / (cellDensity * cellDensity) + otherCellPressure / (otherCellDensity * otherCellDensity);
+
+            if (distance > NEAR_ZERO) {
+                auto kernel_d = calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
+                F_pressure += posDelta / (-distance) * factor * kernel_d;
+                F_viscosity += velDelta / otherCellDensity * distance * kernel_d / (distance * distance + 0.25f);
+            }
+        });
+
+        cells.forces[index] += F_pressure * parameters.fluidMotion.pressureStrength + F_viscosity * parameters.fluidMotion.viscosityStrength;
+        _densities[index] = density;
+        _posDeltas[index] = cellPosDelta;
+    }
+}
+
+void CpuFluidPhysics::calcConnectionForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, int beginIndex, int endIndex) const
+{
+    for (int index = beginIndex; index < endIndex; ++index) {
+        auto const& pos = cells.positions[index];
+        auto cellStiffnessSquared = cells.stiffnesses[index] * cells.stiffnesses[index];
+
+        RealVector2D force;
+        for (int i = 0, numConnections = cells.numConnections[index]; i < numConnections; ++i) {
+            auto connectedIndex = cells.connectedIndices[index * MAX_CELL_BONDS + i];
+            auto connectedCellStiffnessSquared = cells.stiffnesses[connectedIndex] * cells.stiffnesses[connectedIndex];
+
+            auto displacement = getCorrectedDirection(cells.positions[connectedIndex] - pos, parameters.worldSize);
+            auto actualDistance = Math::length(displacement);
+            if (actualDistance < NEAR_ZERO) {
+                continue;
+            }
+            auto deviation = actualDistance - cells.bondDistances[index * MAX_CELL_BONDS + i];
+            force += displacement / actualDistance * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+        }
+        cells.forces[index] += force;
+    }
+}
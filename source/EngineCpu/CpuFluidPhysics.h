@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "Base/SpatialHashGrid.h"
+#include "EngineInterface/FundamentalConstants.h"
+#include "EngineInterface/Motion.h"
+
+class ThreadPool;
+
+//struct-of-arrays cell store, the entries with the same index belong to the same cell
+struct CpuFluidCells
+{
+    std::vector<RealVector2D> positions;
+    std::vector<RealVector2D> velocities;
+    std::vector<RealVector2D> forces;
+    std::vector<RealVector2D> previousForces;  //forces of the last time step as needed by the Verlet integration
+    std::vector<float> densities;  //result of the last time step, also used as pressure
+    std::vector<float> stiffnesses;
+    std::vector<int> numConnections;
+    std::vector<int> connectedIndices;  //MAX_CELL_BONDS entries per cell
+    std::vector<float> bondDistances;  //MAX_CELL_BONDS entries per cell
+
+    int getNumCells() const { return toInt(positions.size()); }
+    int addCell(RealVector2D const& pos, RealVector2D const& vel = {0, 0}, float stiffness = 1.0f);  //returns the cell index
+    void addConnection(int index1, int index2, float bondDistance);  //connects both cells with each other
+};
+
+struct CpuFluidParameters
+{
+    RealVector2D worldSize;
+    float timestepSize = 1.0f;
+    float cellMinDistance = 0.3f;
+    FluidMotion fluidMotion;
+};
+
+/**
+ * Host counterpart of the fluid motion path of the GPU engine (CellProcessor::calcFluidForces_reconnectCells_correctOverlap,
+ * calcConnectionForces without angles and the Verlet updates) over a struct-of-arrays cell store.
+ * Neighbors are found by a SpatialHashGrid with slots of twice the smoothing length. The cells are processed in the slot order
+ * of the grid and each chunk of consecutive slots forms a spatial tile for a thread. Every cell gathers the contributions of its neighbors
+ * and only writes its own entries, hence no atomics are needed and the results do not depend on the number of threads.
+ * Barriers, fusion and cell functions are not part of this module.
+ */
+class CpuFluidPhysics
+{
+public:
+    void calcTimestep(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool = nullptr);
+
+    //steps of calcTimestep
+    void verletPositionUpdate(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool = nullptr) const;
+    void calcForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool = nullptr);  //also corrects overlaps
+    void verletVelocityUpdate(CpuFluidCells& cells, CpuFluidParameters const& parameters, ThreadPool* threadPool = nullptr) const;
+
+    //cubic spline kernel and its derivative in units of the smoothing length
+    static float calcKernel(float q);
+    static float calcKernel_d(float q);
+
+private:
+    //processes the cells at the positions [begin, end) of the slot order of the grid
+    void calcFluidForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, int begin, int end);
+    void calcConnectionForces(CpuFluidCells& cells, CpuFluidParameters const& parameters, int beginIndex, int endIndex) const;
+
+    SpatialHashGrid _grid;
+    std::vector<float> _densities;  //buffers for the results which must not be visible to other cells before all cells are processed
+    std::vector<RealVector2D> _posDeltas;
+};
@@ -0,0 +1,131 @@
+#include "CpuGarbageCollector.h"
+
+#include <cstring>
+
+namespace
+{
+    //calls func(dataIndex, size) for all ranges of the auxiliary data referenced by the cell
+    template <typename Cell, typename Func>
+    void forEachAuxiliaryDataRange(Cell& cell, Func const& func)
+    {
+        func(cell.metadata.nameDataIndex, static_cast<uint64_t>(cell.metadata.nameSize));
+        func(cell.metadata.descriptionDataIndex, static_cast<uint64_t>(cell.metadata.descriptionSize));
+        switch (cell.cellFunction) {
+        case CellFunction_Neuron:
+            func(cell.cellFunctionData.neuron.weightsAndBiasesDataIndex, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
+            break;
+        case CellFunction_Constructor:
+            func(cell.cellFunctionData.constructor.genomeDataIndex, static_cast<uint64_t>(cell.cellFunctionData.constructor.genomeSize));
+            break;
+        case CellFunction_Injector:
+            func(cell.cellFunctionData.injector.genomeDataIndex, static_cast<uint64_t>(cell.cellFunctionData.injector.genomeSize));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void CpuGarbageCollector::cleanupAfterTimestep(CpuObjects& objects, Arena& arena)
+{
+    removeDeletedObjects(objects, arena);
+    if (!objects.auxiliaryData.empty() && calcNumReferencedAuxiliaryData(objects) * 2 <= objects.auxiliaryData.size()) {
+        compactAuxiliaryData(objects, arena);
+    }
+}
+
+void CpuGarbageCollector::cleanupAfterDataManipulation(CpuObjects& objects, Arena& arena)
+{
+    removeDeletedObjects(objects, arena);
+    compactAuxiliaryData(objects, arena);
+}
+
+void CpuGarbageCollector::removeDeletedObjects(CpuObjects& objects, Arena& arena)
+{
+    auto newCellIndices = arena.allocateArray<int>(objects.cells.size());
+    int numCells = 0;
+    for (int index = 0; index < objects.getNumCells(); ++index) {
+        if (objects.cellDeleted[index]) {
+            newCellIndices[index] = -1;
+            continue;
+        }
+        newCellIndices[index] = numCells;
+        if (index != numCells) {
+            objects.cells[numCells] = objects.cells[index];
+            objects.cellPositions[numCells] = objects.cellPositions[index];
+            objects.cellVelocities[numCells] = objects.cellVelocities[index];
+            objects.cellDensities[numCells] = objects.cellDensities[index];
+        }
+        ++numCells;
+    }
+    objects.cells.resize(numCells);
+    objects.cellPositions.resize(numCells);
+    objects.cellVelocities.resize(numCells);
+    objects.cellDensities.resize(numCells);
+    objects.cellDeleted.assign(numCells, 0);
+    for (auto& cell : objects.cells) {
+        int numConnections = 0;
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto newCellIndex = newCellIndices[cell.connections[i].cellIndex];
+            if (newCellIndex == -1) {  //should not happen since connections are symmetric
+                continue;
+            }
+            cell.connections[numConnections] = cell.connections[i];
+            cell.connections[numConnections].cellIndex = newCellIndex;
+            ++numConnections;
+        }
+        cell.numConnections = numConnections;
+    }
+
+    int numParticles = 0;
+    for (int index = 0; index < objects.getNumParticles(); ++index) {
+        if (objects.particleDeleted[index]) {
+            continue;
+        }
+        if (index != numParticles) {
+            objects.particles[numParticles] = objects.particles[index];
+            objects.particlePositions[numParticles] = objects.particlePositions[index];
+            objects.particleVelocities[numParticles] = objects.particleVelocities[index];
+            objects.particleLastAbsorbedCellIds[numParticles] = objects.particleLastAbsorbedCellIds[index];
+        }
+        ++numParticles;
+    }
+    objects.particles.resize(numParticles);
+    objects.particlePositions.resize(numParticles);
+    objects.particleVelocities.resize(numParticles);
+    objects.particleLastAbsorbedCellIds.resize(numParticles);
+    objects.particleDeleted.assign(numParticles, 0);
+}
+
+//ranges exceeding the auxiliary data are invalid anyway, they are not relocated
+void CpuGarbageCollector::compactAuxiliaryData(CpuObjects& objects, Arena& arena)
+{
+    auto& auxiliaryData = objects.auxiliaryData;
+    auto newAuxiliaryData = arena.allocateArray<uint8_t>(calcNumReferencedAuxiliaryData(objects));
+    uint64_t numNewAuxiliaryData = 0;
+    for (auto& cell : objects.cells) {
+        forEachAuxiliaryDataRange(cell, [&](uint64_t& dataIndex, uint64_t size) {
+            if (size == 0) {
+                dataIndex = numNewAuxiliaryData;
+            } else if (dataIndex + size <= auxiliaryData.size()) {
+                std::memcpy(newAuxiliaryData + numNewAuxiliaryData, auxiliaryData.data() + dataIndex, size);
+                dataIndex = numNewAuxiliaryData;
+                numNewAuxiliaryData += size;
+            }
+        });
+    }
+    auxiliaryData.assign(newAuxiliaryData, newAuxiliaryData + numNewAuxiliaryData);
+}
+
+uint64_t CpuGarbageCollector::calcNumReferencedAuxiliaryData(CpuObjects const& objects)
+{
+    uint64_t result = 0;
+    for (auto const& cell : objects.cells) {
+        forEachAuxiliaryDataRange(cell, [&](uint64_t const& dataIndex, uint64_t size) {
+            if (dataIndex + size <= objects.auxiliaryData.size()) {
+                result += size;
+            }
+        });
+    }
+    return result;
+}
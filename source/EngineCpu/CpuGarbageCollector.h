@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Base/Arena.h"
+
+#include "CpuSimulationData.h"
+
+//host counterpart of GarbageCollectorKernels: the object arrays and the auxiliary data are compacted in place,
+//temporary data is allocated in the arena
+class CpuGarbageCollector
+{
+public:
+    //auxiliary data is only compacted if at least half of it is no longer referenced
+    static void cleanupAfterTimestep(CpuObjects& objects, Arena& arena);
+    static void cleanupAfterDataManipulation(CpuObjects& objects, Arena& arena);
+
+    //remaining connections to deleted cells are dropped
+    static void removeDeletedObjects(CpuObjects& objects, Arena& arena);
+
+    //relocates the auxiliary data referenced by the cells in cell order and fixes up the data indices of the cells
+    static void compactAuxiliaryData(CpuObjects& objects, Arena& arena);
+    static uint64_t calcNumReferencedAuxiliaryData(CpuObjects const& objects);
+};
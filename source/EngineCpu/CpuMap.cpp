@@ -0,0 +1,11 @@
+#include "CpuMap.h"
+
+void CpuMap::init(IntVector2D const& worldSize)
+{
+    _worldSize = {toFloat(worldSize.x), toFloat(worldSize.y)};
+}
+
+void CpuMap::set(std::vector<RealVector2D> const& positions, std::vector<uint8_t> const& deleted, ThreadPool* threadPool)
+{
+    _grid.build(positions, _worldSize, 1.0f, threadPool, &deleted);
+}
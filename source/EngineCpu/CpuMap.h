@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/SpatialHashGrid.h"
+
+/**
+ * Slots of unit size covering the torus-shaped world, based on SpatialHashGrid. The objects of a slot are listed in ascending index order.
+ */
+class CpuMap
+{
+public:
+    void init(IntVector2D const& worldSize);
+    void set(std::vector<RealVector2D> const& positions, std::vector<uint8_t> const& deleted, ThreadPool* threadPool);
+
+    RealVector2D const& getWorldSize() const { return _worldSize; }
+
+    int getFirst(RealVector2D const& pos) const { return _grid.getFirstIndex(pos); }
+
+    //calls func(index) for all objects within radius of pos
+    template <typename Func>
+    void executeForEach(RealVector2D const& pos, float radius, Func const& func) const
+    {
+        _grid.executeForEachWithinRadius(pos, radius, [&](int index, RealVector2D const&) { func(index); });
+    }
+
+    void correctPosition(RealVector2D& pos) const
+    {
+        pos.x -= std::floor(pos.x / _worldSize.x) * _worldSize.x;
+        pos.y -= std::floor(pos.y / _worldSize.y) * _worldSize.y;
+        if (pos.x >= _worldSize.x) {  //rounding errors for tiny negative values
+            pos.x = 0;
+        }
+        if (pos.y >= _worldSize.y) {
+            pos.y = 0;
+        }
+    }
+
+    RealVector2D getCorrectedDirection(RealVector2D direction) const
+    {
+        direction.x -= std::round(direction.x / _worldSize.x) * _worldSize.x;
+        direction.y -= std::round(direction.y / _worldSize.y) * _worldSize.y;
+        return direction;
+    }
+
+    float getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const
+    {
+        auto delta = getCorrectedDirection(pos2 - pos1);
+        return std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    }
+
+private:
+    RealVector2D _worldSize;
+    SpatialHashGrid _grid;
+};
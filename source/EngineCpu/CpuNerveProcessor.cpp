@@ -0,0 +1,29 @@
+#include "CpuNerveProcessor.h"
+
+#include "CpuCellFunctionProcessor.h"
+
+void CpuNerveProcessor::process(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& operations = data.cellFunctionOperations[CellFunction_Nerve];
+    auto numExecutionOrderNumbers = data.parameters.cellNumExecutionOrderNumbers;
+    data.parallelForWithoutBuffers(toInt(operations.size()), [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            auto index = operations[i];
+            auto& cell = objects.cells[index];
+            auto activity = CpuCellFunctionProcessor::calcInputActivity(objects, index);
+            auto const& nerve = cell.cellFunctionData.nerve;
+            auto counter = (cell.age / numExecutionOrderNumbers) * numExecutionOrderNumbers + cell.executionOrderNumber % numExecutionOrderNumbers;
+            if (nerve.pulseMode > 0 && (counter % (numExecutionOrderNumbers * nerve.pulseMode) == cell.executionOrderNumber)) {
+                if (nerve.alternationMode == 0) {
+                    activity.channels[0] += 1.0f;
+                } else {
+                    auto evenPulse = counter % (numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode * 2)
+                        < cell.executionOrderNumber + numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode;
+                    activity.channels[0] += evenPulse ? 1.0f : -1.0f;
+                }
+            }
+            CpuCellFunctionProcessor::setActivity(cell, activity);
+        }
+    });
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of NerveProcessor
+class CpuNerveProcessor
+{
+public:
+    static void process(CpuSimulationData& data);
+};
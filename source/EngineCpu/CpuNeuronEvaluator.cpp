@@ -0,0 +1,322 @@
+#include "CpuNeuronEvaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ALIEN_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(ALIEN_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define TARGET_AVX2
+#define TARGET_AVX512
+#endif
+
+namespace
+{
+    int constexpr WeightsSize = MAX_CHANNELS * MAX_CHANNELS * CpuNeuronEvaluator::PackSize;
+    int constexpr PacksPerChunk = 16;
+
+    //exp(-z) is calculated as 2^i * 2^f with integer i and f in [-0.5, 0.5], 2^f is approximated by its Taylor polynomial of degree 6
+    float constexpr Log2e = 1.44269504f;
+    float constexpr ExponentBound = 40.0f;  //the sigmoid is saturated beyond
+    float constexpr C1 = 0.693147181f;
+    float constexpr C2 = 0.240226507f;
+    float constexpr C3 = 0.0555041087f;
+    float constexpr C4 = 0.00961812911f;
+    float constexpr C5 = 0.00133335581f;
+    float constexpr C6 = 0.000154035512f;
+
+    float scaledSigmoid_scalar(float z)
+    {
+        auto x = std::clamp(-z * Log2e, -ExponentBound, ExponentBound);
+        auto i = std::nearbyint(x);
+        auto f = x - i;
+        auto p = ((((((C6 * f + C5) * f + C4) * f + C3) * f + C2) * f + C1) * f + 1.0f);
+        auto bits = static_cast<uint32_t>(static_cast<int>(i) + 127) << 23;
+        float powerOfTwo;
+        std::memcpy(&powerOfTwo, &bits, sizeof(float));
+        return 2.0f / (1.0f + p * powerOfTwo) - 1.0f;
+    }
+
+    void evaluatePack_scalar(
+        float const* pack,
+        float const (&input)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize],
+        float (&output)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize])
+    {
+        auto biases = pack + WeightsSize;
+        for (int row = 0; row < MAX_CHANNELS; ++row) {
+            float sum[CpuNeuronEvaluator::PackSize];
+            for (int lane = 0; lane < CpuNeuronEvaluator::PackSize; ++lane) {
+                sum[lane] = biases[row * CpuNeuronEvaluator::PackSize + lane];
+            }
+            for (int col = 0; col < MAX_CHANNELS; ++col) {
+                auto weights = pack + (row * MAX_CHANNELS + col) * CpuNeuronEvaluator::PackSize;
+                for (int lane = 0; lane < CpuNeuronEvaluator::PackSize; ++lane) {
+                    sum[lane] += weights[lane] * input[col][lane];
+                }
+            }
+            for (int lane = 0; lane < CpuNeuronEvaluator::PackSize; ++lane) {
+                output[row][lane] = scaledSigmoid_scalar(sum[lane]);
+            }
+        }
+    }
+
+#ifdef ALIEN_X86_64
+    TARGET_AVX2 __m256 scaledSigmoid_avx2(__m256 z)
+    {
+        auto x = _mm256_mul_ps(z, _mm256_set1_ps(-Log2e));
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-ExponentBound)), _mm256_set1_ps(ExponentBound));
+        auto i = _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        auto f = _mm256_sub_ps(x, i);
+        auto p = _mm256_fmadd_ps(_mm256_set1_ps(C6), f, _mm256_set1_ps(C5));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C4));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C3));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C2));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C1));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f));
+        auto powerOfTwo = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(i), _mm256_set1_epi32(127)), 23));
+        auto one = _mm256_set1_ps(1.0f);
+        return _mm256_sub_ps(_mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_fmadd_ps(p, powerOfTwo, one)), one);
+    }
+
+    TARGET_AVX2 void evaluatePack_avx2(
+        float const* pack,
+        float const (&input)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize],
+        float (&output)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize])
+    {
+        auto biases = pack + WeightsSize;
+        for (int half = 0; half < CpuNeuronEvaluator::PackSize; half += 8) {
+            __m256 inputs[MAX_CHANNELS];
+            for (int col = 0; col < MAX_CHANNELS; ++col) {
+                inputs[col] = _mm256_loadu_ps(&input[col][half]);
+            }
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                auto sum = _mm256_loadu_ps(biases + row * CpuNeuronEvaluator::PackSize + half);
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    sum = _mm256_fmadd_ps(_mm256_loadu_ps(pack + (row * MAX_CHANNELS + col) * CpuNeuronEvaluator::PackSize + half), inputs[col], sum);
+                }
+                _mm256_storeu_ps(&output[row][half], scaledSigmoid_avx2(sum));
+            }
+        }
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"  //false positives in the AVX-512 intrinsics of GCC 12
+#endif
+    TARGET_AVX512 __m512 scaledSigmoid_avx512(__m512 z)
+    {
+        auto x = _mm512_mul_ps(z, _mm512_set1_ps(-Log2e));
+        x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(-ExponentBound)), _mm512_set1_ps(ExponentBound));
+        auto i = _mm512_roundscale_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        auto f = _mm512_sub_ps(x, i);
+        auto p = _mm512_fmadd_ps(_mm512_set1_ps(C6), f, _mm512_set1_ps(C5));
+        p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(C4));
+        p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(C3));
+        p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(C2));
+        p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(C1));
+        p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(1.0f));
+        auto powerOfTwo = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(i), _mm512_set1_epi32(127)), 23));
+        auto one = _mm512_set1_ps(1.0f);
+        return _mm512_sub_ps(_mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_fmadd_ps(p, powerOfTwo, one)), one);
+    }
+
+    TARGET_AVX512 void evaluatePack_avx512(
+        float const* pack,
+        float const (&input)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize],
+        float (&output)[MAX_CHANNELS][CpuNeuronEvaluator::PackSize])
+    {
+        auto biases = pack + WeightsSize;
+        __m512 inputs[MAX_CHANNELS];
+        for (int col = 0; col < MAX_CHANNELS; ++col) {
+            inputs[col] = _mm512_loadu_ps(&input[col][0]);
+        }
+        for (int row = 0; row < MAX_CHANNELS; ++row) {
+            auto sum = _mm512_loadu_ps(biases + row * CpuNeuronEvaluator::PackSize);
+            for (int col = 0; col < MAX_CHANNELS; ++col) {
+                sum = _mm512_fmadd_ps(_mm512_loadu_ps(pack + (row * MAX_CHANNELS + col) * CpuNeuronEvaluator::PackSize), inputs[col], sum);
+            }
+            _mm512_storeu_ps(&output[row][0], scaledSigmoid_avx512(sum));
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    bool isAvx2Supported()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        auto isFmaSupported = (info[2] & (1 << 12)) != 0;
+        auto isOsXSaveSupported = (info[2] & (1 << 27)) != 0;
+        if (!isFmaSupported || !isOsXSaveSupported || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    }
+
+    bool isAvx512Supported()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0xe6) != 0xe6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 16)) != 0;
+#else
+        return __builtin_cpu_supports("avx512f");
+#endif
+    }
+#endif
+}
+
+CpuNeuronEvaluator::CpuNeuronEvaluator()
+    : _instructionSet(getSupportedInstructionSet())
+{}
+
+NeuronInstructionSet CpuNeuronEvaluator::getSupportedInstructionSet()
+{
+#ifdef ALIEN_X86_64
+    if (isAvx512Supported()) {
+        return NeuronInstructionSet_Avx512;
+    }
+    if (isAvx2Supported()) {
+        return NeuronInstructionSet_Avx2;
+    }
+#endif
+    return NeuronInstructionSet_Scalar;
+}
+
+std::string CpuNeuronEvaluator::getInstructionSetName(NeuronInstructionSet instructionSet)
+{
+    switch (instructionSet) {
+    case NeuronInstructionSet_Avx2:
+        return "AVX2";
+    case NeuronInstructionSet_Avx512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+NeuronInstructionSet CpuNeuronEvaluator::getInstructionSet() const
+{
+    return _instructionSet;
+}
+
+void CpuNeuronEvaluator::setInstructionSet(NeuronInstructionSet instructionSet)
+{
+    CHECK(instructionSet <= getSupportedInstructionSet());
+    _instructionSet = instructionSet;
+}
+
+void CpuNeuronEvaluator::clear()
+{
+    _numNetworks = 0;
+    _packs.clear();
+}
+
+int CpuNeuronEvaluator::addNetwork(std::vector<std::vector<float>> const& weights, std::vector<float> const& biases)
+{
+    CHECK(weights.size() == MAX_CHANNELS && biases.size() == MAX_CHANNELS);
+
+    float weightsAndBiases[MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS];
+    for (int row = 0; row < MAX_CHANNELS; ++row) {
+        CHECK(weights[row].size() == MAX_CHANNELS);
+        std::copy(weights[row].begin(), weights[row].end(), weightsAndBiases + row * MAX_CHANNELS);
+    }
+    std::copy(biases.begin(), biases.end(), weightsAndBiases + MAX_CHANNELS * MAX_CHANNELS);
+    return addNetwork(weightsAndBiases);
+}
+
+int CpuNeuronEvaluator::addNetwork(float const* weightsAndBiases)
+{
+    auto lane = _numNetworks % PackSize;
+    if (lane == 0) {
+        _packs.resize(_packs.size() + PackStride, 0.0f);
+    }
+    auto pack = _packs.data() + (_numNetworks / PackSize) * PackStride;
+    for (int entry = 0; entry < MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS; ++entry) {
+        pack[entry * PackSize + lane] = weightsAndBiases[entry];
+    }
+    return _numNetworks++;
+}
+
+int CpuNeuronEvaluator::getNumNetworks() const
+{
+    return _numNetworks;
+}
+
+void CpuNeuronEvaluator::evaluate(float const* inputs, float* outputs, ThreadPool* threadPool) const
+{
+    auto numPacks = (_numNetworks + PackSize - 1) / PackSize;
+    if (threadPool) {
+        threadPool->parallelFor(numPacks, PacksPerChunk, [&](int beginPack, int endPack) { evaluatePacks(inputs, outputs, beginPack, endPack); });
+    } else {
+        evaluatePacks(inputs, outputs, 0, numPacks);
+    }
+}
+
+float CpuNeuronEvaluator::scaledSigmoid(float z)
+{
+    return scaledSigmoid_scalar(z);
+}
+
+void CpuNeuronEvaluator::evaluatePacks(float const* inputs, float* outputs, int beginPack, int endPack) const
+{
+    for (int packIndex = beginPack; packIndex < endPack; ++packIndex) {
+        auto numLanes = std::min(PackSize, _numNetworks - packIndex * PackSize);
+        auto packInputs = inputs + packIndex * PackSize * MAX_CHANNELS;
+        auto packOutputs = outputs + packIndex * PackSize * MAX_CHANNELS;
+
+        //transpose the activities of the pack, unused lanes are zero
+        float input[MAX_CHANNELS][PackSize] = {};
+        float output[MAX_CHANNELS][PackSize];
+        for (int lane = 0; lane < numLanes; ++lane) {
+            for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+                input[channel][lane] = packInputs[lane * MAX_CHANNELS + channel];
+            }
+        }
+
+        auto pack = _packs.data() + packIndex * PackStride;
+        switch (_instructionSet) {
+#ifdef ALIEN_X86_64
+        case NeuronInstructionSet_Avx512:
+            evaluatePack_avx512(pack, input, output);
+            break;
+        case NeuronInstructionSet_Avx2:
+            evaluatePack_avx2(pack, input, output);
+            break;
+#endif
+        default:
+            evaluatePack_scalar(pack, input, output);
+            break;
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane) {
+            for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+                packOutputs[lane * MAX_CHANNELS + channel] = output[channel][lane];
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "EngineInterface/FundamentalConstants.h"
+
+class ThreadPool;
+
+using NeuronInstructionSet = int;
+enum NeuronInstructionSet_
+{
+    NeuronInstructionSet_Scalar,
+    NeuronInstructionSet_Avx2,
+    NeuronInstructionSet_Avx512
+};
+
+/**
+ * Host counterpart of NeuronProcessor::processCell for many neural networks at once, e.g. all neuron cells of a simulation or
+ * the neurons of genomes to be replayed offline. The networks are interleaved in packs of PackSize networks (struct-of-arrays) such that
+ * each weight of consecutive networks is contiguous in memory and can be processed by SIMD instructions.
+ * The sigmoid uses a polynomial approximation of exp which deviates from the exact value by less than 1e-6.
+ */
+class CpuNeuronEvaluator
+{
+public:
+    static int constexpr PackSize = 16;
+
+    CpuNeuronEvaluator();  //uses the best instruction set supported by the processor
+
+    static NeuronInstructionSet getSupportedInstructionSet();
+    static std::string getInstructionSetName(NeuronInstructionSet instructionSet);
+    NeuronInstructionSet getInstructionSet() const;
+    void setInstructionSet(NeuronInstructionSet instructionSet);  //prerequisite: instructionSet <= getSupportedInstructionSet()
+
+    void clear();
+    //weights[row][col] weights the input channel col for the output channel row as in NeuronDescription, returns the network index
+    int addNetwork(std::vector<std::vector<float>> const& weights, std::vector<float> const& biases);
+    //weightsAndBiases holds the weights in row-major order followed by the biases as NeuronFunction::NeuronState
+    int addNetwork(float const* weightsAndBiases);
+    int getNumNetworks() const;
+
+    //inputs and outputs contain MAX_CHANNELS values per network, the values of network i start at i * MAX_CHANNELS
+    void evaluate(float const* inputs, float* outputs, ThreadPool* threadPool = nullptr) const;
+
+    static float scaledSigmoid(float z);  //maps to [-1, 1]
+
+private:
+    static int constexpr PackStride = (MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS) * PackSize;  //weights followed by biases
+
+    void evaluatePacks(float const* inputs, float* outputs, int beginPack, int endPack) const;
+
+    NeuronInstructionSet _instructionSet = NeuronInstructionSet_Scalar;
+    int _numNetworks = 0;
+    std::vector<float> _packs;
+};
@@ -0,0 +1,41 @@
+#include "CpuNeuronProcessor.h"
+
+#include <cstring>
+
+#include "CpuCellFunctionProcessor.h"
+
+void CpuNeuronProcessor::process(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& operations = data.cellFunctionOperations[CellFunction_Neuron];
+    auto numOperations = toInt(operations.size());
+    if (numOperations == 0) {
+        return;
+    }
+
+    auto& evaluator = data.neuronEvaluator;
+    evaluator.clear();
+    for (auto index : operations) {
+        float weightsAndBiases[MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS];  //copied since the auxiliary data is not aligned for floats
+        auto dataIndex = objects.cells[index].cellFunctionData.neuron.weightsAndBiasesDataIndex;
+        std::memcpy(weightsAndBiases, objects.auxiliaryData.data() + dataIndex, sizeof(weightsAndBiases));
+        evaluator.addNetwork(weightsAndBiases);
+    }
+
+    auto inputs = data.arena.allocateArray<float>(static_cast<size_t>(numOperations) * MAX_CHANNELS);
+    auto outputs = data.arena.allocateArray<float>(static_cast<size_t>(numOperations) * MAX_CHANNELS);
+    data.parallelForWithoutBuffers(numOperations, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            auto activity = CpuCellFunctionProcessor::calcInputActivity(objects, operations[i]);
+            std::memcpy(inputs + i * MAX_CHANNELS, activity.channels, sizeof(activity.channels));
+        }
+    });
+    evaluator.evaluate(inputs, outputs, data.threadPool.get());
+    data.parallelForWithoutBuffers(numOperations, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            ActivityTO activity;
+            std::memcpy(activity.channels, outputs + i * MAX_CHANNELS, sizeof(activity.channels));
+            CpuCellFunctionProcessor::setActivity(objects.cells[operations[i]], activity);
+        }
+    });
+}
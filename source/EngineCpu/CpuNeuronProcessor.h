@@ -0,0 +1,10 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of NeuronProcessor, the networks of all neuron operations are evaluated together by CpuNeuronEvaluator
+class CpuNeuronProcessor
+{
+public:
+    static void process(CpuSimulationData& data);
+};
@@ -0,0 +1,244 @@
+#include "CpuParticleProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+#include "CpuSpotCalculator.h"
+
+namespace
+{
+    float lengthMax(RealVector2D const& v) { return std::max(std::abs(v.x), std::abs(v.y)); }
+
+    RealVector2D normalized(RealVector2D v)
+    {
+        Math::normalize(v);
+        return v;
+    }
+}
+
+void CpuParticleProcessor::updateMap(CpuSimulationData& data)
+{
+    data.particleMap.set(data.objects.particlePositions, data.objects.particleDeleted, data.threadPool.get());
+}
+
+void CpuParticleProcessor::movement(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto timestepSize = data.parameters.timestepSize;
+    data.parallelForWithoutBuffers(objects.getNumParticles(), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto& pos = objects.particlePositions[index];
+            pos += objects.particleVelocities[index] * timestepSize;
+            data.particleMap.correctPosition(pos);
+        }
+    });
+}
+
+void CpuParticleProcessor::collision(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto& collisions = data.particleCollisions;
+    collisions.assign(objects.getNumParticles(), CpuParticleCollision());
+
+    //determine collision partners in parallel; only the own particle is modified
+    data.parallelForWithoutBuffers(objects.getNumParticles(), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            auto const& pos = objects.particlePositions[index];
+            auto& vel = objects.particleVelocities[index];
+            auto otherIndex = data.particleMap.getFirst(pos);
+            if (otherIndex != -1 && otherIndex != index) {
+                auto delta = pos - objects.particlePositions[otherIndex];
+                if (delta.x * delta.x + delta.y * delta.y < 0.5f) {
+                    collisions[index].otherParticleIndex = otherIndex;
+                    continue;
+                }
+            }
+            auto cellIndex = data.cellMap.getFirst(pos + vel);
+            if (cellIndex == -1) {
+                continue;
+            }
+            auto const& cell = objects.cells[cellIndex];
+            auto const& cellVel = objects.cellVelocities[cellIndex];
+            if (cell.barrier) {
+                auto vr = vel - cellVel;
+                auto r = data.cellMap.getCorrectedDirection(pos - objects.cellPositions[cellIndex]);
+                auto dot_vr_r = vr.x * r.x + vr.y * r.y;
+                if (dot_vr_r < 0) {
+                    auto truncated_r_squared = std::max(0.1f, r.x * r.x + r.y * r.y);
+                    vel = vr - r * 2 * dot_vr_r / truncated_r_squared + cellVel;
+                }
+            } else {
+                if (objects.particleLastAbsorbedCellIds[index] == cell.id) {
+                    continue;
+                }
+                auto radiationAbsorption = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersSpotValues::radiationAbsorption,
+                    &SimulationParametersSpotActivatedValues::radiationAbsorption,
+                    data,
+                    objects.cellPositions[cellIndex],
+                    cell.color);
+                if (radiationAbsorption < NEAR_ZERO) {
+                    continue;
+                }
+                collisions[index].cellIndex = cellIndex;
+                collisions[index].radiationAbsorption = radiationAbsorption;
+            }
+        }
+    });
+
+    //fusions and absorptions are executed in index order
+    for (int index = 0; index < objects.getNumParticles(); ++index) {
+        auto const& collision = collisions[index];
+        auto& particle = objects.particles[index];
+        if (collision.otherParticleIndex != -1) {
+            auto otherIndex = collision.otherParticleIndex;
+            auto& otherParticle = objects.particles[otherIndex];
+            if (objects.particleDeleted[otherIndex] || particle.energy <= NEAR_ZERO || otherParticle.energy <= NEAR_ZERO) {
+                continue;
+            }
+            auto factor1 = particle.energy / (particle.energy + otherParticle.energy);
+            objects.particleVelocities[otherIndex] = objects.particleVelocities[index] * factor1 + objects.particleVelocities[otherIndex] * (1.0f - factor1);
+            otherParticle.energy += particle.energy;
+            objects.particleLastAbsorbedCellIds[otherIndex] = 0;
+            particle.energy = 0;
+            objects.particleDeleted[index] = 1;
+        } else if (collision.cellIndex != -1) {
+            auto& cell = objects.cells[collision.cellIndex];
+            auto energyToTransfer = particle.energy * collision.radiationAbsorption;
+            energyToTransfer *=
+                std::max(0.0f, 1.0f - Math::length(objects.cellVelocities[collision.cellIndex]) * data.parameters.radiationAbsorptionVelocityPenalty[cell.color]);
+            if (particle.energy < 1) {
+                energyToTransfer = particle.energy;
+            }
+            cell.energy += energyToTransfer;
+            particle.energy -= energyToTransfer;
+            if (particle.energy < NEAR_ZERO) {
+                objects.particleDeleted[index] = 1;
+            } else {
+                objects.particleLastAbsorbedCellIds[index] = cell.id;
+            }
+        }
+    }
+}
+
+void CpuParticleProcessor::transformation(CpuSimulationData& data)
+{
+    auto const& parameters = data.parameters;
+    if (!parameters.particleTransformationAllowed) {
+        return;
+    }
+    auto& objects = data.objects;
+    auto numParticles = objects.getNumParticles();
+    for (int index = 0; index < numParticles; ++index) {
+        auto const& particle = objects.particles[index];
+        if (objects.particleDeleted[index] || particle.energy < parameters.cellNormalEnergy[particle.color]) {
+            continue;
+        }
+        CpuRandom random(data.randomSeed, data.timestep, index, CpuRandomStage_ParticleTransformation);
+        auto const& pos = objects.particlePositions[index];
+        auto const& vel = objects.particleVelocities[index];
+
+        //random cell functions are not supported by the host engine, hence the new cell has none
+        CellTO cell{};
+        cell.id = data.createNewId();
+        cell.pos = {pos.x, pos.y};
+        cell.vel = {vel.x, vel.y};
+        cell.energy = particle.energy;
+        cell.stiffness = random.random();
+        cell.maxConnections = random.random(MAX_CELL_BONDS);
+        cell.executionOrderNumber = random.random(parameters.cellNumExecutionOrderNumbers - 1);
+        cell.inputExecutionOrderNumber = random.random(parameters.cellNumExecutionOrderNumbers - 1);
+        cell.outputBlocked = random.random(1) == 1;
+        cell.livingState = LivingState_Ready;
+        cell.color = particle.color;
+        cell.cellFunction = CellFunction_None;
+        objects.addCell(cell, pos, vel);
+
+        objects.particleDeleted[index] = 1;
+    }
+}
+
+void CpuParticleProcessor::radiate(
+    CpuSimulationData const& data,
+    CpuRandom& random,
+    CpuChunkBuffers& buffers,
+    RealVector2D pos,
+    RealVector2D vel,
+    int color,
+    float energy)
+{
+    auto const& parameters = data.parameters;
+    if (parameters.numParticleSources > 0) {
+        auto const& source = parameters.particleSources[random.random(parameters.numParticleSources - 1)];
+        pos = {source.posX, source.posY};
+
+        if (source.shapeType == RadiationSourceShapeType_Circular) {
+            auto radius = std::max(1.0f, source.shapeData.circularRadiationSource.radius);
+            RealVector2D delta{0, 0};
+            for (int i = 0; i < 10; ++i) {
+                delta.x = random.random() * radius * 2 - radius;
+                delta.y = random.random() * radius * 2 - radius;
+                if (Math::length(delta) <= radius) {
+                    break;
+                }
+            }
+            pos += delta;
+            if (source.useAngle) {
+                vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+            } else {
+                vel = normalized(delta) * random.random(0.5f, 1.0f);
+            }
+        }
+        if (source.shapeType == RadiationSourceShapeType_Rectangular) {
+            auto const& rectangle = source.shapeData.rectangularRadiationSource;
+            RealVector2D delta;
+            delta.x = random.random() * rectangle.width - rectangle.width / 2;
+            delta.y = random.random() * rectangle.height - rectangle.height / 2;
+            pos += delta;
+            if (source.useAngle) {
+                vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+            } else {
+                auto roundSize = std::min(rectangle.width, rectangle.height) / 2;
+                RealVector2D corner1{-rectangle.width / 2, -rectangle.height / 2};
+                RealVector2D corner2{rectangle.width / 2, -rectangle.height / 2};
+                RealVector2D corner3{-rectangle.width / 2, rectangle.height / 2};
+                RealVector2D corner4{rectangle.width / 2, rectangle.height / 2};
+                if (lengthMax(corner1 - delta) <= roundSize) {
+                    vel = normalized(delta - (corner1 + RealVector2D{roundSize, roundSize}));
+                } else if (lengthMax(corner2 - delta) <= roundSize) {
+                    vel = normalized(delta - (corner2 + RealVector2D{-roundSize, roundSize}));
+                } else if (lengthMax(corner3 - delta) <= roundSize) {
+                    vel = normalized(delta - (corner3 + RealVector2D{roundSize, -roundSize}));
+                } else if (lengthMax(corner4 - delta) <= roundSize) {
+                    vel = normalized(delta - (corner4 + RealVector2D{-roundSize, -roundSize}));
+                } else {
+                    vel = {0, 0};
+                    auto dx1 = rectangle.width / 2 + delta.x;
+                    auto dx2 = rectangle.width / 2 - delta.x;
+                    auto dy1 = rectangle.height / 2 + delta.y;
+                    auto dy2 = rectangle.height / 2 - delta.y;
+                    if (dx1 <= dy1 && dx1 <= dy2 && delta.x <= 0) {
+                        vel.x = -1;
+                    }
+                    if (dy1 <= dx1 && dy1 <= dx2 && delta.y <= 0) {
+                        vel.y = -1;
+                    }
+                    if (dx2 <= dy1 && dx2 <= dy2 && delta.x > 0) {
+                        vel.x = 1;
+                    }
+                    if (dy2 <= dx1 && dy2 <= dx2 && delta.y > 0) {
+                        vel.y = 1;
+                    }
+                }
+                vel = vel * random.random(0.5f, 1.0f);
+            }
+        }
+    }
+
+    if (energy > NEAR_ZERO) {
+        data.cellMap.correctPosition(pos);
+        buffers.particles.emplace_back(CpuNewParticle{pos, vel, color, energy});
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CpuRandom.h"
+#include "CpuSimulationData.h"
+
+//host counterpart of ParticleProcessor
+class CpuParticleProcessor
+{
+public:
+    static void updateMap(CpuSimulationData& data);
+    static void movement(CpuSimulationData& data);
+    static void collision(CpuSimulationData& data);
+    static void transformation(CpuSimulationData& data);
+
+    //buffers a new particle at pos or at a particle source
+    static void radiate(
+        CpuSimulationData const& data,
+        CpuRandom& random,
+        CpuChunkBuffers& buffers,
+        RealVector2D pos,
+        RealVector2D vel,
+        int color,
+        float energy);
+};
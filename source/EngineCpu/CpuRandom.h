@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+using CpuRandomStage = int;
+enum CpuRandomStage_
+{
+    CpuRandomStage_Radiation,
+    CpuRandomStage_CheckForces,
+    CpuRandomStage_Decay,
+    CpuRandomStage_CellDeletion,
+    CpuRandomStage_ParticleTransformation
+};
+
+/**
+ * Counter-based random number generator: the sequence only depends on the seed, the time step, the object index and the
+ * processing stage. Hence, results of the host engine do not depend on the number of threads or the order of execution.
+ */
+class CpuRandom
+{
+public:
+    CpuRandom(uint64_t seed, uint64_t timestep, int index, CpuRandomStage stage)
+        : _state(mix(mix(mix(seed + 0x9e3779b97f4a7c15ull) ^ timestep) ^ static_cast<uint64_t>(static_cast<uint32_t>(index))) ^ static_cast<uint64_t>(stage))
+    {}
+
+    //returns a value in [0, 1)
+    float random() { return static_cast<float>(next() >> 40) / static_cast<float>(1ull << 24); }
+
+    float random(float minValue, float maxValue) { return minValue + random() * (maxValue - minValue); }
+
+    //returns a value in [0, maxValue]
+    int random(int maxValue) { return static_cast<int>(next() % static_cast<uint64_t>(maxValue + 1)); }
+
+private:
+    static uint64_t mix(uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t next()
+    {
+        _state += 0x9e3779b97f4a7c15ull;
+        return mix(_state);
+    }
+
+    uint64_t _state;
+};
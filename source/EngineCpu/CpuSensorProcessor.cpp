@@ -0,0 +1,238 @@
+#include "CpuSensorProcessor.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Base/Math.h"
+
+#include "CpuCellFunctionProcessor.h"
+
+namespace
+{
+    int constexpr NumScanPoints = 64;
+    uint64_t constexpr NoLookupResult = std::numeric_limits<uint64_t>::max();
+    uint32_t constexpr NoCreatureId = 0xffffffff;
+
+    bool isCreatureDetectionEnabled(CpuSimulationData const& data, CellTO const& cell)
+    {
+        return data.parameters.cellFunctionAttackerSensorDetectionFactor[cell.color] > NEAR_ZERO;
+    }
+
+    //returns the creature id of the first cell of the scanned color in the given offset range from scanPos
+    uint32_t detectCreature(
+        CpuSimulationData const& data,
+        int cellIndex,
+        int scanColor,
+        RealVector2D const& scanPos,
+        float minOffset,
+        float maxOffset,
+        RealVector2D& preciseDelta)
+    {
+        auto const& objects = data.objects;
+        for (float dx = minOffset; dx < maxOffset + NEAR_ZERO; dx += 1.0f) {
+            for (float dy = minOffset; dy < maxOffset + NEAR_ZERO; dy += 1.0f) {
+                auto otherIndex = data.cellMap.getFirst(scanPos + RealVector2D{dx, dy});
+                if (otherIndex != -1 && objects.cells[otherIndex].color == scanColor) {
+                    preciseDelta = data.cellMap.getCorrectedDirection(objects.cellPositions[otherIndex] - objects.cellPositions[cellIndex]);
+                    return static_cast<uint32_t>(objects.cells[otherIndex].creatureId);
+                }
+            }
+        }
+        return NoCreatureId;
+    }
+}
+
+void CpuSensorProcessor::fillDensityMap(CpuSimulationData& data)
+{
+    auto const& objects = data.objects;
+    data.densityMap.clear();
+    for (int index = 0; index < objects.getNumCells(); ++index) {
+        data.densityMap.addCell(objects.cellPositions[index], objects.cells[index].color);
+    }
+}
+
+void CpuSensorProcessor::process(CpuSimulationData& data)
+{
+    auto& objects = data.objects;
+    auto const& parameters = data.parameters;
+    auto const& operations = data.cellFunctionOperations[CellFunction_Sensor];
+    auto numOperations = toInt(operations.size());
+    if (numOperations == 0) {
+        return;
+    }
+
+    auto activities = data.arena.allocateArray<ActivityTO>(numOperations);
+    data.parallelForWithoutBuffers(numOperations, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            activities[i] = CpuCellFunctionProcessor::calcInputActivity(objects, operations[i]);
+        }
+    });
+    auto isActive = [&](int i) { return std::abs(activities[i].channels[0]) > parameters.cellFunctionSensorActivityThreshold; };
+
+    //the neighborhood scans without creature detection are delegated to the scanner
+    auto queryIndices = data.arena.allocateArray<int>(numOperations);
+    std::vector<CpuSensorQuery> queries;
+    for (int i = 0; i < numOperations; ++i) {
+        queryIndices[i] = -1;
+        auto const& cell = objects.cells[operations[i]];
+        if (!isActive(i) || cell.cellFunctionData.sensor.mode != SensorMode_Neighborhood || isCreatureDetectionEnabled(data, cell)) {
+            continue;
+        }
+        CpuSensorQuery query;
+        query.pos = objects.cellPositions[operations[i]];
+        query.refAngle = Math::angleOfVector(CpuCellFunctionProcessor::calcSignalDirection(data, operations[i]));
+        query.cellColor = cell.color;
+        query.scanColor = cell.cellFunctionData.sensor.color;
+        query.minDensity = cell.cellFunctionData.sensor.minDensity;
+        query.range = parameters.cellFunctionSensorRange[cell.color];
+        queryIndices[i] = toInt(queries.size());
+        queries.emplace_back(query);
+    }
+    std::vector<CpuSensorResult> results;
+    if (!queries.empty()) {
+        data.sensorScanner.build(data.densityMap, data.threadPool.get());
+        data.sensorScanner.scan(queries, results, data.threadPool.get());
+    }
+
+    data.parallelForWithoutBuffers(numOperations, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            auto index = operations[i];
+            auto& cell = objects.cells[index];
+            auto& activity = activities[i];
+            if (isActive(i)) {
+                if (queryIndices[i] != -1) {
+                    auto const& result = results[queryIndices[i]];
+                    if (result.found) {
+                        setFoundActivity(cell.cellFunctionData.sensor, result, activity);
+                    } else {
+                        setNotFoundActivity(cell.cellFunctionData.sensor, activity);
+                    }
+                } else if (cell.cellFunctionData.sensor.mode == SensorMode_Neighborhood) {
+                    searchNeighborhood(data, index, activity);
+                } else if (cell.cellFunctionData.sensor.mode == SensorMode_FixedAngle) {
+                    searchByAngle(data, index, activity);
+                }
+            }
+            CpuCellFunctionProcessor::setActivity(cell, activity);
+        }
+    });
+}
+
+void CpuSensorProcessor::searchNeighborhood(CpuSimulationData& data, int cellIndex, ActivityTO& activity)
+{
+    auto& cell = data.objects.cells[cellIndex];
+    auto& sensor = cell.cellFunctionData.sensor;
+    auto const& pos = data.objects.cellPositions[cellIndex];
+    auto refScanAngle = Math::angleOfVector(CpuCellFunctionProcessor::calcSignalDirection(data, cellIndex));
+    auto minDensity = toInt(sensor.minDensity * 100);
+    auto color = sensor.color;
+    auto creatureDetection = isCreatureDetectionEnabled(data, cell);
+
+    auto lookupResult = NoLookupResult;
+    auto startRadius = color == cell.color ? CpuSensorScanner::StartRadiusForSameColor : 0.0f;
+    for (float radius = startRadius; radius <= data.parameters.cellFunctionSensorRange[cell.color]; radius += CpuSensorScanner::RadiusStep) {
+        for (int angleIndex = 0; angleIndex < CpuSensorScanner::NumScanAngles; ++angleIndex) {
+            float angle = 360.0f / CpuSensorScanner::NumScanAngles * angleIndex;
+            auto scanPos = pos + Math::unitVectorOfAngle(angle) * radius;
+            data.cellMap.correctPosition(scanPos);
+            auto density = static_cast<unsigned char>(data.densityMap.getDensity(scanPos, color));
+            if (density < minDensity) {
+                continue;
+            }
+            auto preciseAngle = angle;
+            auto preciseDistance = radius;
+            auto creatureId = NoCreatureId;
+            if (creatureDetection) {
+                RealVector2D preciseDelta;
+                creatureId = detectCreature(data, cellIndex, color, scanPos, 0.0f, 6.0f, preciseDelta);
+                if (creatureId != NoCreatureId) {
+                    preciseAngle = Math::angleOfVector(preciseDelta);
+                    preciseDistance = Math::length(preciseDelta);
+                }
+            }
+            uint64_t relAngleData = CpuSensorScanner::convertAngleToData(Math::subtractAngle(preciseAngle, refScanAngle));
+            uint64_t combined = static_cast<uint64_t>(preciseDistance) << 48 | static_cast<uint64_t>(density) << 40 | relAngleData << 32 | creatureId;
+            lookupResult = std::min(lookupResult, combined);
+        }
+    }
+
+    if (lookupResult != NoLookupResult) {
+        CpuSensorResult result;
+        result.found = true;
+        result.density = toInt((lookupResult >> 40) & 0xff);
+        result.distance = toInt(lookupResult >> 48);
+        result.angleData = static_cast<uint8_t>((lookupResult >> 32) & 0xff);
+        setFoundActivity(sensor, result, activity);
+        auto targetCreatureId = lookupResult & 0xffffffff;
+        if (targetCreatureId != NoCreatureId) {
+            sensor.targetedCreatureId = toInt(targetCreatureId);
+        }
+    } else {
+        setNotFoundActivity(sensor, activity);
+    }
+}
+
+void CpuSensorProcessor::searchByAngle(CpuSimulationData& data, int cellIndex, ActivityTO& activity)
+{
+    auto& cell = data.objects.cells[cellIndex];
+    auto& sensor = cell.cellFunctionData.sensor;
+    auto const& pos = data.objects.cellPositions[cellIndex];
+    auto minDensity = toInt(sensor.minDensity * 255);
+    auto color = sensor.color;
+    auto searchDelta = Math::rotateClockwise(CpuCellFunctionProcessor::calcSignalDirection(data, cellIndex), sensor.angle);
+    auto creatureDetection = isCreatureDetectionEnabled(data, cell);
+
+    auto lookupResult = NoLookupResult;
+    auto startRadius = color == cell.color ? CpuSensorScanner::StartRadiusForSameColor : 0.0f;
+    for (int distanceIndex = 0; distanceIndex < NumScanPoints; ++distanceIndex) {
+        auto distance = startRadius + data.parameters.cellFunctionSensorRange[cell.color] / NumScanPoints * distanceIndex;
+        auto scanPos = pos + searchDelta * distance;
+        data.cellMap.correctPosition(scanPos);
+        auto density = static_cast<unsigned char>(data.densityMap.getDensity(scanPos, color));
+        if (density < minDensity) {
+            continue;
+        }
+        auto preciseDistance = distance;
+        auto creatureId = NoCreatureId;
+        if (creatureDetection) {
+            RealVector2D preciseDelta;
+            creatureId = detectCreature(data, cellIndex, color, scanPos, -3.0f, 3.0f, preciseDelta);
+            if (creatureId != NoCreatureId) {
+                preciseDistance = Math::length(preciseDelta);
+            }
+        }
+        uint64_t combined = static_cast<uint64_t>(preciseDistance) << 48 | static_cast<uint64_t>(density) << 40 | creatureId;
+        lookupResult = std::min(lookupResult, combined);
+    }
+
+    if (lookupResult != NoLookupResult) {
+        activity.channels[0] = 1;  //something found
+        activity.channels[1] = static_cast<float>((lookupResult >> 40) & 0xff) / 256;  //density
+        activity.channels[2] = static_cast<float>(lookupResult >> 48) / 256;  //distance
+        auto targetCreatureId = lookupResult & 0xffffffff;
+        if (targetCreatureId != NoCreatureId) {
+            sensor.targetedCreatureId = toInt(targetCreatureId);
+        }
+    } else {
+        activity.channels[0] = 0;  //nothing found
+    }
+}
+
+void CpuSensorProcessor::setFoundActivity(SensorTO& sensor, CpuSensorResult const& result, ActivityTO& activity)
+{
+    activity.channels[0] = 1;  //something found
+    activity.channels[1] = static_cast<float>(result.density) / 256;  //density
+    activity.channels[2] = static_cast<float>(result.distance) / 256;  //distance
+    activity.channels[3] = CpuSensorScanner::convertDataToAngle(result.angleData) / 360.0f;  //angle: between -0.5 and 0.5
+    sensor.memoryChannel1 = activity.channels[1];
+    sensor.memoryChannel2 = activity.channels[2];
+    sensor.memoryChannel3 = activity.channels[3];
+}
+
+void CpuSensorProcessor::setNotFoundActivity(SensorTO const& sensor, ActivityTO& activity)
+{
+    activity.channels[0] = 0;  //nothing found
+    activity.channels[1] = sensor.memoryChannel1;
+    activity.channels[2] = sensor.memoryChannel2;
+    activity.channels[3] = sensor.memoryChannel3;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CpuSimulationData.h"
+
+//host counterpart of SensorProcessor: the neighborhood scans are performed by CpuSensorScanner on the density map of the time step,
+//except for the scans with creature detection which need the cells near the samples
+class CpuSensorProcessor
+{
+public:
+    static void fillDensityMap(CpuSimulationData& data);
+    static void process(CpuSimulationData& data);
+
+private:
+    static void searchNeighborhood(CpuSimulationData& data, int cellIndex, ActivityTO& activity);  //with creature detection
+    static void searchByAngle(CpuSimulationData& data, int cellIndex, ActivityTO& activity);
+
+    static void setFoundActivity(SensorTO& sensor, CpuSensorResult const& result, ActivityTO& activity);
+    static void setNotFoundActivity(SensorTO const& sensor, ActivityTO& activity);
+};
@@ -0,0 +1,395 @@
+#include "CpuSensorScanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    uint64_t constexpr NoLookupResult = std::numeric_limits<uint64_t>::max();
+    uint64_t constexpr NoCreatureId = 0xffffffff;
+    float constexpr RangeMargin = 1.0f;  //covers rounding errors of the sample positions
+    float constexpr BlockMargin = 0.1f;  //exceeds the rounding errors of the sample positions for world sizes up to 10^5
+}
+
+void CpuDensityMap::init(IntVector2D const& worldSize, int slotSize)
+{
+    _worldSize = worldSize;
+    _mapSize = {worldSize.x / slotSize, worldSize.y / slotSize};
+    _slotSize = slotSize;
+    _slots.assign(static_cast<size_t>(_mapSize.x) * _mapSize.y, 0);
+}
+
+void CpuDensityMap::clear()
+{
+    std::fill(_slots.begin(), _slots.end(), 0);
+}
+
+void CpuDensityMap::addCell(RealVector2D const& pos, int color)
+{
+    auto index = toInt(pos.x) / _slotSize + toInt(pos.y) / _slotSize * _mapSize.x;
+    if (index >= 0 && index < _mapSize.x * _mapSize.y) {
+        color = ((color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS;
+        _slots[index] += uint64_t(1) << (color * 8);
+    }
+}
+
+uint32_t CpuDensityMap::getDensity(RealVector2D const& pos, int color) const
+{
+    return getDensity(toInt(pos.x) / _slotSize, toInt(pos.y) / _slotSize, color);
+}
+
+uint32_t CpuDensityMap::getDensity(int slotX, int slotY, int color) const
+{
+    auto index = slotX + slotY * _mapSize.x;
+    if (index >= 0 && index < _mapSize.x * _mapSize.y) {
+        return (_slots[index] >> (color * 8)) & 0xff;
+    }
+    return 0;
+}
+
+CpuSensorScanner::CpuSensorScanner()
+{
+    for (int angleIndex = 0; angleIndex < NumScanAngles; ++angleIndex) {
+        auto unitVector = Math::unitVectorOfAngle(360.0f / NumScanAngles * angleIndex);
+        _unitVectorsX[angleIndex] = unitVector.x;
+        _unitVectorsY[angleIndex] = unitVector.y;
+    }
+}
+
+void CpuSensorScanner::build(CpuDensityMap const& densityMap, ThreadPool* threadPool)
+{
+    _densityMap = &densityMap;
+    auto const& mapSize = densityMap.getMapSize();
+    auto const& slots = densityMap.getSlots();
+
+    _levels.resize(1);
+    _levels.front().size = mapSize;
+    _levels.front().maxDensities.resize(static_cast<size_t>(mapSize.x) * mapSize.y * MAX_COLORS);
+    parallelFor(threadPool, mapSize.y, [&](int beginRow, int endRow) {
+        auto& maxDensities = _levels.front().maxDensities;
+        for (int color = 0; color < MAX_COLORS; ++color) {
+            for (int index = beginRow * mapSize.x; index < endRow * mapSize.x; ++index) {
+                maxDensities[color * mapSize.x * mapSize.y + index] = static_cast<uint8_t>(slots[index] >> (color * 8));
+            }
+        }
+    });
+
+    while (_levels.back().size.x > 1 || _levels.back().size.y > 1) {
+        auto const& finerSize = _levels.back().size;
+        Level level;
+        level.size = {(finerSize.x + 1) / 2, (finerSize.y + 1) / 2};
+        level.maxDensities.resize(static_cast<size_t>(level.size.x) * level.size.y * MAX_COLORS);
+        auto finerLevelIndex = toInt(_levels.size()) - 1;
+        parallelFor(threadPool, level.size.y, [&](int beginRow, int endRow) {
+            for (int color = 0; color < MAX_COLORS; ++color) {
+                for (int y = beginRow; y < endRow; ++y) {
+                    auto finerY2 = std::min(y * 2 + 1, finerSize.y - 1);
+                    for (int x = 0; x < level.size.x; ++x) {
+                        auto finerX2 = std::min(x * 2 + 1, finerSize.x - 1);
+                        auto maxDensity = std::max(
+                            std::max(getMaxDensity(finerLevelIndex, color, x * 2, y * 2), getMaxDensity(finerLevelIndex, color, finerX2, y * 2)),
+                            std::max(getMaxDensity(finerLevelIndex, color, x * 2, finerY2), getMaxDensity(finerLevelIndex, color, finerX2, finerY2)));
+                        level.maxDensities[(color * level.size.y + y) * level.size.x + x] = maxDensity;
+                    }
+                }
+            }
+        });
+        _levels.emplace_back(std::move(level));
+    }
+}
+
+CpuSensorResult CpuSensorScanner::scan(CpuSensorQuery const& query) const
+{
+    return _mode == SensorScanMode_Pyramid ? scan_pyramid(query) : scan_bruteForce(query);
+}
+
+void CpuSensorScanner::scan(std::vector<CpuSensorQuery> const& queries, std::vector<CpuSensorResult>& results, ThreadPool* threadPool) const
+{
+    results.resize(queries.size());
+    parallelFor(threadPool, toInt(queries.size()), [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            results[index] = scan(queries[index]);
+        }
+    });
+}
+
+uint8_t CpuSensorScanner::convertAngleToData(float angle)
+{
+    //0 to 180 degree => 0 to 128
+    //-180 to 0 degree => 128 to 256 (= 0)
+    angle = std::remainder(std::remainder(angle, 360.0f) + 360.0f, 360.0f);  //get angle between 0 and 360
+    if (angle > 180.0f) {
+        angle -= 360.0f;
+    }
+    int result = static_cast<int>(angle * 128.0f / 180.0f);
+    return static_cast<uint8_t>(result);
+}
+
+float CpuSensorScanner::convertDataToAngle(uint8_t b)
+{
+    //0 to 127 => 0 to 179 degree
+    //128 to 255 => -179 to 0 degree
+    if (b < 128) {
+        return (0.5f + static_cast<float>(b)) * (180.0f / 128.0f);
+    } else {
+        return (-256.0f - 0.5f + static_cast<float>(b)) * (180.0f / 128.0f);
+    }
+}
+
+void CpuSensorScanner::parallelFor(ThreadPool* threadPool, int numItems, std::function<void(int begin, int end)> const& func)
+{
+    if (threadPool) {
+        threadPool->parallelFor(numItems, ChunkSize, func);
+    } else {
+        for (int begin = 0; begin < numItems; begin += ChunkSize) {
+            func(begin, std::min(begin + ChunkSize, numItems));
+        }
+    }
+}
+
+auto CpuSensorScanner::getScanSetup(CpuSensorQuery const& query) const -> ScanSetup
+{
+    ScanSetup result;
+    result.color = query.scanColor;
+    result.minDensity = toInt(query.minDensity * 100);
+    result.startRadius = query.scanColor == query.cellColor ? StartRadiusForSameColor : 0.0f;
+    while (result.startRadius + RadiusStep * toFloat(result.numSteps) <= query.range) {
+        ++result.numSteps;
+    }
+    return result;
+}
+
+//floor and the integer divisions are expressed by truncating conversions with corrections so that the compiler can vectorize the loop
+void CpuSensorScanner::calcSampleSlots(
+    RealVector2D const& pos,
+    float radius,
+    float const* unitVectorsX,
+    float const* unitVectorsY,
+    int numSamples,
+    SampleSlots& slots) const
+{
+    auto worldSize = _densityMap->getWorldSize();
+    auto slotSize = _densityMap->getSlotSize();
+    for (int i = 0; i < numSamples; ++i) {
+        auto scanPosX = pos.x + unitVectorsX[i] * radius;
+        auto scanPosY = pos.y + unitVectorsY[i] * radius;
+
+        //position correction of BaseMap: the integer part is taken modulo the world size
+        auto intPartX = toInt(scanPosX);
+        auto intPartY = toInt(scanPosY);
+        intPartX -= toFloat(intPartX) > scanPosX ? 1 : 0;
+        intPartY -= toFloat(intPartY) > scanPosY ? 1 : 0;
+        auto fracPartX = scanPosX - toFloat(intPartX);
+        auto fracPartY = scanPosY - toFloat(intPartY);
+        auto correctedIntPartX = intPartX - toInt(toFloat(intPartX) / toFloat(worldSize.x)) * worldSize.x;
+        auto correctedIntPartY = intPartY - toInt(toFloat(intPartY) / toFloat(worldSize.y)) * worldSize.y;
+        correctedIntPartX += correctedIntPartX < 0 ? worldSize.x : 0;
+        correctedIntPartY += correctedIntPartY < 0 ? worldSize.y : 0;
+        correctedIntPartX -= correctedIntPartX >= worldSize.x ? worldSize.x : 0;
+        correctedIntPartY -= correctedIntPartY >= worldSize.y ? worldSize.y : 0;
+
+        auto correctedPosX = toInt(toFloat(correctedIntPartX) + fracPartX);
+        auto correctedPosY = toInt(toFloat(correctedIntPartY) + fracPartY);
+        auto slotX = toInt(toFloat(correctedPosX) / toFloat(slotSize));
+        auto slotY = toInt(toFloat(correctedPosY) / toFloat(slotSize));
+        slotX += (slotX + 1) * slotSize <= correctedPosX ? 1 : 0;
+        slotY += (slotY + 1) * slotSize <= correctedPosY ? 1 : 0;
+        slotX -= slotX * slotSize > correctedPosX ? 1 : 0;
+        slotY -= slotY * slotSize > correctedPosY ? 1 : 0;
+        slots.x[i] = slotX;
+        slots.y[i] = slotY;
+        slots.offsetX[i] = intPartX - correctedIntPartX;
+        slots.offsetY[i] = intPartY - correctedIntPartY;
+    }
+}
+
+void CpuSensorScanner::evaluateSample(
+    CpuSensorQuery const& query,
+    ScanSetup const& setup,
+    int angleIndex,
+    int step,
+    int slotX,
+    int slotY,
+    uint64_t& lookupResult) const
+{
+    auto density = _densityMap->getDensity(slotX, slotY, setup.color);
+    if (toInt(density) >= setup.minDensity) {
+        auto radius = setup.startRadius + RadiusStep * toFloat(step);
+        float angle = 360.0f / NumScanAngles * angleIndex;
+        uint64_t angleData = convertAngleToData(Math::subtractAngle(angle, query.refAngle));
+        uint64_t combined = static_cast<uint64_t>(radius) << 48 | static_cast<uint64_t>(density) << 40 | angleData << 32 | NoCreatureId;
+        lookupResult = std::min(lookupResult, combined);
+    }
+}
+
+void CpuSensorScanner::evaluateRadius(CpuSensorQuery const& query, ScanSetup const& setup, int step, uint64_t& lookupResult) const
+{
+    SampleSlots slots;
+    calcSampleSlots(query.pos, setup.startRadius + RadiusStep * toFloat(step), _unitVectorsX, _unitVectorsY, NumScanAngles, slots);
+    for (int angleIndex = 0; angleIndex < NumScanAngles; ++angleIndex) {
+        evaluateSample(query, setup, angleIndex, step, slots.x[angleIndex], slots.y[angleIndex], lookupResult);
+    }
+}
+
+CpuSensorResult CpuSensorScanner::convertToResult(uint64_t lookupResult) const
+{
+    CpuSensorResult result;
+    if (lookupResult != NoLookupResult) {
+        result.found = true;
+        result.density = toInt((lookupResult >> 40) & 0xff);
+        result.distance = toInt(lookupResult >> 48);
+        result.angleData = static_cast<uint8_t>((lookupResult >> 32) & 0xff);
+    }
+    return result;
+}
+
+CpuSensorResult CpuSensorScanner::scan_bruteForce(CpuSensorQuery const& query) const
+{
+    auto setup = getScanSetup(query);
+    auto lookupResult = NoLookupResult;
+    for (int step = 0; step < setup.numSteps; ++step) {
+        evaluateRadius(query, setup, step, lookupResult);
+    }
+    return convertToResult(lookupResult);
+}
+
+CpuSensorResult CpuSensorScanner::scan_pyramid(CpuSensorQuery const& query) const
+{
+    auto setup = getScanSetup(query);
+    if (setup.numSteps == 0 || isRangeBelowMinDensity(query, setup)) {
+        return {};
+    }
+    auto const& mapSize = _densityMap->getMapSize();
+
+    int nextSteps[NumScanAngles] = {};  //the samples of a ray before this step are known to be below the minimum density
+    int blockLevels[NumScanAngles] = {};  //level of the last block of a ray, a good starting point for the next block
+    int angleIndices[NumScanAngles];
+    float unitVectorsX[NumScanAngles];
+    float unitVectorsY[NumScanAngles];
+    SampleSlots slots;
+    for (int step = 0; step < setup.numSteps;) {
+        int numSamples = 0;
+        for (int angleIndex = 0; angleIndex < NumScanAngles; ++angleIndex) {
+            if (nextSteps[angleIndex] == step) {
+                angleIndices[numSamples] = angleIndex;
+                unitVectorsX[numSamples] = _unitVectorsX[angleIndex];
+                unitVectorsY[numSamples] = _unitVectorsY[angleIndex];
+                ++numSamples;
+            }
+        }
+        calcSampleSlots(query.pos, setup.startRadius + RadiusStep * toFloat(step), unitVectorsX, unitVectorsY, numSamples, slots);
+
+        auto hit = false;
+        for (int i = 0; i < numSamples; ++i) {
+            auto angleIndex = angleIndices[i];
+            auto slotX = slots.x[i];
+            auto slotY = slots.y[i];
+
+            //positions in the margin not covered by slots are looked up as on the GPU
+            if (slotX >= mapSize.x || slotY >= mapSize.y) {
+                hit |= toInt(_densityMap->getDensity(slotX, slotY, setup.color)) >= setup.minDensity;
+                nextSteps[angleIndex] = step + 1;
+                continue;
+            }
+            auto level = findEmptyBlockLevel(setup.color, setup.minDensity, slotX, slotY, blockLevels[angleIndex]);
+            if (level == -1) {
+                hit = true;
+                continue;
+            }
+            blockLevels[angleIndex] = level;
+            nextSteps[angleIndex] = calcExitStep(query, setup, angleIndex, step, slots, i, level);
+        }
+        //the distance takes precedence in the lookup result, hence only the samples of the first radius with a hit compete
+        if (hit) {
+            auto lookupResult = NoLookupResult;
+            evaluateRadius(query, setup, step, lookupResult);
+            return convertToResult(lookupResult);
+        }
+        step = *std::min_element(nextSteps, nextSteps + NumScanAngles);
+    }
+    return {};
+}
+
+bool CpuSensorScanner::isRangeBelowMinDensity(CpuSensorQuery const& query, ScanSetup const& setup) const
+{
+    auto const& mapSize = _densityMap->getMapSize();
+    auto slotSize = _densityMap->getSlotSize();
+    auto maxRadius = setup.startRadius + RadiusStep * toFloat(setup.numSteps - 1) + RangeMargin;
+    auto minX = query.pos.x - maxRadius;
+    auto minY = query.pos.y - maxRadius;
+    auto maxX = query.pos.x + maxRadius;
+    auto maxY = query.pos.y + maxRadius;
+
+    //ranges crossing the world boundary or reaching the margin not covered by slots are left to the ray marching
+    if (minX < 0 || minY < 0 || maxX >= toFloat(mapSize.x * slotSize) || maxY >= toFloat(mapSize.y * slotSize)) {
+        return false;
+    }
+    auto minSlotX = toInt(minX) / slotSize;
+    auto minSlotY = toInt(minY) / slotSize;
+    auto maxSlotX = toInt(maxX) / slotSize;
+    auto maxSlotY = toInt(maxY) / slotSize;
+    int level = 0;
+    while (level + 1 < toInt(_levels.size()) && ((maxSlotX >> level) - (minSlotX >> level) > 1 || (maxSlotY >> level) - (minSlotY >> level) > 1)) {
+        ++level;
+    }
+    for (int blockY = minSlotY >> level; blockY <= maxSlotY >> level; ++blockY) {
+        for (int blockX = minSlotX >> level; blockX <= maxSlotX >> level; ++blockX) {
+            if (getMaxDensity(level, setup.color, blockX, blockY) >= setup.minDensity) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int CpuSensorScanner::findEmptyBlockLevel(int color, int minDensity, int slotX, int slotY, int startLevel) const
+{
+    auto numLevels = toInt(_levels.size());
+    auto level = std::min(startLevel, numLevels - 1);
+    while (level > 0 && getMaxDensity(level, color, slotX >> level, slotY >> level) >= minDensity) {
+        --level;
+    }
+    if (level == 0 && getMaxDensity(0, color, slotX, slotY) >= minDensity) {
+        return -1;
+    }
+    while (level + 1 < numLevels && getMaxDensity(level + 1, color, slotX >> (level + 1), slotY >> (level + 1)) < minDensity) {
+        ++level;
+    }
+    return level;
+}
+
+//the sample positions are monotonic along a ray, hence all samples up to the boundary of the block (reduced by a margin for rounding errors)
+//lie in the block; the block is taken in the uncorrected coordinates of the sample such that the ray does not wrap around inside the block
+int CpuSensorScanner::calcExitStep(CpuSensorQuery const& query, ScanSetup const& setup, int angleIndex, int step, SampleSlots const& slots, int i, int level)
+    const
+{
+    auto const& mapSize = _densityMap->getMapSize();
+    auto slotSize = _densityMap->getSlotSize();
+    auto blockMinX = toFloat((slots.x[i] >> level << level) * slotSize + slots.offsetX[i]);
+    auto blockMinY = toFloat((slots.y[i] >> level << level) * slotSize + slots.offsetY[i]);
+    auto blockMaxX = toFloat(std::min(((slots.x[i] >> level) + 1) << level, mapSize.x) * slotSize + slots.offsetX[i]);
+    auto blockMaxY = toFloat(std::min(((slots.y[i] >> level) + 1) << level, mapSize.y) * slotSize + slots.offsetY[i]);
+
+    auto unitVectorX = _unitVectorsX[angleIndex];
+    auto unitVectorY = _unitVectorsY[angleIndex];
+    auto exitRadius = std::numeric_limits<float>::max();
+    if (unitVectorX > 0) {
+        exitRadius = std::min(exitRadius, (blockMaxX - BlockMargin - query.pos.x) / unitVectorX);
+    } else if (unitVectorX < 0) {
+        exitRadius = std::min(exitRadius, (blockMinX + BlockMargin - query.pos.x) / unitVectorX);
+    }
+    if (unitVectorY > 0) {
+        exitRadius = std::min(exitRadius, (blockMaxY - BlockMargin - query.pos.y) / unitVectorY);
+    } else if (unitVectorY < 0) {
+        exitRadius = std::min(exitRadius, (blockMinY + BlockMargin - query.pos.y) / unitVectorY);
+    }
+    auto exitStep = (exitRadius - setup.startRadius) / RadiusStep;
+    if (exitStep >= toFloat(setup.numSteps)) {
+        return setup.numSteps;
+    }
+    return std::max(step + 1, toInt(std::ceil(exitStep)));
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/FundamentalConstants.h"
+
+class ThreadPool;
+
+/**
+ * Host counterpart of DensityMap with the same packed layout: each slot of slotSize x slotSize holds the number of cells per color
+ * in 8 bits per color of a 64-bit word. As on the GPU, a count exceeding 255 carries into the next color.
+ */
+class CpuDensityMap
+{
+public:
+    static int constexpr DefaultSlotSize = 8;  //as used by PreprocessedCellFunctionData
+
+    void init(IntVector2D const& worldSize, int slotSize = DefaultSlotSize);
+    void clear();
+    void addCell(RealVector2D const& pos, int color);
+
+    uint32_t getDensity(RealVector2D const& pos, int color) const;
+    uint32_t getDensity(int slotX, int slotY, int color) const;  //slot coordinates are only bounded by the index range as on the GPU
+
+    IntVector2D const& getWorldSize() const { return _worldSize; }
+    IntVector2D const& getMapSize() const { return _mapSize; }
+    int getSlotSize() const { return _slotSize; }
+    std::vector<uint64_t> const& getSlots() const { return _slots; }
+
+private:
+    IntVector2D _worldSize;
+    IntVector2D _mapSize;
+    int _slotSize = DefaultSlotSize;
+    std::vector<uint64_t> _slots;
+};
+
+struct CpuSensorQuery
+{
+    RealVector2D pos;
+    float refAngle = 0;  //angle of the signal direction, the angle of the result is relative to it
+    int cellColor = 0;
+    int scanColor = 0;
+    float minDensity = 0.05f;
+    float range = 255.0f;  //cellFunctionSensorRange of the cell color
+};
+
+//corresponds to the lookup result of SensorProcessor::searchNeighborhood, the detection of creatures is not part of the host module
+struct CpuSensorResult
+{
+    bool found = false;
+    int density = 0;  //channel 1 is density / 256
+    int distance = 0;  //channel 2 is distance / 256
+    uint8_t angleData = 0;  //channel 3 is convertDataToAngle(angleData) / 360
+
+    bool operator==(CpuSensorResult const& other) const = default;
+};
+
+using SensorScanMode = int;
+enum SensorScanMode_
+{
+    SensorScanMode_Pyramid,
+    SensorScanMode_BruteForce
+};
+
+/**
+ * Host counterpart of SensorProcessor::searchNeighborhood for many sensor queries on a CpuDensityMap.
+ * The brute-force mode looks up all NumScanAngles x radius samples as the GPU does. The pyramid mode builds a max-density pyramid per color
+ * where each level halves the resolution of the previous one. A query is discarded if the coarse blocks covering its range are below the
+ * minimum density. Otherwise the rays are marched outwards in lockstep until the first radius with a hit. When a sample lies in a block
+ * below the minimum density, the ray skips all following samples inside the coarsest such block by calculating where it leaves the block.
+ * The positions of the remaining samples of a radius are calculated in a vectorized loop.
+ * Both modes use the same sample positions and yield identical results.
+ */
+class CpuSensorScanner
+{
+public:
+    static int constexpr NumScanAngles = 32;
+    static float constexpr RadiusStep = 8.0f;
+    static float constexpr StartRadiusForSameColor = 14.0f;  //omits the cells of the own creature
+
+    CpuSensorScanner();
+
+    SensorScanMode getMode() const { return _mode; }
+    void setMode(SensorScanMode mode) { _mode = mode; }
+
+    void build(CpuDensityMap const& densityMap, ThreadPool* threadPool = nullptr);  //densityMap must outlive the queries
+
+    CpuSensorResult scan(CpuSensorQuery const& query) const;
+    void scan(std::vector<CpuSensorQuery> const& queries, std::vector<CpuSensorResult>& results, ThreadPool* threadPool = nullptr) const;
+
+    static uint8_t convertAngleToData(float angle);
+    static float convertDataToAngle(uint8_t b);
+
+private:
+    static int constexpr ChunkSize = 64;
+
+    //slots of the samples of one radius, offsets are the multiples of the world size subtracted by the position correction
+    struct SampleSlots
+    {
+        int x[NumScanAngles];
+        int y[NumScanAngles];
+        int offsetX[NumScanAngles];
+        int offsetY[NumScanAngles];
+    };
+
+    struct ScanSetup
+    {
+        int color = 0;
+        int minDensity = 0;
+        float startRadius = 0;
+        int numSteps = 0;
+    };
+
+    static void parallelFor(ThreadPool* threadPool, int numItems, std::function<void(int begin, int end)> const& func);
+
+    ScanSetup getScanSetup(CpuSensorQuery const& query) const;
+    void calcSampleSlots(RealVector2D const& pos, float radius, float const* unitVectorsX, float const* unitVectorsY, int numSamples, SampleSlots& slots)
+        const;
+    void evaluateSample(CpuSensorQuery const& query, ScanSetup const& setup, int angleIndex, int step, int slotX, int slotY, uint64_t& lookupResult) const;
+    void evaluateRadius(CpuSensorQuery const& query, ScanSetup const& setup, int step, uint64_t& lookupResult) const;
+    CpuSensorResult convertToResult(uint64_t lookupResult) const;
+
+    CpuSensorResult scan_bruteForce(CpuSensorQuery const& query) const;
+    CpuSensorResult scan_pyramid(CpuSensorQuery const& query) const;
+    bool isRangeBelowMinDensity(CpuSensorQuery const& query, ScanSetup const& setup) const;
+    int findEmptyBlockLevel(int color, int minDensity, int slotX, int slotY, int startLevel) const;  //returns -1 if the slot has enough density
+    int calcExitStep(CpuSensorQuery const& query, ScanSetup const& setup, int angleIndex, int step, SampleSlots const& slots, int i, int level) const;
+
+    uint8_t getMaxDensity(int level, int color, int blockX, int blockY) const
+    {
+        auto const& pyramidLevel = _levels[level];
+        return pyramidLevel.maxDensities[(color * pyramidLevel.size.y + blockY) * pyramidLevel.size.x + blockX];
+    }
+
+    struct Level
+    {
+        IntVector2D size;
+        std::vector<uint8_t> maxDensities;  //planes per color
+    };
+
+    SensorScanMode _mode = SensorScanMode_Pyramid;
+    CpuDensityMap const* _densityMap = nullptr;
+    std::vector<Level> _levels;
+    float _unitVectorsX[NumScanAngles];
+    float _unitVectorsY[NumScanAngles];
+};
@@ -0,0 +1,59 @@
+#include "CpuSimulationData.h"
+
+void CpuObjects::clear()
+{
+    cells.clear();
+    cellPositions.clear();
+    cellVelocities.clear();
+    cellDensities.clear();
+    cellDeleted.clear();
+    particles.clear();
+    particlePositions.clear();
+    particleVelocities.clear();
+    particleLastAbsorbedCellIds.clear();
+    particleDeleted.clear();
+    auxiliaryData.clear();
+}
+
+void CpuObjects::addCell(CellTO const& cell, RealVector2D const& pos, RealVector2D const& vel)
+{
+    cells.emplace_back(cell);
+    cellPositions.emplace_back(pos);
+    cellVelocities.emplace_back(vel);
+    cellDensities.emplace_back(1.0f);
+    cellDeleted.emplace_back(0);
+}
+
+void CpuObjects::addParticle(ParticleTO const& particle, RealVector2D const& pos, RealVector2D const& vel)
+{
+    particles.emplace_back(particle);
+    particlePositions.emplace_back(pos);
+    particleVelocities.emplace_back(vel);
+    particleLastAbsorbedCellIds.emplace_back(0);
+    particleDeleted.emplace_back(0);
+}
+
+void CpuSimulationData::commitChunkBuffers()
+{
+    for (auto& buffers : chunkBuffers) {
+        commitBuffers(buffers);
+    }
+}
+
+void CpuSimulationData::commitBuffers(CpuChunkBuffers& buffers)
+{
+    structuralOperations.insert(structuralOperations.end(), buffers.operations.begin(), buffers.operations.end());
+    buffers.operations.clear();
+
+    for (auto const& newParticle : buffers.particles) {
+        ParticleTO particle;
+        particle.id = createNewId();
+        particle.energy = newParticle.energy;
+        particle.pos = {newParticle.pos.x, newParticle.pos.y};
+        particle.vel = {newParticle.vel.x, newParticle.vel.y};
+        particle.color = newParticle.color;
+        particle.selected = 0;
+        objects.addParticle(particle, newParticle.pos, newParticle.vel);
+    }
+    buffers.particles.clear();
+}
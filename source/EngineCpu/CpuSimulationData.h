@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Base/Arena.h"
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "CpuClusterFinder.h"
+#include "CpuMap.h"
+#include "CpuNeuronEvaluator.h"
+#include "CpuSensorScanner.h"
+
+//positions and velocities are stored in separate arrays since they are accessed most frequently;
+//the transfer objects hold the remaining properties
+struct CpuObjects
+{
+    std::vector<CellTO> cells;
+    std::vector<RealVector2D> cellPositions;
+    std::vector<RealVector2D> cellVelocities;
+    std::vector<float> cellDensities;  //fluid density of the last time step, also used as pressure
+    std::vector<uint8_t> cellDeleted;
+
+    std::vector<ParticleTO> particles;
+    std::vector<RealVector2D> particlePositions;
+    std::vector<RealVector2D> particleVelocities;
+    std::vector<uint64_t> particleLastAbsorbedCellIds;  //0 = none
+    std::vector<uint8_t> particleDeleted;
+
+    std::vector<uint8_t> auxiliaryData;
+
+    int getNumCells() const { return toInt(cells.size()); }
+    int getNumParticles() const { return toInt(particles.size()); }
+
+    void clear();
+    void addCell(CellTO const& cell, RealVector2D const& pos, RealVector2D const& vel);
+    void addParticle(ParticleTO const& particle, RealVector2D const& pos, RealVector2D const& vel);
+};
+
+struct CpuStructuralOperation
+{
+    enum class Type
+    {
+        AddConnectionPair,
+        DelConnection,  //deletes the connection from cellIndex to otherCellIndex
+        DelCell
+    };
+    Type type;
+    int cellIndex;
+    int otherCellIndex;
+};
+
+struct CpuNewParticle
+{
+    RealVector2D pos;
+    RealVector2D vel;
+    int color;
+    float energy;
+};
+
+//objects and operations created during parallel processing are buffered per chunk and committed in chunk order afterwards,
+//which makes the results independent of the thread scheduling
+struct CpuChunkBuffers
+{
+    std::vector<CpuStructuralOperation> operations;
+    std::vector<CpuNewParticle> particles;
+};
+
+struct CpuParticleCollision
+{
+    int otherParticleIndex = -1;  //particle to fuse with
+    int cellIndex = -1;  //cell absorbing the particle energy
+    float radiationAbsorption = 0;
+};
+
+struct CpuSimulationData
+{
+    static int constexpr ChunkSize = 256;
+
+    uint64_t timestep = 0;
+    uint64_t randomSeed = 0;
+    SimulationParameters parameters;
+    uint64_t nextObjectId = 1;
+
+    CpuObjects objects;
+    CpuMap cellMap;
+    CpuMap particleMap;
+
+    //intermediate data per cell
+    std::vector<RealVector2D> cellForces;
+    std::vector<RealVector2D> cellPrevForces;
+    std::vector<RealVector2D> cellPosDeltas;
+    std::vector<float> cellNewDensities;
+    std::vector<RealVector2D> cellConnectionForces;  //MAX_CELL_BONDS entries per cell: angular forces acting on the connected cells
+    std::vector<RealVector2D> cellNewVelocities;
+    std::vector<LivingState> cellNewLivingStates;
+
+    CpuClusterFinder clusterFinder;
+
+    std::vector<int> cellFunctionOperations[CellFunction_Count];  //indices of the cells whose function is executed in the current time step
+    CpuNeuronEvaluator neuronEvaluator;
+    CpuDensityMap densityMap;
+    CpuSensorScanner sensorScanner;
+
+    //intermediate data per particle
+    std::vector<CpuParticleCollision> particleCollisions;
+
+    std::vector<CpuStructuralOperation> structuralOperations;
+    std::vector<CpuChunkBuffers> chunkBuffers;
+    std::unique_ptr<ThreadPool> threadPool;
+
+    Arena arena;  //temporary data of the current time step, reset at its beginning
+
+    //calls func(begin, end, chunkBuffers) for disjoint chunks of [0, numItems) in parallel
+    template <typename Func>
+    void parallelFor(int numItems, Func const& func)
+    {
+        auto numChunks = (numItems + ChunkSize - 1) / ChunkSize;
+        if (toInt(chunkBuffers.size()) < numChunks) {
+            chunkBuffers.resize(numChunks);
+        }
+        threadPool->parallelFor(numItems, ChunkSize, [&](int begin, int end) { func(begin, end, chunkBuffers[begin / ChunkSize]); });
+    }
+
+    //for phases which neither create objects nor schedule operations, they may run concurrently to phases using chunkBuffers
+    template <typename Func>
+    void parallelForWithoutBuffers(int numItems, Func const& func)
+    {
+        threadPool->parallelFor(numItems, ChunkSize, func);
+    }
+
+    //moves buffered operations to structuralOperations and creates buffered particles
+    void commitChunkBuffers();
+    void commitBuffers(CpuChunkBuffers& buffers);
+
+    uint64_t createNewId() { return nextObjectId++; }
+};
@@ -0,0 +1,412 @@
+#include "CpuSimulationFacade.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuCellConnectionProcessor.h"
+#include "CpuCellFunctionProcessor.h"
+#include "CpuCellProcessor.h"
+#include "CpuClusterProcessor.h"
+#include "CpuGarbageCollector.h"
+#include "CpuNerveProcessor.h"
+#include "CpuNeuronProcessor.h"
+#include "CpuParticleProcessor.h"
+#include "CpuSensorProcessor.h"
+
+namespace
+{
+    void shiftAuxiliaryDataIndices(CellTO& cell, uint64_t offset)
+    {
+        cell.metadata.nameDataIndex += offset;
+        cell.metadata.descriptionDataIndex += offset;
+        switch (cell.cellFunction) {
+        case CellFunction_Neuron:
+            cell.cellFunctionData.neuron.weightsAndBiasesDataIndex += offset;
+            break;
+        case CellFunction_Constructor:
+            cell.cellFunctionData.constructor.genomeDataIndex += offset;
+            break;
+        case CellFunction_Injector:
+            cell.cellFunctionData.injector.genomeDataIndex += offset;
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool isRigidityUpdateEnabled(SimulationParameters const& parameters)
+    {
+        for (int i = 0; i < parameters.numSpots; ++i) {
+            if (parameters.spots[i].values.rigidity != 0) {
+                return true;
+            }
+        }
+        return parameters.baseValues.rigidity != 0;
+    }
+}
+
+_CpuSimulationFacade::_CpuSimulationFacade(uint64_t timestep, Settings const& settings, int numThreads)
+    : _settings(settings)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    _data.threadPool = std::make_unique<ThreadPool>(numThreads - 1);
+    if (numThreads > 1) {
+        _phaseThreadPool = std::make_unique<ThreadPool>(1);  //the phase graph consists of a cell and a particle branch
+    }
+    _data.timestep = timestep;
+    _data.randomSeed = settings.generalSettings.randomSeed != 0 ? settings.generalSettings.randomSeed : std::random_device()();
+    _data.parameters = settings.simulationParameters;
+    _data.cellMap.init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+    _data.particleMap.init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+    _data.densityMap.init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+}
+
+void _CpuSimulationFacade::calcTimestep()
+{
+    calcSimulationParametersForNextTimestep();
+    prepareForNextTimestep();
+    createPhaseGraph();
+    _phaseGraph.run(_phaseThreadPool.get());
+
+    ++_data.timestep;
+}
+
+void _CpuSimulationFacade::getSimulationData(DataTO const& dataTO) const
+{
+    auto const& objects = _data.objects;
+
+    *dataTO.numCells = objects.getNumCells();
+    for (int i = 0; i < objects.getNumCells(); ++i) {
+        auto& cellTO = dataTO.cells[i];
+        cellTO = objects.cells[i];
+        cellTO.pos = {objects.cellPositions[i].x, objects.cellPositions[i].y};
+        cellTO.vel = {objects.cellVelocities[i].x, objects.cellVelocities[i].y};
+    }
+
+    *dataTO.numParticles = objects.getNumParticles();
+    for (int i = 0; i < objects.getNumParticles(); ++i) {
+        auto& particleTO = dataTO.particles[i];
+        particleTO = objects.particles[i];
+        particleTO.pos = {objects.particlePositions[i].x, objects.particlePositions[i].y};
+        particleTO.vel = {objects.particleVelocities[i].x, objects.particleVelocities[i].y};
+    }
+
+    *dataTO.numAuxiliaryData = objects.auxiliaryData.size();
+    if (!objects.auxiliaryData.empty()) {
+        std::memcpy(dataTO.auxiliaryData, objects.auxiliaryData.data(), objects.auxiliaryData.size());
+    }
+}
+
+void _CpuSimulationFacade::addAndSelectSimulationData(DataTO const& dataTO)
+{
+    for (auto& cell : _data.objects.cells) {
+        cell.selected = 0;
+    }
+    for (auto& particle : _data.objects.particles) {
+        particle.selected = 0;
+    }
+    addData(dataTO, true, true);
+}
+
+void _CpuSimulationFacade::setSimulationData(DataTO const& dataTO)
+{
+    clear();
+    addData(dataTO, false, false);
+}
+
+void _CpuSimulationFacade::clear()
+{
+    _data.objects.clear();
+    _data.structuralOperations.clear();
+}
+
+ArraySizes _CpuSimulationFacade::getArraySizes() const
+{
+    auto const& objects = _data.objects;
+    return {
+        static_cast<uint64_t>(objects.getNumCells()), static_cast<uint64_t>(objects.getNumParticles()), static_cast<uint64_t>(objects.auxiliaryData.size())};
+}
+
+SimulationParameters _CpuSimulationFacade::getSimulationParameters() const
+{
+    return _settings.simulationParameters;
+}
+
+void _CpuSimulationFacade::setSimulationParameters(SimulationParameters const& parameters)
+{
+    _settings.simulationParameters = parameters;
+
+    //the densities of the last time step are not meaningful for changed fluid parameters
+    std::fill(_data.objects.cellDensities.begin(), _data.objects.cellDensities.end(), 1.0f);
+}
+
+StatisticsData _CpuSimulationFacade::getStatistics() const
+{
+    auto const& objects = _data.objects;
+
+    StatisticsData result;
+    auto& timestepStatistics = result.timeline.timestep;
+    for (auto const& cell : objects.cells) {
+        ++timestepStatistics.numCells[cell.color];
+        timestepStatistics.numConnections[cell.color] += cell.numConnections;
+        timestepStatistics.totalEnergy[cell.color] += cell.energy;
+    }
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        timestepStatistics.numConnections[i] /= 2;
+    }
+    for (auto const& particle : objects.particles) {
+        ++timestepStatistics.numParticles[particle.color];
+        timestepStatistics.totalEnergy[particle.color] += particle.energy;
+    }
+
+    auto& histogram = result.histogram;
+    for (int color = 0; color < MAX_COLORS; ++color) {
+        std::fill(std::begin(histogram.numCellsByColorBySlot[color]), std::end(histogram.numCellsByColorBySlot[color]), 0);
+    }
+    histogram.maxValue = 0;
+    for (auto const& cell : objects.cells) {
+        if (!cell.barrier) {
+            histogram.maxValue = std::max(histogram.maxValue, cell.age);
+        }
+    }
+    for (auto const& cell : objects.cells) {
+        if (!cell.barrier) {
+            ++histogram.numCellsByColorBySlot[cell.color][cell.age * MAX_HISTOGRAM_SLOTS / (histogram.maxValue + 1)];
+        }
+    }
+    return result;
+}
+
+uint64_t _CpuSimulationFacade::getCurrentTimestep() const
+{
+    return _data.timestep;
+}
+
+void _CpuSimulationFacade::setCurrentTimestep(uint64_t timestep)
+{
+    _data.timestep = timestep;
+}
+
+int _CpuSimulationFacade::getNumThreads() const
+{
+    return _data.threadPool->getNumThreads() + 1;
+}
+
+void _CpuSimulationFacade::setPhaseTracingEnabled(bool value)
+{
+    _phaseGraph.setTracingEnabled(value);
+}
+
+void _CpuSimulationFacade::writePhaseTrace(std::ostream& stream) const
+{
+    _phaseGraph.writeTrace(stream);
+}
+
+void _CpuSimulationFacade::writePhaseGraph(std::ostream& stream) const
+{
+    _phaseGraph.writeDot(stream);
+}
+
+void _CpuSimulationFacade::addData(DataTO const& dataTO, bool selectData, bool createIds)
+{
+    auto& objects = _data.objects;
+
+    auto auxiliaryDataOffset = objects.auxiliaryData.size();
+    objects.auxiliaryData.insert(objects.auxiliaryData.end(), dataTO.auxiliaryData, dataTO.auxiliaryData + *dataTO.numAuxiliaryData);
+
+    auto cellIndexOffset = objects.getNumCells();
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto cell = dataTO.cells[i];
+        shiftAuxiliaryDataIndices(cell, auxiliaryDataOffset);
+        for (int j = 0; j < cell.numConnections; ++j) {
+            cell.connections[j].cellIndex += cellIndexOffset;
+        }
+        if (createIds) {
+            cell.id = _data.createNewId();
+        } else {
+            _data.nextObjectId = std::max(_data.nextObjectId, cell.id + 1);
+        }
+        cell.selected = selectData ? 1 : 0;
+        RealVector2D pos{cell.pos.x, cell.pos.y};
+        _data.cellMap.correctPosition(pos);
+        objects.addCell(cell, pos, {cell.vel.x, cell.vel.y});
+    }
+
+    for (uint64_t i = 0; i < *dataTO.numParticles; ++i) {
+        auto particle = dataTO.particles[i];
+        if (createIds) {
+            particle.id = _data.createNewId();
+        } else {
+            _data.nextObjectId = std::max(_data.nextObjectId, particle.id + 1);
+        }
+        particle.selected = selectData ? 1 : 0;
+        RealVector2D pos{particle.pos.x, particle.pos.y};
+        _data.particleMap.correctPosition(pos);
+        objects.addParticle(particle, pos, {particle.vel.x, particle.vel.y});
+    }
+
+    _data.arena.reset();
+    CpuGarbageCollector::cleanupAfterDataManipulation(objects, _data.arena);
+}
+
+void _CpuSimulationFacade::calcSimulationParametersForNextTimestep()
+{
+    auto& parameters = _settings.simulationParameters;
+    SpaceCalculator space({_settings.generalSettings.worldSizeX, _settings.generalSettings.worldSizeY});
+    for (int i = 0; i < parameters.numParticleSources; ++i) {
+        auto& source = parameters.particleSources[i];
+        source.posX += source.velX * parameters.timestepSize;
+        source.posY += source.velY * parameters.timestepSize;
+        auto correctedPosition = space.getCorrectedPosition({source.posX, source.posY});
+        source.posX = correctedPosition.x;
+        source.posY = correctedPosition.y;
+    }
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        auto& spot = parameters.spots[i];
+        spot.posX += spot.velX * parameters.timestepSize;
+        spot.posY += spot.velY * parameters.timestepSize;
+        auto correctedPosition = space.getCorrectedPosition({spot.posX, spot.posY});
+        spot.posX = correctedPosition.x;
+        spot.posY = correctedPosition.y;
+    }
+    _data.parameters = parameters;
+}
+
+void _CpuSimulationFacade::prepareForNextTimestep()
+{
+    auto numCells = static_cast<size_t>(_data.objects.getNumCells());
+    _data.cellForces.assign(numCells, {0, 0});
+    _data.cellPrevForces.assign(numCells, {0, 0});
+    _data.cellPosDeltas.assign(numCells, {0, 0});
+    _data.cellNewDensities.resize(numCells);
+    _data.cellConnectionForces.resize(numCells * MAX_CELL_BONDS);
+    _data.cellNewVelocities.resize(numCells);
+    _data.cellNewLivingStates.resize(numCells);
+    _data.arena.reset();
+}
+
+//resources of the declared accesses: "cells" (including cellDeleted and cellDensities), "cellPositions", "cellVelocities", "cellIntermediates" (intermediate data per cell),
+//"particles" (all particle data except the positions), "particlePositions", "cellMap", "particleMap", "structuralOperations", "objectIds",
+//"auxiliaryData", "clusters", "cellFunctionOperations", "densityMap" and "chunkBuffers" which is written by all phases using CpuSimulationData::parallelFor
+void _CpuSimulationFacade::createPhaseGraph()
+{
+    auto& data = _data;
+    auto& graph = _phaseGraph;
+    graph.clear();
+
+    auto considerForcesFromAngleDifferences = (data.timestep % 3 == 0);
+    auto considerInnerFriction = (data.timestep % 3 == 0);
+    auto considerRigidityUpdate = (data.timestep % 3 == 0);
+
+    auto addCommit = [&](std::string const& name, bool withNewParticles) {
+        std::vector<std::string> writes{"chunkBuffers", "structuralOperations"};
+        if (withNewParticles) {
+            writes.insert(writes.end(), {"particles", "particlePositions", "objectIds"});
+        }
+        graph.addTask(name, {}, writes, [&data] { data.commitChunkBuffers(); });
+    };
+
+    //physics
+    graph.addTask("cellUpdateMap", {"cells", "cellPositions"}, {"cellMap"}, [&data] { CpuCellProcessor::updateMap(data); });
+    graph.addTask("radiation", {"cellPositions", "cellVelocities", "cellMap"}, {"cells", "chunkBuffers"}, [&data] { CpuCellProcessor::radiation(data); });
+    addCommit("commitRadiation", true);
+
+    if (data.parameters.motionType == MotionType_Fluid) {
+        graph.addTask("calcFluidForces_correctOverlap", {"cellVelocities", "cellMap"}, {"cells", "cellPositions", "cellIntermediates", "chunkBuffers"}, [&data] {
+            CpuCellProcessor::calcFluidForces_correctOverlap(data);
+        });
+    } else {
+        graph.addTask("calcCollisions_correctOverlap", {"cells", "cellVelocities", "cellMap"}, {"cellPositions", "cellIntermediates", "chunkBuffers"}, [&data] {
+            CpuCellProcessor::calcCollisions_correctOverlap(data);
+        });
+    }
+    addCommit("commitCollisions", false);
+    graph.addTask("fillDensityMap", {"cells", "cellPositions"}, {"densityMap"}, [&data] { CpuSensorProcessor::fillDensityMap(data); });
+    graph.addTask("particleUpdateMap", {"particles", "particlePositions"}, {"particleMap"}, [&data] { CpuParticleProcessor::updateMap(data); });
+    if (data.parameters.numSpots > 0) {
+        graph.addTask("applyFlowFields", {"cells", "cellPositions", "cellMap"}, {"cellIntermediates", "chunkBuffers"}, [&data] {
+            CpuCellProcessor::applyFlowFields(data);
+        });
+    }
+
+    graph.addTask("checkForces", {"cells", "cellPositions", "cellIntermediates", "cellMap"}, {"chunkBuffers"}, [&data] {
+        CpuCellProcessor::checkForces(data);
+    });
+    addCommit("commitForces", false);
+    graph.addTask("applyForces", {"cells"}, {"cellVelocities", "cellIntermediates", "chunkBuffers"}, [&data] { CpuCellProcessor::applyForces(data); });
+    graph.addTask("particleMovement", {"particles", "particleMap"}, {"particlePositions"}, [&data] { CpuParticleProcessor::movement(data); });
+    graph.addTask("particleCollision", {"particlePositions", "particleMap", "cellPositions", "cellVelocities", "cellMap"}, {"particles", "cells"}, [&data] {
+        CpuParticleProcessor::collision(data);
+    });
+
+    auto addCalcConnectionForces = [&](std::string const& name) {
+        graph.addTask(name, {"cells", "cellPositions", "cellMap"}, {"cellIntermediates", "chunkBuffers"}, [&data, considerForcesFromAngleDifferences] {
+            CpuCellProcessor::calcConnectionForces(data, considerForcesFromAngleDifferences);
+        });
+    };
+    addCalcConnectionForces("calcConnectionForces");
+    graph.addTask("verletPositionUpdate", {"cells", "cellVelocities", "cellMap"}, {"cellPositions", "cellIntermediates", "chunkBuffers"}, [&data] {
+        CpuCellProcessor::verletPositionUpdate(data);
+    });
+    graph.addTask("checkConnections", {"cellPositions", "cellMap"}, {"cells", "chunkBuffers"}, [&data] { CpuCellProcessor::checkConnections(data); });
+    addCommit("commitConnections", false);
+    addCalcConnectionForces("calcConnectionForces2");
+    graph.addTask("verletVelocityUpdate", {"cells", "cellIntermediates"}, {"cellVelocities", "chunkBuffers"}, [&data] {
+        CpuCellProcessor::verletVelocityUpdate(data);
+    });
+
+    //cell functions
+    graph.addTask("aging", {"cellPositions", "cellMap"}, {"cells", "chunkBuffers"}, [&data] { CpuCellProcessor::aging(data); });
+    graph.addTask("livingStateTransition", {"auxiliaryData"}, {"cells", "cellIntermediates", "chunkBuffers"}, [&data] {
+        CpuCellProcessor::livingStateTransition(data);
+    });
+    graph.addTask("collectCellFunctionOperations", {"cells"}, {"cellFunctionOperations"}, [&data] {
+        CpuCellFunctionProcessor::collectCellFunctionOperations(data);
+    });
+    graph.addTask("nerve", {"cellFunctionOperations"}, {"cells"}, [&data] { CpuNerveProcessor::process(data); });
+    graph.addTask("neuron", {"cellFunctionOperations", "auxiliaryData"}, {"cells"}, [&data] { CpuNeuronProcessor::process(data); });
+    graph.addTask("sensor", {"cellFunctionOperations", "cellPositions", "cellMap", "densityMap"}, {"cells"}, [&data] {
+        CpuSensorProcessor::process(data);
+    });
+    graph.addTask("resetFetchedActivities", {}, {"cells"}, [&data] { CpuCellFunctionProcessor::resetFetchedActivities(data); });
+
+    //physics
+    if (considerInnerFriction) {
+        graph.addTask("applyInnerFriction", {"cells"}, {"cellVelocities", "cellIntermediates", "chunkBuffers"}, [&data] {
+            CpuCellProcessor::applyInnerFriction(data);
+        });
+    }
+    graph.addTask("applyFriction", {"cells", "cellPositions", "cellMap"}, {"cellVelocities", "chunkBuffers"}, [&data] {
+        CpuCellProcessor::applyFriction(data);
+    });
+    graph.addTask("decay", {"cellPositions", "cellMap"}, {"cells", "chunkBuffers"}, [&data] { CpuCellProcessor::decay(data); });
+    addCommit("commitDecay", false);
+
+    if (considerRigidityUpdate && isRigidityUpdateEnabled(data.parameters)) {
+        graph.addTask("rigidity", {"cells", "cellPositions", "cellMap"}, {"cellVelocities", "clusters", "chunkBuffers"}, [&data] {
+            CpuClusterProcessor::findClusters(data);
+            CpuClusterProcessor::applyClusterData(data);
+        });
+    }
+
+    //structural operations
+    graph.addTask(
+        "processOperations",
+        {"cellPositions", "cellVelocities", "cellMap", "auxiliaryData"},
+        {"cells", "structuralOperations", "chunkBuffers", "particles", "particlePositions", "objectIds"},
+        [&data] { CpuCellConnectionProcessor::processOperations(data); });
+    graph.addTask("particleTransformation", {}, {"particles", "particlePositions", "cells", "cellPositions", "cellVelocities", "objectIds"}, [&data] {
+        CpuParticleProcessor::transformation(data);
+    });
+    graph.addTask("garbageCollection", {}, {"cells", "cellPositions", "cellVelocities", "particles", "particlePositions", "auxiliaryData"}, [&data] {
+        CpuGarbageCollector::cleanupAfterTimestep(data.objects, data.arena);
+    });
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+
+#include "Base/TaskGraph.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/StatisticsData.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Multithreaded host counterpart of _CudaSimulationFacade. It covers the physics, particle and structural operation phases
+ * of a time step including cluster finding for the rigidity. Of the cell functions, only nerves, neurons and sensors are executed.
+ * Results do not depend on the number of threads.
+ * The phases of a time step form a task graph, e.g. particle phases run concurrently to independent cell phases.
+ * The facade is not thread-safe, calls must be synchronized by the caller.
+ */
+class _CpuSimulationFacade
+{
+public:
+    _CpuSimulationFacade(uint64_t timestep, Settings const& settings, int numThreads);  //numThreads = 0: number of hardware threads
+
+    void calcTimestep();
+
+    //auxiliary data indices of the given transfer objects refer to its auxiliary data
+    void getSimulationData(DataTO const& dataTO) const;  //prerequisite: dataTO has been allocated for getArraySizes()
+    void addAndSelectSimulationData(DataTO const& dataTO);
+    void setSimulationData(DataTO const& dataTO);
+    void clear();
+
+    ArraySizes getArraySizes() const;
+
+    SimulationParameters getSimulationParameters() const;
+    void setSimulationParameters(SimulationParameters const& parameters);
+
+    StatisticsData getStatistics() const;
+    uint64_t getCurrentTimestep() const;
+    void setCurrentTimestep(uint64_t timestep);
+
+    int getNumThreads() const;  //including the calling thread
+
+    //trace of the phases of the last time step
+    void setPhaseTracingEnabled(bool value);
+    void writePhaseTrace(std::ostream& stream) const;  //Chrome trace event format
+    void writePhaseGraph(std::ostream& stream) const;  //Graphviz format
+
+private:
+    void addData(DataTO const& dataTO, bool selectData, bool createIds);
+    void calcSimulationParametersForNextTimestep();
+    void prepareForNextTimestep();
+    void createPhaseGraph();
+
+    Settings _settings;
+    CpuSimulationData _data;
+
+    TaskGraph _phaseGraph;
+    std::unique_ptr<ThreadPool> _phaseThreadPool;  //runs phases concurrently, each phase parallelizes its work on _data.threadPool
+};
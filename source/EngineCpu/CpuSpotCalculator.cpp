@@ -0,0 +1,130 @@
+#include "CpuSpotCalculator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+float CpuSpotCalculator::calcParameter(
+    float SimulationParametersSpotValues::*value,
+    bool SimulationParametersSpotActivatedValues::*valueActivated,
+    CpuSimulationData const& data,
+    RealVector2D const& worldPos)
+{
+    auto const& parameters = data.parameters;
+    float spotValues[MAX_SPOTS];
+    int numValues = 0;
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        if (parameters.spots[i].activatedValues.*valueActivated) {
+            spotValues[numValues++] = parameters.spots[i].values.*value;
+        }
+    }
+    return calcResultingValue(data, worldPos, parameters.baseValues.*value, spotValues, valueActivated);
+}
+
+float CpuSpotCalculator::calcParameter(
+    ColorVector<float> SimulationParametersSpotValues::*value,
+    bool SimulationParametersSpotActivatedValues::*valueActivated,
+    CpuSimulationData const& data,
+    RealVector2D const& worldPos,
+    int color)
+{
+    auto const& parameters = data.parameters;
+    float spotValues[MAX_SPOTS];
+    int numValues = 0;
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        if (parameters.spots[i].activatedValues.*valueActivated) {
+            spotValues[numValues++] = (parameters.spots[i].values.*value)[color];
+        }
+    }
+    return calcResultingValue(data, worldPos, (parameters.baseValues.*value)[color], spotValues, valueActivated);
+}
+
+RealVector2D
+CpuSpotCalculator::calcResultingFlowField(CpuSimulationData const& data, RealVector2D const& worldPos, RealVector2D const (&accelerations)[MAX_SPOTS])
+{
+    auto const& parameters = data.parameters;
+    float spotWeights[MAX_SPOTS];
+    int numValues = 0;
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        if (parameters.spots[i].flowType != FlowType_None) {
+            RealVector2D spotPos{parameters.spots[i].posX, parameters.spots[i].posY};
+            spotWeights[numValues++] = calcWeight(data, data.cellMap.getCorrectedDirection(spotPos - worldPos), i);
+        }
+    }
+    return mix(RealVector2D{0, 0}, accelerations, spotWeights, numValues);
+}
+
+int CpuSpotCalculator::getFirstMatchingSpotOrBase(
+    CpuSimulationData const& data,
+    RealVector2D const& worldPos,
+    bool SimulationParametersSpotActivatedValues::*valueActivated)
+{
+    auto const& parameters = data.parameters;
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        if (parameters.spots[i].activatedValues.*valueActivated) {
+            RealVector2D spotPos{parameters.spots[i].posX, parameters.spots[i].posY};
+            if (calcWeight(data, data.cellMap.getCorrectedDirection(spotPos - worldPos), i) < NEAR_ZERO) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+template <typename T>
+T CpuSpotCalculator::calcResultingValue(
+    CpuSimulationData const& data,
+    RealVector2D const& worldPos,
+    T const& baseValue,
+    T const (&spotValues)[MAX_SPOTS],
+    bool SimulationParametersSpotActivatedValues::*valueActivated)
+{
+    auto const& parameters = data.parameters;
+    if (0 == parameters.numSpots) {
+        return baseValue;
+    }
+    float spotWeights[MAX_SPOTS];
+    int numValues = 0;
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        if (parameters.spots[i].activatedValues.*valueActivated) {
+            RealVector2D spotPos{parameters.spots[i].posX, parameters.spots[i].posY};
+            spotWeights[numValues++] = calcWeight(data, data.cellMap.getCorrectedDirection(spotPos - worldPos), i);
+        }
+    }
+    return mix(baseValue, spotValues, spotWeights, numValues);
+}
+
+float CpuSpotCalculator::calcWeight(CpuSimulationData const& data, RealVector2D const& delta, int spotIndex)
+{
+    auto const& spot = data.parameters.spots[spotIndex];
+    if (spot.shapeType == SpotShapeType_Rectangular) {
+        auto const& rectangle = spot.shapeData.rectangularSpot;
+        if (std::abs(delta.x) > rectangle.width / 2 || std::abs(delta.y) > rectangle.height / 2) {
+            RealVector2D distanceFromRect{std::max(0.0f, std::abs(delta.x) - rectangle.width / 2), std::max(0.0f, std::abs(delta.y) - rectangle.height / 2)};
+            return std::min(1.0f, Math::length(distanceFromRect) / (spot.fadeoutRadius + 1));
+        }
+        return 0;
+    } else {
+        auto distance = Math::length(delta);
+        auto coreRadius = spot.shapeData.circularSpot.coreRadius;
+        return distance < coreRadius ? 0.0f : std::min(1.0f, (distance - coreRadius) / (spot.fadeoutRadius + 1));
+    }
+}
+
+template <typename T>
+T CpuSpotCalculator::mix(T const& baseValue, T const (&spotValues)[MAX_SPOTS], float const (&spotWeights)[MAX_SPOTS], int numValues)
+{
+    float baseFactor = 1;
+    float sum = 0;
+    for (int i = 0; i < numValues; ++i) {
+        baseFactor *= spotWeights[i];
+        sum += 1.0f - spotWeights[i];
+    }
+    sum += baseFactor;
+    T result = baseValue * baseFactor;
+    for (int i = 0; i < numValues; ++i) {
+        result += spotValues[i] * (1.0f - spotWeights[i]) / sum;
+    }
+    return result;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+
+//host counterpart of SpotCalculator: mixes base values and spot values depending on the distance to the spots
+class CpuSpotCalculator
+{
+public:
+    static float calcParameter(
+        float SimulationParametersSpotValues::*value,
+        bool SimulationParametersSpotActivatedValues::*valueActivated,
+        CpuSimulationData const& data,
+        RealVector2D const& worldPos);
+    static float calcParameter(
+        ColorVector<float> SimulationParametersSpotValues::*value,
+        bool SimulationParametersSpotActivatedValues::*valueActivated,
+        CpuSimulationData const& data,
+        RealVector2D const& worldPos,
+        int color);
+
+    static RealVector2D calcResultingFlowField(CpuSimulationData const& data, RealVector2D const& worldPos, RealVector2D const (&accelerations)[MAX_SPOTS]);
+
+    //returns -1 for base
+    static int getFirstMatchingSpotOrBase(
+        CpuSimulationData const& data,
+        RealVector2D const& worldPos,
+        bool SimulationParametersSpotActivatedValues::*valueActivated);
+
+private:
+    template <typename T>
+    static T calcResultingValue(
+        CpuSimulationData const& data,
+        RealVector2D const& worldPos,
+        T const& baseValue,
+        T const (&spotValues)[MAX_SPOTS],
+        bool SimulationParametersSpotActivatedValues::*valueActivated);
+
+    static float calcWeight(CpuSimulationData const& data, RealVector2D const& delta, int spotIndex);
+
+    template <typename T>
+    static T mix(T const& baseValue, T const (&spotValues)[MAX_SPOTS], float const (&spotWeights)[MAX_SPOTS], int numValues);
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <memory>
+
+class _CpuSimulationFacade;
+using CpuSimulationFacade = std::shared_ptr<_CpuSimulationFacade>;
+
+struct CpuSimulationData;
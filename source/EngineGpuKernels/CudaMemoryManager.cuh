@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 
 #include <cuda/helper_cuda.h>
 
@@ -21,14 +23,18 @@ public:
 
     void reset()
     {
+        std::lock_guard lock(_mutex);
         _bytes = 0;
+        _peakBytes = 0;
     }
 
     template<typename T>
     void acquireMemory(uint64_t arraySize, T*& result)
     {
+        std::lock_guard lock(_mutex);
         CHECK_FOR_CUDA_ERROR(cudaMalloc(&result, sizeof(T)*arraySize));
         _bytes += sizeof(T)*arraySize;
+        _peakBytes = std::max(_peakBytes, _bytes);
         _pointerToSizeMap.emplace(reinterpret_cast<void*>(result), arraySize);
     }
 
@@ -38,6 +44,7 @@ public:
         if (!memory) {
             return;
         }
+        std::lock_guard lock(_mutex);
         auto findResult = _pointerToSizeMap.find(reinterpret_cast<void*>(memory));
         if (findResult != _pointerToSizeMap.end()) {
             cudaFree(memory);
@@ -48,13 +55,22 @@ public:
 
     uint64_t getSizeOfAcquiredMemory() const
     {
+        std::lock_guard lock(_mutex);
         return _bytes;
     }
 
+    uint64_t getPeakSizeOfAcquiredMemory() const
+    {
+        std::lock_guard lock(_mutex);
+        return _peakBytes;
+    }
+
 private:
     CudaMemoryManager() {}
     ~CudaMemoryManager() {}
 
+    mutable std::mutex _mutex;  //rendering from a snapshot may allocate memory concurrently to the worker thread
     uint64_t _bytes = 0;
+    uint64_t _peakBytes = 0;  //since the last reset
     std::map<void*, uint64_t> _pointerToSizeMap;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <random>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -23,7 +24,8 @@ private:
     unsigned int* _currentSmallId;
 
 public:
-    void init(int size)
+    //the random numbers are reproducible for a given 'seed' except for 0
+    void init(int size, uint32_t seed)
     {
         _size = size;
 
@@ -39,8 +41,17 @@ public:
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_currentSmallId, &hostCurrentSmallId, sizeof(unsigned int), cudaMemcpyHostToDevice));
 
         std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
+        if (seed != 0) {
+            std::seed_seq seedSequence{seed, static_cast<uint32_t>(size)};
+            std::mt19937 generator(seedSequence);
+            std::uniform_int_distribution<int> distribution(0, RAND_MAX);
+            for (int i = 0; i < size; ++i) {
+                randomNumbers[i] = distribution(generator);
+            }
+        } else {
+            for (int i = 0; i < size; ++i) {
+                randomNumbers[i] = rand();
+            }
         }
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
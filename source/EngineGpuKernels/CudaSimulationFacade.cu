@@ -39,6 +39,7 @@
 #include "SelectionResult.cuh"
 #include "RenderingData.cuh"
 #include "TestKernelsLauncher.cuh"
+#include "KernelProfiler.cuh"
 
 _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const& settings)
 {
@@ -57,12 +58,17 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     _cudaAccessTO = std::make_shared<DataTO>();
     _simulationStatistics = std::make_shared<SimulationStatistics>();
 
-    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep);
+    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep, settings.generalSettings.randomSeed);
     _cudaRenderingData->init();
+    for (int i = 0; i < SnapshotExchange<RenderSnapshot>::NumSlots; ++i) {
+        _renderSnapshots.getSlot(i).init();
+    }
+    CHECK_FOR_CUDA_ERROR(cudaStreamCreateWithFlags(&_renderingStream, cudaStreamNonBlocking));
     _simulationStatistics->init();
     _cudaSelectionResult->init();
 
-    _simulationKernels = std::make_shared<_SimulationKernelsLauncher>();
+    _profiler = std::make_shared<_KernelProfiler>();
+    _simulationKernels = std::make_shared<_SimulationKernelsLauncher>(_profiler);
     _dataAccessKernels = std::make_shared<_DataAccessKernelsLauncher>();
     _garbageCollectorKernels = std::make_shared<_GarbageCollectorKernelsLauncher>();
     _renderingKernels = std::make_shared<_RenderingKernelsLauncher>();
@@ -81,6 +87,10 @@ _CudaSimulationFacade::~_CudaSimulationFacade()
 {
     _cudaSimulationData->free();
     _cudaRenderingData->free();
+    for (int i = 0; i < SnapshotExchange<RenderSnapshot>::NumSlots; ++i) {
+        _renderSnapshots.getSlot(i).free();
+    }
+    cudaStreamDestroy(_renderingStream);
     _simulationStatistics->free();
     _cudaSelectionResult->free();
 
@@ -149,6 +159,7 @@ void _CudaSimulationFacade::drawVectorGraphics(
 {
     checkAndProcessSimulationParameterChanges();
 
+    KernelProfilerScope scope(_profiler, "Rendering");
     auto cudaResourceImpl = reinterpret_cast<cudaGraphicsResource*>(cudaResource);
     CHECK_FOR_CUDA_ERROR(cudaGraphicsMapResources(1, &cudaResourceImpl));
 
@@ -175,11 +186,74 @@ void _CudaSimulationFacade::drawVectorGraphics(
     CHECK_FOR_CUDA_ERROR(cudaGraphicsUnmapResources(1, &cudaResourceImpl));
 }
 
+bool _CudaSimulationFacade::isRenderSnapshotRequired() const
+{
+    return _renderSnapshots.isNextSnapshotRequired();
+}
+
+bool _CudaSimulationFacade::publishRenderSnapshot()
+{
+    auto slot = _renderSnapshots.beginWrite();
+    if (!slot) {
+        return false;
+    }
+    KernelProfilerScope scope(_profiler, "Render snapshot");
+    auto data = getSimulationDataIntern();
+    auto& snapshot = _renderSnapshots.getSlot(*slot);
+    snapshot.resizeIfNecessary(data.objects.cellPointers.getNumEntries_host(), data.objects.particlePointers.getNumEntries_host());
+    snapshot.worldSize = data.worldSize;
+    snapshot.timestep = data.timestep;
+    snapshot.gpuSettings = _settings.gpuSettings;
+
+    _renderingKernels->createSnapshot(_settings.gpuSettings, data, snapshot);
+    syncAndCheck();
+
+    _renderSnapshots.endWrite(*slot);
+    return true;
+}
+
+bool _CudaSimulationFacade::tryDrawVectorGraphicsFromRenderSnapshot(
+    float2 const& rectUpperLeft,
+    float2 const& rectLowerRight,
+    void* cudaResource,
+    int2 const& imageSize,
+    double zoom)
+{
+    auto slot = _renderSnapshots.beginRead();
+    if (!slot) {
+        return false;
+    }
+    auto const& snapshot = _renderSnapshots.getSlot(*slot);
+
+    auto cudaResourceImpl = reinterpret_cast<cudaGraphicsResource*>(cudaResource);
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsMapResources(1, &cudaResourceImpl, _renderingStream));
+
+    cudaArray* mappedArray;
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsSubResourceGetMappedArray(&mappedArray, cudaResourceImpl, 0, 0));
+
+    _cudaRenderingData->resizeImageIfNecessary(imageSize);
+
+    _renderingKernels->drawImageFromSnapshot(
+        snapshot.gpuSettings, _renderingStream, rectUpperLeft, rectLowerRight, imageSize, static_cast<float>(zoom), snapshot, *_cudaRenderingData);
+
+    const size_t widthBytes = sizeof(uint64_t) * imageSize.x;
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy2DToArrayAsync(
+        mappedArray, 0, 0, _cudaRenderingData->imageData, widthBytes, widthBytes, imageSize.y, cudaMemcpyDeviceToDevice, _renderingStream));
+
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsUnmapResources(1, &cudaResourceImpl, _renderingStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_renderingStream));
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    _renderSnapshots.endRead(*slot);
+    return true;
+}
+
 void _CudaSimulationFacade::getSimulationData(
     int2 const& rectUpperLeft,
     int2 const& rectLowerRight,
     DataTO const& dataTO)
 {
+    KernelProfilerScope scope(_profiler, "Data access");
     _dataAccessKernels->getData(_settings.gpuSettings, getSimulationDataIntern(), rectUpperLeft, rectLowerRight, *_cudaAccessTO);
     syncAndCheck();
 
@@ -188,6 +262,7 @@ void _CudaSimulationFacade::getSimulationData(
 
 void _CudaSimulationFacade::getSelectedSimulationData(bool includeClusters, DataTO const& dataTO)
 {
+    KernelProfilerScope scope(_profiler, "Data access");
     _dataAccessKernels->getSelectedData(_settings.gpuSettings, getSimulationDataIntern(), includeClusters, *_cudaAccessTO);
     syncAndCheck();
 
@@ -206,6 +281,8 @@ void _CudaSimulationFacade::getInspectedSimulationData(std::vector<uint64_t> ent
     if (entityIds.size() < Const::MaxInspectedObjects) {
         ids.values[entityIds.size()] = 0;
     }
+
+    KernelProfilerScope scope(_profiler, "Data access");
     _dataAccessKernels->getInspectedData(_settings.gpuSettings, getSimulationDataIntern(), ids, *_cudaAccessTO);
     syncAndCheck();
     copyDataTOtoHost(dataTO);
@@ -213,6 +290,7 @@ void _CudaSimulationFacade::getInspectedSimulationData(std::vector<uint64_t> ent
 
 void _CudaSimulationFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
 {
+    KernelProfilerScope scope(_profiler, "Data access");
     _dataAccessKernels->getOverlayData(_settings.gpuSettings, getSimulationDataIntern(), rectUpperLeft, rectLowerRight, *_cudaAccessTO);
     syncAndCheck();
 
@@ -357,6 +435,16 @@ void _CudaSimulationFacade::setGpuConstants(GpuSettings const& gpuConstants)
         cudaMemcpyToSymbol(cudaThreadSettings, &gpuConstants, sizeof(GpuSettings), 0, cudaMemcpyHostToDevice));
 }
 
+void _CudaSimulationFacade::setProfilingEnabled(bool value)
+{
+    _profiler->setEnabled(value);
+}
+
+std::vector<ProfilingScopeDuration> _CudaSimulationFacade::fetchProfilingScopeDurations()
+{
+    return _profiler->fetchScopeDurations();
+}
+
 SimulationParameters _CudaSimulationFacade::getSimulationParameters() const
 {
     std::lock_guard lock(_mutexForSimulationParameters);
@@ -378,6 +466,21 @@ auto _CudaSimulationFacade::getArraySizes() const -> ArraySizes
     };
 }
 
+uint64_t _CudaSimulationFacade::getDeviceMemory() const
+{
+    return CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
+}
+
+uint64_t _CudaSimulationFacade::getPeakDeviceMemory() const
+{
+    return CudaMemoryManager::getInstance().getPeakSizeOfAcquiredMemory();
+}
+
+int _CudaSimulationFacade::getNumArrayResizes() const
+{
+    return _numArrayResizes;
+}
+
 StatisticsData _CudaSimulationFacade::getStatistics()
 {
     _statisticsKernels->updateStatistics(_settings.gpuSettings, getSimulationDataIntern(), *_simulationStatistics);
@@ -497,7 +600,8 @@ auto _CudaSimulationFacade::checkAndReturnGpuInfo() -> GpuInfo
 
 void _CudaSimulationFacade::syncAndCheck()
 {
-    cudaDeviceSynchronize();
+    //the rendering stream is not synchronized since drawing from render snapshots runs concurrently
+    cudaStreamSynchronize(0);
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 }
 
@@ -539,6 +643,7 @@ void _CudaSimulationFacade::automaticResizeArrays()
 void _CudaSimulationFacade::resizeArrays(ArraySizes const& additionals)
 {
     log(Priority::Important, "resize arrays");
+    ++_numArrayResizes;
 
     _cudaSimulationData->resizeTargetObjects(additionals);
     if (!_cudaSimulationData->isEmpty()) {
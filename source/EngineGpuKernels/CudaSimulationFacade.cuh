@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <vector>
@@ -10,8 +11,11 @@
 #endif
 
 #include <vector_types.h>
+#include <driver_types.h>
 #include <GL/gl.h>
 
+#include "Base/SnapshotExchange.h"
+#include "EngineInterface/ProfilingData.h"
 #include "EngineInterface/StatisticsData.h"
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
@@ -19,6 +23,7 @@
 #include "EngineInterface/MutationType.h"
 
 #include "Definitions.cuh"
+#include "RenderSnapshot.cuh"
 
 struct cudaGraphicsResource;
 
@@ -41,6 +46,17 @@ public:
     void applyCataclysm(int power);
 
     void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom);
+
+    //render snapshots are published by the simulating thread and can be drawn concurrently to the calculation of the next time step
+    bool isRenderSnapshotRequired() const;
+    bool publishRenderSnapshot();  //returns false if both snapshots are in use
+    bool tryDrawVectorGraphicsFromRenderSnapshot(  //returns false if no snapshot has been published
+        float2 const& rectUpperLeft,
+        float2 const& rectLowerRight,
+        void* cudaResource,
+        int2 const& imageSize,
+        double zoom);
+
     void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
     void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO);
     void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO);
@@ -68,11 +84,20 @@ public:
     void setDetached(bool value);
 
     void setGpuConstants(GpuSettings const& cudaConstants);
+
+    //profiling requires additional CUDA events and should only be enabled on demand
+    void setProfilingEnabled(bool value);
+    std::vector<ProfilingScopeDuration> fetchProfilingScopeDurations();  //of the operations since the last fetch
     SimulationParameters getSimulationParameters() const;
     void setSimulationParameters(SimulationParameters const& parameters);
 
     ArraySizes getArraySizes() const;
 
+    //device memory in bytes, peak and number of array resizes since the simulation has been created
+    uint64_t getDeviceMemory() const;
+    uint64_t getPeakDeviceMemory() const;
+    int getNumArrayResizes() const;
+
     StatisticsData getStatistics();
     void resetTimeIntervalStatistics();
     uint64_t getCurrentTimestep() const;
@@ -108,11 +133,15 @@ private:
     std::shared_ptr<SimulationData> _cudaSimulationData;
 
     std::shared_ptr<RenderingData> _cudaRenderingData;
+    SnapshotExchange<RenderSnapshot> _renderSnapshots;
+    cudaStream_t _renderingStream = nullptr;
     std::shared_ptr<SelectionResult> _cudaSelectionResult;
     std::shared_ptr<DataTO> _cudaAccessTO;
     std::shared_ptr<SimulationStatistics> _simulationStatistics;
+    std::atomic<int> _numArrayResizes{0};
 
 
+    KernelProfiler _profiler;
     SimulationKernelsLauncher _simulationKernels;
     DataAccessKernelsLauncher _dataAccessKernels;
     GarbageCollectorKernelsLauncher _garbageCollectorKernels;
@@ -19,6 +19,9 @@ struct SimulationParameters;
 struct GpuSettings;
 class SimulationStatistics;
 
+class _KernelProfiler;
+using KernelProfiler = std::shared_ptr<_KernelProfiler>;
+
 class _SimulationKernelsLauncher;
 using SimulationKernelsLauncher = std::shared_ptr<_SimulationKernelsLauncher>;
 
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <nppdefs.h>
-
 #include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/GenomeBytesDecoder.h"
 #include "EngineInterface/GenomeConstants.h"
 #include "Base.cuh"
 #include "Object.cuh"
@@ -85,7 +84,7 @@ public:
     __inline__ __device__ static float convertByteToAngle(uint8_t b);
     __inline__ __device__ static uint8_t convertOptionalByteToByte(int value);
 
-    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = 30;
+    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = GenomeBytesDecoder::MaxSubGenomeRecursionDepth;
 
 private:
     __inline__ __device__ static int findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex);
@@ -108,61 +107,17 @@ template <typename Func>
 __inline__ __device__ void GenomeDecoder::executeForEachNodeRecursively(uint8_t* genome, int genomeSize, Func func)
 {
     CHECK(genomeSize >= Const::GenomeHeaderSize)
-
-    int subGenomeEndAddresses[MAX_SUBGENOME_RECURSION_DEPTH];
-    int subGenomeNumRepetitions[MAX_SUBGENOME_RECURSION_DEPTH + 1];
-    int depth = 0;
-    subGenomeNumRepetitions[0] = getNumRepetitions(genome, true);
-    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize;) {
-        auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
-        func(depth, nodeAddress, subGenomeNumRepetitions[depth]);
-
-        bool goToNextSibling = true;
-        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
-            auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
-            auto makeSelfCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes]);
-            if (!makeSelfCopy) {
-                auto subGenomeSize = GenomeDecoder::getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-                nodeAddress += Const::CellBasicBytes + cellFunctionFixedBytes + 3;
-                subGenomeEndAddresses[depth++] = nodeAddress + subGenomeSize;
-
-                auto repetitions = getNumRepetitions(genome + nodeAddress, true);
-                subGenomeNumRepetitions[depth] = subGenomeNumRepetitions[depth - 1] * repetitions;
-                nodeAddress += Const::GenomeHeaderSize;
-                goToNextSibling = false;
-            }
-        }
-        if (goToNextSibling) {
-            nodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
-        }
-        for (int i = 0; i < MAX_SUBGENOME_RECURSION_DEPTH && depth > 0; ++i) {
-            if (depth > 0) {
-                if (subGenomeEndAddresses[depth - 1] == nodeAddress) {
-                    --depth;
-                } else {
-                    break;
-                }
-            }
-        }
-    }
+    GenomeBytesDecoder::executeForEachNodeRecursively(genome, genomeSize, func);
 }
 
 __inline__ __device__ int GenomeDecoder::getGenomeDepth(uint8_t* genome, int genomeSize)
 {
-    auto result = 0;
-    executeForEachNodeRecursively(genome, genomeSize, [&result](int depth, int nodeAddress, int repetition) { result = max(result, depth); });
-    return result;
+    return GenomeBytesDecoder::getGenomeDepth(genome, genomeSize);
 }
 
 __inline__ __device__ int GenomeDecoder::getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions)
 {
-    auto result = 0;
-    if (!includeRepetitions) {
-        executeForEachNodeRecursively(genome, genomeSize, [&result](int depth, int nodeAddress, int repetitions) { ++result; });
-    } else {
-        executeForEachNodeRecursively(genome, genomeSize, [&result](int depth, int nodeAddress, int repetitions) { result += repetitions; });
-    }
-    return result;
+    return GenomeBytesDecoder::getNumNodesRecursively(genome, genomeSize, includeRepetitions);
 }
 
 __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
@@ -353,25 +308,13 @@ __inline__ __device__ bool GenomeDecoder::isSingleConstruction(uint8_t* genome)
 
 __inline__ __device__ int GenomeDecoder::getNumRepetitions(uint8_t* genome, bool countInfinityAsOne)
 {
-    int result = max(1, toInt(genome[Const::GenomeHeaderNumRepetitionsPos]));
-    if (!countInfinityAsOne) {
-        return result == 255 ? NPP_MAX_32S : result;
-    } else {
-        return result == 255 ? 1 : result;
-    }
+    return GenomeBytesDecoder::convertByteToNumRepetitions(genome[Const::GenomeHeaderNumRepetitionsPos], countInfinityAsOne);
 }
 
 template <typename ConstructorOrInjector>
 __inline__ __device__ bool GenomeDecoder::containsSelfReplication(ConstructorOrInjector const& cellFunction)
 {
-    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < cellFunction.genomeSize;) {
-        if (isNextCellSelfCopy(cellFunction.genome, currentNodeAddress)) {
-            return true;
-        }
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(cellFunction.genome, cellFunction.genomeSize, currentNodeAddress);
-    }
-
-    return false;
+    return GenomeBytesDecoder::containsSelfReplication(cellFunction.genome, toInt(cellFunction.genomeSize));
 }
 
 __inline__ __device__ GenomeHeader GenomeDecoder::readGenomeHeader(ConstructorFunction const& constructor)
@@ -403,7 +346,7 @@ __inline__ __device__ void GenomeDecoder::writeWord(uint8_t* genome, int address
 
 __inline__ __device__ bool GenomeDecoder::convertByteToBool(uint8_t b)
 {
-    return static_cast<int8_t>(b) > 0;
+    return GenomeBytesDecoder::convertByteToBool(b);
 }
 
 __inline__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
@@ -413,7 +356,7 @@ __inline__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
 
 __inline__ __device__ int GenomeDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
 {
-    return static_cast<int>(b1) | (static_cast<int>(b2 << 8));
+    return GenomeBytesDecoder::convertBytesToWord(b1, b2);
 }
 
 __inline__ __device__ void GenomeDecoder::convertWordToBytes(int word, uint8_t& b1, uint8_t& b2)
@@ -464,26 +407,12 @@ __inline__ __device__ void GenomeDecoder::setRandomCellFunctionData(
 
 __inline__ __device__ int GenomeDecoder::getNumNodes(uint8_t* genome, int genomeSize)
 {
-    int result = 0;
-    int currentNodeAddress = Const::GenomeHeaderSize;
-    for (; result < genomeSize && currentNodeAddress < genomeSize; ++result) {
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-    }
-
-    return result;
+    return GenomeBytesDecoder::getNumNodes(genome, genomeSize);
 }
 
 __inline__ __device__ int GenomeDecoder::getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex)
 {
-    int currentNodeAddress = Const::GenomeHeaderSize;
-    for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex; ++currentNodeIndex) {
-        if (currentNodeAddress >= genomeSize) {
-            break;
-        }
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-    }
-
-    return currentNodeAddress;
+    return GenomeBytesDecoder::getNodeAddress(genome, genomeSize, nodeIndex);
 }
 
 
@@ -502,54 +431,12 @@ __inline__ __device__ int GenomeDecoder::findStartNodeAddress(uint8_t* genome, i
 
 __inline__ __device__ int GenomeDecoder::getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenomes)
 {
-    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
-    switch (cellFunction) {
-    case CellFunction_Neuron:
-        return Const::NeuronBytes;
-    case CellFunction_Transmitter:
-        return Const::TransmitterBytes;
-    case CellFunction_Constructor: {
-        if (withSubgenomes) {
-            auto isMakeCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes]);
-            if (isMakeCopy) {
-                return Const::ConstructorFixedBytes + 1;
-            } else {
-                return Const::ConstructorFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-            }
-        } else {
-            return Const::ConstructorFixedBytes;
-        }
-    }
-    case CellFunction_Sensor:
-        return Const::SensorBytes;
-    case CellFunction_Nerve:
-        return Const::NerveBytes;
-    case CellFunction_Attacker:
-        return Const::AttackerBytes;
-    case CellFunction_Injector: {
-        if (withSubgenomes) {
-            auto isMakeCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes]);
-            if (isMakeCopy) {
-                return Const::InjectorFixedBytes + 1;
-            } else {
-                return Const::InjectorFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-            }
-        } else {
-            return Const::InjectorFixedBytes;
-        }
-    }
-    case CellFunction_Muscle:
-        return Const::MuscleBytes;
-    case CellFunction_Defender:
-        return Const::DefenderBytes;
-    default:
-        return 0;
-    }
+    return GenomeBytesDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress, withSubgenomes);
 }
 
 __inline__ __device__ int GenomeDecoder::getNextCellFunctionType(uint8_t* genome, int nodeAddress)
 {
-    return genome[nodeAddress] % CellFunction_Count;
+    return GenomeBytesDecoder::getNextCellFunctionType(genome, nodeAddress);
 }
 
 __inline__ __device__ bool GenomeDecoder::isNextCellSelfCopy(uint8_t* genome, int nodeAddress)
@@ -605,10 +492,7 @@ __inline__ __device__ void GenomeDecoder::setNextConstructorSeparation(uint8_t*
 
 __inline__ __device__ int GenomeDecoder::getNextSubGenomeSize(uint8_t* genome, int genomeSize, int nodeAddress)
 {
-    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
-    auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
-    auto subGenomeSizeIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
-    return max(min(GenomeDecoder::convertBytesToWord(genome[subGenomeSizeIndex], genome[subGenomeSizeIndex + 1]), genomeSize - (subGenomeSizeIndex + 2)), 0);
+    return GenomeBytesDecoder::getNextSubGenomeSize(genome, genomeSize, nodeAddress);
 }
 
 __inline__ __device__ int GenomeDecoder::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
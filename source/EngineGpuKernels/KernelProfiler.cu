@@ -0,0 +1,90 @@
+#include "KernelProfiler.cuh"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+
+#include "Macros.cuh"
+
+_KernelProfiler::~_KernelProfiler()
+{
+    for (auto const& scope : _scopes) {
+        cudaEventDestroy(scope.start);
+        cudaEventDestroy(scope.end);
+    }
+}
+
+void _KernelProfiler::setEnabled(bool value)
+{
+    if (_enabled == value) {
+        return;
+    }
+    _enabled = value;
+    _numScopes = 0;
+    _openScopes.clear();
+}
+
+bool _KernelProfiler::isEnabled() const
+{
+    return _enabled;
+}
+
+void _KernelProfiler::beginScope(char const* name)
+{
+    if (!_enabled) {
+        return;
+    }
+    if (_numScopes == toInt(_scopes.size())) {
+        Scope scope;
+        CHECK_FOR_CUDA_ERROR(cudaEventCreate(&scope.start));
+        CHECK_FOR_CUDA_ERROR(cudaEventCreate(&scope.end));
+        _scopes.emplace_back(scope);
+    }
+    auto& scope = _scopes.at(_numScopes);
+    scope.name = name;
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(scope.start));
+    _openScopes.emplace_back(_numScopes++);
+}
+
+void _KernelProfiler::endScope()
+{
+    if (!_enabled || _openScopes.empty()) {
+        return;
+    }
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_scopes.at(_openScopes.back()).end));
+    _openScopes.pop_back();
+}
+
+std::vector<ProfilingScopeDuration> _KernelProfiler::fetchScopeDurations()
+{
+    std::vector<ProfilingScopeDuration> result;
+    if (!_openScopes.empty()) {
+        return result;
+    }
+    for (int i = 0; i < _numScopes; ++i) {
+        auto const& scope = _scopes.at(i);
+        CHECK_FOR_CUDA_ERROR(cudaEventSynchronize(scope.end));
+        float duration;
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&duration, scope.start, scope.end));
+
+        auto findResult = std::find_if(result.begin(), result.end(), [&](auto const& element) { return element.name == scope.name; });
+        if (findResult != result.end()) {
+            findResult->duration += duration;
+        } else {
+            result.emplace_back(ProfilingScopeDuration{scope.name, duration});
+        }
+    }
+    _numScopes = 0;
+    return result;
+}
+
+KernelProfilerScope::KernelProfilerScope(KernelProfiler const& profiler, char const* name)
+    : _profiler(profiler)
+{
+    _profiler->beginScope(name);
+}
+
+KernelProfilerScope::~KernelProfilerScope()
+{
+    _profiler->endScope();
+}
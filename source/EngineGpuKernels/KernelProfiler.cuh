@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "EngineInterface/ProfilingData.h"
+
+#include "Definitions.cuh"
+
+/**
+ * Measures the GPU durations of named scopes by recording CUDA events before and after the enclosed kernel calls.
+ * Scopes can be nested and may occur several times between two fetches; their durations are summed up by name.
+ * If the profiler is disabled no events are recorded.
+ */
+class _KernelProfiler
+{
+public:
+    ~_KernelProfiler();
+
+    void setEnabled(bool value);
+    bool isEnabled() const;
+
+    void beginScope(char const* name);
+    void endScope();
+
+    //waits for the completion of the recorded scopes
+    std::vector<ProfilingScopeDuration> fetchScopeDurations();
+
+private:
+    struct Scope
+    {
+        std::string name;
+        cudaEvent_t start;
+        cudaEvent_t end;
+    };
+
+    bool _enabled = false;
+    std::vector<Scope> _scopes;  //pool of events, reused after each fetch
+    int _numScopes = 0;
+    std::vector<int> _openScopes;
+};
+
+class KernelProfilerScope
+{
+public:
+    KernelProfilerScope(KernelProfiler const& profiler, char const* name);
+    ~KernelProfilerScope();
+
+private:
+    KernelProfiler _profiler;
+};
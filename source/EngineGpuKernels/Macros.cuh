@@ -90,3 +90,21 @@ void checkAndThrowError(T result, char const *const func, const char *const file
     } else { \
         func<<<1, 1>>>(__VA_ARGS__); \
     }
+
+#define KERNEL_CALL_ON_STREAM(stream, func, ...) \
+    if (GlobalSettings::getInstance().isDebugMode()) { \
+        func<<<gpuSettings.numBlocks, gpuSettings.numThreadsPerBlock, 0, stream>>>(__VA_ARGS__); \
+        cudaStreamSynchronize(stream); \
+        CHECK_FOR_CUDA_ERROR(cudaGetLastError()); \
+    } else { \
+        func<<<gpuSettings.numBlocks, gpuSettings.numThreadsPerBlock, 0, stream>>>(__VA_ARGS__); \
+    }
+
+#define KERNEL_CALL_1_1_ON_STREAM(stream, func, ...) \
+    if (GlobalSettings::getInstance().isDebugMode()) { \
+        func<<<1, 1, 0, stream>>>(__VA_ARGS__); \
+        cudaStreamSynchronize(stream); \
+        CHECK_FOR_CUDA_ERROR(cudaGetLastError()); \
+    } else { \
+        func<<<1, 1, 0, stream>>>(__VA_ARGS__); \
+    }
@@ -0,0 +1,33 @@
+﻿#include "RenderSnapshot.cuh"
+
+#include "CudaMemoryManager.cuh"
+
+void RenderSnapshot::init()
+{
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, numCells);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, numParticles);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numCells, 0, sizeof(int)));
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numParticles, 0, sizeof(int)));
+}
+
+void RenderSnapshot::resizeIfNecessary(uint64_t newCellCapacity, uint64_t newParticleCapacity)
+{
+    if (newCellCapacity > cellCapacity) {
+        CudaMemoryManager::getInstance().freeMemory(cells);
+        cellCapacity = newCellCapacity * 2;
+        CudaMemoryManager::getInstance().acquireMemory<RenderSnapshotCell>(cellCapacity, cells);
+    }
+    if (newParticleCapacity > particleCapacity) {
+        CudaMemoryManager::getInstance().freeMemory(particles);
+        particleCapacity = newParticleCapacity * 2;
+        CudaMemoryManager::getInstance().acquireMemory<RenderSnapshotParticle>(particleCapacity, particles);
+    }
+}
+
+void RenderSnapshot::free()
+{
+    CudaMemoryManager::getInstance().freeMemory(cells);
+    CudaMemoryManager::getInstance().freeMemory(particles);
+    CudaMemoryManager::getInstance().freeMemory(numCells);
+    CudaMemoryManager::getInstance().freeMemory(numParticles);
+}
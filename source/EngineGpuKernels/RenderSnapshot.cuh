@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#include <vector_types.h>
+
+#include "EngineInterface/FundamentalConstants.h"
+#include "EngineInterface/GpuSettings.h"
+
+struct RenderSnapshotCell
+{
+    float2 pos;
+    float3 color;
+    bool active;
+    uint8_t numConnections;
+    uint8_t arrowConnections;  //bit i set = arrow from connected cell i
+    int connectionIndices[MAX_CELL_BONDS];  //indices in the snapshot
+};
+
+struct RenderSnapshotParticle
+{
+    float2 pos;
+    float3 color;
+};
+
+//compact copy of the data needed for rendering, allows drawing while the next time step is calculated
+struct RenderSnapshot
+{
+    int2 worldSize;
+    uint64_t timestep = 0;
+    GpuSettings gpuSettings;  //launch configuration for drawing, copied since the settings may change during drawing
+
+    uint64_t cellCapacity = 0;
+    uint64_t particleCapacity = 0;
+    RenderSnapshotCell* cells = nullptr;
+    RenderSnapshotParticle* particles = nullptr;
+    int* numCells = nullptr;
+    int* numParticles = nullptr;
+
+    void init();
+    void resizeIfNecessary(uint64_t newCellCapacity, uint64_t newParticleCapacity);
+    void free();
+};
@@ -367,3 +367,152 @@ __global__ void cudaDrawRadiationSources(uint64_t* targetImage, float2 rectUpper
     }
 }
 
+/************************************************************************/
+/* Render snapshot                                                      */
+/************************************************************************/
+__global__ void cudaPrepareRenderSnapshot(Array<Cell*> cells)
+{
+    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        cells.at(index)->tag = index;
+    }
+}
+
+__global__ void cudaCreateRenderSnapshot(Array<Cell*> cells, Array<Particle*> particles, RenderSnapshot snapshot)
+{
+    if (threadIdx.x == 0 && blockIdx.x == 0) {
+        *snapshot.numCells = cells.getNumEntries();
+        *snapshot.numParticles = particles.getNumEntries();
+    }
+    {
+        auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells.at(index);
+            auto& snapshotCell = snapshot.cells[index];
+            snapshotCell.pos = cell->pos;
+            snapshotCell.color = calcColor(cell, cell->selected);
+            snapshotCell.active = cell->isActive();
+            snapshotCell.numConnections = cell->numConnections;
+            snapshotCell.arrowConnections = 0;
+
+            auto inputExecutionOrderNumber = cell->inputExecutionOrderNumber;
+            auto hasInput = inputExecutionOrderNumber != -1 && inputExecutionOrderNumber != cell->executionOrderNumber;
+            for (int i = 0; i < cell->numConnections; ++i) {
+                auto const& otherCell = cell->connections[i].cell;
+                snapshotCell.connectionIndices[i] = otherCell->tag;
+                if (hasInput && otherCell->executionOrderNumber == inputExecutionOrderNumber && !otherCell->outputBlocked) {
+                    snapshotCell.arrowConnections |= 1 << i;
+                }
+            }
+        }
+    }
+    {
+        auto const partition = calcAllThreadsPartition(particles.getNumEntries());
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& particle = particles.at(index);
+            auto& snapshotParticle = snapshot.particles[index];
+            snapshotParticle.pos = particle->absPos;
+            snapshotParticle.color = calcColor(particle, 0 != particle->selected);
+        }
+    }
+}
+
+__global__ void cudaDrawCellsFromSnapshot(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    float2 rectLowerRight,
+    RenderSnapshot snapshot,
+    uint64_t* imageData,
+    int2 imageSize,
+    float zoom)
+{
+    auto const partition = calcAllThreadsPartition(*snapshot.numCells);
+
+    BaseMap map;
+    map.init(universeSize);
+
+    auto shadedCells = zoom >= ZoomLevelForShadedCells;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& cell = snapshot.cells[index];
+
+        auto cellPos = cell.pos;
+        map.correctPosition(cellPos);
+        if (isContainedInRect(rectUpperLeft, rectLowerRight, cellPos)) {
+            auto cellImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos, zoom);
+
+            //draw cell
+            auto color = cell.color;
+            auto radius = zoom / 3;
+            drawCircle(imageData, imageSize, cellImagePos, color, radius, shadedCells, true);
+
+            color = color * min((zoom - 1.0f) / 3, 1.0f);
+            if (cell.active && zoom >= cudaSimulationParameters.zoomLevelNeuronalActivity) {
+                drawCircle(imageData, imageSize, cellImagePos, float3{0.3f, 0.3f, 0.3f}, radius, shadedCells);
+            }
+
+            //draw connections
+            if (zoom >= ZoomLevelForConnections) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto const otherCellPos = snapshot.cells[cell.connectionIndices[i]].pos;
+                    auto topologyCorrection = map.getCorrectionIncrement(cellPos, otherCellPos);
+
+                    if (Math::lengthSquared(topologyCorrection) < NEAR_ZERO) {
+                        auto distFromCellCenter = Math::normalized(otherCellPos - cellPos) / 3;
+                        auto const startImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos + distFromCellCenter, zoom);
+                        auto const endImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, otherCellPos - distFromCellCenter, zoom);
+                        drawLine(startImagePos, endImagePos, color, imageData, imageSize);
+                    }
+                }
+            }
+
+            //draw arrows
+            if (zoom >= ZoomLevelForArrows && cell.arrowConnections != 0) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    if ((cell.arrowConnections & (1 << i)) == 0) {
+                        continue;
+                    }
+                    auto const otherCellPos = snapshot.cells[cell.connectionIndices[i]].pos;
+                    auto topologyCorrection = map.getCorrectionIncrement(cellPos, otherCellPos);
+                    if (Math::lengthSquared(topologyCorrection) > NEAR_ZERO) {
+                        continue;
+                    }
+
+                    auto const otherCellImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, otherCellPos, zoom);
+                    auto const arrowEnd = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos + Math::normalized(otherCellPos - cellPos) / 3, zoom);
+                    auto direction = Math::normalized(arrowEnd - otherCellImagePos);
+                    {
+                        float2 arrowPartStart = {-direction.x + direction.y, -direction.x - direction.y};
+                        arrowPartStart = arrowPartStart * zoom / 8 + arrowEnd;
+                        drawLine(arrowPartStart, arrowEnd, color, imageData, imageSize, 0.5f);
+                    }
+                    {
+                        float2 arrowPartStart = {-direction.x - direction.y, direction.x - direction.y};
+                        arrowPartStart = arrowPartStart * zoom / 8 + arrowEnd;
+                        drawLine(arrowPartStart, arrowEnd, color, imageData, imageSize, 0.5f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+__global__ void cudaDrawParticlesFromSnapshot(int2 universeSize, float2 rectUpperLeft, RenderSnapshot snapshot, uint64_t* imageData, int2 imageSize, float zoom)
+{
+    BaseMap map;
+    map.init(universeSize);
+
+    auto const partition = calcAllThreadsPartition(*snapshot.numParticles);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& particle = snapshot.particles[index];
+        auto particlePos = particle.pos;
+        map.correctPosition(particlePos);
+
+        auto const particleImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, particlePos, zoom);
+        if (isContainedInRect({0, 0}, imageSize, particleImagePos)) {
+            auto radius = zoom / 3;
+            drawCircle(imageData, imageSize, particleImagePos, particle.color, radius);
+        }
+    }
+}
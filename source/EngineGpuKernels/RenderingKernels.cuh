@@ -10,6 +10,7 @@
 #include "Map.cuh"
 #include "SimulationData.cuh"
 #include "RenderingData.cuh"
+#include "RenderSnapshot.cuh"
 
 #include <cuda_runtime_api.h>
 #include <cuda_runtime.h>
@@ -20,3 +21,15 @@ cudaDrawCells(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Ar
 __global__ void
 cudaDrawParticles(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Particle*> particles, uint64_t* imageData, int2 imageSize, float zoom);
 __global__ void cudaDrawRadiationSources(uint64_t* targetImage, float2 rectUpperLeft, int2 imageSize, float zoom);
+
+__global__ void cudaPrepareRenderSnapshot(Array<Cell*> cells);
+__global__ void cudaCreateRenderSnapshot(Array<Cell*> cells, Array<Particle*> particles, RenderSnapshot snapshot);
+__global__ void cudaDrawCellsFromSnapshot(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    float2 rectLowerRight,
+    RenderSnapshot snapshot,
+    uint64_t* imageData,
+    int2 imageSize,
+    float zoom);
+__global__ void cudaDrawParticlesFromSnapshot(int2 universeSize, float2 rectUpperLeft, RenderSnapshot snapshot, uint64_t* imageData, int2 imageSize, float zoom);
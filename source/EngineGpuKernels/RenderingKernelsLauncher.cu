@@ -19,3 +19,27 @@ void _RenderingKernelsLauncher::drawImage(
     KERNEL_CALL(cudaDrawParticles, data.worldSize, rectUpperLeft, rectLowerRight, data.objects.particlePointers, targetImage, imageSize, zoom);
     KERNEL_CALL_1_1(cudaDrawRadiationSources, targetImage, rectUpperLeft, imageSize, zoom);
 }
+
+void _RenderingKernelsLauncher::createSnapshot(GpuSettings const& gpuSettings, SimulationData data, RenderSnapshot snapshot)
+{
+    KERNEL_CALL(cudaPrepareRenderSnapshot, data.objects.cellPointers);
+    KERNEL_CALL(cudaCreateRenderSnapshot, data.objects.cellPointers, data.objects.particlePointers, snapshot);
+}
+
+void _RenderingKernelsLauncher::drawImageFromSnapshot(
+    GpuSettings const& gpuSettings,
+    cudaStream_t stream,
+    float2 rectUpperLeft,
+    float2 rectLowerRight,
+    int2 imageSize,
+    float zoom,
+    RenderSnapshot snapshot,
+    RenderingData renderingData)
+{
+    uint64_t* targetImage = renderingData.imageData;
+
+    KERNEL_CALL_ON_STREAM(stream, cudaDrawBackground, targetImage, imageSize, snapshot.worldSize, zoom, rectUpperLeft, rectLowerRight);
+    KERNEL_CALL_ON_STREAM(stream, cudaDrawCellsFromSnapshot, snapshot.worldSize, rectUpperLeft, rectLowerRight, snapshot, targetImage, imageSize, zoom);
+    KERNEL_CALL_ON_STREAM(stream, cudaDrawParticlesFromSnapshot, snapshot.worldSize, rectUpperLeft, snapshot, targetImage, imageSize, zoom);
+    KERNEL_CALL_1_1_ON_STREAM(stream, cudaDrawRadiationSources, targetImage, rectUpperLeft, imageSize, zoom);
+}
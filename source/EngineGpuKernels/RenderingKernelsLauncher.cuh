@@ -8,6 +8,7 @@
 #include "Definitions.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
 #include "Macros.cuh"
+#include "RenderSnapshot.cuh"
 
 class _RenderingKernelsLauncher
 {
@@ -20,4 +21,17 @@ public:
         float zoom,
         SimulationData data,
         RenderingData renderingData);
+
+    void createSnapshot(GpuSettings const& gpuSettings, SimulationData data, RenderSnapshot snapshot);
+
+    //does not access the simulation data and can therefore run concurrently to the calculation of a time step
+    void drawImageFromSnapshot(
+        GpuSettings const& gpuSettings,
+        cudaStream_t stream,
+        float2 rectUpperLeft,
+        float2 rectLowerRight,
+        int2 imageSize,
+        float zoom,
+        RenderSnapshot snapshot,
+        RenderingData renderingData);
 };
@@ -2,7 +2,7 @@
 
 #include "GarbageCollectorKernels.cuh"
 
-void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
+void SimulationData::init(int2 const& worldSize_, uint64_t timestep_, uint32_t randomSeed)
 {
     worldSize = worldSize_;
     timestep = timestep_;
@@ -17,8 +17,8 @@ void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
     CHECK_FOR_CUDA_ERROR(cudaMemset(residualEnergy, 0, sizeof(double)));
  
     processMemory.init();
-    numberGen1.init(40312357);   //some array size for random numbers (~ 40 MB)
-    numberGen2.init(1536941);  //some array size for random numbers (~ 1.5 MB)
+    numberGen1.init(40312357, randomSeed);   //some array size for random numbers (~ 40 MB)
+    numberGen2.init(1536941, randomSeed);  //some array size for random numbers (~ 1.5 MB)
 
     structuralOperations.init();
     for (int i = 0; i < CellFunction_WithoutNone_Count; ++i) {
@@ -4,11 +4,13 @@
 #include "SimulationKernels.cuh"
 #include "FlowFieldKernels.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
+#include "KernelProfiler.cuh"
 #include "DebugKernels.cuh"
 #include "SimulationStatistics.cuh"
 #include "EngineInterface/SpaceCalculator.h"
 
-_SimulationKernelsLauncher::_SimulationKernelsLauncher()
+_SimulationKernelsLauncher::_SimulationKernelsLauncher(KernelProfiler const& profiler)
+    : _profiler(profiler)
 {
     _garbageCollector = std::make_shared<_GarbageCollectorKernelsLauncher>();
 }
@@ -61,7 +63,9 @@ namespace
 
 void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationStatistics const& statistics)
 {
-    auto const gpuSettings = settings.gpuSettings;
+    KernelProfilerScope timestepScope(_profiler, "Time step");
+
+    auto gpuSettings = settings.gpuSettings;
     KERNEL_CALL_1_1(cudaNextTimestep_prepare, data, statistics);
 
     //not all kernels need to be executed in each time step for performance reasons
@@ -69,6 +73,8 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
     bool considerInnerFriction = (data.timestep % 3 == 0);
     bool considerRigidityUpdate = (data.timestep % 3 == 0);
 
+    gpuSettings = settings.gpuSettings.getForPhase(KernelPhase_Physics);
+    _profiler->beginScope(KernelPhaseNames[KernelPhase_Physics]);
     KERNEL_CALL(cudaNextTimestep_physics_init, data);
     KERNEL_CALL(cudaNextTimestep_physics_fillMaps, data);
     if (settings.simulationParameters.motionType == MotionType_Fluid) {
@@ -85,29 +91,58 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
     KERNEL_CALL(cudaNextTimestep_physics_verletPositionUpdate, data);
     KERNEL_CALL(cudaNextTimestep_physics_calcConnectionForces, data, considerForcesFromAngleDifferences);
     KERNEL_CALL(cudaNextTimestep_physics_verletVelocityUpdate, data);
+    _profiler->endScope();
 
     //cell functions
+    gpuSettings = settings.gpuSettings.getForPhase(KernelPhase_CellFunctions);
+    _profiler->beginScope(KernelPhaseNames[KernelPhase_CellFunctions]);
+    _profiler->beginScope("Cell functions/Preparation");
     KERNEL_CALL(cudaNextTimestep_cellFunction_prepare_substep1, data);
     KERNEL_CALL(cudaNextTimestep_cellFunction_prepare_substep2, data);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Nerve");
     KERNEL_CALL(cudaNextTimestep_cellFunction_nerve, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Neuron");
     KERNEL_CALL(cudaNextTimestep_cellFunction_neuron, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Constructor");
     if (settings.simulationParameters.cellFunctionConstructorCheckCompletenessForSelfReplication) {
         KERNEL_CALL(cudaNextTimestep_cellFunction_constructor_completenessCheck, data, statistics);
     }
     KERNEL_CALL(cudaNextTimestep_cellFunction_constructor_process, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Injector");
     KERNEL_CALL(cudaNextTimestep_cellFunction_injector, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Attacker");
     KERNEL_CALL(cudaNextTimestep_cellFunction_attacker, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Transmitter");
     KERNEL_CALL(cudaNextTimestep_cellFunction_transmitter, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Muscle");
     KERNEL_CALL(cudaNextTimestep_cellFunction_muscle, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Sensor");
     KERNEL_CALL(cudaNextTimestep_cellFunction_sensor, data, statistics);
+    _profiler->endScope();
+    _profiler->beginScope("Cell functions/Reconnector");
     KERNEL_CALL(cudaNextTimestep_cellFunction_reconnector, data, statistics);
+    _profiler->endScope();
+    _profiler->endScope();
 
+    gpuSettings = settings.gpuSettings.getForPhase(KernelPhase_Physics);
+    _profiler->beginScope(KernelPhaseNames[KernelPhase_Physics]);
     if (considerInnerFriction) {
         KERNEL_CALL(cudaNextTimestep_physics_substep7_innerFriction, data);
     }
     KERNEL_CALL(cudaNextTimestep_physics_substep8, data);
+    _profiler->endScope();
 
+    gpuSettings = settings.gpuSettings;
     if (considerRigidityUpdate && isRigidityUpdateEnabled(settings)) {
+        KernelProfilerScope clusterFindingScope(_profiler, "Cluster finding");
         KERNEL_CALL(cudaInitClusterData, data);
         KERNEL_CALL(cudaFindClusterIteration, data);  //3 iterations should provide a good approximation
         KERNEL_CALL(cudaFindClusterIteration, data);
@@ -117,13 +152,19 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
         KERNEL_CALL(cudaAccumulateClusterAngularProp, data);
         KERNEL_CALL(cudaApplyClusterData, data);
     }
+
+    gpuSettings = settings.gpuSettings.getForPhase(KernelPhase_StructuralOperations);
+    _profiler->beginScope(KernelPhaseNames[KernelPhase_StructuralOperations]);
     KERNEL_CALL_1_1(cudaNextTimestep_structuralOperations_substep1, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep2, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep3, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep4, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep5, data);
+    _profiler->endScope();
 
+    _profiler->beginScope("Garbage collection");
     _garbageCollector->cleanupAfterTimestep(settings.gpuSettings, data);
+    _profiler->endScope();
 }
 
 void _SimulationKernelsLauncher::prepareForSimulationParametersChanges(Settings const& settings, SimulationData const& data)
@@ -8,7 +8,7 @@
 class _SimulationKernelsLauncher
 {
 public:
-    _SimulationKernelsLauncher();
+    _SimulationKernelsLauncher(KernelProfiler const& profiler);
 
     bool calcSimulationParametersForNextTimestep(Settings& settings);
     void calcTimestep(Settings const& settings, SimulationData const& simulationData, SimulationStatistics const& statistics);
@@ -18,5 +18,5 @@ private:
     bool isRigidityUpdateEnabled(Settings const& settings) const;
 
     GarbageCollectorKernelsLauncher _garbageCollector;
+    KernelProfiler _profiler;
 };
-
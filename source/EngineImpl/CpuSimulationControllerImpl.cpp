@@ -0,0 +1,517 @@
+#include "CpuSimulationControllerImpl.h"
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <unordered_set>
+
+#include "Base/Exceptions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineCpu/CpuSimulationFacade.h"
+
+#include "AccessDataTOCache.h"
+#include "DescriptionConverter.h"
+
+namespace
+{
+    //the data is calculated synchronously, errors are delivered through the future as by the GPU backend
+    template <typename Func>
+    auto makeReadyFuture(Func const& func)
+    {
+        std::promise<decltype(func())> promise;
+        try {
+            promise.set_value(func());
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        return promise.get_future();
+    }
+
+    [[noreturn]] void throwUnsupportedOperation(std::string const& operation)
+    {
+        throw UnsupportedOperationException(operation + " is not supported by the CPU backend.");
+    }
+}
+
+_CpuSimulationControllerImpl::_CpuSimulationControllerImpl(int numThreads)
+    : _numThreads(numThreads)
+{
+    _dataTOCache = std::make_shared<_AccessDataTOCache>();
+}
+
+_CpuSimulationControllerImpl::~_CpuSimulationControllerImpl()
+{
+    pauseSimulation();
+}
+
+void _CpuSimulationControllerImpl::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
+{
+    _generalSettings = generalSettings;
+    _origSettings.generalSettings = generalSettings;
+    _origSettings.simulationParameters = parameters;
+
+    Settings settings;
+    settings.generalSettings = generalSettings;
+    settings.simulationParameters = parameters;
+    settings.gpuSettings = _gpuSettings;
+
+    std::lock_guard lock(_mutex);
+    _cpuSimulation = std::make_shared<_CpuSimulationFacade>(timestep, settings, _numThreads);
+}
+
+void _CpuSimulationControllerImpl::clear()
+{
+    std::lock_guard lock(_mutex);
+    _cpuSimulation->clear();
+}
+
+void _CpuSimulationControllerImpl::setImageResource(void* image) {}
+
+std::string _CpuSimulationControllerImpl::getGpuName() const
+{
+    std::lock_guard lock(_mutex);
+    auto numThreads = _cpuSimulation ? _cpuSimulation->getNumThreads() : _numThreads;
+    return "CPU (" + std::to_string(numThreads) + " threads)";
+}
+
+void _CpuSimulationControllerImpl::tryDrawVectorGraphics(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{}
+
+std::optional<OverlayDescription> _CpuSimulationControllerImpl::tryDrawVectorGraphicsAndReturnOverlay(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    return std::nullopt;
+}
+
+bool _CpuSimulationControllerImpl::isSyncSimulationWithRendering() const
+{
+    return _syncSimulationWithRendering;
+}
+
+void _CpuSimulationControllerImpl::setSyncSimulationWithRendering(bool value)
+{
+    _syncSimulationWithRendering = value;
+}
+
+int _CpuSimulationControllerImpl::getSyncSimulationWithRenderingRatio() const
+{
+    return _syncSimulationWithRenderingRatio;
+}
+
+void _CpuSimulationControllerImpl::setSyncSimulationWithRenderingRatio(int value)
+{
+    _syncSimulationWithRenderingRatio = value;
+}
+
+ClusteredDataDescription _CpuSimulationControllerImpl::getClusteredSimulationData()
+{
+    std::lock_guard lock(_mutex);
+    auto dataTO = provideTO();
+    _cpuSimulation->getSimulationData(dataTO);
+
+    DescriptionConverter converter(_cpuSimulation->getSimulationParameters());
+    return converter.convertTOtoClusteredDataDescription(dataTO);
+}
+
+DataDescription _CpuSimulationControllerImpl::getSimulationData()
+{
+    std::lock_guard lock(_mutex);
+    return getSimulationDataIntern();
+}
+
+ClusteredDataDescription _CpuSimulationControllerImpl::getSelectedClusteredSimulationData(bool includeClusters)
+{
+    throwUnsupportedOperation("Selection");
+}
+
+DataDescription _CpuSimulationControllerImpl::getSelectedSimulationData(bool includeClusters)
+{
+    throwUnsupportedOperation("Selection");
+}
+
+DataDescription _CpuSimulationControllerImpl::getInspectedSimulationData(std::vector<uint64_t> objectIds)
+{
+    std::unordered_set<uint64_t> objectIdSet(objectIds.begin(), objectIds.end());
+    auto data = getSimulationData();
+
+    DataDescription result;
+    for (auto const& cell : data.cells) {
+        if (objectIdSet.contains(cell.id)) {
+            result.addCell(cell);
+        }
+    }
+    for (auto const& particle : data.particles) {
+        if (objectIdSet.contains(particle.id)) {
+            result.addParticle(particle);
+        }
+    }
+    return result;
+}
+
+std::future<ClusteredDataDescription> _CpuSimulationControllerImpl::getClusteredSimulationData_async()
+{
+    return makeReadyFuture([&] { return getClusteredSimulationData(); });
+}
+
+std::future<DataDescription> _CpuSimulationControllerImpl::getSelectedSimulationData_async(bool includeClusters)
+{
+    return makeReadyFuture([&] { return getSelectedSimulationData(includeClusters); });
+}
+
+std::future<DataDescription> _CpuSimulationControllerImpl::getInspectedSimulationData_async(std::vector<uint64_t> objectIds)
+{
+    return makeReadyFuture([&] { return getInspectedSimulationData(objectIds); });
+}
+
+std::future<SelectionShallowData> _CpuSimulationControllerImpl::getSelectionShallowData_async()
+{
+    return makeReadyFuture([&] { return getSelectionShallowData(); });
+}
+
+void _CpuSimulationControllerImpl::addAndSelectSimulationData(DataDescription const& dataToAdd)
+{
+    DescriptionConverter converter(getSimulationParameters());
+
+    std::lock_guard lock(_mutex);
+    auto dataTO = _dataTOCache->getDataTO(converter.getArraySizes(dataToAdd));
+    converter.convertDescriptionToTO(dataTO, dataToAdd);
+    _cpuSimulation->addAndSelectSimulationData(dataTO);
+}
+
+void _CpuSimulationControllerImpl::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
+{
+    DescriptionConverter converter(getSimulationParameters());
+
+    std::lock_guard lock(_mutex);
+    auto dataTO = _dataTOCache->getDataTO(converter.getArraySizes(dataToUpdate));
+    converter.convertDescriptionToTO(dataTO, dataToUpdate);
+    _cpuSimulation->setSimulationData(dataTO);
+}
+
+void _CpuSimulationControllerImpl::setSimulationData(DataDescription const& dataToUpdate)
+{
+    std::lock_guard lock(_mutex);
+    setSimulationDataIntern(dataToUpdate);
+}
+
+void _CpuSimulationControllerImpl::removeSelectedObjects(bool includeClusters)
+{
+    throwUnsupportedOperation("Removing selected objects");
+}
+
+void _CpuSimulationControllerImpl::relaxSelectedObjects(bool includeClusters)
+{
+    throwUnsupportedOperation("Relaxing selected objects");
+}
+
+void _CpuSimulationControllerImpl::uniformVelocitiesForSelectedObjects(bool includeClusters)
+{
+    throwUnsupportedOperation("Uniform velocities for selected objects");
+}
+
+void _CpuSimulationControllerImpl::makeSticky(bool includeClusters)
+{
+    throwUnsupportedOperation("Making selected objects sticky");
+}
+
+void _CpuSimulationControllerImpl::removeStickiness(bool includeClusters)
+{
+    throwUnsupportedOperation("Removing the stickiness of selected objects");
+}
+
+void _CpuSimulationControllerImpl::setBarrier(bool value, bool includeClusters)
+{
+    throwUnsupportedOperation("Setting barriers for selected objects");
+}
+
+void _CpuSimulationControllerImpl::colorSelectedObjects(unsigned char color, bool includeClusters)
+{
+    throwUnsupportedOperation("Coloring selected objects");
+}
+
+void _CpuSimulationControllerImpl::reconnectSelectedObjects()
+{
+    throwUnsupportedOperation("Reconnecting selected objects");
+}
+
+void _CpuSimulationControllerImpl::setDetached(bool value)
+{
+    throwUnsupportedOperation("Detaching selected objects");
+}
+
+void _CpuSimulationControllerImpl::changeCell(CellDescription const& changedCell)
+{
+    std::lock_guard lock(_mutex);
+    auto data = getSimulationDataIntern();
+    for (auto& cell : data.cells) {
+        if (cell.id == changedCell.id) {
+            cell = changedCell;
+        }
+    }
+    setSimulationDataIntern(data);
+}
+
+void _CpuSimulationControllerImpl::changeParticle(ParticleDescription const& changedParticle)
+{
+    std::lock_guard lock(_mutex);
+    auto data = getSimulationDataIntern();
+    for (auto& particle : data.particles) {
+        if (particle.id == changedParticle.id) {
+            particle = changedParticle;
+        }
+    }
+    setSimulationDataIntern(data);
+}
+
+void _CpuSimulationControllerImpl::calcTimesteps(uint64_t timesteps)
+{
+    std::lock_guard lock(_mutex);
+    for (uint64_t i = 0; i < timesteps; ++i) {
+        _cpuSimulation->calcTimestep();
+    }
+}
+
+void _CpuSimulationControllerImpl::runSimulation()
+{
+    if (_isSimulationRunning.exchange(true)) {
+        return;
+    }
+    _thread = new std::thread(&_CpuSimulationControllerImpl::runThreadLoop, this);
+}
+
+void _CpuSimulationControllerImpl::pauseSimulation()
+{
+    _isSimulationRunning = false;
+    if (_thread) {
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+    _tps.store(0);
+}
+
+void _CpuSimulationControllerImpl::applyCataclysm(int power)
+{
+    throwUnsupportedOperation("Cataclysm");
+}
+
+bool _CpuSimulationControllerImpl::isSimulationRunning() const
+{
+    return _isSimulationRunning;
+}
+
+void _CpuSimulationControllerImpl::closeSimulation()
+{
+    pauseSimulation();
+
+    std::lock_guard lock(_mutex);
+    _cpuSimulation.reset();
+}
+
+uint64_t _CpuSimulationControllerImpl::getCurrentTimestep() const
+{
+    std::lock_guard lock(_mutex);
+    return _cpuSimulation->getCurrentTimestep();
+}
+
+void _CpuSimulationControllerImpl::setCurrentTimestep(uint64_t value)
+{
+    std::lock_guard lock(_mutex);
+    _cpuSimulation->setCurrentTimestep(value);
+}
+
+SimulationParameters _CpuSimulationControllerImpl::getSimulationParameters() const
+{
+    std::lock_guard lock(_mutex);
+    return _cpuSimulation->getSimulationParameters();
+}
+
+SimulationParameters const& _CpuSimulationControllerImpl::getOriginalSimulationParameters() const
+{
+    return _origSettings.simulationParameters;
+}
+
+void _CpuSimulationControllerImpl::setSimulationParameters(SimulationParameters const& parameters)
+{
+    std::lock_guard lock(_mutex);
+    _cpuSimulation->setSimulationParameters(parameters);
+}
+
+void _CpuSimulationControllerImpl::setOriginalSimulationParameters(SimulationParameters const& parameters)
+{
+    _origSettings.simulationParameters = parameters;
+}
+
+GpuSettings _CpuSimulationControllerImpl::getGpuSettings() const
+{
+    return _gpuSettings;
+}
+
+GpuSettings _CpuSimulationControllerImpl::getOriginalGpuSettings() const
+{
+    return _origSettings.gpuSettings;
+}
+
+void _CpuSimulationControllerImpl::setGpuSettings_async(GpuSettings const& gpuSettings)
+{
+    _gpuSettings = gpuSettings;
+}
+
+void _CpuSimulationControllerImpl::startGpuSettingsTuning() {}
+
+std::optional<float> _CpuSimulationControllerImpl::getGpuSettingsTuningProgress() const
+{
+    return std::nullopt;
+}
+
+void _CpuSimulationControllerImpl::applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius)
+{
+    throwUnsupportedOperation("Applying forces");
+}
+
+void _CpuSimulationControllerImpl::switchSelection(RealVector2D const& pos, float radius)
+{
+    throwUnsupportedOperation("Selection");
+}
+
+void _CpuSimulationControllerImpl::swapSelection(RealVector2D const& pos, float radius)
+{
+    throwUnsupportedOperation("Selection");
+}
+
+SelectionShallowData _CpuSimulationControllerImpl::getSelectionShallowData()
+{
+    return SelectionShallowData();
+}
+
+void _CpuSimulationControllerImpl::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
+{
+    throwUnsupportedOperation("Updating selected objects");
+}
+
+void _CpuSimulationControllerImpl::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
+{
+    throwUnsupportedOperation("Selection");
+}
+
+void _CpuSimulationControllerImpl::removeSelection() {}
+
+bool _CpuSimulationControllerImpl::updateSelectionIfNecessary()
+{
+    return false;
+}
+
+GeneralSettings _CpuSimulationControllerImpl::getGeneralSettings() const
+{
+    return _generalSettings;
+}
+
+IntVector2D _CpuSimulationControllerImpl::getWorldSize() const
+{
+    return {_generalSettings.worldSizeX, _generalSettings.worldSizeY};
+}
+
+StatisticsData _CpuSimulationControllerImpl::getStatistics() const
+{
+    std::lock_guard lock(_mutex);
+    return _cpuSimulation->getStatistics();
+}
+
+std::optional<int> _CpuSimulationControllerImpl::getTpsRestriction() const
+{
+    auto result = _tpsRestriction.load();
+    return 0 != result ? std::optional<int>(result) : std::optional<int>();
+}
+
+void _CpuSimulationControllerImpl::setTpsRestriction(std::optional<int> const& value)
+{
+    _tpsRestriction.store(value ? *value : 0);
+}
+
+float _CpuSimulationControllerImpl::getTps() const
+{
+    return _tps.load();
+}
+
+bool _CpuSimulationControllerImpl::isProfilingEnabled() const
+{
+    return false;
+}
+
+void _CpuSimulationControllerImpl::setProfilingEnabled(bool value)
+{
+    if (value) {
+        throwUnsupportedOperation("Profiling");
+    }
+}
+
+ProfilingData _CpuSimulationControllerImpl::getProfilingData() const
+{
+    throwUnsupportedOperation("Profiling");
+}
+
+std::optional<DeviceMemoryData> _CpuSimulationControllerImpl::getDeviceMemoryData() const
+{
+    return std::nullopt;
+}
+
+void _CpuSimulationControllerImpl::testOnly_mutate(uint64_t cellId, MutationType mutationType)
+{
+    throwUnsupportedOperation("Mutation");
+}
+
+DataTO _CpuSimulationControllerImpl::provideTO()
+{
+    return _dataTOCache->getDataTO(_cpuSimulation->getArraySizes());
+}
+
+DataDescription _CpuSimulationControllerImpl::getSimulationDataIntern()
+{
+    auto dataTO = provideTO();
+    _cpuSimulation->getSimulationData(dataTO);
+
+    DescriptionConverter converter(_cpuSimulation->getSimulationParameters());
+    return converter.convertTOtoDataDescription(dataTO);
+}
+
+void _CpuSimulationControllerImpl::setSimulationDataIntern(DataDescription const& data)
+{
+    DescriptionConverter converter(_cpuSimulation->getSimulationParameters());
+    auto dataTO = _dataTOCache->getDataTO(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+    _cpuSimulation->setSimulationData(dataTO);
+}
+
+void _CpuSimulationControllerImpl::runThreadLoop()
+{
+    using Clock = std::chrono::steady_clock;
+    auto measurementStart = Clock::now();
+    int timestepsSinceMeasurement = 0;
+
+    while (_isSimulationRunning) {
+        auto timestepStart = Clock::now();
+        {
+            std::lock_guard lock(_mutex);
+            _cpuSimulation->calcTimestep();
+        }
+        ++timestepsSinceMeasurement;
+
+        if (auto tpsRestriction = _tpsRestriction.load(); tpsRestriction > 0) {
+            std::this_thread::sleep_until(timestepStart + std::chrono::microseconds(1000000 / tpsRestriction));
+        }
+
+        auto duration = std::chrono::duration<float>(Clock::now() - measurementStart).count();
+        if (duration > 0.2f) {
+            _tps.store(toFloat(timestepsSinceMeasurement) / duration);
+            measurementStart = Clock::now();
+            timestepsSinceMeasurement = 0;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/OverlayDescriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineGpuKernels/TOs.cuh"
+#include "EngineCpu/Definitions.h"
+
+#include "Definitions.h"
+
+/**
+ * Simulation controller for the host engine. It is intended for machines without CUDA device and for headless runs.
+ * Selections, editing functions, cataclysms, profiling and mutations are not supported, the corresponding methods throw
+ * UnsupportedOperationException. Rendering and GPU specific settings have no effect. Of the cell functions, only nerves, neurons and sensors are executed.
+ */
+class _CpuSimulationControllerImpl : public _SimulationController
+{
+public:
+    _CpuSimulationControllerImpl(int numThreads = 0);  //numThreads = 0: number of hardware threads
+    ~_CpuSimulationControllerImpl();
+
+    void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters) override;
+    void clear() override;
+
+    void setImageResource(void* image) override;
+    std::string getGpuName() const override;
+
+    void tryDrawVectorGraphics(
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) override;
+    std::optional<OverlayDescription> tryDrawVectorGraphicsAndReturnOverlay(
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) override;
+
+    bool isSyncSimulationWithRendering() const override;
+    void setSyncSimulationWithRendering(bool value) override;
+    int getSyncSimulationWithRenderingRatio() const override;
+    void setSyncSimulationWithRenderingRatio(int value) override;
+
+    ClusteredDataDescription getClusteredSimulationData() override;
+    DataDescription getSimulationData() override;
+    ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
+    DataDescription getSelectedSimulationData(bool includeClusters) override;
+    DataDescription getInspectedSimulationData(std::vector<uint64_t> objectIds) override;
+
+    std::future<ClusteredDataDescription> getClusteredSimulationData_async() override;
+    std::future<DataDescription> getSelectedSimulationData_async(bool includeClusters) override;
+    std::future<DataDescription> getInspectedSimulationData_async(std::vector<uint64_t> objectIds) override;
+    std::future<SelectionShallowData> getSelectionShallowData_async() override;
+
+    void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
+    void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
+    void setSimulationData(DataDescription const& dataToUpdate) override;
+    void removeSelectedObjects(bool includeClusters) override;
+    void relaxSelectedObjects(bool includeClusters) override;
+    void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedObjects() override;
+    void setDetached(bool value) override;
+    void changeCell(CellDescription const& changedCell) override;
+    void changeParticle(ParticleDescription const& changedParticle) override;
+
+    void calcTimesteps(uint64_t timesteps) override;
+    void runSimulation() override;
+    void pauseSimulation() override;
+    void applyCataclysm(int power) override;
+
+    bool isSimulationRunning() const override;
+
+    void closeSimulation() override;
+
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t value) override;
+
+    SimulationParameters getSimulationParameters() const override;
+    SimulationParameters const& getOriginalSimulationParameters() const override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+    void setOriginalSimulationParameters(SimulationParameters const& parameters) override;
+
+    GpuSettings getGpuSettings() const override;
+    GpuSettings getOriginalGpuSettings() const override;
+    void setGpuSettings_async(GpuSettings const& gpuSettings) override;
+    void startGpuSettingsTuning() override;
+    std::optional<float> getGpuSettingsTuningProgress() const override;
+
+    void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) override;
+
+    void switchSelection(RealVector2D const& pos, float radius) override;
+    void swapSelection(RealVector2D const& pos, float radius) override;
+    SelectionShallowData getSelectionShallowData() override;
+    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) override;
+    void setSelection(RealVector2D const& startPos, RealVector2D const& endPos) override;
+    void removeSelection() override;
+    bool updateSelectionIfNecessary() override;
+
+    GeneralSettings getGeneralSettings() const override;
+    IntVector2D getWorldSize() const override;
+    StatisticsData getStatistics() const override;
+
+    std::optional<int> getTpsRestriction() const override;
+    void setTpsRestriction(std::optional<int> const& value) override;
+
+    float getTps() const override;
+
+    bool isProfilingEnabled() const override;
+    void setProfilingEnabled(bool value) override;
+    ProfilingData getProfilingData() const override;
+    std::optional<DeviceMemoryData> getDeviceMemoryData() const override;
+
+    //for tests
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
+
+private:
+    DataTO provideTO();
+    DataDescription getSimulationDataIntern();
+    void setSimulationDataIntern(DataDescription const& data);
+    void runThreadLoop();
+
+    int _numThreads = 0;
+    Settings _origSettings;
+    GeneralSettings _generalSettings;
+    GpuSettings _gpuSettings;
+    bool _syncSimulationWithRendering = false;
+    int _syncSimulationWithRenderingRatio = 30;
+
+    mutable std::mutex _mutex;
+    CpuSimulationFacade _cpuSimulation;
+    AccessDataTOCache _dataTOCache;
+
+    std::thread* _thread = nullptr;
+    std::atomic<bool> _isSimulationRunning{false};
+    std::atomic<int> _tpsRestriction{0};  //0 = no restriction
+    std::atomic<float> _tps{0};
+};
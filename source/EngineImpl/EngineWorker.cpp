@@ -2,6 +2,7 @@
 
 #include <chrono>
 
+#include "Base/LoggingService.h"
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/CudaSimulationFacade.cuh"
 #include "AccessDataTOCache.h"
@@ -11,19 +12,30 @@ namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
     std::chrono::milliseconds const StatisticsUpdate(30);
+    std::chrono::microseconds const MaxWaitDuration(1000);
 }
 
 void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
     _accessState = 0;
+    _scheduler.reset();
+    _gpuSettingsTuner.reset();
+    _gpuSettingsTuningProgress = -1.0f;
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+        _settings.gpuSettings = _gpuSettings;
+        _updateGpuSettingsJob = std::nullopt;
+        _startGpuSettingsTuningJob = false;
+    }
     _dataTOCache = std::make_shared<_AccessDataTOCache>();
     _cudaSimulation = std::make_shared<_CudaSimulationFacade>(timestep, _settings);
 
     if (_imageResource) {
         _cudaResource = _cudaSimulation->registerImageResource(*_imageResource);
     }
+    _isRenderSnapshotOutdated = true;
     updateStatistics();
 }
 
@@ -55,16 +67,25 @@ void EngineWorker::tryDrawVectorGraphics(
     IntVector2D const& imageSize,
     double zoom)
 {
+    //drawing from the last render snapshot does not require exclusive access
+    auto startTimepoint = std::chrono::steady_clock::now();
+    if (_cudaSimulation->tryDrawVectorGraphicsFromRenderSnapshot(
+            {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom)) {
+        frameDrawn(startTimepoint);
+        return;
+    }
+
     EngineWorkerGuard access(this, FrameTimeout);
 
     if (!access.isTimeout()) {
+        startTimepoint = std::chrono::steady_clock::now();
         _cudaSimulation->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y},
             {rectLowerRight.x, rectLowerRight.y},
             _cudaResource,
             {imageSize.x, imageSize.y},
             zoom);
-        syncSimulationWithRenderingIfDesired();
+        frameDrawn(startTimepoint);
     }
 }
 
@@ -77,6 +98,7 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
     EngineWorkerGuard access(this, FrameTimeout);
 
     if (!access.isTimeout()) {
+        auto startTimepoint = std::chrono::steady_clock::now();
         _cudaSimulation->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y},
             {rectLowerRight.x, rectLowerRight.y},
@@ -94,7 +116,7 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
         DescriptionConverter converter(_settings.simulationParameters);
         auto result = converter.convertTOtoOverlayDescription(dataTO);
 
-        syncSimulationWithRenderingIfDesired();
+        frameDrawn(startTimepoint);
         return result;
     }
     return std::nullopt;
@@ -123,16 +145,12 @@ void EngineWorker::setSyncSimulationWithRenderingRatio(int value)
 ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
     EngineWorkerGuard access(this);
+    return getClusteredSimulationDataIntern(rectUpperLeft, rectLowerRight);
+}
 
-    DataTO dataTO = provideTO();
-    
-    _cudaSimulation->getSimulationData(
-        {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
-
-    DescriptionConverter converter(_settings.simulationParameters);
-
-    auto result = converter.convertTOtoClusteredDataDescription(dataTO);
-    return result;
+std::future<ClusteredDataDescription> EngineWorker::getClusteredSimulationData_async(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    return addDataAccessJob<ClusteredDataDescription>([=, this] { return getClusteredSimulationDataIntern(rectUpperLeft, rectLowerRight); });
 }
 
 DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
@@ -166,30 +184,27 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    return getSelectedSimulationDataIntern(includeClusters);
+}
 
-    DataTO dataTO = provideTO();
-    
-    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
-
-    DescriptionConverter converter(_settings.simulationParameters);
-
-    auto result = converter.convertTOtoDataDescription(dataTO);
-
-    return result;
+std::future<DataDescription> EngineWorker::getSelectedSimulationData_async(bool includeClusters)
+{
+    return addDataAccessJob<DataDescription>([=, this] {
+        _cudaSimulation->updateSelection();
+        _isRenderSnapshotOutdated = true;
+        return getSelectedSimulationDataIntern(includeClusters);
+    });
 }
 
 DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> objectsIds)
 {
     EngineWorkerGuard access(this);
+    return getInspectedSimulationDataIntern(objectsIds);
+}
 
-    DataTO dataTO = provideTO();
-    
-    _cudaSimulation->getInspectedSimulationData(objectsIds, dataTO);
-
-    DescriptionConverter converter(_settings.simulationParameters);
-
-    auto result = converter.convertTOtoDataDescription(dataTO);
-    return result;
+std::future<DataDescription> EngineWorker::getInspectedSimulationData_async(std::vector<uint64_t> objectsIds)
+{
+    return addDataAccessJob<DataDescription>([=, this] { return getInspectedSimulationDataIntern(objectsIds); });
 }
 
 StatisticsData EngineWorker::getStatistics() const
@@ -323,6 +338,7 @@ void EngineWorker::calcTimesteps(uint64_t timesteps)
 
     for (uint64_t i = 0; i < timesteps; ++i) {
         _cudaSimulation->calcTimestep();
+        processProfilingData();
     }
     updateStatistics();
 }
@@ -381,14 +397,65 @@ SimulationParameters EngineWorker::getSimulationParameters() const
 void EngineWorker::setSimulationParameters(SimulationParameters const& parameters)
 {
     _cudaSimulation->setSimulationParameters(parameters);
+    _isRenderSnapshotOutdated = true;
+}
+
+GpuSettings EngineWorker::getGpuSettings() const
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    return _gpuSettings;
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    _gpuSettings = gpuSettings;
     _updateGpuSettingsJob = gpuSettings;
 }
 
+bool EngineWorker::isProfilingEnabled() const
+{
+    return _isProfilingEnabled;
+}
+
+void EngineWorker::setProfilingEnabled(bool value)
+{
+    std::lock_guard guard(_mutexForProfiling);
+    _isProfilingEnabled = value;
+    _profilingAggregator.reset();
+}
+
+ProfilingData EngineWorker::getProfilingData() const
+{
+    std::lock_guard guard(_mutexForProfiling);
+    return _profilingAggregator.getData(std::chrono::steady_clock::now());
+}
+
+DeviceMemoryData EngineWorker::getDeviceMemoryData() const
+{
+    DeviceMemoryData result;
+    result.memory = _cudaSimulation->getDeviceMemory();
+    result.peakMemory = _cudaSimulation->getPeakDeviceMemory();
+    result.numArrayResizes = _cudaSimulation->getNumArrayResizes();
+    return result;
+}
+
+void EngineWorker::startGpuSettingsTuning_async()
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    _startGpuSettingsTuningJob = true;
+}
+
+std::optional<float> EngineWorker::getGpuSettingsTuningProgress() const
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    if (_startGpuSettingsTuningJob) {
+        return 0.0f;
+    }
+    auto result = _gpuSettingsTuningProgress.load();
+    return result >= 0 ? std::make_optional(result) : std::nullopt;
+}
+
 void EngineWorker::applyForce_async(
     RealVector2D const& start,
     RealVector2D const& end,
@@ -417,6 +484,11 @@ SelectionShallowData EngineWorker::getSelectionShallowData()
     return _cudaSimulation->getSelectionShallowData();
 }
 
+std::future<SelectionShallowData> EngineWorker::getSelectionShallowData_async()
+{
+    return addDataAccessJob<SelectionShallowData>([this] { return _cudaSimulation->getSelectionShallowData(); });
+}
+
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
     EngineWorkerGuard access(this);
@@ -468,28 +540,41 @@ void EngineWorker::setDetached(bool value)
 void EngineWorker::runThreadLoop()
 {
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
-
         while (!_isShutdown.load()) {
 
-            if (!_syncSimulationWithRendering && _accessState == 0) {
-                if (_isSimulationRunning.load()) {
-                    _cudaSimulation->calcTimestep();
+            //other thread has access
+            if (_accessState == 2) {
+                continue;
+            }
 
-                    if (++_statisticsCounter == 3) {  //for performance reasons...
-                        updateStatistics(true);
-                        _statisticsCounter = 0;
-                    }
+            processJobs();
+            processRenderSnapshot();
+
+            auto now = std::chrono::steady_clock::now();
+            auto isSimulationRunning = _isSimulationRunning.load();
+            switch (_scheduler.decide(now, isSimulationRunning, _accessState == 1)) {
+            case TimestepScheduler::Decision::CalcTimestep: {
+                _cudaSimulation->calcTimestep();
+                _scheduler.timestepCalculated(now, std::chrono::steady_clock::now());
+                _isRenderSnapshotOutdated = true;
+                processProfilingData();
+
+                if (++_statisticsCounter == 3) {  //for performance reasons...
+                    updateStatistics(true);
+                    _statisticsCounter = 0;
                 }
                 measureTPS();
-                slowdownTPS();
-            }
-            
-            processJobs();
-
-            if (_accessState == 1) {
+            } break;
+            case TimestepScheduler::Decision::ServiceAccessRequest: {
                 _accessState = 2;
+            } break;
+            case TimestepScheduler::Decision::Wait: {
+                if (!isSimulationRunning) {
+                    measureTPS();
+                }
+                processProfilingData();
+                waitAndAllowAccess(std::min(_scheduler.getWaitDuration(now), MaxWaitDuration));
+            } break;
             }
         }
     } catch (std::exception const& e) {
@@ -525,6 +610,54 @@ DataTO EngineWorker::provideTO()
     return _dataTOCache->getDataTO(_cudaSimulation->getArraySizes());
 }
 
+template <typename T>
+std::future<T> EngineWorker::addDataAccessJob(std::function<T()> const& job)
+{
+    auto promise = std::make_shared<std::promise<T>>();
+    auto result = promise->get_future();
+
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    //errors are only delivered through the future so that the worker thread and the remaining jobs of the batch are not affected
+    _dataAccessJobs.emplace_back([promise, job] {
+        try {
+            promise->set_value(job());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
+
+ClusteredDataDescription EngineWorker::getClusteredSimulationDataIntern(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    DataTO dataTO = provideTO();
+
+    _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    return converter.convertTOtoClusteredDataDescription(dataTO);
+}
+
+DataDescription EngineWorker::getSelectedSimulationDataIntern(bool includeClusters)
+{
+    DataTO dataTO = provideTO();
+
+    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    return converter.convertTOtoDataDescription(dataTO);
+}
+
+DataDescription EngineWorker::getInspectedSimulationDataIntern(std::vector<uint64_t> const& objectsIds)
+{
+    DataTO dataTO = provideTO();
+
+    _cudaSimulation->getInspectedSimulationData(objectsIds, dataTO);
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    return converter.convertTOtoDataDescription(dataTO);
+}
+
 void EngineWorker::resetTimeIntervalStatistics()
 {
     std::lock_guard guard(_mutexForStatistics);
@@ -544,11 +677,33 @@ void EngineWorker::updateStatistics(bool afterMinDuration)
 
 void EngineWorker::processJobs()
 {
+    updateSchedulerSettings();
+
     std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
+    if (_frameDrawnJob) {
+        _scheduler.frameDrawn(_frameDrawnJob->endTimepoint, _frameDrawnJob->drawDuration);
+        _frameDrawnJob = std::nullopt;
+    }
     if (_updateGpuSettingsJob) {
+
+        //manual changes cancel a running tuning
+        if (_gpuSettingsTuner) {
+            _gpuSettingsTuner.reset();
+            _gpuSettingsTuningProgress = -1.0f;
+        }
+        _settings.gpuSettings = *_updateGpuSettingsJob;
         _cudaSimulation->setGpuConstants(*_updateGpuSettingsJob);
         _updateGpuSettingsJob = std::nullopt;
     }
+    if (_startGpuSettingsTuningJob) {
+        auto initialSettings = _gpuSettings;
+        initialSettings.resetPhases();
+        _gpuSettingsTuner.emplace(initialSettings);
+        _gpuSettingsTuningProgress = 0.0f;
+        _cudaSimulation->setGpuConstants(_gpuSettingsTuner->getCurrentSettings());
+        _startGpuSettingsTuningJob = false;
+        log(Priority::Important, "gpu settings tuning started");
+    }
     if (!_applyForceJobs.empty()) {
         for (auto const& applyForceJob : _applyForceJobs) {
             _cudaSimulation->applyForce(
@@ -560,25 +715,92 @@ void EngineWorker::processJobs()
         }
         _applyForceJobs.clear();
     }
+    _cudaSimulation->setProfilingEnabled(_isProfilingEnabled || _gpuSettingsTuner.has_value());
+
+    //data access jobs are processed without lock since they may take longer
+    if (!_dataAccessJobs.empty()) {
+        auto dataAccessJobs = std::move(_dataAccessJobs);
+        _dataAccessJobs.clear();
+        asyncJobsLock.unlock();
+
+        for (auto const& dataAccessJob : dataAccessJobs) {
+            dataAccessJob();
+        }
+    }
 }
 
-void EngineWorker::syncSimulationWithRenderingIfDesired()
+void EngineWorker::processRenderSnapshot()
 {
-    if (_syncSimulationWithRendering && _isSimulationRunning) {
-        for (int i = 0; i < _syncSimulationWithRenderingRatio; ++i) {
-            calcTimesteps(1);
-            measureTPS();
-            slowdownTPS();
+    //a new snapshot is only created after the last one has been drawn
+    if (_isRenderSnapshotOutdated && _cudaSimulation->isRenderSnapshotRequired()) {
+        if (_cudaSimulation->publishRenderSnapshot()) {
+            _isRenderSnapshotOutdated = false;
         }
     }
 }
 
+void EngineWorker::processProfilingData()
+{
+    if (!_isProfilingEnabled && !_gpuSettingsTuner.has_value()) {
+        return;
+    }
+    auto scopeDurations = _cudaSimulation->fetchProfilingScopeDurations();
+    if (scopeDurations.empty()) {
+        return;
+    }
+    if (_gpuSettingsTuner) {
+        processGpuSettingsTuning(scopeDurations);
+    }
+    if (_isProfilingEnabled) {
+        std::lock_guard guard(_mutexForProfiling);
+        _profilingAggregator.add(std::chrono::steady_clock::now(), scopeDurations);
+    }
+}
+
+void EngineWorker::processGpuSettingsTuning(std::vector<ProfilingScopeDuration> const& scopeDurations)
+{
+    _gpuSettingsTuner->addMeasurement(GpuSettingsTuner::calcKernelPhaseDurations(scopeDurations));
+    if (!_gpuSettingsTuner->isFinished()) {
+        _cudaSimulation->setGpuConstants(_gpuSettingsTuner->getCurrentSettings());
+        _gpuSettingsTuningProgress = _gpuSettingsTuner->getProgress();
+        return;
+    }
+
+    auto bestSettings = _gpuSettingsTuner->getBestSettings();
+    _gpuSettingsTuner.reset();
+    _cudaSimulation->setGpuConstants(bestSettings);
+    _settings.gpuSettings = bestSettings;
+    GpuSettingsTuner::saveTunedSettings(getGpuName(), {_settings.generalSettings.worldSizeX, _settings.generalSettings.worldSizeY}, bestSettings);
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+        _gpuSettings = bestSettings;
+    }
+    _gpuSettingsTuningProgress = -1.0f;
+    log(Priority::Important, "gpu settings tuning finished");
+}
+
+void EngineWorker::frameDrawn(std::chrono::steady_clock::time_point const& startTimepoint)
+{
+    auto endTimepoint = std::chrono::steady_clock::now();
+    auto drawDuration = std::chrono::duration_cast<std::chrono::microseconds>(endTimepoint - startTimepoint);
+
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    _frameDrawnJob = FrameDrawnJob{endTimepoint, drawDuration};
+}
+
+void EngineWorker::updateSchedulerSettings()
+{
+    auto tpsRestriction = _tpsRestriction.load();
+    _scheduler.setTpsRestriction(tpsRestriction > 0 ? std::optional<int>(tpsRestriction) : std::nullopt);
+    _scheduler.setStepsPerFrame(_syncSimulationWithRendering ? std::optional<int>(_syncSimulationWithRenderingRatio.load()) : std::nullopt);
+}
+
 void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
 {
     auto startTimepoint = std::chrono::steady_clock::now();
     while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
         if (_accessState == 1) {
-            _accessState = 2;
+            return;
         }
     }
 }
@@ -607,26 +829,6 @@ void EngineWorker::measureTPS()
     }
 }
 
-void EngineWorker::slowdownTPS()
-{
-    if (_slowDownTimepoint) {
-        auto timestepDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *_slowDownTimepoint);
-        if (_slowDownOvershot) {
-            timestepDuration += *_slowDownOvershot;
-        }
-        auto tpsRestriction = _tpsRestriction.load();
-        if (_isSimulationRunning.load() && tpsRestriction > 0) {
-            auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
-            if (desiredDuration > timestepDuration) {
-                waitAndAllowAccess(desiredDuration - timestepDuration);
-            } else {
-            }
-            _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
-        }
-    }
-    _slowDownTimepoint = std::chrono::steady_clock::now();
-}
-
 EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::chrono::milliseconds> const& maxDuration)
     : _worker(worker)
 {
@@ -639,6 +841,7 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
         auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
         if (maxDuration) {
             if (timePassed > *maxDuration) {
+                _isTimeout = true;
                 break;
             }
         } else {
@@ -653,6 +856,7 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
+    _worker->_isRenderSnapshotOutdated = true;  //simulation data may have been changed
     _worker->_accessState = 0;
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
+#include <future>
 #include <mutex>
 #include <condition_variable>
 
@@ -23,6 +25,9 @@
 #include "EngineGpuKernels/Definitions.h"
 
 #include "Definitions.h"
+#include "GpuSettingsTuner.h"
+#include "ProfilingAggregator.h"
+#include "TimestepScheduler.h"
 
 struct ExceptionData
 {
@@ -56,6 +61,12 @@ public:
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters);
     DataDescription getSelectedSimulationData(bool includeClusters);
     DataDescription getInspectedSimulationData(std::vector<uint64_t> objectsIds);
+
+    //processed by the worker thread between time steps without blocking the caller
+    std::future<ClusteredDataDescription> getClusteredSimulationData_async(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    std::future<DataDescription> getSelectedSimulationData_async(bool includeClusters);  //selection is updated beforehand
+    std::future<DataDescription> getInspectedSimulationData_async(std::vector<uint64_t> objectsIds);
+    std::future<SelectionShallowData> getSelectionShallowData_async();
     StatisticsData getStatistics() const;
 
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
@@ -85,7 +96,15 @@ public:
 
     SimulationParameters getSimulationParameters() const;
     void setSimulationParameters(SimulationParameters const& parameters);
+    GpuSettings getGpuSettings() const;
     void setGpuSettings_async(GpuSettings const& gpuSettings);
+    void startGpuSettingsTuning_async();
+    std::optional<float> getGpuSettingsTuningProgress() const;
+
+    bool isProfilingEnabled() const;
+    void setProfilingEnabled(bool value);
+    ProfilingData getProfilingData() const;
+    DeviceMemoryData getDeviceMemoryData() const;
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius);
 
@@ -110,14 +129,22 @@ public:
 
 private:
     DataTO provideTO(); 
+    template <typename T>
+    std::future<T> addDataAccessJob(std::function<T()> const& job);
+    ClusteredDataDescription getClusteredSimulationDataIntern(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    DataDescription getSelectedSimulationDataIntern(bool includeClusters);
+    DataDescription getInspectedSimulationDataIntern(std::vector<uint64_t> const& objectsIds);
     void resetTimeIntervalStatistics();
     void updateStatistics(bool afterMinDuration = false);
     void processJobs();
+    void processRenderSnapshot();
+    void processProfilingData();
+    void processGpuSettingsTuning(std::vector<ProfilingScopeDuration> const& scopeDurations);
 
-    void syncSimulationWithRenderingIfDesired();
+    void frameDrawn(std::chrono::steady_clock::time_point const& startTimepoint);
+    void updateSchedulerSettings();
     void waitAndAllowAccess(std::chrono::microseconds const& duration);
     void measureTPS();
-    void slowdownTPS();
 
     CudaSimulationFacade _cudaSimulation;
 
@@ -130,11 +157,14 @@ private:
     std::atomic<int> _accessState{0};  //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
     std::atomic<bool> _isSimulationRunning{false};
     std::atomic<bool> _isShutdown{false};
+    std::atomic<bool> _isRenderSnapshotOutdated{false};
     ExceptionData _exceptionData;
 
     //async jobs
     mutable std::mutex _mutexForAsyncJobs;
+    GpuSettings _gpuSettings;
     std::optional<GpuSettings> _updateGpuSettingsJob;
+    bool _startGpuSettingsTuningJob = false;
     std::optional<GLuint> _imageResource;
 
     struct ApplyForceJob
@@ -146,13 +176,29 @@ private:
     };
     std::vector<ApplyForceJob> _applyForceJobs;
 
+    struct FrameDrawnJob
+    {
+        std::chrono::steady_clock::time_point endTimepoint;
+        std::chrono::microseconds drawDuration;
+    };
+    std::optional<FrameDrawnJob> _frameDrawnJob;
+    std::vector<std::function<void()>> _dataAccessJobs;
+
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
     std::atomic<float> _tps;
     int _timestepsSinceMeasurement = 0;
     std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
-    std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
-    std::optional<std::chrono::microseconds> _slowDownOvershot;
+    TimestepScheduler _scheduler;
+
+    //gpu settings tuning
+    std::optional<GpuSettingsTuner> _gpuSettingsTuner;
+    std::atomic<float> _gpuSettingsTuningProgress{-1.0f};  //negative = no tuning in progress
+
+    //profiling
+    std::atomic<bool> _isProfilingEnabled{false};
+    mutable std::mutex _mutexForProfiling;
+    ProfilingAggregator _profilingAggregator;
   
     //statistics data
     std::optional<std::chrono::steady_clock::time_point> _lastStatisticsUpdateTime;
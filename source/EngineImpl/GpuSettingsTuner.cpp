@@ -0,0 +1,173 @@
+#include "GpuSettingsTuner.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+#include "Base/GlobalSettings.h"
+
+namespace
+{
+    char const* const PhaseKeys[KernelPhase_Count] = {"physics", "cell functions", "structural operations"};
+
+    std::string getPhaseKey(std::string const& gpuName, IntVector2D const& worldSize, KernelPhase phase)
+    {
+        auto gpuKey = gpuName;
+        std::replace(gpuKey.begin(), gpuKey.end(), '.', '_');  //'.' separates the key levels
+        return "settings.gpu.tuned." + gpuKey + "." + std::to_string(worldSize.x) + "x" + std::to_string(worldSize.y) + "." + PhaseKeys[phase];
+    }
+
+    float calcMedian(std::vector<float> values)
+    {
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+}
+
+GpuSettingsTuner::GpuSettingsTuner(GpuSettings const& initialSettings, GpuSettingsTunerParameters const& parameters)
+    : _parameters(parameters)
+    , _initialSettings(initialSettings)
+{
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        auto phaseSettings = initialSettings.getForPhase(phase);
+        _bestNumThreadsPerBlock[phase] = phaseSettings.numThreadsPerBlock;
+        _bestNumBlocks[phase] = phaseSettings.numBlocks;
+    }
+    if (getNumCandidates() == 0) {
+        nextCandidate();
+    }
+}
+
+GpuSettings GpuSettingsTuner::getCurrentSettings() const
+{
+    if (_stage == Stage::Finished) {
+        return getBestSettings();
+    }
+    auto result = _initialSettings;
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        if (_stage == Stage::NumThreadsPerBlock) {
+            result.numThreadsPerBlockByPhase[phase] = _parameters.numThreadsPerBlockCandidates.at(_candidateIndex);
+            result.numBlocksByPhase[phase] = _bestNumBlocks[phase];
+        } else {
+            result.numThreadsPerBlockByPhase[phase] = _bestNumThreadsPerBlock[phase];
+            result.numBlocksByPhase[phase] = _parameters.numBlocksCandidates.at(_candidateIndex);
+        }
+    }
+    return result;
+}
+
+void GpuSettingsTuner::addMeasurement(KernelPhaseDurations const& durations)
+{
+    if (_stage == Stage::Finished) {
+        return;
+    }
+    if (std::none_of(durations.begin(), durations.end(), [](auto const& duration) { return duration.has_value(); })) {
+        return;  //no time step has been calculated
+    }
+    ++_numTimesteps;
+    if (_timestepForCandidate++ >= _parameters.warmupTimesteps) {
+        for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+            if (durations.at(phase)) {
+                _samples[phase].emplace_back(*durations.at(phase));
+            }
+        }
+    }
+    if (_timestepForCandidate >= _parameters.warmupTimesteps + _parameters.measuredTimesteps) {
+        evaluateCandidate();
+        nextCandidate();
+    }
+}
+
+bool GpuSettingsTuner::isFinished() const
+{
+    return _stage == Stage::Finished;
+}
+
+float GpuSettingsTuner::getProgress() const
+{
+    if (_stage == Stage::Finished) {
+        return 1.0f;
+    }
+    auto numCandidates = _parameters.numThreadsPerBlockCandidates.size() + _parameters.numBlocksCandidates.size();
+    auto totalTimesteps = numCandidates * (_parameters.warmupTimesteps + _parameters.measuredTimesteps);
+    return std::min(1.0f, toFloat(_numTimesteps) / toFloat(totalTimesteps));
+}
+
+GpuSettings GpuSettingsTuner::getBestSettings() const
+{
+    auto result = _initialSettings;
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        result.numThreadsPerBlockByPhase[phase] = _bestNumThreadsPerBlock[phase];
+        result.numBlocksByPhase[phase] = _bestNumBlocks[phase];
+    }
+    return result;
+}
+
+KernelPhaseDurations GpuSettingsTuner::calcKernelPhaseDurations(std::vector<ProfilingScopeDuration> const& scopeDurations)
+{
+    KernelPhaseDurations result;
+    for (auto const& scopeDuration : scopeDurations) {
+        for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+            if (scopeDuration.name == KernelPhaseNames[phase]) {
+                result.at(phase) = result.at(phase).value_or(0.0f) + scopeDuration.duration;
+            }
+        }
+    }
+    return result;
+}
+
+std::optional<GpuSettings> GpuSettingsTuner::loadTunedSettings(std::string const& gpuName, IntVector2D const& worldSize, GpuSettings const& baseSettings)
+{
+    auto result = baseSettings;
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        auto key = getPhaseKey(gpuName, worldSize, phase);
+        result.numBlocksByPhase[phase] = GlobalSettings::getInstance().getIntState(key + ".num blocks", 0);
+        result.numThreadsPerBlockByPhase[phase] = GlobalSettings::getInstance().getIntState(key + ".num threads per block", 0);
+        if (result.numBlocksByPhase[phase] <= 0 || result.numThreadsPerBlockByPhase[phase] <= 0) {
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+void GpuSettingsTuner::saveTunedSettings(std::string const& gpuName, IntVector2D const& worldSize, GpuSettings const& settings)
+{
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        auto key = getPhaseKey(gpuName, worldSize, phase);
+        auto phaseSettings = settings.getForPhase(phase);
+        GlobalSettings::getInstance().setIntState(key + ".num blocks", phaseSettings.numBlocks);
+        GlobalSettings::getInstance().setIntState(key + ".num threads per block", phaseSettings.numThreadsPerBlock);
+    }
+}
+
+int GpuSettingsTuner::getNumCandidates() const
+{
+    return toInt(_stage == Stage::NumThreadsPerBlock ? _parameters.numThreadsPerBlockCandidates.size() : _parameters.numBlocksCandidates.size());
+}
+
+void GpuSettingsTuner::evaluateCandidate()
+{
+    auto settings = getCurrentSettings();
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        if (_samples[phase].empty()) {
+            continue;
+        }
+        auto duration = calcMedian(_samples[phase]);
+        if (!_bestDuration[phase] || duration < *_bestDuration[phase]) {
+            _bestDuration[phase] = duration;
+            _bestNumThreadsPerBlock[phase] = settings.numThreadsPerBlockByPhase[phase];
+            _bestNumBlocks[phase] = settings.numBlocksByPhase[phase];
+        }
+        _samples[phase].clear();
+    }
+}
+
+void GpuSettingsTuner::nextCandidate()
+{
+    _timestepForCandidate = 0;
+    ++_candidateIndex;
+    while (_stage != Stage::Finished && _candidateIndex >= getNumCandidates()) {
+        _candidateIndex = 0;
+        _stage = _stage == Stage::NumThreadsPerBlock ? Stage::NumBlocks : Stage::Finished;
+    }
+}
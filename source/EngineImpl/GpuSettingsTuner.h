@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Base/Vector2D.h"
+#include "EngineInterface/GpuSettings.h"
+#include "EngineInterface/KernelPhaseDurations.h"
+#include "EngineInterface/ProfilingData.h"
+
+struct GpuSettingsTunerParameters
+{
+    std::vector<int> numThreadsPerBlockCandidates = {8, 16, 32, 64, 128, 256};
+    std::vector<int> numBlocksCandidates = {1024, 2048, 4096, 8192, 16384, 32768, 65536};
+    int warmupTimesteps = 3;  //not measured after a configuration change
+    int measuredTimesteps = 15;
+};
+
+/**
+ * Searches launch configurations (blocks and threads per block) for each phase of a time step. The search is driven
+ * by the measured phase durations of consecutive time steps: the caller applies 'getCurrentSettings()' for the next time
+ * step and reports the measured durations via 'addMeasurement(...)'. Since the durations of all phases are measured in
+ * each time step, the phases are tuned simultaneously. First the number of threads per block is determined with fixed
+ * number of blocks, then the number of blocks with the best number of threads.
+ */
+class GpuSettingsTuner
+{
+public:
+    GpuSettingsTuner(GpuSettings const& initialSettings, GpuSettingsTunerParameters const& parameters = GpuSettingsTunerParameters());
+
+    GpuSettings getCurrentSettings() const;
+    void addMeasurement(KernelPhaseDurations const& durations);
+
+    bool isFinished() const;
+    float getProgress() const;  //between 0 and 1
+    GpuSettings getBestSettings() const;
+
+    //phases are measured in profiling scopes named by 'KernelPhaseNames'
+    static KernelPhaseDurations calcKernelPhaseDurations(std::vector<ProfilingScopeDuration> const& scopeDurations);
+
+    //tuned settings depend on the device and world size
+    static std::optional<GpuSettings> loadTunedSettings(std::string const& gpuName, IntVector2D const& worldSize, GpuSettings const& baseSettings);
+    static void saveTunedSettings(std::string const& gpuName, IntVector2D const& worldSize, GpuSettings const& settings);
+
+private:
+    enum class Stage
+    {
+        NumThreadsPerBlock,
+        NumBlocks,
+        Finished
+    };
+
+    int getNumCandidates() const;
+    void evaluateCandidate();
+    void nextCandidate();
+
+    GpuSettingsTunerParameters _parameters;
+    GpuSettings _initialSettings;
+
+    Stage _stage = Stage::NumThreadsPerBlock;
+    int _candidateIndex = 0;
+    int _timestepForCandidate = 0;
+    int _numTimesteps = 0;
+    std::vector<float> _samples[KernelPhase_Count];
+
+    int _bestNumThreadsPerBlock[KernelPhase_Count];
+    int _bestNumBlocks[KernelPhase_Count];
+    std::optional<float> _bestDuration[KernelPhase_Count];
+};
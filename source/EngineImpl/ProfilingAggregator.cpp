@@ -0,0 +1,77 @@
+#include "ProfilingAggregator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    //nearest-rank method
+    float getPercentile(std::vector<float> const& sortedValues, double percentile)
+    {
+        auto rank = toInt(std::ceil(percentile * toDouble(sortedValues.size())));
+        return sortedValues.at(std::max(0, rank - 1));
+    }
+}
+
+ProfilingAggregator::ProfilingAggregator(Clock::duration const& window, int maxSamplesPerScope)
+    : _window(window)
+    , _maxSamplesPerScope(maxSamplesPerScope)
+{}
+
+void ProfilingAggregator::add(Clock::time_point const& time, std::vector<ProfilingScopeDuration> const& scopeDurations)
+{
+    for (auto const& scopeDuration : scopeDurations) {
+        auto findResult = std::find_if(_scopes.begin(), _scopes.end(), [&](auto const& scope) { return scope.name == scopeDuration.name; });
+        if (findResult == _scopes.end()) {
+            _scopes.emplace_back(ScopeSamples{scopeDuration.name});
+            findResult = std::prev(_scopes.end());
+        }
+        findResult->samples.emplace_back(Sample{time, scopeDuration.duration});
+    }
+
+    for (auto& scope : _scopes) {
+        auto& samples = scope.samples;
+        while (!samples.empty() && (samples.front().time + _window < time || toInt(samples.size()) > _maxSamplesPerScope)) {
+            samples.pop_front();
+        }
+    }
+}
+
+ProfilingData ProfilingAggregator::getData(Clock::time_point const& now) const
+{
+    ProfilingData result;
+    for (auto const& scope : _scopes) {
+        std::vector<float> durations;
+        for (auto const& sample : scope.samples) {
+            if (sample.time + _window >= now) {
+                durations.emplace_back(sample.duration);
+            }
+        }
+        if (durations.empty()) {
+            continue;
+        }
+        std::sort(durations.begin(), durations.end());
+
+        ProfilingScopeData scopeData;
+        scopeData.name = scope.name;
+        scopeData.numSamples = toInt(durations.size());
+        auto sum = 0.0;
+        for (auto const& duration : durations) {
+            sum += duration;
+        }
+        scopeData.mean = toFloat(sum / durations.size());
+        scopeData.median = getPercentile(durations, 0.5);
+        scopeData.percentile95 = getPercentile(durations, 0.95);
+        scopeData.percentile99 = getPercentile(durations, 0.99);
+        scopeData.max = durations.back();
+        result.scopes.emplace_back(scopeData);
+    }
+    return result;
+}
+
+void ProfilingAggregator::reset()
+{
+    _scopes.clear();
+}
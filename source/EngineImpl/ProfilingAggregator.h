@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "EngineInterface/ProfilingData.h"
+
+/**
+ * Aggregates the measured durations of profiling scopes to rolling statistics (mean and percentiles) over a time window.
+ * Like the TimestepScheduler it does not query any clock itself so that it can be used with fake time in tests.
+ */
+class ProfilingAggregator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ProfilingAggregator(Clock::duration const& window = DefaultWindow, int maxSamplesPerScope = DefaultMaxSamplesPerScope);
+
+    void add(Clock::time_point const& time, std::vector<ProfilingScopeDuration> const& scopeDurations);
+    ProfilingData getData(Clock::time_point const& now) const;
+    void reset();
+
+    static Clock::duration constexpr DefaultWindow = std::chrono::seconds(5);
+    static int constexpr DefaultMaxSamplesPerScope = 10000;
+
+private:
+    struct Sample
+    {
+        Clock::time_point time;
+        float duration;
+    };
+    struct ScopeSamples
+    {
+        std::string name;
+        std::deque<Sample> samples;
+    };
+
+    Clock::duration _window;
+    int _maxSamplesPerScope;
+    std::vector<ScopeSamples> _scopes;  //in order of their first occurrence
+};
@@ -0,0 +1,12 @@
+#include "SimulationControllerFactory.h"
+
+#include "CpuSimulationControllerImpl.h"
+#include "SimulationControllerImpl.h"
+
+SimulationController SimulationControllerFactory::create(SimulationBackend backend, int numThreads)
+{
+    if (backend == SimulationBackend_Cpu) {
+        return std::make_shared<_CpuSimulationControllerImpl>(numThreads);
+    }
+    return std::make_shared<_SimulationControllerImpl>();
+}
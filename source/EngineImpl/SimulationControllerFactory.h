@@ -0,0 +1,11 @@
+#pragma once
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/SimulationBackend.h"
+
+class SimulationControllerFactory
+{
+public:
+    //numThreads is only used for the CPU backend (0 = number of hardware threads)
+    static SimulationController create(SimulationBackend backend, int numThreads = 0);
+};
@@ -2,11 +2,22 @@
 
 #include "EngineInterface/Descriptions.h"
 
+#include "GpuSettingsTuner.h"
+
 void _SimulationControllerImpl::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
     _generalSettings = generalSettings;
     _origSettings.generalSettings = generalSettings;
     _origSettings.simulationParameters = parameters;
+
+    //launch configurations of the phases have been tuned for a specific world size
+    auto gpuSettings = _worker.getGpuSettings();
+    gpuSettings.resetPhases();
+    if (auto tunedSettings = GpuSettingsTuner::loadTunedSettings(getGpuName(), {generalSettings.worldSizeX, generalSettings.worldSizeY}, gpuSettings)) {
+        gpuSettings = *tunedSettings;
+    }
+    _worker.setGpuSettings_async(gpuSettings);
+
     _worker.newSimulation(timestep, generalSettings, parameters);
 
     _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
@@ -98,6 +109,27 @@ DataDescription _SimulationControllerImpl::getInspectedSimulationData(std::vecto
     return _worker.getInspectedSimulationData(objectIds);
 }
 
+std::future<ClusteredDataDescription> _SimulationControllerImpl::getClusteredSimulationData_async()
+{
+    auto size = getWorldSize();
+    return _worker.getClusteredSimulationData_async({-10, -10}, {size.x + 10, size.y + 10});
+}
+
+std::future<DataDescription> _SimulationControllerImpl::getSelectedSimulationData_async(bool includeClusters)
+{
+    return _worker.getSelectedSimulationData_async(includeClusters);
+}
+
+std::future<DataDescription> _SimulationControllerImpl::getInspectedSimulationData_async(std::vector<uint64_t> objectIds)
+{
+    return _worker.getInspectedSimulationData_async(objectIds);
+}
+
+std::future<SelectionShallowData> _SimulationControllerImpl::getSelectionShallowData_async()
+{
+    return _worker.getSelectionShallowData_async();
+}
+
 void _SimulationControllerImpl::addAndSelectSimulationData(DataDescription const& dataToAdd)
 {
     _worker.addAndSelectSimulationData(dataToAdd);
@@ -239,7 +271,7 @@ void _SimulationControllerImpl::setOriginalSimulationParameters(SimulationParame
 
 GpuSettings _SimulationControllerImpl::getGpuSettings() const
 {
-    return _gpuSettings;
+    return _worker.getGpuSettings();
 }
 
 GpuSettings _SimulationControllerImpl::getOriginalGpuSettings() const
@@ -249,10 +281,19 @@ GpuSettings _SimulationControllerImpl::getOriginalGpuSettings() const
 
 void _SimulationControllerImpl::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    _gpuSettings = gpuSettings;
     _worker.setGpuSettings_async(gpuSettings);
 }
 
+void _SimulationControllerImpl::startGpuSettingsTuning()
+{
+    _worker.startGpuSettingsTuning_async();
+}
+
+std::optional<float> _SimulationControllerImpl::getGpuSettingsTuningProgress() const
+{
+    return _worker.getGpuSettingsTuningProgress();
+}
+
 void _SimulationControllerImpl::applyForce_async(
     RealVector2D const& start,
     RealVector2D const& end,
@@ -333,6 +374,26 @@ float _SimulationControllerImpl::getTps() const
     return _worker.getTps();
 }
 
+bool _SimulationControllerImpl::isProfilingEnabled() const
+{
+    return _worker.isProfilingEnabled();
+}
+
+void _SimulationControllerImpl::setProfilingEnabled(bool value)
+{
+    _worker.setProfilingEnabled(value);
+}
+
+ProfilingData _SimulationControllerImpl::getProfilingData() const
+{
+    return _worker.getProfilingData();
+}
+
+std::optional<DeviceMemoryData> _SimulationControllerImpl::getDeviceMemoryData() const
+{
+    return _worker.getDeviceMemoryData();
+}
+
 void _SimulationControllerImpl::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     _worker.testOnly_mutate(cellId, mutationType);
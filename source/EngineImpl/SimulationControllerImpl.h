@@ -48,6 +48,11 @@ public:
     DataDescription getSelectedSimulationData(bool includeClusters) override;
     DataDescription getInspectedSimulationData(std::vector<uint64_t> objectIds) override;
 
+    std::future<ClusteredDataDescription> getClusteredSimulationData_async() override;
+    std::future<DataDescription> getSelectedSimulationData_async(bool includeClusters) override;
+    std::future<DataDescription> getInspectedSimulationData_async(std::vector<uint64_t> objectIds) override;
+    std::future<SelectionShallowData> getSelectionShallowData_async() override;
+
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
@@ -83,6 +88,8 @@ public:
     GpuSettings getGpuSettings() const override;
     GpuSettings getOriginalGpuSettings() const override;
     void setGpuSettings_async(GpuSettings const& gpuSettings) override;
+    void startGpuSettingsTuning() override;
+    std::optional<float> getGpuSettingsTuningProgress() const override;
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) override;
 
@@ -103,6 +110,11 @@ public:
 
     float getTps() const override;
 
+    bool isProfilingEnabled() const override;
+    void setProfilingEnabled(bool value) override;
+    ProfilingData getProfilingData() const override;
+    std::optional<DeviceMemoryData> getDeviceMemoryData() const override;
+
     //for tests
     void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
 
@@ -111,7 +123,6 @@ private:
 
     Settings _origSettings;
     GeneralSettings _generalSettings;
-    GpuSettings _gpuSettings;
 
     EngineWorker _worker;
     std::thread* _thread = nullptr;
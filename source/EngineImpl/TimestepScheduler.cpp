@@ -0,0 +1,187 @@
+#include "TimestepScheduler.h"
+
+#include <algorithm>
+
+namespace
+{
+    double constexpr SmoothingFactor = 0.1;
+    int constexpr InactiveRenderingFrames = 4;
+    TimestepScheduler::Duration constexpr MaxFrameInterval = std::chrono::milliseconds(250);
+
+    double smooth(std::optional<double> const& average, double newValue)
+    {
+        return average ? *average * (1.0 - SmoothingFactor) + newValue * SmoothingFactor : newValue;
+    }
+
+    TimestepScheduler::Duration toDuration(double microseconds)
+    {
+        return TimestepScheduler::Duration(static_cast<int64_t>(microseconds));
+    }
+}
+
+TimestepScheduler::TimestepScheduler(Duration const& frameBudget)
+    : _frameBudget(frameBudget)
+{}
+
+void TimestepScheduler::setFrameBudget(Duration const& value)
+{
+    _frameBudget = value;
+}
+
+auto TimestepScheduler::getFrameBudget() const -> Duration
+{
+    return _frameBudget;
+}
+
+void TimestepScheduler::setTpsRestriction(std::optional<int> const& value)
+{
+    if (value && *value <= 0) {
+        _tpsRestriction.reset();
+    } else {
+        _tpsRestriction = value;
+    }
+}
+
+void TimestepScheduler::setStepsPerFrame(std::optional<int> const& value)
+{
+    if (value && *value <= 0) {
+        _stepsPerFrame.reset();
+    } else {
+        _stepsPerFrame = value;
+    }
+}
+
+auto TimestepScheduler::decide(Clock::time_point const& now, bool isSimulationRunning, bool isAccessRequested) const -> Decision
+{
+    if (isAccessRequested) {
+        return Decision::ServiceAccessRequest;
+    }
+    if (!isSimulationRunning) {
+        return Decision::Wait;
+    }
+    if (_stepsPerFrame && _timestepsSinceLastFrame >= *_stepsPerFrame) {
+        return Decision::Wait;
+    }
+    if (isTpsRestrictionReached(now)) {
+        return Decision::Wait;
+    }
+    if (isFrameDue(now)) {
+        return Decision::Wait;
+    }
+    return Decision::CalcTimestep;
+}
+
+auto TimestepScheduler::getWaitDuration(Clock::time_point const& now) const -> Duration
+{
+    Duration result(0);
+    if (_tpsRestriction && _lastTimestepStart) {
+        auto nextTimestep = *_lastTimestepStart + calcDurationBetweenTimesteps();
+        result = std::max(result, std::chrono::duration_cast<Duration>(nextTimestep - now));
+    }
+    if (isFrameDue(now)) {
+        result = std::max(result, toDuration(_averageDrawDuration.value_or(0)));
+    }
+    return result;
+}
+
+void TimestepScheduler::timestepCalculated(Clock::time_point const& startTime, Clock::time_point const& endTime)
+{
+    auto duration = std::chrono::duration_cast<Duration>(endTime - startTime);
+    _averageTimestepDuration = smooth(_averageTimestepDuration, static_cast<double>(duration.count()));
+
+    if (_tpsRestriction && _lastTimestepStart) {
+        auto desiredDuration = Duration(1000000 / *_tpsRestriction);
+        auto actualDuration = std::chrono::duration_cast<Duration>(startTime - *_lastTimestepStart) + _overshoot;
+        _overshoot = std::min(std::max(actualDuration - desiredDuration, Duration(0)), desiredDuration);
+    } else {
+        _overshoot = Duration(0);
+    }
+    _lastTimestepStart = startTime;
+    ++_timestepsSinceLastFrame;
+}
+
+void TimestepScheduler::frameDrawn(Clock::time_point const& endTime, Duration const& drawDuration)
+{
+    _averageDrawDuration = smooth(_averageDrawDuration, static_cast<double>(drawDuration.count()));
+    if (_lastFrameEnd) {
+        auto frameInterval = std::min(std::chrono::duration_cast<Duration>(endTime - *_lastFrameEnd), Duration(MaxFrameInterval));
+        _averageFrameInterval = smooth(_averageFrameInterval, static_cast<double>(frameInterval.count()));
+    }
+    _lastFrameEnd = endTime;
+    _timestepsSinceLastFrame = 0;
+}
+
+void TimestepScheduler::reset()
+{
+    _lastTimestepStart.reset();
+    _overshoot = Duration(0);
+    _averageTimestepDuration.reset();
+    _lastFrameEnd.reset();
+    _averageDrawDuration.reset();
+    _averageFrameInterval.reset();
+    _timestepsSinceLastFrame = 0;
+}
+
+auto TimestepScheduler::getAverageTimestepDuration() const -> std::optional<Duration>
+{
+    if (!_averageTimestepDuration) {
+        return std::nullopt;
+    }
+    return toDuration(*_averageTimestepDuration);
+}
+
+auto TimestepScheduler::getAverageDrawDuration() const -> std::optional<Duration>
+{
+    if (!_averageDrawDuration) {
+        return std::nullopt;
+    }
+    return toDuration(*_averageDrawDuration);
+}
+
+bool TimestepScheduler::isTpsRestrictionReached(Clock::time_point const& now) const
+{
+    if (!_tpsRestriction || !_lastTimestepStart) {
+        return false;
+    }
+    return now < *_lastTimestepStart + calcDurationBetweenTimesteps();
+}
+
+bool TimestepScheduler::isFrameDue(Clock::time_point const& now) const
+{
+    if (!isRenderingActive(now) || !_averageTimestepDuration) {
+        return false;
+    }
+
+    //deferring a time step only helps if it is shorter than a frame
+    auto timestepDuration = toDuration(*_averageTimestepDuration);
+    if (timestepDuration >= _frameBudget) {
+        return false;
+    }
+
+    //the next draw request is expected one frame interval after the last one has been finished
+    auto drawDuration = toDuration(_averageDrawDuration.value_or(0));
+    auto nextDrawStart = *_lastFrameEnd + calcExpectedFrameInterval() - drawDuration;
+
+    //do not wait for a late frame forever
+    auto tolerance = _frameBudget / 4;
+    return now + timestepDuration > nextDrawStart && now < nextDrawStart + tolerance;
+}
+
+bool TimestepScheduler::isRenderingActive(Clock::time_point const& now) const
+{
+    if (!_lastFrameEnd) {
+        return false;
+    }
+    return now - *_lastFrameEnd < calcExpectedFrameInterval() * InactiveRenderingFrames;
+}
+
+auto TimestepScheduler::calcDurationBetweenTimesteps() const -> Duration
+{
+    auto desiredDuration = Duration(1000000 / *_tpsRestriction);
+    return desiredDuration - _overshoot;
+}
+
+auto TimestepScheduler::calcExpectedFrameInterval() const -> Duration
+{
+    return std::max(_frameBudget, toDuration(_averageFrameInterval.value_or(0)));
+}
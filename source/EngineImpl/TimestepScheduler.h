@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+/**
+ * Decides in each iteration of the worker loop whether a time step should be calculated, a pending access request
+ * (rendering, data access or editing from the GUI thread) should be serviced or whether the worker should wait.
+ * The decision is based on the measured durations of time steps and frames, the TPS restriction and the frame budget.
+ * The scheduler does not query any clock itself. Time points are passed in by the caller so that it can be used with fake
+ * time in tests.
+ */
+class TimestepScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    enum class Decision
+    {
+        CalcTimestep,
+        ServiceAccessRequest,
+        Wait
+    };
+
+    TimestepScheduler(Duration const& frameBudget = DefaultFrameBudget);
+
+    void setFrameBudget(Duration const& value);
+    Duration getFrameBudget() const;
+
+    void setTpsRestriction(std::optional<int> const& value);
+    void setStepsPerFrame(std::optional<int> const& value);  //nullopt = steps are not synchronized with frames
+
+    Decision decide(Clock::time_point const& now, bool isSimulationRunning, bool isAccessRequested) const;
+    Duration getWaitDuration(Clock::time_point const& now) const;  //upper bound of how long a 'Wait' decision lasts
+
+    void timestepCalculated(Clock::time_point const& startTime, Clock::time_point const& endTime);
+    void frameDrawn(Clock::time_point const& endTime, Duration const& drawDuration);
+    void reset();
+
+    std::optional<Duration> getAverageTimestepDuration() const;
+    std::optional<Duration> getAverageDrawDuration() const;
+
+    static Duration constexpr DefaultFrameBudget = Duration(16667);  //60 FPS
+
+private:
+    bool isTpsRestrictionReached(Clock::time_point const& now) const;
+    bool isFrameDue(Clock::time_point const& now) const;
+    bool isRenderingActive(Clock::time_point const& now) const;
+    Duration calcDurationBetweenTimesteps() const;
+    Duration calcExpectedFrameInterval() const;
+
+    Duration _frameBudget;
+    std::optional<int> _tpsRestriction;
+    std::optional<int> _stepsPerFrame;
+
+    std::optional<Clock::time_point> _lastTimestepStart;
+    Duration _overshoot = Duration(0);
+    std::optional<double> _averageTimestepDuration;  //in microseconds
+
+    std::optional<Clock::time_point> _lastFrameEnd;
+    std::optional<double> _averageDrawDuration;  //in microseconds
+    std::optional<double> _averageFrameInterval;  //in microseconds
+    int _timestepsSinceLastFrame = 0;
+};
@@ -0,0 +1,41 @@
+#include "BatchJobs.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+std::vector<BatchJob> BatchJobs::parse(std::istream& stream)
+{
+    std::vector<BatchJob> result;
+    std::string line;
+    for (int lineNumber = 1; std::getline(stream, line); ++lineNumber) {
+        std::stringstream lineStream(line);
+        lineStream >> std::ws;
+        if (lineStream.eof() || lineStream.peek() == '#') {
+            continue;
+        }
+        BatchJob job;
+        int64_t timesteps = -1;
+        std::string remainder;
+        lineStream >> std::quoted(job.inputFilename) >> timesteps >> std::quoted(job.outputFilename);
+        if (lineStream.fail() || timesteps < 0 || job.inputFilename.empty() || job.outputFilename.empty() || (lineStream >> remainder)) {
+            throw InvalidBatchJobsException(
+                "Line " + std::to_string(lineNumber) + " must consist of an input file, a non-negative number of time steps and an output file.");
+        }
+        job.timesteps = static_cast<uint64_t>(timesteps);
+        result.emplace_back(job);
+    }
+    if (result.empty()) {
+        throw InvalidBatchJobsException("No jobs given.");
+    }
+    return result;
+}
+
+std::vector<BatchJob> BatchJobs::parseFromFile(std::string const& filename)
+{
+    std::ifstream stream(filename);
+    if (!stream) {
+        throw InvalidBatchJobsException("Could not read jobs from '" + filename + "'.");
+    }
+    return parse(stream);
+}
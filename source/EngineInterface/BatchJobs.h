@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class InvalidBatchJobsException : public std::runtime_error
+{
+public:
+    InvalidBatchJobsException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
+
+struct BatchJob
+{
+    std::string inputFilename;
+    uint64_t timesteps = 0;
+    std::string outputFilename;
+};
+
+/**
+ * List of unrelated simulations which are advanced by a given number of time steps. Each line of a jobs file consists of
+ * the input file, the number of time steps and the output file separated by whitespace. Filenames containing spaces
+ * can be quoted. Empty lines and lines starting with '#' are ignored. Example:
+ *   # input              time steps   output
+ *   worlds/a.sim         100000       out/a.sim
+ *   "worlds/world b.sim" 50000        "out/world b.sim"
+ */
+class BatchJobs
+{
+public:
+    static std::vector<BatchJob> parse(std::istream& stream);  //throws InvalidBatchJobsException
+    static std::vector<BatchJob> parseFromFile(std::string const& filename);  //throws InvalidBatchJobsException
+};
@@ -0,0 +1,137 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+#include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
+#include "Base/StringHelper.h"
+#include "DescriptionHelper.h"
+
+namespace
+{
+    struct ReferenceWorldSpec
+    {
+        char const* name;
+        IntVector2D worldSize;
+        int numHorizontal;  //number of cell rectangles in x-direction
+        int numVertical;
+    };
+    ReferenceWorldSpec const ReferenceWorldSpecs[] = {
+        {"small", {512, 256}, 24, 12},
+        {"medium", {2048, 1024}, 96, 48},
+        {"large", {4096, 2048}, 192, 96},
+    };
+    auto constexpr RectSize = 6;
+    auto constexpr MaxVelocity = 0.25f;
+}
+
+std::vector<std::string> Benchmark::getReferenceWorldNames()
+{
+    std::vector<std::string> result;
+    for (auto const& spec : ReferenceWorldSpecs) {
+        result.emplace_back(spec.name);
+    }
+    return result;
+}
+
+std::optional<BenchmarkWorld> Benchmark::createReferenceWorld(std::string const& name)
+{
+    auto spec = std::find_if(std::begin(ReferenceWorldSpecs), std::end(ReferenceWorldSpecs), [&](auto const& spec) { return spec.name == name; });
+    if (spec == std::end(ReferenceWorldSpecs)) {
+        return std::nullopt;
+    }
+    auto horizontalDistance = toFloat(spec->worldSize.x) / toFloat(spec->numHorizontal);
+    auto verticalDistance = toFloat(spec->worldSize.y) / toFloat(spec->numVertical);
+
+    //one cell rectangle and one energy particle per grid cell with velocities between -MaxVelocity and MaxVelocity
+    auto templateData = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters()
+                                                          .width(RectSize)
+                                                          .height(RectSize)
+                                                          .center({horizontalDistance / 2, verticalDistance / 2})
+                                                          .randomCreatureId(false));
+    templateData.addParticle(ParticleDescription().setId(NumberGenerator::getInstance().getId()).setPos({0, 0}).setEnergy(50.0f));
+    templateData.accelerate({-MaxVelocity, -MaxVelocity}, 0);
+
+    BenchmarkWorld result;
+    result.worldSize = spec->worldSize;
+    result.data = DescriptionHelper::gridMultiply(
+        templateData,
+        DescriptionHelper::GridMultiplyParameters()
+            .horizontalNumber(spec->numHorizontal)
+            .horizontalDistance(horizontalDistance)
+            .horizontalVelXinc(2 * MaxVelocity / toFloat(spec->numHorizontal))
+            .verticalNumber(spec->numVertical)
+            .verticalDistance(verticalDistance)
+            .verticalVelYinc(2 * MaxVelocity / toFloat(spec->numVertical)));
+    return result;
+}
+
+double Benchmark::calcTps(BenchmarkInterval const& interval)
+{
+    return interval.duration > 0 ? 1000.0 * interval.timesteps / interval.duration : 0.0;
+}
+
+void Benchmark::writeJsonReport(std::ostream& stream, BenchmarkReport const& report)
+{
+    BenchmarkInterval total;
+    auto minTps = std::numeric_limits<double>::max();
+    auto maxTps = 0.0;
+    for (auto const& interval : report.intervals) {
+        total.timesteps += interval.timesteps;
+        total.duration += interval.duration;
+        minTps = std::min(minTps, calcTps(interval));
+        maxTps = std::max(maxTps, calcTps(interval));
+    }
+    if (report.intervals.empty()) {
+        minTps = 0;
+    }
+
+    stream << std::setprecision(10);
+    stream << "{" << std::endl;
+    stream << "  \"world\": " << StringHelper::toJsonString(report.world) << "," << std::endl;
+    stream << "  \"world size\": [" << report.worldSize.x << ", " << report.worldSize.y << "]," << std::endl;
+    stream << "  \"cells\": " << report.numCells << "," << std::endl;
+    stream << "  \"particles\": " << report.numParticles << "," << std::endl;
+    stream << "  \"gpu\": " << StringHelper::toJsonString(report.gpuName) << "," << std::endl;
+    stream << "  \"warmup time steps\": " << report.warmupTimesteps << "," << std::endl;
+    stream << "  \"tps\": {\"mean\": " << calcTps(total) << ", \"min\": " << minTps << ", \"max\": " << maxTps << "}," << std::endl;
+
+    stream << "  \"intervals\": [";
+    for (size_t i = 0; i < report.intervals.size(); ++i) {
+        auto const& interval = report.intervals.at(i);
+        stream << (i == 0 ? "" : ",") << std::endl;
+        stream << "    {\"time steps\": " << interval.timesteps << ", \"duration [ms]\": " << interval.duration << ", \"tps\": " << calcTps(interval) << "}";
+    }
+    stream << std::endl << "  ]," << std::endl;
+
+    stream << "  \"phases\": [";
+    auto const& scopes = report.profilingData.scopes;
+    for (size_t i = 0; i < scopes.size(); ++i) {
+        auto const& scope = scopes.at(i);
+        stream << (i == 0 ? "" : ",") << std::endl;
+        stream << "    {\"name\": " << StringHelper::toJsonString(scope.name) << ", \"samples\": " << scope.numSamples << ", \"mean [ms]\": " << scope.mean
+               << ", \"median [ms]\": " << scope.median << ", \"95th percentile [ms]\": " << scope.percentile95
+               << ", \"99th percentile [ms]\": " << scope.percentile99 << ", \"max [ms]\": " << scope.max << "}";
+    }
+    stream << std::endl << "  ]," << std::endl;
+
+    stream << "  \"host\": {\"upload [ms]\": " << report.uploadDuration << ", \"download [ms]\": " << report.downloadDuration
+           << ", \"serialization [ms]\": " << report.serializationDuration << ", \"peak memory [bytes]\": ";
+    if (report.peakHostMemory) {
+        stream << *report.peakHostMemory;
+    } else {
+        stream << "null";
+    }
+    stream << "}," << std::endl;
+    stream << "  \"device\": ";
+    if (report.deviceMemoryData) {
+        stream << "{\"memory [bytes]\": " << report.deviceMemoryData->memory << ", \"peak memory [bytes]\": " << report.deviceMemoryData->peakMemory
+               << ", \"array resizes\": " << report.deviceMemoryData->numArrayResizes << "}";
+    } else {
+        stream << "null";
+    }
+    stream << std::endl;
+    stream << "}" << std::endl;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Base/Vector2D.h"
+#include "Descriptions.h"
+#include "ProfilingData.h"
+
+struct BenchmarkWorld
+{
+    IntVector2D worldSize;
+    DataDescription data;
+};
+
+struct BenchmarkInterval
+{
+    int timesteps = 0;
+    double duration = 0;  //in milliseconds
+};
+
+struct BenchmarkReport
+{
+    std::string world;  //name of the reference world or input file
+    IntVector2D worldSize;
+    int numCells = 0;
+    int numParticles = 0;
+    std::string gpuName;
+
+    int warmupTimesteps = 0;
+    std::vector<BenchmarkInterval> intervals;
+    ProfilingData profilingData;  //phase durations of a profiled interval after the measured intervals
+    std::optional<DeviceMemoryData> deviceMemoryData;  //not available for the CPU backend
+
+    //host-side durations in milliseconds
+    double uploadDuration = 0;  //conversion of the descriptions and copying to the device
+    double downloadDuration = 0;  //copying from the device and conversion to descriptions
+    double serializationDuration = 0;
+    std::optional<uint64_t> peakHostMemory;  //in bytes
+};
+
+/**
+ * Reference worlds for throughput measurements and a JSON report of the results. The reference worlds consist of
+ * grids of cell rectangles and energy particles and are generated deterministically apart from the ids.
+ */
+class Benchmark
+{
+public:
+    static std::vector<std::string> getReferenceWorldNames();  //ordered by size
+    static std::optional<BenchmarkWorld> createReferenceWorld(std::string const& name);
+
+    static double calcTps(BenchmarkInterval const& interval);
+    static void writeJsonReport(std::ostream& stream, BenchmarkReport const& report);
+};
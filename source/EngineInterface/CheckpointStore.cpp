@@ -0,0 +1,195 @@
+#include "CheckpointStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    char const CheckpointMagic[] = "ALIENCKP";
+    uint32_t const CheckpointVersion = 1;
+    auto const CheckpointPrefix = "checkpoint_";
+    auto const CheckpointExtension = ".ckpt";
+
+    //FNV-1a
+    uint64_t calcChecksum(std::string const& auxiliaryData, std::string const& mainData)
+    {
+        uint64_t result = 14695981039346656037ull;
+        for (auto const& data : {&auxiliaryData, &mainData}) {
+            for (auto const& c : *data) {
+                result ^= static_cast<uint8_t>(c);
+                result *= 1099511628211ull;
+            }
+        }
+        return result;
+    }
+
+    std::string getCheckpointFilename(std::string const& directory, uint64_t timestep)
+    {
+        std::stringstream stream;
+        stream << CheckpointPrefix << std::setw(14) << std::setfill('0') << timestep << CheckpointExtension;
+        return (std::filesystem::path(directory) / stream.str()).string();
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+CheckpointStore::CheckpointStore(std::string const& directory, int numKeptCheckpoints, uint64_t targetTimestep)
+    : _directory(directory)
+    , _numKeptCheckpoints(numKeptCheckpoints)
+    , _targetTimestep(targetTimestep)
+{}
+
+CheckpointStore::~CheckpointStore()
+{
+    waitForPendingSave();
+}
+
+bool CheckpointStore::init()
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    return std::filesystem::is_directory(_directory, error);
+}
+
+void CheckpointStore::save_async(DeserializedSimulation data)
+{
+    waitForPendingSave();
+    _pendingSave = std::async(std::launch::async, [this, data = std::move(data)] { return save(data); });
+}
+
+bool CheckpointStore::waitForPendingSave()
+{
+    if (_pendingSave.valid()) {
+        _lastSaveSucceeded = _pendingSave.get();
+    }
+    return _lastSaveSucceeded;
+}
+
+std::optional<Checkpoint> CheckpointStore::loadLatest(std::string const& directory)
+{
+    auto filenames = getCheckpointFilenames(directory);
+    for (auto it = filenames.rbegin(); it != filenames.rend(); ++it) {
+        Checkpoint result;
+        SerializedSimulation serializedData;
+        if (!readCheckpointFile(result.header, serializedData, *it)) {
+            continue;
+        }
+        if (!Serializer::deserializeSimulationFromStrings(result.data, serializedData)) {
+            continue;
+        }
+        result.data.auxiliaryData.timestep = result.header.timestep;
+        return result;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> CheckpointStore::getCheckpointFilenames(std::string const& directory)
+{
+    std::vector<std::string> result;
+    std::error_code error;
+    for (auto const& entry : std::filesystem::directory_iterator(directory, error)) {
+        auto filename = entry.path().filename().string();
+        if (entry.is_regular_file() && filename.starts_with(CheckpointPrefix) && filename.ends_with(CheckpointExtension)) {
+            result.emplace_back(entry.path().string());
+        }
+    }
+    std::sort(result.begin(), result.end());  //time steps in filenames are zero-padded
+    return result;
+}
+
+bool CheckpointStore::writeCheckpointFile(std::string const& filename, CheckpointHeader const& header, SerializedSimulation const& data)
+{
+    auto tempFilename = filename + ".tmp";
+    {
+        std::ofstream stream(tempFilename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        stream.write(CheckpointMagic, sizeof(CheckpointMagic) - 1);
+        writeValue(stream, CheckpointVersion);
+        writeValue(stream, header.timestep);
+        writeValue(stream, header.targetTimestep);
+        writeValue(stream, static_cast<uint64_t>(data.auxiliaryData.size()));
+        writeValue(stream, static_cast<uint64_t>(data.mainData.size()));
+        writeValue(stream, calcChecksum(data.auxiliaryData, data.mainData));
+        stream.write(data.auxiliaryData.data(), data.auxiliaryData.size());
+        stream.write(data.mainData.data(), data.mainData.size());
+        stream.close();
+        if (!stream) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempFilename, filename, error);
+    return !error;
+}
+
+bool CheckpointStore::readCheckpointFile(CheckpointHeader& header, SerializedSimulation& data, std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    char magic[sizeof(CheckpointMagic) - 1];
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0) {
+        return false;
+    }
+    uint32_t version;
+    uint64_t auxiliaryDataSize, mainDataSize, checksum;
+    if (!readValue(stream, version) || version != CheckpointVersion || !readValue(stream, header.timestep) || !readValue(stream, header.targetTimestep)
+        || !readValue(stream, auxiliaryDataSize)
+        || !readValue(stream, mainDataSize) || !readValue(stream, checksum)) {
+        return false;
+    }
+
+    //sizes of a corrupted header must not lead to huge allocations
+    std::error_code error;
+    auto fileSize = std::filesystem::file_size(filename, error);
+    if (error || mainDataSize > fileSize || auxiliaryDataSize > fileSize - mainDataSize) {
+        return false;
+    }
+    data.auxiliaryData.resize(auxiliaryDataSize);
+    data.mainData.resize(mainDataSize);
+    if (!stream.read(data.auxiliaryData.data(), auxiliaryDataSize) || !stream.read(data.mainData.data(), mainDataSize)) {
+        return false;
+    }
+    return checksum == calcChecksum(data.auxiliaryData, data.mainData);
+}
+
+bool CheckpointStore::save(DeserializedSimulation const& data) const
+{
+    SerializedSimulation serializedData;
+    if (!Serializer::serializeSimulationToStrings(serializedData, data)) {
+        return false;
+    }
+    auto timestep = data.auxiliaryData.timestep;
+    if (!writeCheckpointFile(getCheckpointFilename(_directory, timestep), CheckpointHeader{timestep, _targetTimestep}, serializedData)) {
+        return false;
+    }
+    removeOldCheckpoints();
+    return true;
+}
+
+void CheckpointStore::removeOldCheckpoints() const
+{
+    auto filenames = getCheckpointFilenames(_directory);
+    auto numRemoved = toInt(filenames.size()) - _numKeptCheckpoints;
+    for (int i = 0; i < numRemoved; ++i) {
+        std::error_code error;
+        std::filesystem::remove(filenames.at(i), error);
+    }
+}
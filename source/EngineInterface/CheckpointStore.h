@@ -0,0 +1,55 @@
+#pragma once
+
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Serializer.h"
+
+struct CheckpointHeader
+{
+    uint64_t timestep = 0;
+    uint64_t targetTimestep = 0;  //time step at which the run finishes
+};
+
+struct Checkpoint
+{
+    CheckpointHeader header;
+    DeserializedSimulation data;
+};
+
+/**
+ * Rotating checkpoints of a simulation run in a directory. A checkpoint is a single file consisting of a header (magic,
+ * version, 'CheckpointHeader', sizes and a checksum of the payload) followed by the serialized simulation. The serialization and
+ * compression run on a background thread and the files are written under a temporary name and renamed afterwards, so
+ * that an interrupted write never leaves a truncated checkpoint behind. Only the newest 'numKeptCheckpoints' are kept.
+ */
+class CheckpointStore
+{
+public:
+    CheckpointStore(std::string const& directory, int numKeptCheckpoints, uint64_t targetTimestep);
+    ~CheckpointStore();
+
+    bool init();  //creates the directory if necessary
+
+    void save_async(DeserializedSimulation data);  //waits for a preceding save
+    bool waitForPendingSave();  //returns false if the last save failed
+
+    //tries the checkpoints from newest to oldest and skips those which fail the integrity check
+    static std::optional<Checkpoint> loadLatest(std::string const& directory);
+
+    static std::vector<std::string> getCheckpointFilenames(std::string const& directory);  //sorted by time step in ascending order
+    static bool writeCheckpointFile(std::string const& filename, CheckpointHeader const& header, SerializedSimulation const& data);
+    static bool readCheckpointFile(CheckpointHeader& header, SerializedSimulation& data, std::string const& filename);
+
+private:
+    bool save(DeserializedSimulation const& data) const;
+    void removeOldCheckpoints() const;
+
+    std::string _directory;
+    int _numKeptCheckpoints;
+    uint64_t _targetTimestep;
+    std::future<bool> _pendingSave;
+    bool _lastSaveSucceeded = true;
+};
@@ -0,0 +1,238 @@
+#include "ControlServer.h"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/property_tree/json_parser.hpp>
+
+//same configuration as in the GUI so that the inline definitions of httplib are identical in all translation units
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+#include "Base/StringHelper.h"
+#include "StatisticsExporter.h"
+
+namespace
+{
+    auto constexpr JobTimeout = std::chrono::seconds(30);
+
+    ControlResponse createResponse(std::string const& key, std::string const& jsonValue)
+    {
+        return ControlResponse{200, "{" + StringHelper::toJsonString(key) + ": " + jsonValue + "}"};
+    }
+
+    ControlResponse createErrorResponse(int status, std::string const& message)
+    {
+        return ControlResponse{status, "{\"error\": " + StringHelper::toJsonString(message) + "}"};
+    }
+
+    std::string toJson(ControlStatus const& status)
+    {
+        std::stringstream stream;
+        stream << std::setprecision(10);
+        stream << "{\"time step\": " << status.timestep << ", \"tps\": " << status.tps << ", \"paused\": " << (status.paused ? "true" : "false")
+               << ", \"tps limit\": ";
+        if (status.tpsLimit) {
+            stream << *status.tpsLimit;
+        } else {
+            stream << "null";
+        }
+        stream << ", \"statistics\": {";
+        auto columnNames = StatisticsExporter::getColumnNames();
+        auto values = StatisticsExporter::getColumnValues(status.statistics);
+        for (size_t i = 0; i < columnNames.size(); ++i) {
+            stream << (i == 0 ? "" : ", ") << StringHelper::toJsonString(columnNames.at(i)) << ": " << values.at(i);
+        }
+        stream << "}}";
+        return stream.str();
+    }
+
+    std::optional<std::vector<ParameterValue>> parseParameterValues(std::string const& json, std::string& errorMessage)
+    {
+        boost::property_tree::ptree tree;
+        try {
+            std::stringstream stream(json);
+            boost::property_tree::read_json(stream, tree);
+        } catch (boost::property_tree::json_parser_error const& e) {
+            errorMessage = "Parameters are not valid JSON: " + e.message();
+            return std::nullopt;
+        }
+        if (tree.empty()) {
+            errorMessage = "No parameters given.";
+            return std::nullopt;
+        }
+        std::vector<ParameterValue> result;
+        for (auto const& [path, valueTree] : tree) {
+            ParameterValue value{path, valueTree.get_value<std::string>()};
+            if (auto error = ParameterPatch::validate(value)) {
+                errorMessage = *error;
+                return std::nullopt;
+            }
+            result.emplace_back(value);
+        }
+        return result;
+    }
+
+    void setResponse(httplib::Response& response, ControlResponse const& controlResponse)
+    {
+        response.status = controlResponse.status;
+        response.set_content(controlResponse.body, "application/json");
+    }
+}
+
+ControlServer::ControlServer(ControlTarget& target)
+    : _target(target)
+{}
+
+ControlServer::~ControlServer()
+{
+    stop();
+}
+
+bool ControlServer::start(std::string const& host, int port)
+{
+    stop();
+    _server = std::make_unique<httplib::Server>();
+    _server->Get("/status", [this](httplib::Request const&, httplib::Response& response) {
+        setResponse(response, execute([this] { return ControlResponse{200, toJson(_target.getStatus())}; }));
+    });
+    _server->Post("/snapshot", [this](httplib::Request const& request, httplib::Response& response) {
+        auto filename = request.get_param_value("file");
+        if (filename.empty()) {
+            setResponse(response, createErrorResponse(400, "No file given."));
+            return;
+        }
+        setResponse(response, execute([this, filename] {
+            return _target.saveSnapshot(filename) ? createResponse("file", StringHelper::toJsonString(filename))
+                                                  : createErrorResponse(500, "Could not write to '" + filename + "'.");
+        }));
+    });
+    _server->Post("/pause", [this](httplib::Request const&, httplib::Response& response) {
+        setResponse(response, execute([this] {
+            _target.setPaused(true);
+            return createResponse("paused", "true");
+        }));
+    });
+    _server->Post("/resume", [this](httplib::Request const&, httplib::Response& response) {
+        setResponse(response, execute([this] {
+            _target.setPaused(false);
+            return createResponse("paused", "false");
+        }));
+    });
+    _server->Post("/tps-limit", [this](httplib::Request const& request, httplib::Response& response) {
+        int value = -1;
+        try {
+            value = std::stoi(request.get_param_value("value"));
+        } catch (std::exception const&) {
+        }
+        if (value < 0) {
+            setResponse(response, createErrorResponse(400, "'value' must be a non-negative number."));
+            return;
+        }
+        setResponse(response, execute([this, value] {
+            _target.setTpsLimit(value > 0 ? std::make_optional(value) : std::nullopt);
+            return createResponse("tps limit", value > 0 ? std::to_string(value) : "null");
+        }));
+    });
+    _server->Post("/parameters", [this](httplib::Request const& request, httplib::Response& response) {
+        std::string errorMessage;
+        auto values = parseParameterValues(request.body, errorMessage);
+        if (!values) {
+            setResponse(response, createErrorResponse(400, errorMessage));
+            return;
+        }
+        setResponse(response, execute([this, values] {
+            _target.setParameters(*values);
+            return createResponse("changed parameters", std::to_string(values->size()));
+        }));
+    });
+
+    _port = port == 0 ? _server->bind_to_any_port(host.c_str()) : (_server->bind_to_port(host.c_str(), port) ? port : -1);
+    if (_port < 0) {
+        _server.reset();
+        _port = 0;
+        return false;
+    }
+    {
+        std::lock_guard lock(_jobsMutex);
+        _stopped = false;
+    }
+    std::promise<bool> listenResult;
+    auto listenFinished = listenResult.get_future();
+    _thread = std::thread([this, listenResult = std::move(listenResult)]() mutable { listenResult.set_value(_server->listen_after_bind()); });
+
+    //'httplib::Server::stop' has no effect before the server is running, listening returns only early if it fails
+    while (!_server->is_running()) {
+        if (listenFinished.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready) {
+            _thread.join();
+            _server.reset();
+            _port = 0;
+            throw std::runtime_error("Could not listen on " + host + ":" + std::to_string(port) + ".");
+        }
+    }
+    return true;
+}
+
+void ControlServer::stop()
+{
+    {
+        std::lock_guard lock(_jobsMutex);
+        _stopped = true;
+        _jobs.clear();
+        _hasPendingJobs = false;
+    }
+    if (_server) {
+        _server->stop();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _server.reset();
+}
+
+int ControlServer::getPort() const
+{
+    return _port;
+}
+
+void ControlServer::processPendingJobs()
+{
+    if (!_hasPendingJobs) {
+        return;
+    }
+    std::deque<std::packaged_task<ControlResponse()>> jobs;
+    {
+        std::lock_guard lock(_jobsMutex);
+        jobs.swap(_jobs);
+        _hasPendingJobs = false;
+    }
+    for (auto& job : jobs) {
+        job();
+    }
+}
+
+ControlResponse ControlServer::execute(std::function<ControlResponse()> const& job)
+{
+    std::future<ControlResponse> result;
+    {
+        std::lock_guard lock(_jobsMutex);
+        if (_stopped) {
+            return createErrorResponse(503, "The server is stopping.");
+        }
+        _jobs.emplace_back(job);
+        result = _jobs.back().get_future();
+        _hasPendingJobs = true;
+    }
+    if (result.wait_for(JobTimeout) != std::future_status::ready) {
+        return createErrorResponse(503, "The simulation did not respond.");
+    }
+    try {
+        return result.get();
+    } catch (std::future_error const&) {
+        return createErrorResponse(503, "The server is stopping.");
+    } catch (std::exception const& e) {
+        return createErrorResponse(500, e.what());
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParameterPatch.h"
+#include "StatisticsData.h"
+
+namespace httplib
+{
+    class Server;
+}
+
+struct ControlStatus
+{
+    uint64_t timestep = 0;
+    float tps = 0;
+    bool paused = false;
+    std::optional<int> tpsLimit;
+    TimelineStatistics statistics;
+};
+
+//operations of a running simulation, they are only called from 'ControlServer::processPendingJobs'
+class ControlTarget
+{
+public:
+    virtual ~ControlTarget() = default;
+
+    virtual ControlStatus getStatus() = 0;
+    virtual bool saveSnapshot(std::string const& filename) = 0;  //"{timestep}" in the filename is replaced
+    virtual void setPaused(bool value) = 0;
+    virtual void setTpsLimit(std::optional<int> const& value) = 0;
+    virtual void setParameters(std::vector<ParameterValue> const& values) = 0;
+};
+
+struct ControlResponse
+{
+    int status = 200;
+    std::string body;  //JSON
+};
+
+/**
+ * Local HTTP endpoint for controlling a headless run:
+ *   GET  /status                 time step, TPS, pause state, TPS limit and the current statistics
+ *   POST /snapshot?file=<name>   writes the simulation to the given file
+ *   POST /pause, POST /resume
+ *   POST /tps-limit?value=<n>    0 removes the limit
+ *   POST /parameters             body: JSON object with parameter paths and values, e.g. { "radiation.factor[0]": 0.001 }
+ * The requests are received on background threads and queued as jobs. The jobs are executed on the simulation thread by
+ * 'processPendingJobs', which should be called between time steps and returns immediately if no job is pending.
+ */
+class ControlServer
+{
+public:
+    ControlServer(ControlTarget& target);
+    ~ControlServer();
+
+    //port 0 binds to a free port, returns false if binding fails and throws std::runtime_error if listening fails afterwards
+    bool start(std::string const& host, int port);
+    void stop();  //pending requests are answered with an error
+    int getPort() const;
+
+    void processPendingJobs();
+
+private:
+    ControlResponse execute(std::function<ControlResponse()> const& job);  //called from the request threads
+
+    ControlTarget& _target;
+    std::unique_ptr<httplib::Server> _server;
+    std::thread _thread;
+    int _port = 0;
+
+    std::mutex _jobsMutex;
+    std::deque<std::packaged_task<ControlResponse()>> _jobs;
+    std::atomic<bool> _hasPendingJobs = false;
+    bool _stopped = false;
+};
@@ -6,6 +6,7 @@
 
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
+#include "Base/SpatialHashGrid.h"
 #include "GenomeDescriptions.h"
 #include "SpaceCalculator.h"
 #include "GenomeDescriptionConverter.h"
@@ -200,30 +201,10 @@ void DescriptionHelper::duplicate(ClusteredDataDescription& data, IntVector2D co
 
 namespace
 {
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
+    std::vector<int> getCellIndicesWithinRadius(DataDescription const& data, SpatialHashGrid const& cellGrid, RealVector2D const& pos, float radius)
     {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
+        auto result = cellGrid.getIndicesWithinRadius(pos, radius);
+        std::stable_sort(result.begin(), result.end(), [&](int index1, int index2) {
             auto const& cell1 = data.cells.at(index1);
             auto const& cell2 = data.cells.at(index2);
             return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
@@ -270,16 +251,17 @@ DataDescription DescriptionHelper::randomMultiply(
 {
     overlappingCheckSuccessful = true;
     SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
+    SpatialHashGrid existentCellGrid;
+    Occupancy addedCellPosBySlot;
 
-    //create map for overlapping check
+    //create map for overlapping check, the few added cells are kept separately
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> existentCellPositions;
+        existentCellPositions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            existentCellPositions.emplace_back(cell.pos);
         }
+        existentCellGrid.build(existentCellPositions, {toFloat(worldSize.x), toFloat(worldSize.y)}, 2.0f);
     }
 
     //do multiplication
@@ -305,7 +287,7 @@ DataDescription DescriptionHelper::randomMultiply(
             if (parameters._overlappingCheck) {
                 for (auto const& cell : copy.cells) {
                     auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
+                    if (isCellPresent(existentCellGrid, pos, 2.0f) || isCellPresent(addedCellPosBySlot, spaceCalculator, pos, 2.0f)) {
                         overlapping = true;
                     }
                 }
@@ -320,13 +302,11 @@ DataDescription DescriptionHelper::randomMultiply(
         generateNewCreatureIds(copy);
         result.add(copy);
 
-        //add copy to existentData for overlapping check
+        //add copy to map for overlapping check
         if (parameters._overlappingCheck) {
             for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
                 auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
+                addedCellPosBySlot[intPos].emplace_back(cell.pos);
             }
         }
     }
@@ -353,21 +333,21 @@ void DescriptionHelper::addIfSpaceAvailable(
 
 void DescriptionHelper::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> cellPositions;
+    cellPositions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        cellPositions.emplace_back(cell.pos);
     }
+    SpatialHashGrid cellGrid;
+    cellGrid.buildBounded(cellPositions, std::max(1.0f, maxDistance));
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
     for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellGrid, cell.pos, maxDistance);
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -587,6 +567,17 @@ void DescriptionHelper::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
+bool DescriptionHelper::isCellPresent(SpatialHashGrid const& cellGrid, RealVector2D const& posToCheck, float distance)
+{
+    auto result = false;
+    cellGrid.executeForEachWithinRadius(posToCheck, distance, [&](int, RealVector2D const& delta) {
+        if (Math::length(delta) < distance) {
+            result = true;
+        }
+    });
+    return result;
+}
+
 bool DescriptionHelper::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
 {
     auto intPos = toIntVector2D(posToCheck);
@@ -3,6 +3,8 @@
 #include "Base/Definitions.h"
 #include "Descriptions.h"
 
+class SpatialHashGrid;
+
 class DescriptionHelper
 {
 public:
@@ -121,4 +123,5 @@ private:
         SpaceCalculator const& spaceCalculator,
         RealVector2D const& posToCheck,
         float distance);
+    static bool isCellPresent(SpatialHashGrid const& cellGrid, RealVector2D const& posToCheck, float distance);
 };
@@ -0,0 +1,69 @@
+#include "EnsembleStatistics.h"
+
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+#include "StatisticsExporter.h"
+
+void EnsembleStatistics::add(uint64_t timestep, TimelineStatistics const& statistics)
+{
+    auto values = StatisticsExporter::getColumnValues(statistics);
+    auto& accumulator = _accumulatorByTimestep[timestep];
+    if (accumulator.numReplicas == 0) {
+        accumulator.means.resize(values.size(), 0.0);
+        accumulator.squaredDeviationSums.resize(values.size(), 0.0);
+    }
+
+    //Welford's algorithm
+    ++accumulator.numReplicas;
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto delta = values[i] - accumulator.means[i];
+        accumulator.means[i] += delta / accumulator.numReplicas;
+        accumulator.squaredDeviationSums[i] += delta * (values[i] - accumulator.means[i]);
+    }
+}
+
+std::vector<EnsembleSample> EnsembleStatistics::getSamples() const
+{
+    std::vector<EnsembleSample> result;
+    result.reserve(_accumulatorByTimestep.size());
+    for (auto const& [timestep, accumulator] : _accumulatorByTimestep) {
+        EnsembleSample sample;
+        sample.timestep = timestep;
+        sample.numReplicas = accumulator.numReplicas;
+        sample.means = accumulator.means;
+        sample.standardDeviations.reserve(accumulator.means.size());
+        for (auto const& squaredDeviationSum : accumulator.squaredDeviationSums) {
+            sample.standardDeviations.emplace_back(accumulator.numReplicas > 1 ? std::sqrt(squaredDeviationSum / (accumulator.numReplicas - 1)) : 0.0);
+        }
+        result.emplace_back(std::move(sample));
+    }
+    return result;
+}
+
+void EnsembleStatistics::writeCsv(std::ostream& stream) const
+{
+    stream << "Time step, Replicas";
+    for (auto const& columnName : StatisticsExporter::getColumnNames()) {
+        stream << ", " << columnName << " (mean), " << columnName << " (std dev)";
+    }
+    stream << std::endl;
+
+    for (auto const& sample : getSamples()) {
+        stream << sample.timestep << ", " << sample.numReplicas;
+        for (size_t i = 0; i < sample.means.size(); ++i) {
+            stream << ", " << sample.means[i] << ", " << sample.standardDeviations[i];
+        }
+        stream << std::endl;
+    }
+}
+
+std::string EnsembleStatistics::getReplicaFilename(std::string const& filename, int replica)
+{
+    std::filesystem::path path(filename);
+    std::stringstream stream;
+    stream << path.stem().string() << "_replica_" << std::setw(4) << std::setfill('0') << replica << path.extension().string();
+    return (path.parent_path() / stream.str()).string();
+}
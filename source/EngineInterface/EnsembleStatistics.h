@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "StatisticsData.h"
+
+//statistics of all replicas at one time step
+struct EnsembleSample
+{
+    uint64_t timestep = 0;
+    int numReplicas = 0;
+    std::vector<double> means;  //one value per column of 'StatisticsExporter::getColumnNames()'
+    std::vector<double> standardDeviations;
+};
+
+/**
+ * Aggregates the statistics of replicas of a simulation which are sampled at the same time steps. Replicas which have
+ * been stopped early only contribute to the time steps they have reached.
+ */
+class EnsembleStatistics
+{
+public:
+    void add(uint64_t timestep, TimelineStatistics const& statistics);
+
+    std::vector<EnsembleSample> getSamples() const;  //ordered by time step
+
+    //columns: time step, number of replicas and for each statistic its mean and standard deviation
+    void writeCsv(std::ostream& stream) const;
+
+    //e.g. "stats.csv" -> "stats_replica_0001.csv"
+    static std::string getReplicaFilename(std::string const& filename, int replica);
+
+private:
+    struct Accumulator
+    {
+        int numReplicas = 0;
+        std::vector<double> means;
+        std::vector<double> squaredDeviationSums;
+    };
+    std::map<uint64_t, Accumulator> _accumulatorByTimestep;
+};
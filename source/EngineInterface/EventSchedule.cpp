@@ -0,0 +1,175 @@
+#include "EventSchedule.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/Definitions.h"
+#include "GenomeDescriptionConverter.h"
+
+namespace
+{
+    std::string const TimestepPlaceholder = "{timestep}";
+
+    std::optional<RealVector2D> parsePosition(boost::property_tree::ptree const& eventTree)
+    {
+        auto positionTree = eventTree.get_child_optional("position");
+        if (!positionTree) {
+            return std::nullopt;
+        }
+        std::vector<float> coordinates;
+        for (auto const& [key, coordinateTree] : *positionTree) {
+            coordinates.emplace_back(coordinateTree.get_value<float>());
+        }
+        if (coordinates.size() != 2) {
+            throw InvalidEventScheduleException("'position' must consist of two coordinates.");
+        }
+        return RealVector2D(coordinates.at(0), coordinates.at(1));
+    }
+
+    ScheduledEvent parseEvent(boost::property_tree::ptree const& eventTree)
+    {
+        ScheduledEvent result;
+        auto timestep = eventTree.get_optional<int64_t>("time step");
+        if (!timestep || *timestep < 0) {
+            throw InvalidEventScheduleException("Each event needs a non-negative 'time step'.");
+        }
+        result.timestep = static_cast<uint64_t>(*timestep);
+
+        auto type = eventTree.get<std::string>("type", "");
+        if (type == "parameters") {
+            result.type = ScheduledEventType_Parameters;
+            auto valuesTree = eventTree.get_child_optional("values");
+            if (!valuesTree || valuesTree->empty()) {
+                throw InvalidEventScheduleException("Parameter event at time step " + std::to_string(result.timestep) + " contains no values.");
+            }
+            for (auto const& [path, valueTree] : *valuesTree) {
+                ParameterValue value{path, valueTree.get_value<std::string>()};
+                if (auto error = ParameterPatch::validate(value)) {
+                    throw InvalidEventScheduleException(*error);
+                }
+                result.parameterValues.emplace_back(value);
+            }
+        } else if (type == "cataclysm") {
+            result.type = ScheduledEventType_Cataclysm;
+            result.power = eventTree.get<int>("power", 1);
+            if (result.power < 1) {
+                throw InvalidEventScheduleException("'power' of a cataclysm must be positive.");
+            }
+        } else if (type == "inject simulation" || type == "inject genome" || type == "snapshot") {
+            result.type = type == "inject simulation" ? ScheduledEventType_InjectSimulation
+                : type == "inject genome"             ? ScheduledEventType_InjectGenome
+                                                      : ScheduledEventType_Snapshot;
+            result.filename = eventTree.get<std::string>("file", "");
+            if (result.filename.empty()) {
+                throw InvalidEventScheduleException("Event '" + type + "' at time step " + std::to_string(result.timestep) + " needs a 'file'.");
+            }
+            result.position = parsePosition(eventTree);
+            result.color = eventTree.get<int>("color", 0);
+            if (result.color < 0 || result.color >= MAX_COLORS) {
+                throw InvalidEventScheduleException("Invalid 'color' " + std::to_string(result.color) + ".");
+            }
+        } else {
+            throw InvalidEventScheduleException("Unknown event type '" + type + "'.");
+        }
+        return result;
+    }
+}
+
+EventSchedule::EventSchedule(std::vector<ScheduledEvent> events)
+    : _events(std::move(events))
+{
+    std::stable_sort(_events.begin(), _events.end(), [](auto const& left, auto const& right) { return left.timestep < right.timestep; });
+}
+
+EventSchedule EventSchedule::parse(std::string const& json)
+{
+    boost::property_tree::ptree tree;
+    try {
+        std::stringstream stream(json);
+        boost::property_tree::read_json(stream, tree);
+    } catch (boost::property_tree::json_parser_error const& e) {
+        throw InvalidEventScheduleException("Event schedule is not valid JSON: " + e.message() + " (line " + std::to_string(e.line()) + ")");
+    }
+
+    std::vector<ScheduledEvent> events;
+    try {
+        if (auto eventsTree = tree.get_child_optional("events")) {
+            for (auto const& [key, eventTree] : *eventsTree) {
+                events.emplace_back(parseEvent(eventTree));
+            }
+        }
+    } catch (boost::property_tree::ptree_error const& e) {
+        throw InvalidEventScheduleException(std::string("Invalid event: ") + e.what());
+    }
+    return EventSchedule(std::move(events));
+}
+
+EventSchedule EventSchedule::parseFromFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw InvalidEventScheduleException("Could not read event schedule from '" + filename + "'.");
+    }
+    std::stringstream content;
+    content << stream.rdbuf();
+    return parse(content.str());
+}
+
+bool EventSchedule::isEmpty() const
+{
+    return _nextEventIndex == _events.size();
+}
+
+bool EventSchedule::contains(ScheduledEventType type) const
+{
+    return std::any_of(_events.begin(), _events.end(), [type](auto const& event) { return event.type == type; });
+}
+
+std::optional<uint64_t> EventSchedule::getNextTimestep() const
+{
+    if (isEmpty()) {
+        return std::nullopt;
+    }
+    return _events.at(_nextEventIndex).timestep;
+}
+
+std::vector<ScheduledEvent> EventSchedule::popDueEvents(uint64_t timestep)
+{
+    std::vector<ScheduledEvent> result;
+    for (; _nextEventIndex < _events.size() && _events.at(_nextEventIndex).timestep <= timestep; ++_nextEventIndex) {
+        result.emplace_back(_events.at(_nextEventIndex));
+    }
+    return result;
+}
+
+void EventSchedule::skipUntil(uint64_t timestep)
+{
+    popDueEvents(timestep);
+}
+
+std::string EventSchedule::getSnapshotFilename(std::string const& filename, uint64_t timestep)
+{
+    auto result = filename;
+    for (auto pos = result.find(TimestepPlaceholder); pos != std::string::npos; pos = result.find(TimestepPlaceholder, pos)) {
+        result.replace(pos, TimestepPlaceholder.size(), std::to_string(timestep));
+    }
+    return result;
+}
+
+DataDescription EventSchedule::createSpore(std::vector<uint8_t> const& genome, RealVector2D const& position, int color, SimulationParameters const& parameters)
+{
+    auto genomeDesc = GenomeDescriptionConverter::convertBytesToDescription(genome);
+    auto energy = parameters.cellNormalEnergy[color] * toFloat(toInt(genomeDesc.cells.size()) * std::min(1000, genomeDesc.header.numRepetitions) * 2 + 1);
+    auto cell = CellDescription()
+                    .setPos(position)
+                    .setEnergy(energy)
+                    .setStiffness(1.0f)
+                    .setMaxConnections(6)
+                    .setExecutionOrderNumber(0)
+                    .setColor(color)
+                    .setCellFunction(ConstructorDescription().setGenome(genome));
+    return DataDescription().addCell(cell);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Base/Vector2D.h"
+#include "Descriptions.h"
+#include "ParameterPatch.h"
+#include "SimulationParameters.h"
+
+class InvalidEventScheduleException : public std::runtime_error
+{
+public:
+    InvalidEventScheduleException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
+
+using ScheduledEventType = int;
+enum ScheduledEventType_
+{
+    ScheduledEventType_Parameters,
+    ScheduledEventType_Cataclysm,
+    ScheduledEventType_InjectSimulation,
+    ScheduledEventType_InjectGenome,
+    ScheduledEventType_Snapshot
+};
+
+struct ScheduledEvent
+{
+    uint64_t timestep = 0;
+    ScheduledEventType type = ScheduledEventType_Parameters;
+
+    std::vector<ParameterValue> parameterValues;  //for parameters
+    int power = 1;  //for cataclysm
+    std::string filename;  //for injections and snapshots, "{timestep}" is replaced in snapshot filenames
+    std::optional<RealVector2D> position;  //center of the injected data, default: unchanged for simulations and world center for genomes
+    int color = 0;  //for genome injections
+};
+
+/**
+ * Time step-triggered actions for headless runs. Events at a time step are applied in the order of the schedule file
+ * after this time step has been reached. Example:
+ * {
+ *   "events": [
+ *     { "time step": 1000000, "type": "parameters", "values": { "radiation.factor[0]": 0.001, "spots.0.pos.x": 500 } },
+ *     { "time step": 1500000, "type": "cataclysm", "power": 2 },
+ *     { "time step": 2000000, "type": "inject simulation", "file": "creatures.sim", "position": [1000, 500] },
+ *     { "time step": 2000000, "type": "inject genome", "file": "replicator.genome", "color": 1 },
+ *     { "time step": 3000000, "type": "snapshot", "file": "snapshot_{timestep}.sim" }
+ *   ]
+ * }
+ */
+class EventSchedule
+{
+public:
+    EventSchedule() = default;
+    EventSchedule(std::vector<ScheduledEvent> events);  //sorted by time step while preserving the order of events at the same time step
+
+    static EventSchedule parse(std::string const& json);  //throws InvalidEventScheduleException
+    static EventSchedule parseFromFile(std::string const& filename);  //throws InvalidEventScheduleException
+
+    bool isEmpty() const;
+    bool contains(ScheduledEventType type) const;  //including already applied events
+    std::optional<uint64_t> getNextTimestep() const;
+    std::vector<ScheduledEvent> popDueEvents(uint64_t timestep);  //events up to the given time step
+    void skipUntil(uint64_t timestep);  //removes the events up to the given time step, e.g. if they have already been applied before a checkpoint
+
+    static std::string getSnapshotFilename(std::string const& filename, uint64_t timestep);
+
+    //a single constructor cell with the genome and enough energy to build it, analogous to a spore created in the genome editor
+    static DataDescription createSpore(std::vector<uint8_t> const& genome, RealVector2D const& position, int color, SimulationParameters const& parameters);
+
+private:
+    std::vector<ScheduledEvent> _events;
+    size_t _nextEventIndex = 0;
+};
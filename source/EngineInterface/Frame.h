@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+//image in RGB format with 8 bits per channel, stored row by row
+struct Frame
+{
+    IntVector2D size;
+    std::vector<uint8_t> pixels;
+};
@@ -0,0 +1,68 @@
+#include "FrameEncoder.h"
+
+#include <fstream>
+
+#include <zlib.h>
+
+namespace
+{
+    void appendBigEndian(std::string& data, uint32_t value)
+    {
+        data.push_back(static_cast<char>((value >> 24) & 0xff));
+        data.push_back(static_cast<char>((value >> 16) & 0xff));
+        data.push_back(static_cast<char>((value >> 8) & 0xff));
+        data.push_back(static_cast<char>(value & 0xff));
+    }
+
+    void writeChunk(std::ostream& stream, char const* type, std::string const& content)
+    {
+        std::string chunk;
+        appendBigEndian(chunk, static_cast<uint32_t>(content.size()));
+        chunk.append(type, 4);
+        chunk.append(content);
+        auto crc = crc32(0, reinterpret_cast<Bytef const*>(chunk.data() + 4), static_cast<uInt>(chunk.size() - 4));
+        appendBigEndian(chunk, static_cast<uint32_t>(crc));
+        stream.write(chunk.data(), chunk.size());
+    }
+}
+
+bool FrameEncoder::writePng(std::string const& filename, Frame const& frame)
+{
+    //each row is preceded by the filter type (0 = none)
+    auto rowSize = static_cast<size_t>(frame.size.x) * 3;
+    std::vector<uint8_t> rawData;
+    rawData.reserve((rowSize + 1) * frame.size.y);
+    for (int y = 0; y < frame.size.y; ++y) {
+        rawData.emplace_back(0);
+        rawData.insert(rawData.end(), frame.pixels.begin() + y * rowSize, frame.pixels.begin() + (y + 1) * rowSize);
+    }
+    auto compressedSize = compressBound(static_cast<uLong>(rawData.size()));
+    std::string compressedData(compressedSize, '\0');
+    if (compress2(reinterpret_cast<Bytef*>(compressedData.data()), &compressedSize, rawData.data(), static_cast<uLong>(rawData.size()), Z_BEST_SPEED)
+        != Z_OK) {
+        return false;
+    }
+    compressedData.resize(compressedSize);
+
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    stream.write("\x89PNG\r\n\x1a\n", 8);
+
+    std::string header;
+    appendBigEndian(header, static_cast<uint32_t>(frame.size.x));
+    appendBigEndian(header, static_cast<uint32_t>(frame.size.y));
+    header.append({8, 2, 0, 0, 0});  //bit depth, color type RGB, compression, filter, interlace
+    writeChunk(stream, "IHDR", header);
+    writeChunk(stream, "IDAT", compressedData);
+    writeChunk(stream, "IEND", "");
+    stream.close();
+    return static_cast<bool>(stream);
+}
+
+bool FrameEncoder::appendRaw(std::ostream& stream, Frame const& frame)
+{
+    stream.write(reinterpret_cast<char const*>(frame.pixels.data()), frame.pixels.size());
+    return static_cast<bool>(stream);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "Frame.h"
+
+class FrameEncoder
+{
+public:
+    static bool writePng(std::string const& filename, Frame const& frame);
+
+    //frames without header, can be converted by e.g. 'ffmpeg -f rawvideo -pix_fmt rgb24 -video_size <width>x<height> -i <file> video.mp4'
+    static bool appendRaw(std::ostream& stream, Frame const& frame);
+};
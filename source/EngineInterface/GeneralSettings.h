@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+
 struct GeneralSettings
 {
     int worldSizeX;
     int worldSizeY;
+    uint32_t randomSeed = 0;  //seed for the random numbers of the engine, 0 = not seeded
 };
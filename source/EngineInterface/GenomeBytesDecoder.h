@@ -0,0 +1,315 @@
+#pragma once
+
+#include <cstdint>
+
+#include "CellFunctionConstants.h"
+#include "GenomeConstants.h"
+
+//the decoding functions are also compiled for the device when included by nvcc
+#ifdef __CUDACC__
+#define GENOME_DECODER_FUNC __host__ __device__ __inline__
+#else
+#define GENOME_DECODER_FUNC inline
+#endif
+
+/**
+ * Decoding of genomes in byte form without memory allocations, shared by GenomeDecoder on the device and the host code.
+ * Nodes are identified by their address, i.e. the position of their cell function byte. Bytes beyond the genome size are read as 0
+ * as in GenomeDescriptionConverter, hence truncated genomes can be walked safely. Sub-genomes are only descended up to
+ * MaxSubGenomeRecursionDepth.
+ */
+class GenomeBytesDecoder
+{
+public:
+    static int constexpr MaxSubGenomeRecursionDepth = 30;
+    static int constexpr InfiniteRepetitions = 0x7fffffff;
+
+    //genome-wide methods
+    GENOME_DECODER_FUNC static int getNumRepetitions(uint8_t const* genome, int genomeSize, bool countInfinityAsOne = false);
+    GENOME_DECODER_FUNC static bool isSeparating(uint8_t const* genome, int genomeSize);
+    GENOME_DECODER_FUNC static bool isSingleConstruction(uint8_t const* genome, int genomeSize);
+    GENOME_DECODER_FUNC static int getNumNodes(uint8_t const* genome, int genomeSize);
+    GENOME_DECODER_FUNC static int getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex);  //genome size for indices beyond the last node
+    GENOME_DECODER_FUNC static int getNodeIndex(uint8_t const* genome, int genomeSize, int nodeAddress);  //number of nodes starting before nodeAddress
+    GENOME_DECODER_FUNC static bool containsSelfReplication(uint8_t const* genome, int genomeSize);  //only the nodes of the genome itself are considered
+    GENOME_DECODER_FUNC static int getGenomeDepth(uint8_t const* genome, int genomeSize);
+    GENOME_DECODER_FUNC static int getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions);
+
+    //calls func(depth, nodeAddress, numRepetitions) for all nodes including the nodes of sub-genomes in depth-first order,
+    //numRepetitions is the product of the repetitions of the genome and all enclosing genomes where infinite repetitions count as one
+    template <typename Func>
+    GENOME_DECODER_FUNC static void executeForEachNodeRecursively(uint8_t const* genome, int genomeSize, Func const& func);
+
+    //node-wide methods
+    GENOME_DECODER_FUNC static int getNextCellFunctionType(uint8_t const* genome, int nodeAddress);
+    GENOME_DECODER_FUNC static int getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenomes = true);
+    GENOME_DECODER_FUNC static int getNextNodeSize(uint8_t const* genome, int genomeSize, int nodeAddress);
+    GENOME_DECODER_FUNC static bool isNextCellSelfCopy(uint8_t const* genome, int genomeSize, int nodeAddress);
+    GENOME_DECODER_FUNC static bool hasNextCellSubGenome(uint8_t const* genome, int genomeSize, int nodeAddress);
+    GENOME_DECODER_FUNC static int getNextSubGenomeAddress(uint8_t const* genome, int nodeAddress);  //prerequisite: constructor or injector
+    GENOME_DECODER_FUNC static int
+    getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress);  //prerequisites: (constructor or injector) and !makeSelfCopy
+
+    //conversion methods
+    GENOME_DECODER_FUNC static bool convertByteToBool(uint8_t b);
+    GENOME_DECODER_FUNC static int convertBytesToWord(uint8_t b1, uint8_t b2);
+    GENOME_DECODER_FUNC static int convertByteToNumRepetitions(uint8_t b, bool countInfinityAsOne);
+
+private:
+    GENOME_DECODER_FUNC static uint8_t readByte(uint8_t const* genome, int genomeSize, int address);
+    GENOME_DECODER_FUNC static int getCellFunctionFixedBytes(int cellFunction);  //prerequisite: constructor or injector
+};
+
+//iterates over the node addresses of a genome (without sub-genomes): for (auto nodeAddress : GenomeNodes(genome, genomeSize)) {...}
+class GenomeNodes
+{
+public:
+    class Iterator
+    {
+    public:
+        GENOME_DECODER_FUNC Iterator(uint8_t const* genome, int genomeSize, int nodeAddress)
+            : _genome(genome)
+            , _genomeSize(genomeSize)
+            , _nodeAddress(nodeAddress < genomeSize ? nodeAddress : genomeSize)
+        {}
+
+        GENOME_DECODER_FUNC int operator*() const { return _nodeAddress; }
+        GENOME_DECODER_FUNC Iterator& operator++()
+        {
+            _nodeAddress += GenomeBytesDecoder::getNextNodeSize(_genome, _genomeSize, _nodeAddress);
+            if (_nodeAddress > _genomeSize) {
+                _nodeAddress = _genomeSize;
+            }
+            return *this;
+        }
+        GENOME_DECODER_FUNC bool operator!=(Iterator const& other) const { return _nodeAddress != other._nodeAddress; }
+
+    private:
+        uint8_t const* _genome;
+        int _genomeSize;
+        int _nodeAddress;
+    };
+
+    GENOME_DECODER_FUNC GenomeNodes(uint8_t const* genome, int genomeSize)
+        : _genome(genome)
+        , _genomeSize(genomeSize)
+    {}
+
+    GENOME_DECODER_FUNC Iterator begin() const { return Iterator(_genome, _genomeSize, Const::GenomeHeaderSize); }
+    GENOME_DECODER_FUNC Iterator end() const { return Iterator(_genome, _genomeSize, _genomeSize); }
+
+private:
+    uint8_t const* _genome;
+    int _genomeSize;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNumRepetitions(uint8_t const* genome, int genomeSize, bool countInfinityAsOne)
+{
+    return convertByteToNumRepetitions(readByte(genome, genomeSize, Const::GenomeHeaderNumRepetitionsPos), countInfinityAsOne);
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::isSeparating(uint8_t const* genome, int genomeSize)
+{
+    return convertByteToBool(readByte(genome, genomeSize, Const::GenomeHeaderSeparationPos));
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::isSingleConstruction(uint8_t const* genome, int genomeSize)
+{
+    return convertByteToBool(readByte(genome, genomeSize, Const::GenomeHeaderSingleConstruction));
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNumNodes(uint8_t const* genome, int genomeSize)
+{
+    int result = 0;
+    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize; ++result) {
+        nodeAddress += getNextNodeSize(genome, genomeSize, nodeAddress);
+    }
+    return result;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex)
+{
+    auto result = Const::GenomeHeaderSize;
+    for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex && result < genomeSize; ++currentNodeIndex) {
+        result += getNextNodeSize(genome, genomeSize, result);
+    }
+    return result < genomeSize ? result : genomeSize;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNodeIndex(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    int result = 0;
+    for (auto currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < nodeAddress && currentNodeAddress < genomeSize; ++result) {
+        currentNodeAddress += getNextNodeSize(genome, genomeSize, currentNodeAddress);
+    }
+    return result;
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::containsSelfReplication(uint8_t const* genome, int genomeSize)
+{
+    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize;) {
+        if (isNextCellSelfCopy(genome, genomeSize, nodeAddress)) {
+            return true;
+        }
+        nodeAddress += getNextNodeSize(genome, genomeSize, nodeAddress);
+    }
+    return false;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getGenomeDepth(uint8_t const* genome, int genomeSize)
+{
+    auto result = 0;
+    executeForEachNodeRecursively(genome, genomeSize, [&result](int depth, int, int) { result = depth > result ? depth : result; });
+    return result;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions)
+{
+    auto result = 0;
+    executeForEachNodeRecursively(
+        genome, genomeSize, [&result, includeRepetitions](int, int, int numRepetitions) { result += includeRepetitions ? numRepetitions : 1; });
+    return result;
+}
+
+#ifdef __CUDACC__
+#pragma nv_exec_check_disable
+#endif
+template <typename Func>
+GENOME_DECODER_FUNC void GenomeBytesDecoder::executeForEachNodeRecursively(uint8_t const* genome, int genomeSize, Func const& func)
+{
+    //the end addresses of the enclosing genomes serve as genome sizes for reading the nodes of sub-genomes
+    int genomeEndAddresses[MaxSubGenomeRecursionDepth + 1];
+    int genomeNumRepetitions[MaxSubGenomeRecursionDepth + 1];
+    int depth = 0;
+    genomeEndAddresses[0] = genomeSize;
+    genomeNumRepetitions[0] = getNumRepetitions(genome, genomeSize, true);
+    auto nodeAddress = Const::GenomeHeaderSize;
+    while (true) {
+        while (depth > 0 && nodeAddress >= genomeEndAddresses[depth]) {
+            nodeAddress = genomeEndAddresses[depth];
+            --depth;
+        }
+        auto genomeEndAddress = genomeEndAddresses[depth];
+        if (nodeAddress >= genomeEndAddress) {
+            return;
+        }
+        func(depth, nodeAddress, genomeNumRepetitions[depth]);
+
+        if (depth < MaxSubGenomeRecursionDepth && hasNextCellSubGenome(genome, genomeEndAddress, nodeAddress)) {
+            auto subGenomeAddress = getNextSubGenomeAddress(genome, nodeAddress);
+            auto subGenomeEndAddress = subGenomeAddress + getNextSubGenomeSize(genome, genomeEndAddress, nodeAddress);
+            auto numRepetitionsByte = readByte(genome, subGenomeEndAddress, subGenomeAddress + Const::GenomeHeaderNumRepetitionsPos);
+            auto numRepetitions = convertByteToNumRepetitions(numRepetitionsByte, true);
+            ++depth;
+            genomeEndAddresses[depth] = subGenomeEndAddress;
+            genomeNumRepetitions[depth] = genomeNumRepetitions[depth - 1] * numRepetitions;
+            nodeAddress = subGenomeAddress + Const::GenomeHeaderSize;
+        } else {
+            nodeAddress += getNextNodeSize(genome, genomeEndAddress, nodeAddress);
+        }
+    }
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNextCellFunctionType(uint8_t const* genome, int nodeAddress)
+{
+    return genome[nodeAddress] % CellFunction_Count;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenomes)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    switch (cellFunction) {
+    case CellFunction_Neuron:
+        return Const::NeuronBytes;
+    case CellFunction_Transmitter:
+        return Const::TransmitterBytes;
+    case CellFunction_Constructor:
+    case CellFunction_Injector: {
+        auto cellFunctionFixedBytes = getCellFunctionFixedBytes(cellFunction);
+        if (!withSubgenomes) {
+            return cellFunctionFixedBytes;
+        }
+        if (isNextCellSelfCopy(genome, genomeSize, nodeAddress)) {
+            return cellFunctionFixedBytes + 1;
+        }
+        return cellFunctionFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+    }
+    case CellFunction_Sensor:
+        return Const::SensorBytes;
+    case CellFunction_Nerve:
+        return Const::NerveBytes;
+    case CellFunction_Attacker:
+        return Const::AttackerBytes;
+    case CellFunction_Muscle:
+        return Const::MuscleBytes;
+    case CellFunction_Defender:
+        return Const::DefenderBytes;
+    default:
+        return 0;
+    }
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNextNodeSize(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    return Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::isNextCellSelfCopy(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    if (cellFunction != CellFunction_Constructor && cellFunction != CellFunction_Injector) {
+        return false;
+    }
+    return convertByteToBool(readByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + getCellFunctionFixedBytes(cellFunction)));
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::hasNextCellSubGenome(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    return (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) && !isNextCellSelfCopy(genome, genomeSize, nodeAddress);
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNextSubGenomeAddress(uint8_t const* genome, int nodeAddress)
+{
+    return nodeAddress + Const::CellBasicBytes + getCellFunctionFixedBytes(getNextCellFunctionType(genome, nodeAddress)) + 3;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    auto subGenomeSizeIndex = getNextSubGenomeAddress(genome, nodeAddress) - 2;
+    auto result = convertBytesToWord(readByte(genome, genomeSize, subGenomeSizeIndex), readByte(genome, genomeSize, subGenomeSizeIndex + 1));
+    auto maxSize = genomeSize - (subGenomeSizeIndex + 2);
+    result = result < maxSize ? result : maxSize;
+    return result > 0 ? result : 0;
+}
+
+GENOME_DECODER_FUNC bool GenomeBytesDecoder::convertByteToBool(uint8_t b)
+{
+    return static_cast<int8_t>(b) > 0;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
+{
+    return static_cast<int>(b1) | (static_cast<int>(b2 << 8));
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::convertByteToNumRepetitions(uint8_t b, bool countInfinityAsOne)
+{
+    if (b == 255) {
+        return countInfinityAsOne ? 1 : InfiniteRepetitions;
+    }
+    return b > 1 ? static_cast<int>(b) : 1;
+}
+
+GENOME_DECODER_FUNC uint8_t GenomeBytesDecoder::readByte(uint8_t const* genome, int genomeSize, int address)
+{
+    return address < genomeSize ? genome[address] : 0;
+}
+
+GENOME_DECODER_FUNC int GenomeBytesDecoder::getCellFunctionFixedBytes(int cellFunction)
+{
+    return cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+}
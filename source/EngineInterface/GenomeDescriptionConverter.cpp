@@ -4,6 +4,7 @@
 
 #include "Base/Definitions.h"
 
+#include "GenomeBytesDecoder.h"
 #include "GenomeConstants.h"
 
 namespace
@@ -243,6 +244,12 @@ std::vector<uint8_t> GenomeDescriptionConverter::convertDescriptionToBytes(Genom
 
 namespace
 {
+    //old genome versions without some header fields are not supported by GenomeBytesDecoder
+    bool isCurrentEncoding(GenomeEncodingSpecification const& spec)
+    {
+        return spec._numRepetitions && spec._concatenationAngle1 && spec._concatenationAngle2;
+    }
+
     struct ConversionResult
     {
         GenomeDescription genome;
@@ -373,18 +380,27 @@ GenomeDescription GenomeDescriptionConverter::convertBytesToDescription(std::vec
 
 int GenomeDescriptionConverter::convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
+    if (isCurrentEncoding(spec)) {
+        return GenomeBytesDecoder::getNodeIndex(data.data(), toInt(data.size()), nodeAddress);
+    }
+    //wasteful approach but sufficient for old genome versions
     return convertBytesToDescriptionIntern(data, nodeAddress, data.size(), spec).genome.cells.size();
 }
 
 int GenomeDescriptionConverter::convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
+    if (isCurrentEncoding(spec)) {
+        return GenomeBytesDecoder::getNodeAddress(data.data(), toInt(data.size()), nodeIndex);
+    }
+    //wasteful approach but sufficient for old genome versions
     return convertBytesToDescriptionIntern(data, data.size(), nodeIndex, spec).lastBytePosition;
 }
 
 int GenomeDescriptionConverter::getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
 {
+    if (isCurrentEncoding(spec)) {
+        return GenomeBytesDecoder::getNumNodesRecursively(data.data(), toInt(data.size()), includeRepetitions);
+    }
     auto genome = convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
     auto result = toInt(genome.cells.size());
     for (auto const& node : genome.cells) {
@@ -1,12 +1,52 @@
 #pragma once
 
+using KernelPhase = int;
+enum KernelPhase_
+{
+    KernelPhase_Physics,
+    KernelPhase_CellFunctions,
+    KernelPhase_StructuralOperations,
+    KernelPhase_Count
+};
+
+inline char const* const KernelPhaseNames[KernelPhase_Count] = {"Physics", "Cell functions", "Structural operations"};
+
 struct GpuSettings
 {
     int numThreadsPerBlock = 8;
     int numBlocks = 16384;
 
+    //launch configuration for the kernels of a phase of a time step, 0 = use the values above
+    int numThreadsPerBlockByPhase[KernelPhase_Count] = {0, 0, 0};
+    int numBlocksByPhase[KernelPhase_Count] = {0, 0, 0};
+
+    GpuSettings getForPhase(KernelPhase phase) const
+    {
+        GpuSettings result = *this;
+        if (numThreadsPerBlockByPhase[phase] > 0) {
+            result.numThreadsPerBlock = numThreadsPerBlockByPhase[phase];
+        }
+        if (numBlocksByPhase[phase] > 0) {
+            result.numBlocks = numBlocksByPhase[phase];
+        }
+        return result;
+    }
+
+    void resetPhases()
+    {
+        for (int i = 0; i < KernelPhase_Count; ++i) {
+            numThreadsPerBlockByPhase[i] = 0;
+            numBlocksByPhase[i] = 0;
+        }
+    }
+
     bool operator==(GpuSettings const& other) const
     {
+        for (int i = 0; i < KernelPhase_Count; ++i) {
+            if (numThreadsPerBlockByPhase[i] != other.numThreadsPerBlockByPhase[i] || numBlocksByPhase[i] != other.numBlocksByPhase[i]) {
+                return false;
+            }
+        }
         return numThreadsPerBlock == other.numThreadsPerBlock && numBlocks == other.numBlocks;
     }
 
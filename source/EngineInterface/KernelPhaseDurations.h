@@ -0,0 +1,9 @@
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include "GpuSettings.h"
+
+//measured GPU durations of the phases of a time step in milliseconds, nullopt = phase has not been executed
+using KernelPhaseDurations = std::array<std::optional<float>, KernelPhase_Count>;
@@ -0,0 +1,68 @@
+#include "ParameterPatch.h"
+
+#include "AuxiliaryDataParser.h"
+
+namespace
+{
+    std::string const ParametersNodePrefix = "simulation parameters.";
+
+    std::string getFullPath(std::string const& path)
+    {
+        return path.starts_with(ParametersNodePrefix) ? path : ParametersNodePrefix + path;
+    }
+
+    bool isBool(std::string const& value)
+    {
+        return value == "true" || value == "false";
+    }
+
+    bool isNumber(std::string const& value)
+    {
+        try {
+            size_t numParsedChars = 0;
+            std::stod(value, &numParsedChars);
+            return numParsedChars == value.size();
+        } catch (...) {
+            return false;
+        }
+    }
+
+    //contains a value for each possible key
+    boost::property_tree::ptree const& getFullTree()
+    {
+        static boost::property_tree::ptree const result = [] {
+            SimulationParameters parameters;
+            parameters.numSpots = MAX_SPOTS;
+            parameters.numParticleSources = MAX_PARTICLE_SOURCES;
+            return AuxiliaryDataParser::encodeSimulationParameters(parameters);
+        }();
+        return result;
+    }
+}
+
+bool ParameterPatch::isValidPath(std::string const& path)
+{
+    auto node = getFullTree().get_child_optional(getFullPath(path));
+    return !path.empty() && node && node->empty();
+}
+
+std::optional<std::string> ParameterPatch::validate(ParameterValue const& value)
+{
+    if (!isValidPath(value.path)) {
+        return "Unknown parameter path '" + value.path + "'.";
+    }
+    auto defaultValue = getFullTree().get<std::string>(getFullPath(value.path));
+    if (isBool(defaultValue) ? !isBool(value.value) : !isNumber(value.value)) {
+        return "Invalid value '" + value.value + "' for parameter '" + value.path + "'.";
+    }
+    return std::nullopt;
+}
+
+SimulationParameters ParameterPatch::apply(SimulationParameters const& parameters, std::vector<ParameterValue> const& values)
+{
+    auto tree = AuxiliaryDataParser::encodeSimulationParameters(parameters);
+    for (auto const& value : values) {
+        tree.put(getFullPath(value.path), value.value);
+    }
+    return AuxiliaryDataParser::decodeSimulationParameters(tree);
+}
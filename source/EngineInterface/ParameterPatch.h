@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "SimulationParameters.h"
+
+struct ParameterValue
+{
+    std::string path;  //key of the simulation parameter in the settings file, e.g. "radiation.factor[0]" or "spots.0.pos.x"
+    std::string value;
+};
+
+//changes simulation parameters addressed by the keys of the settings file (with or without the prefix "simulation parameters.")
+class ParameterPatch
+{
+public:
+    static bool isValidPath(std::string const& path);  //includes the paths of all possible spots and particle sources
+    static std::optional<std::string> validate(ParameterValue const& value);  //returns an error message for invalid paths or values
+
+    static SimulationParameters apply(SimulationParameters const& parameters, std::vector<ParameterValue> const& values);
+};
@@ -0,0 +1,143 @@
+#include "ParameterSweep.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/Definitions.h"
+#include "ParameterPatch.h"
+#include "StatisticsExporter.h"
+
+SweepSpec ParameterSweep::parseSpec(std::string const& json)
+{
+    boost::property_tree::ptree tree;
+    try {
+        std::stringstream stream(json);
+        boost::property_tree::read_json(stream, tree);
+    } catch (boost::property_tree::json_parser_error const& e) {
+        throw InvalidSweepSpecException("Sweep spec is not valid JSON: " + e.message() + " (line " + std::to_string(e.line()) + ")");
+    }
+
+    SweepSpec result;
+    try {
+        if (auto timesteps = tree.get_optional<int>("time steps")) {
+            result.timesteps = *timesteps;
+        }
+        result.numParallelRuns = tree.get<int>("parallel runs", 1);
+    } catch (boost::property_tree::ptree_error const&) {
+        throw InvalidSweepSpecException("'time steps' and 'parallel runs' must be integers.");
+    }
+    if (result.numParallelRuns < 1 || (result.timesteps && *result.timesteps < 0)) {
+        throw InvalidSweepSpecException("'time steps' and 'parallel runs' must not be negative.");
+    }
+
+    auto parametersTree = tree.get_child_optional("parameters");
+    if (!parametersTree || parametersTree->empty()) {
+        throw InvalidSweepSpecException("Sweep spec contains no parameters.");
+    }
+    for (auto const& [key, parameterTree] : *parametersTree) {
+        SweepParameter parameter;
+        parameter.path = parameterTree.get<std::string>("path", "");
+        if (!ParameterPatch::isValidPath(parameter.path)) {
+            throw InvalidSweepSpecException("Unknown parameter path '" + parameter.path + "'.");
+        }
+        if (auto valuesTree = parameterTree.get_child_optional("values")) {
+            for (auto const& [valueKey, valueTree] : *valuesTree) {
+                auto value = valueTree.get_value<std::string>();
+                if (auto error = ParameterPatch::validate({parameter.path, value})) {
+                    throw InvalidSweepSpecException(*error);
+                }
+                parameter.values.emplace_back(value);
+            }
+        }
+        if (parameter.values.empty()) {
+            throw InvalidSweepSpecException("No values given for parameter '" + parameter.path + "'.");
+        }
+        result.parameters.emplace_back(parameter);
+    }
+    return result;
+}
+
+SweepSpec ParameterSweep::parseSpecFromFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw InvalidSweepSpecException("Could not read sweep spec from '" + filename + "'.");
+    }
+    std::stringstream content;
+    content << stream.rdbuf();
+    return parseSpec(content.str());
+}
+
+std::vector<SweepRun> ParameterSweep::expand(SweepSpec const& spec)
+{
+    std::vector<SweepRun> result;
+    if (spec.parameters.empty()) {
+        return result;
+    }
+    std::vector<size_t> valueIndices(spec.parameters.size(), 0);
+    while (true) {
+        SweepRun run;
+        run.index = toInt(result.size());
+        for (size_t i = 0; i < spec.parameters.size(); ++i) {
+            run.values.emplace_back(spec.parameters.at(i).values.at(valueIndices.at(i)));
+        }
+        result.emplace_back(run);
+
+        //increment like a number whose last digit is the last parameter
+        auto parameterIndex = toInt(spec.parameters.size()) - 1;
+        while (parameterIndex >= 0 && ++valueIndices.at(parameterIndex) == spec.parameters.at(parameterIndex).values.size()) {
+            valueIndices.at(parameterIndex) = 0;
+            --parameterIndex;
+        }
+        if (parameterIndex < 0) {
+            return result;
+        }
+    }
+}
+
+SimulationParameters ParameterSweep::applyRun(SimulationParameters const& baseParameters, SweepSpec const& spec, SweepRun const& run)
+{
+    std::vector<ParameterValue> values;
+    for (size_t i = 0; i < spec.parameters.size(); ++i) {
+        if (!ParameterPatch::isValidPath(spec.parameters.at(i).path)) {
+            throw InvalidSweepSpecException("Unknown parameter path '" + spec.parameters.at(i).path + "'.");
+        }
+        values.emplace_back(ParameterValue{spec.parameters.at(i).path, run.values.at(i)});
+    }
+    return ParameterPatch::apply(baseParameters, values);
+}
+
+std::string ParameterSweep::getRunName(SweepRun const& run)
+{
+    std::stringstream stream;
+    stream << "run_" << std::setw(4) << std::setfill('0') << run.index;
+    return stream.str();
+}
+
+void ParameterSweep::writeSummaryCsv(std::ostream& stream, SweepSpec const& spec, std::vector<SweepRun> const& runs, std::vector<SweepRunResult> const& results)
+{
+    stream << "Run";
+    for (auto const& parameter : spec.parameters) {
+        stream << ", " << parameter.path;
+    }
+    stream << ", Succeeded, Time step, TPS, Stop reason";
+    for (auto const& columnName : StatisticsExporter::getColumnNames()) {
+        stream << ", " << columnName;
+    }
+    stream << std::endl;
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+        auto const& run = runs.at(i);
+        auto const& result = results.at(i);
+        stream << getRunName(run);
+        for (auto const& value : run.values) {
+            stream << ", " << value;
+        }
+        stream << ", " << (result.succeeded ? "true" : "false") << ", " << result.timestep << ", " << result.tps << ", " << result.stopReason;
+        StatisticsExporter::writeCsvValues(stream, StatisticsExporter::getColumnValues(result.statistics));
+        stream << std::endl;
+    }
+}
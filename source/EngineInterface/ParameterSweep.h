@@ -0,0 +1,74 @@
+#pragma once
+
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "SimulationParameters.h"
+#include "StatisticsData.h"
+
+class InvalidSweepSpecException : public std::runtime_error
+{
+public:
+    InvalidSweepSpecException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
+
+struct SweepParameter
+{
+    std::string path;  //key of the simulation parameter in the settings file, e.g. "radiation.factor[0]"
+    std::vector<std::string> values;
+};
+
+/**
+ * Example:
+ * {
+ *   "time steps": 10000,
+ *   "parallel runs": 2,
+ *   "parameters": [
+ *     { "path": "radiation.factor[0]", "values": [0.0001, 0.0002] },
+ *     { "path": "cell.function.constructor.mutation probability.neuron data[0]", "values": [0.00001, 0.0001, 0.001] }
+ *   ]
+ * }
+ * "parallel runs" > 1 is only supported by the CPU backend since the GPU engine keeps the simulation parameters in process-wide constant memory.
+ */
+struct SweepSpec
+{
+    std::optional<int> timesteps;
+    int numParallelRuns = 1;
+    std::vector<SweepParameter> parameters;
+};
+
+struct SweepRun
+{
+    int index = 0;
+    std::vector<std::string> values;  //one value for each parameter of the spec
+};
+
+struct SweepRunResult
+{
+    bool succeeded = false;
+    uint64_t timestep = 0;
+    float tps = 0;
+    std::string stopReason;  //empty if the run was not stopped early
+    TimelineStatistics statistics;
+};
+
+//parameter sweeps without running a simulation (parsing, expansion to runs and aggregation of the results)
+class ParameterSweep
+{
+public:
+    static SweepSpec parseSpec(std::string const& json);  //throws InvalidSweepSpecException
+    static SweepSpec parseSpecFromFile(std::string const& filename);  //throws InvalidSweepSpecException
+
+    //cartesian product of the parameter values, the last parameter varies fastest
+    static std::vector<SweepRun> expand(SweepSpec const& spec);
+
+    static SimulationParameters applyRun(SimulationParameters const& baseParameters, SweepSpec const& spec, SweepRun const& run);  //throws InvalidSweepSpecException
+
+    static std::string getRunName(SweepRun const& run);
+    static void writeSummaryCsv(std::ostream& stream, SweepSpec const& spec, std::vector<SweepRun> const& runs, std::vector<SweepRunResult> const& results);
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//measured GPU duration of a named scope (e.g. a group of kernels) in milliseconds
+struct ProfilingScopeDuration
+{
+    std::string name;
+    float duration = 0;
+};
+
+//statistics of a scope over the recent samples, all durations in milliseconds
+struct ProfilingScopeData
+{
+    std::string name;
+    int numSamples = 0;
+    float mean = 0;
+    float median = 0;
+    float percentile95 = 0;
+    float percentile99 = 0;
+    float max = 0;
+};
+
+struct ProfilingData
+{
+    std::vector<ProfilingScopeData> scopes;
+};
+
+//since the simulation has been created, available independently of the profiling
+struct DeviceMemoryData
+{
+    uint64_t memory = 0;  //in bytes
+    uint64_t peakMemory = 0;  //in bytes
+    int numArrayResizes = 0;
+};
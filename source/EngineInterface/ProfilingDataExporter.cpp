@@ -0,0 +1,14 @@
+#include "ProfilingDataExporter.h"
+
+void ProfilingDataExporter::writeCsvHeader(std::ostream& stream)
+{
+    stream << "Time step, Scope, Samples, Mean [ms], Median [ms], 95th percentile [ms], 99th percentile [ms], Max [ms]" << std::endl;
+}
+
+void ProfilingDataExporter::writeCsvRows(std::ostream& stream, uint64_t timestep, ProfilingData const& data)
+{
+    for (auto const& scope : data.scopes) {
+        stream << timestep << ", " << scope.name << ", " << scope.numSamples << ", " << scope.mean << ", " << scope.median << ", " << scope.percentile95
+               << ", " << scope.percentile99 << ", " << scope.max << std::endl;
+    }
+}
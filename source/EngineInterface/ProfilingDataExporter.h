@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+#include "ProfilingData.h"
+
+class ProfilingDataExporter
+{
+public:
+    static void writeCsvHeader(std::ostream& stream);
+    static void writeCsvRows(std::ostream& stream, uint64_t timestep, ProfilingData const& data);  //one row per scope
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+using SimulationBackend = int;
+enum SimulationBackend_
+{
+    SimulationBackend_Gpu,
+    SimulationBackend_Cpu  //host engine without cell functions, see _CpuSimulationFacade
+};
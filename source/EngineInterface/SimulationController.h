@@ -1,6 +1,10 @@
 #pragma once
+
+#include <future>
+
 #include "Definitions.h"
 #include "OverlayDescriptions.h"
+#include "ProfilingData.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
 #include "ShallowUpdateSelectionData.h"
@@ -35,6 +39,12 @@ public:
     virtual DataDescription getSelectedSimulationData(bool includeClusters) = 0;
     virtual DataDescription getInspectedSimulationData(std::vector<uint64_t> objectsIds) = 0;
 
+    //non-blocking variants: the requests are processed by the worker thread between time steps
+    virtual std::future<ClusteredDataDescription> getClusteredSimulationData_async() = 0;
+    virtual std::future<DataDescription> getSelectedSimulationData_async(bool includeClusters) = 0;
+    virtual std::future<DataDescription> getInspectedSimulationData_async(std::vector<uint64_t> objectsIds) = 0;
+    virtual std::future<SelectionShallowData> getSelectionShallowData_async() = 0;
+
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
@@ -70,6 +80,8 @@ public:
     virtual GpuSettings getGpuSettings() const = 0;
     virtual GpuSettings getOriginalGpuSettings() const = 0;
     virtual void setGpuSettings_async(GpuSettings const& gpuSettings) = 0;
+    virtual void startGpuSettingsTuning() = 0;  //tunes the launch configurations while the simulation is running
+    virtual std::optional<float> getGpuSettingsTuningProgress() const = 0;  //nullopt = no tuning in progress
 
     virtual void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) = 0;
 
@@ -90,6 +102,12 @@ public:
 
     virtual float getTps() const = 0;
 
+    //durations of the kernel groups of time steps, rendering and data access
+    virtual bool isProfilingEnabled() const = 0;
+    virtual void setProfilingEnabled(bool value) = 0;
+    virtual ProfilingData getProfilingData() const = 0;
+    virtual std::optional<DeviceMemoryData> getDeviceMemoryData() const = 0;  //nullopt if the backend has no device
+
     //for tests
     virtual void testOnly_mutate(uint64_t cellId, MutationType mutationType) = 0;
 };
@@ -0,0 +1,178 @@
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "Base/Math.h"
+
+#include "Colors.h"
+
+namespace
+{
+    auto constexpr ZoomLevelForConnections = 1.0f;
+
+    struct Color
+    {
+        float r = 0;
+        float g = 0;
+        float b = 0;
+
+        Color operator*(float factor) const { return {r * factor, g * factor, b * factor}; }
+    };
+
+    Color toColor(uint32_t value)
+    {
+        return {toFloat((value >> 16) & 0xff) / 255.0f, toFloat((value >> 8) & 0xff) / 255.0f, toFloat(value & 0xff) / 255.0f};
+    }
+
+    //same colors as in the GPU rendering
+    Color calcCellColor(CellDescription const& cell, SimulationParameters const& parameters)
+    {
+        uint32_t cellColor = 0xbfbfbf;
+        if (parameters.cellColorization == CellColorization_CellColor) {
+            cellColor = Const::IndividualCellColors[((cell.color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS];
+        }
+        if (parameters.cellColorization == CellColorization_MutationId) {
+            auto hash = std::abs(static_cast<int64_t>(cell.mutationId) * 12107);
+            auto h = toFloat(hash % 360) / 60.0f;
+            auto s = 0.3f + toFloat(hash % 700) / 1000;
+            auto x = 1.0f - std::abs(std::fmod(h, 2.0f) - 1.0f);
+            Color rgb = h < 1 ? Color{1, x, 0} : h < 2 ? Color{x, 1, 0} : h < 3 ? Color{0, 1, x} : h < 4 ? Color{0, x, 1} : h < 5 ? Color{x, 0, 1} : Color{1, 0, x};
+            rgb = {1.0f - s + s * rgb.r, 1.0f - s + s * rgb.g, 1.0f - s + s * rgb.b};
+            cellColor = (toInt(rgb.r * 255) << 16) | (toInt(rgb.g * 255) << 8) | toInt(rgb.b * 255);
+        }
+        return toColor(cellColor) * (std::min(300.0f, cell.energy) / 320.0f);
+    }
+
+    Color calcParticleColor(ParticleDescription const& particle)
+    {
+        auto intensity = std::max(std::min((toInt(particle.energy) + 10.0f) * 5, 450.0f), 20.0f) / 1000.0f;
+        return {intensity, intensity, 0.08f};
+    }
+
+    class Canvas
+    {
+    public:
+        Canvas(IntVector2D const& size)
+            : _size(size)
+            , _data(size.x * size.y * 3, 0.0f)
+        {}
+
+        //adds the color bilinearly distributed to the four neighboring pixels
+        void drawDot(RealVector2D const& pos, Color const& color)
+        {
+            auto x = toInt(std::floor(pos.x));
+            auto y = toInt(std::floor(pos.y));
+            auto fracX = pos.x - toFloat(x);
+            auto fracY = pos.y - toFloat(y);
+            addToPixel(x, y, color * ((1.0f - fracX) * (1.0f - fracY)));
+            addToPixel(x + 1, y, color * (fracX * (1.0f - fracY)));
+            addToPixel(x, y + 1, color * ((1.0f - fracX) * fracY));
+            addToPixel(x + 1, y + 1, color * (fracX * fracY));
+        }
+
+        void drawCircle(RealVector2D const& pos, Color const& color, float radius)
+        {
+            if (radius < 2.0f) {
+                drawDot(pos, color * (radius * 2));
+                return;
+            }
+            auto radiusSquared = radius * radius;
+            for (float x = -radius; x <= radius; x += 1.0f) {
+                for (float y = -radius; y <= radius; y += 1.0f) {
+                    auto rSquared = x * x + y * y;
+                    if (rSquared <= radiusSquared) {
+                        drawDot({pos.x + x, pos.y + y}, color * std::min(rSquared / radiusSquared * 2, 1.0f));
+                    }
+                }
+            }
+        }
+
+        void drawLine(RealVector2D const& start, RealVector2D const& end, Color const& color)
+        {
+            auto constexpr PixelDistance = 1.5f;
+            auto delta = end - start;
+            auto distance = Math::length(delta);
+            if (distance < NEAR_ZERO) {
+                return;
+            }
+            auto step = delta * (PixelDistance / distance);
+            auto pos = start;
+            for (float d = 0; d <= distance; d += PixelDistance) {
+                drawDot(pos, color);
+                pos += step;
+            }
+        }
+
+        Frame toFrame(Color const& backgroundColor) const
+        {
+            Frame result{_size, std::vector<uint8_t>(_data.size())};
+            float const background[] = {backgroundColor.r, backgroundColor.g, backgroundColor.b};
+            for (size_t i = 0; i < _data.size(); ++i) {
+                result.pixels[i] = static_cast<uint8_t>(std::min(255.0f, (_data[i] + background[i % 3]) * 255.0f));
+            }
+            return result;
+        }
+
+    private:
+        void addToPixel(int x, int y, Color const& color)
+        {
+            if (x < 0 || y < 0 || x >= _size.x || y >= _size.y) {
+                return;
+            }
+            auto index = (x + y * _size.x) * 3;
+            _data[index] += color.r;
+            _data[index + 1] += color.g;
+            _data[index + 2] += color.b;
+        }
+
+        IntVector2D _size;
+        std::vector<float> _data;
+    };
+}
+
+Frame SoftwareRasterizer::draw(DataDescription const& data, IntVector2D const& worldSize, IntVector2D const& frameSize, SimulationParameters const& parameters)
+{
+    Canvas canvas(frameSize);
+
+    //the whole world is fitted into the frame
+    auto zoom = std::min(toFloat(frameSize.x) / toFloat(worldSize.x), toFloat(frameSize.y) / toFloat(worldSize.y));
+    RealVector2D offset{(toFloat(frameSize.x) - toFloat(worldSize.x) * zoom) / 2, (toFloat(frameSize.y) - toFloat(worldSize.y) * zoom) / 2};
+    auto mapWorldPosToFramePos = [&](RealVector2D const& pos) {
+        return RealVector2D{pos.x * zoom + offset.x, pos.y * zoom + offset.y};
+    };
+
+    std::unordered_map<uint64_t, RealVector2D> cellPosById;
+    if (zoom >= ZoomLevelForConnections) {
+        for (auto const& cell : data.cells) {
+            cellPosById.emplace(cell.id, cell.pos);
+        }
+    }
+    for (auto const& cell : data.cells) {
+        auto color = calcCellColor(cell, parameters);
+        auto framePos = mapWorldPosToFramePos(cell.pos);
+        canvas.drawCircle(framePos, color, zoom / 3);
+
+        if (zoom >= ZoomLevelForConnections) {
+            color = color * std::min((zoom - 1.0f) / 3, 1.0f);
+            for (auto const& connection : cell.connections) {
+                auto findResult = cellPosById.find(connection.cellId);
+                if (findResult == cellPosById.end()) {
+                    continue;
+                }
+                auto otherCellPos = findResult->second;
+                auto delta = otherCellPos - cell.pos;
+                if (std::abs(delta.x) > toFloat(worldSize.x) / 2 || std::abs(delta.y) > toFloat(worldSize.y) / 2) {
+                    continue;  //connection across the world boundary
+                }
+                auto distFromCellCenter = delta * (1.0f / (3.0f * Math::length(delta)));
+                canvas.drawLine(mapWorldPosToFramePos(cell.pos + distFromCellCenter), mapWorldPosToFramePos(otherCellPos - distFromCellCenter), color);
+            }
+        }
+    }
+    for (auto const& particle : data.particles) {
+        canvas.drawCircle(mapWorldPosToFramePos(particle.pos), calcParticleColor(particle), zoom / 3);
+    }
+    return canvas.toFrame(toColor(parameters.backgroundColor));
+}
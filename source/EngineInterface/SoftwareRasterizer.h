@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Descriptions.h"
+#include "Frame.h"
+#include "SimulationParameters.h"
+
+/**
+ * Draws cells, connections and energy particles of the whole world into a frame on the CPU. The result resembles the
+ * vector graphics of the GPU rendering (without spots, radiation sources and selection) and is used where no OpenGL
+ * context is available, e.g. for frames of headless runs.
+ */
+class SoftwareRasterizer
+{
+public:
+    static Frame draw(DataDescription const& data, IntVector2D const& worldSize, IntVector2D const& frameSize, SimulationParameters const& parameters);
+};
@@ -0,0 +1,229 @@
+#include "StatisticsExporter.h"
+
+#include <cstring>
+#include <functional>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    char const BinaryMagic[] = "ALIENSTS";
+    uint32_t const BinaryVersion = 1;
+
+    struct StatisticsField
+    {
+        char const* name;
+        char const* metric;  //identifier in expressions
+        bool isFloat;
+        std::function<double(TimelineStatistics const&, int color)> getValue;
+    };
+
+    std::vector<StatisticsField> const& getFields()
+    {
+        static std::vector<StatisticsField> const result = {
+            {"Cells", "numCells", false, [](auto const& s, int color) { return s.timestep.numCells[color]; }},
+            {"Self-replicators", "numSelfReplicators", false, [](auto const& s, int color) { return s.timestep.numSelfReplicators[color]; }},
+            {"Viruses", "numViruses", false, [](auto const& s, int color) { return s.timestep.numViruses[color]; }},
+            {"Cell connections", "numConnections", false, [](auto const& s, int color) { return s.timestep.numConnections[color]; }},
+            {"Energy particles", "numParticles", false, [](auto const& s, int color) { return s.timestep.numParticles[color]; }},
+            {"Total energy", "totalEnergy", true, [](auto const& s, int color) { return s.timestep.totalEnergy[color]; }},
+            {"Total genome cells", "numGenomeCells", false, [](auto const& s, int color) { return toDouble(s.timestep.numGenomeCells[color]); }},
+            {"Created cells", "numCreatedCells", false, [](auto const& s, int color) { return toDouble(s.accumulated.numCreatedCells[color]); }},
+            {"Attacks", "numAttacks", false, [](auto const& s, int color) { return toDouble(s.accumulated.numAttacks[color]); }},
+            {"Muscle activities", "numMuscleActivities", false, [](auto const& s, int color) { return toDouble(s.accumulated.numMuscleActivities[color]); }},
+            {"Transmitter activities",
+             "numTransmitterActivities",
+             false,
+             [](auto const& s, int color) { return toDouble(s.accumulated.numTransmitterActivities[color]); }},
+            {"Defender activities",
+             "numDefenderActivities",
+             false,
+             [](auto const& s, int color) { return toDouble(s.accumulated.numDefenderActivities[color]); }},
+            {"Injection activities",
+             "numInjectionActivities",
+             false,
+             [](auto const& s, int color) { return toDouble(s.accumulated.numInjectionActivities[color]); }},
+            {"Completed injections",
+             "numCompletedInjections",
+             false,
+             [](auto const& s, int color) { return toDouble(s.accumulated.numCompletedInjections[color]); }},
+            {"Nerve pulses", "numNervePulses", false, [](auto const& s, int color) { return toDouble(s.accumulated.numNervePulses[color]); }},
+            {"Neuron activities", "numNeuronActivities", false, [](auto const& s, int color) { return toDouble(s.accumulated.numNeuronActivities[color]); }},
+            {"Sensor activities", "numSensorActivities", false, [](auto const& s, int color) { return toDouble(s.accumulated.numSensorActivities[color]); }},
+            {"Sensor matches", "numSensorMatches", false, [](auto const& s, int color) { return toDouble(s.accumulated.numSensorMatches[color]); }},
+        };
+        return result;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+std::vector<std::string> StatisticsExporter::getColumnNames()
+{
+    std::vector<std::string> result;
+    for (auto const& field : getFields()) {
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result.emplace_back(std::string(field.name) + " (color " + std::to_string(i) + ")");
+        }
+    }
+    return result;
+}
+
+std::optional<double> StatisticsExporter::getMetricValue(TimelineStatistics const& statistics, std::string const& metric)
+{
+    auto bracketPos = metric.find('[');
+    auto fieldMetric = metric.substr(0, bracketPos);
+    std::optional<int> color;
+    if (bracketPos != std::string::npos) {
+        if (metric.back() != ']' || metric.size() != bracketPos + 3 || metric[bracketPos + 1] < '0' || metric[bracketPos + 1] >= '0' + MAX_COLORS) {
+            return std::nullopt;
+        }
+        color = metric[bracketPos + 1] - '0';
+    }
+    for (auto const& field : getFields()) {
+        if (fieldMetric != field.metric) {
+            continue;
+        }
+        if (color) {
+            return field.getValue(statistics, *color);
+        }
+        auto result = 0.0;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result += field.getValue(statistics, i);
+        }
+        return result;
+    }
+    return std::nullopt;
+}
+
+std::vector<double> StatisticsExporter::getColumnValues(TimelineStatistics const& statistics)
+{
+    std::vector<double> result;
+    result.reserve(getFields().size() * MAX_COLORS);
+    for (auto const& field : getFields()) {
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result.emplace_back(field.getValue(statistics, i));
+        }
+    }
+    return result;
+}
+
+void StatisticsExporter::writeCsvHeader(std::ostream& stream)
+{
+    stream << "Time step";
+    for (auto const& columnName : getColumnNames()) {
+        stream << ", " << columnName;
+    }
+    stream << std::endl;
+}
+
+void StatisticsExporter::writeCsvRow(std::ostream& stream, uint64_t timestep, TimelineStatistics const& statistics)
+{
+    writeCsvRow(stream, timestep, getColumnValues(statistics));
+}
+
+void StatisticsExporter::writeCsvRow(std::ostream& stream, uint64_t timestep, std::vector<double> const& values)
+{
+    stream << timestep;
+    writeCsvValues(stream, values);
+    stream << "\n";  //flushed by the caller
+}
+
+void StatisticsExporter::writeCsvValues(std::ostream& stream, std::vector<double> const& values)
+{
+    auto const& fields = getFields();
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (fields.at(i / MAX_COLORS).isFloat) {
+            stream << ", " << static_cast<float>(values[i]);
+        } else {
+            stream << ", " << static_cast<uint64_t>(values[i]);
+        }
+    }
+}
+
+void StatisticsExporter::writeBinaryHeader(std::ostream& stream)
+{
+    stream.write(BinaryMagic, sizeof(BinaryMagic) - 1);
+    writeValue(stream, BinaryVersion);
+
+    auto columnNames = getColumnNames();
+    writeValue(stream, static_cast<uint32_t>(columnNames.size()));
+    for (auto const& columnName : columnNames) {
+        writeValue(stream, static_cast<uint32_t>(columnName.size()));
+        stream.write(columnName.data(), columnName.size());
+    }
+}
+
+void StatisticsExporter::writeBinaryBlock(std::ostream& stream, std::vector<uint64_t> const& timesteps, std::vector<std::vector<double>> const& rows)
+{
+    if (timesteps.empty()) {
+        return;
+    }
+    writeValue(stream, static_cast<uint32_t>(timesteps.size()));
+    stream.write(reinterpret_cast<char const*>(timesteps.data()), sizeof(uint64_t) * timesteps.size());
+
+    auto numColumns = rows.front().size();
+    std::vector<double> column(rows.size());
+    for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex) {
+        for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+            column[rowIndex] = rows[rowIndex][columnIndex];
+        }
+        stream.write(reinterpret_cast<char const*>(column.data()), sizeof(double) * column.size());
+    }
+}
+
+std::optional<StatisticsTimeSeries> StatisticsExporter::readBinary(std::istream& stream)
+{
+    char magic[sizeof(BinaryMagic) - 1];
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, BinaryMagic, sizeof(magic)) != 0) {
+        return std::nullopt;
+    }
+    uint32_t version;
+    if (!readValue(stream, version) || version != BinaryVersion) {
+        return std::nullopt;
+    }
+
+    StatisticsTimeSeries result;
+    uint32_t numColumns;
+    if (!readValue(stream, numColumns)) {
+        return std::nullopt;
+    }
+    for (uint32_t i = 0; i < numColumns; ++i) {
+        uint32_t length;
+        if (!readValue(stream, length)) {
+            return std::nullopt;
+        }
+        std::string columnName(length, '\0');
+        if (!stream.read(columnName.data(), length)) {
+            return std::nullopt;
+        }
+        result.columnNames.emplace_back(columnName);
+    }
+    result.columns.resize(numColumns);
+
+    uint32_t numRows;
+    while (readValue(stream, numRows)) {
+        auto offset = result.timesteps.size();
+        result.timesteps.resize(offset + numRows);
+        if (!stream.read(reinterpret_cast<char*>(result.timesteps.data() + offset), sizeof(uint64_t) * numRows)) {
+            return std::nullopt;
+        }
+        for (auto& column : result.columns) {
+            column.resize(offset + numRows);
+            if (!stream.read(reinterpret_cast<char*>(column.data() + offset), sizeof(double) * numRows)) {
+                return std::nullopt;
+            }
+        }
+    }
+    return result;
+}
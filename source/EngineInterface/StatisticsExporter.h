@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "StatisticsData.h"
+
+//statistics over time in column-major layout
+struct StatisticsTimeSeries
+{
+    std::vector<std::string> columnNames;  //without time step
+    std::vector<uint64_t> timesteps;
+    std::vector<std::vector<double>> columns;  //one vector of values per column
+};
+
+/**
+ * Flattens the timeline statistics into columns (one column per statistic and color) and writes them either as CSV or
+ * in a compact binary format. The binary format consists of a header with the column names followed by blocks of rows in
+ * column-major layout:
+ *   header: "ALIENSTS", uint32 version, uint32 number of columns, for each column: uint32 name length and name
+ *   block: uint32 number of rows, uint64 time steps, for each column: double values
+ */
+class StatisticsExporter
+{
+public:
+    static std::vector<std::string> getColumnNames();
+    static std::vector<double> getColumnValues(TimelineStatistics const& statistics);
+
+    //metrics are named like the fields of the statistics, e.g. "numSelfReplicators[0]" for color 0 or "numSelfReplicators" for the sum over all colors
+    static std::optional<double> getMetricValue(TimelineStatistics const& statistics, std::string const& metric);
+
+    static void writeCsvHeader(std::ostream& stream);
+    static void writeCsvRow(std::ostream& stream, uint64_t timestep, TimelineStatistics const& statistics);
+    static void writeCsvRow(std::ostream& stream, uint64_t timestep, std::vector<double> const& values);  //values from 'getColumnValues'
+    static void writeCsvValues(std::ostream& stream, std::vector<double> const& values);  //each value is preceded by ", "
+
+    static void writeBinaryHeader(std::ostream& stream);
+    static void writeBinaryBlock(std::ostream& stream, std::vector<uint64_t> const& timesteps, std::vector<std::vector<double>> const& rows);
+    static std::optional<StatisticsTimeSeries> readBinary(std::istream& stream);
+};
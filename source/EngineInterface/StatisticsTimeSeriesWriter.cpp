@@ -0,0 +1,191 @@
+#include "StatisticsTimeSeriesWriter.h"
+
+#include <filesystem>
+#include <sstream>
+
+#include "Base/Definitions.h"
+
+#include "StatisticsExporter.h"
+
+namespace
+{
+    std::ios_base::openmode getOpenMode(StatisticsFormat format, std::ios_base::openmode mode)
+    {
+        return format == StatisticsFormat_Binary ? mode | std::ios_base::binary : mode;
+    }
+
+    bool copyCsvRowsBefore(std::istream& input, std::ostream& output, uint64_t timestep)
+    {
+        std::stringstream expectedHeader;
+        StatisticsExporter::writeCsvHeader(expectedHeader);
+        std::string line;
+        if (!std::getline(input, line) || line + "\n" != expectedHeader.str()) {
+            return false;
+        }
+        output << line << "\n";
+        while (std::getline(input, line)) {
+            uint64_t rowTimestep;
+            if (!(std::istringstream(line) >> rowTimestep)) {
+                return false;
+            }
+            if (rowTimestep < timestep) {
+                output << line << "\n";
+            }
+        }
+        return true;
+    }
+
+    bool copyBinaryRowsBefore(std::istream& input, std::ostream& output, uint64_t timestep)
+    {
+        auto timeSeries = StatisticsExporter::readBinary(input);
+        if (!timeSeries || timeSeries->columnNames != StatisticsExporter::getColumnNames()) {
+            return false;
+        }
+        std::vector<uint64_t> timesteps;
+        std::vector<std::vector<double>> rows;
+        for (size_t rowIndex = 0; rowIndex < timeSeries->timesteps.size(); ++rowIndex) {
+            if (timeSeries->timesteps[rowIndex] >= timestep) {
+                continue;
+            }
+            timesteps.emplace_back(timeSeries->timesteps[rowIndex]);
+            auto& row = rows.emplace_back();
+            for (auto const& column : timeSeries->columns) {
+                row.emplace_back(column[rowIndex]);
+            }
+        }
+        StatisticsExporter::writeBinaryHeader(output);
+        StatisticsExporter::writeBinaryBlock(output, timesteps, rows);
+        return true;
+    }
+}
+
+StatisticsTimeSeriesWriter::StatisticsTimeSeriesWriter(int flushThreshold)
+    : _flushThreshold(flushThreshold)
+{}
+
+StatisticsTimeSeriesWriter::~StatisticsTimeSeriesWriter()
+{
+    close();
+}
+
+bool StatisticsTimeSeriesWriter::open(std::string const& filename, StatisticsFormat format)
+{
+    close();
+
+    _format = format;
+    _file.open(filename, getOpenMode(format, std::ios_base::out));
+    if (!_file) {
+        return false;
+    }
+    if (_format == StatisticsFormat_Binary) {
+        StatisticsExporter::writeBinaryHeader(_file);
+    } else {
+        StatisticsExporter::writeCsvHeader(_file);
+    }
+    startWriterThread();
+    return true;
+}
+
+bool StatisticsTimeSeriesWriter::openForResume(std::string const& filename, StatisticsFormat format, uint64_t timestep)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(filename, error)) {
+        return open(filename, format);
+    }
+    close();
+
+    //the kept rows are written to a temporary file first so that the existing file remains intact on failure
+    auto tempFilename = filename + ".tmp";
+    {
+        std::ifstream input(filename, getOpenMode(format, std::ios_base::in));
+        std::ofstream output(tempFilename, getOpenMode(format, std::ios_base::out));
+        auto success = input && output
+            && (format == StatisticsFormat_Binary ? copyBinaryRowsBefore(input, output, timestep) : copyCsvRowsBefore(input, output, timestep));
+        output.close();
+        if (!success || !output) {
+            std::filesystem::remove(tempFilename, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error) {
+        return false;
+    }
+
+    _format = format;
+    _file.open(filename, getOpenMode(format, std::ios_base::out | std::ios_base::app));
+    if (!_file) {
+        return false;
+    }
+    startWriterThread();
+    return true;
+}
+
+void StatisticsTimeSeriesWriter::add(uint64_t timestep, TimelineStatistics const& statistics)
+{
+    if (!_writerThread.joinable()) {
+        return;
+    }
+    auto values = StatisticsExporter::getColumnValues(statistics);
+    bool notify;
+    {
+        std::lock_guard lock(_mutex);
+        _pendingTimesteps.emplace_back(timestep);
+        _pendingRows.emplace_back(std::move(values));
+        notify = toInt(_pendingRows.size()) >= _flushThreshold;
+    }
+    if (notify) {
+        _condition.notify_one();
+    }
+}
+
+void StatisticsTimeSeriesWriter::close()
+{
+    if (!_writerThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard lock(_mutex);
+        _isClosing = true;
+    }
+    _condition.notify_one();
+    _writerThread.join();
+    _file.close();
+}
+
+void StatisticsTimeSeriesWriter::startWriterThread()
+{
+    _isClosing = false;
+    _writerThread = std::thread(&StatisticsTimeSeriesWriter::runWriterThread, this);
+}
+
+void StatisticsTimeSeriesWriter::runWriterThread()
+{
+    std::vector<uint64_t> timesteps;
+    std::vector<std::vector<double>> rows;
+    bool isClosing = false;
+    while (!isClosing) {
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this] { return _isClosing || toInt(_pendingRows.size()) >= _flushThreshold; });
+            timesteps.swap(_pendingTimesteps);
+            rows.swap(_pendingRows);
+            isClosing = _isClosing;
+        }
+        writeRows(timesteps, rows);
+        _file.flush();
+        timesteps.clear();
+        rows.clear();
+    }
+}
+
+void StatisticsTimeSeriesWriter::writeRows(std::vector<uint64_t> const& timesteps, std::vector<std::vector<double>> const& rows)
+{
+    if (_format == StatisticsFormat_Binary) {
+        StatisticsExporter::writeBinaryBlock(_file, timesteps, rows);
+    } else {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            StatisticsExporter::writeCsvRow(_file, timesteps[i], rows[i]);
+        }
+    }
+}
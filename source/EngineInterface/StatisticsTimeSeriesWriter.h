@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StatisticsData.h"
+
+using StatisticsFormat = int;
+enum StatisticsFormat_
+{
+    StatisticsFormat_Csv,
+    StatisticsFormat_Binary
+};
+
+/**
+ * Append-only writer for statistics sampled over time. 'add(...)' only buffers the values; the buffered rows are
+ * written by a background thread as soon as 'flushThreshold' rows are pending so that the simulation loop does not wait for the file system.
+ * A simulation resumed from a checkpoint continues the file of the interrupted run via 'openForResume(...)'.
+ */
+class StatisticsTimeSeriesWriter
+{
+public:
+    StatisticsTimeSeriesWriter(int flushThreshold = 256);
+    ~StatisticsTimeSeriesWriter();
+
+    bool open(std::string const& filename, StatisticsFormat format);
+
+    //keeps the rows of an existing file before 'timestep' and appends the new rows, the remaining rows are dropped since the resumed
+    //simulation writes them again; fails if the existing file has a different format or columns
+    bool openForResume(std::string const& filename, StatisticsFormat format, uint64_t timestep);
+
+    void add(uint64_t timestep, TimelineStatistics const& statistics);
+    void close();  //writes pending rows and waits for the background thread
+
+private:
+    void startWriterThread();
+    void runWriterThread();
+    void writeRows(std::vector<uint64_t> const& timesteps, std::vector<std::vector<double>> const& rows);
+
+    int _flushThreshold;
+    StatisticsFormat _format = StatisticsFormat_Csv;
+    std::ofstream _file;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<uint64_t> _pendingTimesteps;
+    std::vector<std::vector<double>> _pendingRows;
+    bool _isClosing = false;
+    std::thread _writerThread;
+};
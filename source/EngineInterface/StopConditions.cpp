@@ -0,0 +1,151 @@
+#include "StopConditions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <boost/algorithm/string.hpp>
+
+#include "Base/Definitions.h"
+
+#include "StatisticsExporter.h"
+
+namespace
+{
+    std::vector<std::string> split(std::string const& text, std::string const& separator)
+    {
+        std::vector<std::string> result;
+        size_t start = 0;
+        for (auto pos = text.find(separator); pos != std::string::npos; pos = text.find(separator, start)) {
+            result.emplace_back(text.substr(start, pos - start));
+            start = pos + separator.size();
+        }
+        result.emplace_back(text.substr(start));
+        return result;
+    }
+}
+
+void StopConditions::addExtinction()
+{
+    _extinction = true;
+}
+
+void StopConditions::addExpression(std::string const& expression)
+{
+    Expression result;
+    result.text = expression;
+    for (auto const& conjunction : split(expression, "||")) {
+        std::vector<Term> terms;
+        for (auto const& term : split(conjunction, "&&")) {
+            terms.emplace_back(parseTerm(term));
+        }
+        result.disjunction.emplace_back(terms);
+    }
+    _expressions.emplace_back(result);
+}
+
+void StopConditions::addPlateau(std::string const& metric, int window, double tolerance)
+{
+    if (!StatisticsExporter::getMetricValue(TimelineStatistics(), metric)) {
+        throw InvalidStopConditionException("Unknown metric '" + metric + "'.");
+    }
+    if (window < 2 || tolerance < 0) {
+        throw InvalidStopConditionException("The plateau window must contain at least 2 samples and the tolerance must not be negative.");
+    }
+    _plateaus.emplace_back(Plateau{metric, window, tolerance, {}});
+}
+
+void StopConditions::setMaxDuration(std::chrono::milliseconds const& duration)
+{
+    _maxDuration = duration;
+}
+
+bool StopConditions::isEmpty() const
+{
+    return !_extinction && _expressions.empty() && _plateaus.empty() && !_maxDuration;
+}
+
+std::optional<std::string> StopConditions::evaluate(TimelineStatistics const& statistics, std::chrono::milliseconds const& elapsedTime)
+{
+    if (_extinction && *StatisticsExporter::getMetricValue(statistics, "numSelfReplicators") == 0) {
+        return "extinct";
+    }
+    for (auto const& expression : _expressions) {
+        for (auto const& conjunction : expression.disjunction) {
+            if (std::all_of(conjunction.begin(), conjunction.end(), [&](auto const& term) { return evaluate(term, statistics); })) {
+                return "'" + expression.text + "' holds";
+            }
+        }
+    }
+    for (auto& plateau : _plateaus) {
+        plateau.values.emplace_back(*StatisticsExporter::getMetricValue(statistics, plateau.metric));
+        if (toInt(plateau.values.size()) > plateau.window) {
+            plateau.values.pop_front();
+        }
+        if (toInt(plateau.values.size()) == plateau.window) {
+            auto [min, max] = std::minmax_element(plateau.values.begin(), plateau.values.end());
+            auto mean = std::accumulate(plateau.values.begin(), plateau.values.end(), 0.0) / plateau.window;
+            if (*max - *min <= plateau.tolerance * std::abs(mean)) {
+                return "plateau of " + plateau.metric + " reached";
+            }
+        }
+    }
+    if (_maxDuration && elapsedTime >= *_maxDuration) {
+        return "time budget exhausted";
+    }
+    return std::nullopt;
+}
+
+auto StopConditions::parseTerm(std::string const& text) -> Term
+{
+    //longer operators first since '<' is a prefix of '<='
+    static std::vector<std::pair<std::string, Comparison>> const Operators = {
+        {"<=", Comparison_LessEqual},
+        {">=", Comparison_GreaterEqual},
+        {"==", Comparison_Equal},
+        {"!=", Comparison_NotEqual},
+        {"<", Comparison_Less},
+        {">", Comparison_Greater}};
+    for (auto const& [op, comparison] : Operators) {
+        auto pos = text.find(op);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        auto metric = boost::algorithm::trim_copy(text.substr(0, pos));
+        auto valueString = boost::algorithm::trim_copy(text.substr(pos + op.size()));
+        if (!StatisticsExporter::getMetricValue(TimelineStatistics(), metric)) {
+            throw InvalidStopConditionException("Unknown metric '" + metric + "'.");
+        }
+        try {
+            size_t numParsedChars = 0;
+            auto value = std::stod(valueString, &numParsedChars);
+            if (numParsedChars == valueString.size()) {
+                return Term{metric, comparison, value};
+            }
+        } catch (...) {
+        }
+        throw InvalidStopConditionException("Invalid number '" + valueString + "'.");
+    }
+    throw InvalidStopConditionException("No comparison found in '" + boost::algorithm::trim_copy(text) + "'.");
+}
+
+bool StopConditions::evaluate(Term const& term, TimelineStatistics const& statistics)
+{
+    auto value = *StatisticsExporter::getMetricValue(statistics, term.metric);
+    switch (term.comparison) {
+    case Comparison_Less:
+        return value < term.value;
+    case Comparison_LessEqual:
+        return value <= term.value;
+    case Comparison_Greater:
+        return value > term.value;
+    case Comparison_GreaterEqual:
+        return value >= term.value;
+    case Comparison_Equal:
+        return value == term.value;
+    case Comparison_NotEqual:
+        return value != term.value;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "StatisticsData.h"
+
+class InvalidStopConditionException : public std::runtime_error
+{
+public:
+    InvalidStopConditionException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
+
+/**
+ * Conditions for the early termination of a run, evaluated on sampled statistics. Metrics are named as in
+ * 'StatisticsExporter::getMetricValue'. Expressions consist of comparisons 'metric op number' (op: <, <=, >, >=, ==, !=)
+ * which can be combined by '&&' and '||' ('&&' binds stronger), e.g. "numSelfReplicators[0] > 10000 || numCells < 100".
+ */
+class StopConditions
+{
+public:
+    void addExtinction();  //no self-replicators left
+    void addExpression(std::string const& expression);  //throws InvalidStopConditionException
+    void addPlateau(std::string const& metric, int window, double tolerance);  //throws InvalidStopConditionException
+    void setMaxDuration(std::chrono::milliseconds const& duration);
+
+    bool isEmpty() const;
+
+    //returns the reason if the run should be stopped
+    std::optional<std::string> evaluate(TimelineStatistics const& statistics, std::chrono::milliseconds const& elapsedTime);
+
+private:
+    using Comparison = int;
+    enum Comparison_
+    {
+        Comparison_Less,
+        Comparison_LessEqual,
+        Comparison_Greater,
+        Comparison_GreaterEqual,
+        Comparison_Equal,
+        Comparison_NotEqual
+    };
+    struct Term
+    {
+        std::string metric;
+        Comparison comparison;
+        double value;
+    };
+    struct Expression
+    {
+        std::string text;
+        std::vector<std::vector<Term>> disjunction;  //'||' of '&&'-connected terms
+    };
+    struct Plateau
+    {
+        std::string metric;
+        int window;
+        double tolerance;  //relative to the mean
+        std::deque<double> values;
+    };
+
+    static Term parseTerm(std::string const& text);
+    static bool evaluate(Term const& term, TimelineStatistics const& statistics);
+
+    bool _extinction = false;
+    std::vector<Expression> _expressions;
+    std::vector<Plateau> _plateaus;
+    std::optional<std::chrono::milliseconds> _maxDuration;
+};
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/Arena.h"
+#include "Base/ThreadPool.h"
+
+class ArenaTests : public ::testing::Test
+{
+public:
+    virtual ~ArenaTests() = default;
+
+protected:
+    struct Allocation
+    {
+        uint8_t* data;
+        size_t size;
+        uint8_t value;
+    };
+
+    bool isUnchanged(Allocation const& allocation) const
+    {
+        return std::all_of(allocation.data, allocation.data + allocation.size, [&](auto value) { return value == allocation.value; });
+    }
+};
+
+TEST_F(ArenaTests, alignmentAndDisjointAllocations)
+{
+    Arena arena(1024);
+    std::vector<Allocation> allocations;
+    for (int i = 0; i < 1000; ++i) {
+        auto size = static_cast<size_t>(i % 37);
+        auto alignment = size_t(1) << (i % 7);
+        auto data = static_cast<uint8_t*>(arena.allocate(size, alignment));
+        ASSERT_NE(nullptr, data);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(data) % alignment);
+        auto value = static_cast<uint8_t>(i);
+        std::fill(data, data + size, value);
+        allocations.emplace_back(Allocation{data, size, value});
+    }
+    for (auto const& allocation : allocations) {
+        EXPECT_TRUE(isUnchanged(allocation));
+    }
+}
+
+TEST_F(ArenaTests, largeAllocationGetsOwnChunk)
+{
+    Arena arena(1024);
+    auto small1 = arena.allocateArray<uint8_t>(16);
+    EXPECT_EQ(1, arena.getNumChunks());
+
+    auto large = arena.allocateArray<uint8_t>(4000);
+    std::fill(large, large + 4000, uint8_t(1));
+    EXPECT_EQ(2, arena.getNumChunks());
+    EXPECT_LE(4000, arena.getNumReservedBytes() - 1024);
+
+    //the thread continues to allocate from its previous chunk
+    auto small2 = arena.allocateArray<uint8_t>(16);
+    EXPECT_EQ(2, arena.getNumChunks());
+    EXPECT_EQ(small1 + 16, small2);
+}
+
+TEST_F(ArenaTests, resetReusesChunks)
+{
+    Arena arena(1024);
+    auto allocate = [&] {
+        for (int i = 0; i < 100; ++i) {
+            arena.allocateArray<double>(20);
+        }
+    };
+    allocate();
+    auto numChunks = arena.getNumChunks();
+    auto numReservedBytes = arena.getNumReservedBytes();
+    EXPECT_LT(1, numChunks);
+    EXPECT_EQ(0, arena.getGeneration());
+
+    arena.reset();
+    EXPECT_EQ(1, arena.getGeneration());
+    EXPECT_EQ(0, arena.getNumChunks());
+    EXPECT_EQ(numReservedBytes, arena.getNumReservedBytes());
+
+    allocate();
+    EXPECT_EQ(numChunks, arena.getNumChunks());
+    EXPECT_EQ(numReservedBytes, arena.getNumReservedBytes());
+}
+
+TEST_F(ArenaTests, concurrentAllocations)
+{
+    Arena arena(4096);
+    ThreadPool threadPool(4);
+    for (int generation = 0; generation < 3; ++generation) {
+        int constexpr NumItems = 10000;
+        std::vector<Allocation> allocations(NumItems);
+        threadPool.parallelFor(NumItems, 64, [&](int begin, int end) {
+            for (int index = begin; index < end; ++index) {
+                auto size = static_cast<size_t>(1 + index % 50);
+                auto value = static_cast<uint8_t>(index + generation);
+                auto data = arena.allocateArray<uint8_t>(size);
+                std::fill(data, data + size, value);
+                allocations[index] = Allocation{data, size, value};
+            }
+        });
+        for (auto const& allocation : allocations) {
+            ASSERT_TRUE(isUnchanged(allocation));
+        }
+        arena.reset();
+    }
+}
@@ -0,0 +1,37 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/BatchJobs.h"
+
+class BatchJobsTests : public ::testing::Test
+{
+public:
+    virtual ~BatchJobsTests() = default;
+};
+
+TEST_F(BatchJobsTests, parse)
+{
+    std::stringstream stream(
+        "# input time steps output\n"
+        "a.sim 1000 out/a.sim\n"
+        "\n"
+        "  \"world b.sim\"\t0   \"out/world b.sim\"  \n");
+    auto jobs = BatchJobs::parse(stream);
+
+    ASSERT_EQ(2, jobs.size());
+    EXPECT_EQ("a.sim", jobs.at(0).inputFilename);
+    EXPECT_EQ(1000, jobs.at(0).timesteps);
+    EXPECT_EQ("out/a.sim", jobs.at(0).outputFilename);
+    EXPECT_EQ("world b.sim", jobs.at(1).inputFilename);
+    EXPECT_EQ(0, jobs.at(1).timesteps);
+    EXPECT_EQ("out/world b.sim", jobs.at(1).outputFilename);
+}
+
+TEST_F(BatchJobsTests, invalidLines)
+{
+    for (auto const& content : {"a.sim 1000", "a.sim many out.sim", "a.sim -5 out.sim", "a.sim 1000 out.sim extra", "# no jobs\n"}) {
+        std::stringstream stream(content);
+        EXPECT_THROW(BatchJobs::parse(stream), InvalidBatchJobsException) << content;
+    }
+}
@@ -0,0 +1,87 @@
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Benchmark.h"
+
+class BenchmarkTests : public ::testing::Test
+{
+public:
+    virtual ~BenchmarkTests() = default;
+};
+
+TEST_F(BenchmarkTests, referenceWorlds)
+{
+    auto names = Benchmark::getReferenceWorldNames();
+    ASSERT_EQ(3, names.size());
+    EXPECT_EQ("small", names.front());
+
+    auto world = Benchmark::createReferenceWorld("small");
+    ASSERT_TRUE(world.has_value());
+    EXPECT_EQ(512, world->worldSize.x);
+    EXPECT_EQ(256, world->worldSize.y);
+    EXPECT_EQ(24 * 12 * 36, world->data.cells.size());
+    EXPECT_EQ(24 * 12, world->data.particles.size());
+
+    for (auto const& cell : world->data.cells) {
+        EXPECT_GE(cell.pos.x, 0.0f);
+        EXPECT_LT(cell.pos.x, 512.0f);
+        EXPECT_GE(cell.pos.y, 0.0f);
+        EXPECT_LT(cell.pos.y, 256.0f);
+        EXPECT_LE(std::abs(cell.vel.x), 0.25f + 1e-5f);
+        EXPECT_LE(std::abs(cell.vel.y), 0.25f + 1e-5f);
+    }
+}
+
+TEST_F(BenchmarkTests, unknownReferenceWorld)
+{
+    EXPECT_FALSE(Benchmark::createReferenceWorld("huge").has_value());
+}
+
+TEST_F(BenchmarkTests, writeJsonReport)
+{
+    BenchmarkReport report;
+    report.world = "small \"test\"";
+    report.worldSize = {512, 256};
+    report.numCells = 100;
+    report.warmupTimesteps = 10;
+    report.intervals = {{100, 50.0}, {100, 200.0}};
+    report.profilingData.scopes = {{"Physics", 100, 1.5f, 1.0f, 2.0f, 3.0f, 4.0f}};
+    DeviceMemoryData deviceMemoryData;
+    deviceMemoryData.peakMemory = 1024;
+    deviceMemoryData.numArrayResizes = 2;
+    report.deviceMemoryData = deviceMemoryData;
+    report.uploadDuration = 12.5;
+
+    std::stringstream stream;
+    Benchmark::writeJsonReport(stream, report);
+
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(stream, tree);
+    EXPECT_EQ("small \"test\"", tree.get<std::string>("world"));
+    EXPECT_EQ(100, tree.get<int>("cells"));
+    EXPECT_DOUBLE_EQ(800.0, tree.get<double>("tps.mean"));
+    EXPECT_DOUBLE_EQ(500.0, tree.get<double>("tps.min"));
+    EXPECT_DOUBLE_EQ(2000.0, tree.get<double>("tps.max"));
+    EXPECT_EQ(2, tree.get_child("intervals").size());
+    EXPECT_EQ("Physics", tree.get_child("phases").front().second.get<std::string>("name"));
+    EXPECT_DOUBLE_EQ(12.5, tree.get<double>("host.upload [ms]"));
+    EXPECT_EQ(1024, tree.get<int>("device.peak memory [bytes]"));
+    EXPECT_EQ(2, tree.get<int>("device.array resizes"));
+}
+
+TEST_F(BenchmarkTests, writeJsonReport_withoutDeviceMemory)
+{
+    BenchmarkReport report;
+    report.intervals = {{100, 50.0}};
+
+    std::stringstream stream;
+    Benchmark::writeJsonReport(stream, report);
+
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(stream, tree);
+    EXPECT_EQ("null", tree.get<std::string>("device"));
+    EXPECT_FALSE(tree.get_child_optional("device.peak memory [bytes]").has_value());
+}
@@ -0,0 +1,133 @@
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CheckpointStore.h"
+
+class CheckpointStoreTests : public ::testing::Test
+{
+public:
+    CheckpointStoreTests() { std::filesystem::remove_all(Directory); }
+    virtual ~CheckpointStoreTests() { std::filesystem::remove_all(Directory); }
+
+protected:
+    static auto constexpr Directory = "checkpointStoreTests.tmp";
+
+    DeserializedSimulation createSimulation(uint64_t timestep) const
+    {
+        DeserializedSimulation result;
+        result.auxiliaryData.timestep = timestep;
+        result.auxiliaryData.generalSettings.worldSizeX = 123;
+        result.auxiliaryData.simulationParameters.baseValues.radiationCellAgeStrength[0] = 0.5f;
+        return result;
+    }
+
+    void corruptFile(std::string const& filename) const
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('#');
+    }
+};
+
+TEST_F(CheckpointStoreTests, writeAndReadCheckpointFile)
+{
+    std::filesystem::create_directories(Directory);
+    auto filename = std::string(Directory) + "/checkpoint_test.ckpt";
+
+    SerializedSimulation data{"{\"json\": 1}", std::string("binary\0data", 11)};
+    ASSERT_TRUE(CheckpointStore::writeCheckpointFile(filename, CheckpointHeader{1234, 5000}, data));
+
+    CheckpointHeader header;
+    SerializedSimulation readData;
+    ASSERT_TRUE(CheckpointStore::readCheckpointFile(header, readData, filename));
+    EXPECT_EQ(1234, header.timestep);
+    EXPECT_EQ(5000, header.targetTimestep);
+    EXPECT_EQ(data.auxiliaryData, readData.auxiliaryData);
+    EXPECT_EQ(data.mainData, readData.mainData);
+}
+
+TEST_F(CheckpointStoreTests, corruptedCheckpointFile)
+{
+    std::filesystem::create_directories(Directory);
+    auto filename = std::string(Directory) + "/checkpoint_test.ckpt";
+    ASSERT_TRUE(CheckpointStore::writeCheckpointFile(filename, CheckpointHeader{1234, 5000}, SerializedSimulation{"settings", "content"}));
+    corruptFile(filename);
+
+    CheckpointHeader header;
+    SerializedSimulation readData;
+    EXPECT_FALSE(CheckpointStore::readCheckpointFile(header, readData, filename));
+}
+
+TEST_F(CheckpointStoreTests, checkpointFileWithWrappingDataSizes)
+{
+    std::filesystem::create_directories(Directory);
+    auto filename = std::string(Directory) + "/checkpoint_test.ckpt";
+    ASSERT_TRUE(CheckpointStore::writeCheckpointFile(filename, CheckpointHeader{1234, 5000}, SerializedSimulation{"settings", "content"}));
+
+    //the sum of the data sizes wraps around to a value below the file size
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(28);  //magic, version, time steps
+        uint64_t sizes[] = {std::numeric_limits<uint64_t>::max(), 2};
+        file.write(reinterpret_cast<char const*>(sizes), sizeof(sizes));
+    }
+
+    CheckpointHeader header;
+    SerializedSimulation readData;
+    EXPECT_FALSE(CheckpointStore::readCheckpointFile(header, readData, filename));
+}
+
+TEST_F(CheckpointStoreTests, keepNewestCheckpoints)
+{
+    CheckpointStore store(Directory, 2, 20000);
+    ASSERT_TRUE(store.init());
+    for (uint64_t timestep : {100, 1000, 200, 10000}) {
+        store.save_async(createSimulation(timestep));
+    }
+    ASSERT_TRUE(store.waitForPendingSave());
+
+    auto filenames = CheckpointStore::getCheckpointFilenames(Directory);
+    ASSERT_EQ(2, filenames.size());
+    EXPECT_NE(std::string::npos, filenames.at(0).find("1000.ckpt"));
+    EXPECT_NE(std::string::npos, filenames.at(1).find("10000.ckpt"));
+}
+
+TEST_F(CheckpointStoreTests, loadLatest)
+{
+    {
+        CheckpointStore store(Directory, 3, 1000);
+        ASSERT_TRUE(store.init());
+        store.save_async(createSimulation(100));
+        store.save_async(createSimulation(200));
+    }
+    auto checkpoint = CheckpointStore::loadLatest(Directory);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(200, checkpoint->header.timestep);
+    EXPECT_EQ(1000, checkpoint->header.targetTimestep);
+    EXPECT_EQ(200, checkpoint->data.auxiliaryData.timestep);
+    EXPECT_EQ(123, checkpoint->data.auxiliaryData.generalSettings.worldSizeX);
+    EXPECT_EQ(0.5f, checkpoint->data.auxiliaryData.simulationParameters.baseValues.radiationCellAgeStrength[0]);
+}
+
+TEST_F(CheckpointStoreTests, loadLatest_skipCorruptedCheckpoint)
+{
+    {
+        CheckpointStore store(Directory, 3, 1000);
+        ASSERT_TRUE(store.init());
+        store.save_async(createSimulation(100));
+        store.save_async(createSimulation(200));
+    }
+    corruptFile(CheckpointStore::getCheckpointFilenames(Directory).back());
+
+    auto checkpoint = CheckpointStore::loadLatest(Directory);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(100, checkpoint->header.timestep);
+}
+
+TEST_F(CheckpointStoreTests, loadLatest_noCheckpoint)
+{
+    EXPECT_FALSE(CheckpointStore::loadLatest(Directory).has_value());
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+#include "EngineInterface/ControlServer.h"
+
+namespace
+{
+    class TestControlTarget : public ControlTarget
+    {
+    public:
+        ControlStatus getStatus() override { return status; }
+        bool saveSnapshot(std::string const& filename) override
+        {
+            snapshotFilenames.emplace_back(filename);
+            return true;
+        }
+        void setPaused(bool value) override { status.paused = value; }
+        void setTpsLimit(std::optional<int> const& value) override { status.tpsLimit = value; }
+        void setParameters(std::vector<ParameterValue> const& values) override { parameterValues = values; }
+
+        ControlStatus status;
+        std::vector<std::string> snapshotFilenames;
+        std::vector<ParameterValue> parameterValues;
+    };
+}
+
+class ControlServerTests : public ::testing::Test
+{
+public:
+    ControlServerTests()
+        : _server(_target)
+    {}
+    virtual ~ControlServerTests() = default;
+
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(_server.start("127.0.0.1", 0));
+
+        //simulation thread
+        _isRunning = true;
+        _simulationThread = std::thread([this] {
+            while (_isRunning) {
+                _server.processPendingJobs();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    void TearDown() override
+    {
+        _isRunning = false;
+        _simulationThread.join();
+        _server.stop();
+    }
+
+    httplib::Client createClient() const { return httplib::Client("127.0.0.1", _server.getPort()); }
+
+    TestControlTarget _target;
+    ControlServer _server;
+    std::atomic<bool> _isRunning = false;
+    std::thread _simulationThread;
+};
+
+TEST_F(ControlServerTests, status)
+{
+    _target.status.timestep = 1234;
+    _target.status.statistics.timestep.numCells[0] = 5;
+
+    auto response = createClient().Get("/status");
+    ASSERT_TRUE(response);
+    EXPECT_EQ(200, response->status);
+    EXPECT_NE(std::string::npos, response->body.find("\"time step\": 1234"));
+    EXPECT_NE(std::string::npos, response->body.find("\"tps limit\": null"));
+    EXPECT_NE(std::string::npos, response->body.find("\"Cells (color 0)\": 5"));
+}
+
+TEST_F(ControlServerTests, pauseAndTpsLimit)
+{
+    auto client = createClient();
+    ASSERT_EQ(200, client.Post("/pause")->status);
+    ASSERT_EQ(200, client.Post("/tps-limit?value=50")->status);
+    EXPECT_TRUE(_target.status.paused);
+    EXPECT_EQ(50, _target.status.tpsLimit);
+
+    ASSERT_EQ(200, client.Post("/resume")->status);
+    ASSERT_EQ(200, client.Post("/tps-limit?value=0")->status);
+    EXPECT_FALSE(_target.status.paused);
+    EXPECT_FALSE(_target.status.tpsLimit.has_value());
+
+    EXPECT_EQ(400, client.Post("/tps-limit?value=abc")->status);
+}
+
+TEST_F(ControlServerTests, snapshot)
+{
+    auto client = createClient();
+    ASSERT_EQ(200, client.Post("/snapshot?file=snapshot.sim")->status);
+    ASSERT_EQ(1, _target.snapshotFilenames.size());
+    EXPECT_EQ("snapshot.sim", _target.snapshotFilenames.front());
+
+    EXPECT_EQ(400, client.Post("/snapshot")->status);
+}
+
+TEST_F(ControlServerTests, parameters)
+{
+    auto client = createClient();
+    auto response = client.Post("/parameters", "{\"radiation.factor[0]\": 0.001, \"spots.0.pos.x\": 500}", "application/json");
+    ASSERT_TRUE(response);
+    ASSERT_EQ(200, response->status);
+    ASSERT_EQ(2, _target.parameterValues.size());
+    EXPECT_EQ("radiation.factor[0]", _target.parameterValues.at(0).path);
+    EXPECT_EQ("500", _target.parameterValues.at(1).value);
+
+    EXPECT_EQ(400, client.Post("/parameters", "{\"unknown parameter\": 1}", "application/json")->status);
+    EXPECT_EQ(400, client.Post("/parameters", "no json", "application/json")->status);
+}
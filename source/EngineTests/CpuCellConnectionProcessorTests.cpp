@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineCpu/CpuCellConnectionProcessor.h"
+
+class CpuCellConnectionProcessorTests : public ::testing::Test
+{
+public:
+    virtual ~CpuCellConnectionProcessorTests() = default;
+
+protected:
+    using Type = CpuStructuralOperation::Type;
+
+    void initData(CpuSimulationData& data, int numThreads) const
+    {
+        data.threadPool = std::make_unique<ThreadPool>(numThreads);
+        data.randomSeed = 1;
+        data.cellMap.init({200, 200});
+    }
+
+    void addCell(CpuSimulationData& data, RealVector2D const& pos) const
+    {
+        CellTO cell{};
+        cell.id = data.objects.getNumCells() + 1;
+        cell.energy = 100.0f;
+        cell.maxConnections = MAX_CELL_BONDS;
+        data.objects.addCell(cell, pos, {0, 0});
+    }
+
+    //4 cells forming a triangle with a connected center cell, i.e. a complete graph without crossing connections
+    void createCompleteGraph(CpuSimulationData& data) const
+    {
+        for (auto const& pos : {RealVector2D{10.0f, 10.0f}, RealVector2D{20.0f, 10.0f}, RealVector2D{15.0f, 18.0f}, RealVector2D{15.0f, 12.5f}}) {
+            addCell(data, pos);
+        }
+        for (int index1 = 0; index1 < 4; ++index1) {
+            for (int index2 = index1 + 1; index2 < 4; ++index2) {
+                ASSERT_TRUE(CpuCellConnectionProcessor::tryAddConnections(data, index1, index2, 0, 0, 0));
+            }
+        }
+    }
+
+    //lattice with connections to the right and lower neighbor
+    void createLattice(CpuSimulationData& data, int size) const
+    {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                addCell(data, {toFloat(x) + 10.0f, toFloat(y) + 10.0f});
+            }
+        }
+        for (int index = 0; index < size * size; ++index) {
+            if (index % size < size - 1) {
+                CpuCellConnectionProcessor::tryAddConnections(data, index, index + 1, 0, 0, 0);
+            }
+            if (index / size < size - 1) {
+                CpuCellConnectionProcessor::tryAddConnections(data, index, index + size, 0, 0, 0);
+            }
+        }
+    }
+
+    //expected connections of a cell after deleting the connections to the given cells: the angles of deleted connections are added
+    //to the next remaining connection
+    std::vector<ConnectionTO> calcRemainingConnections_reference(CellTO const& cell, std::vector<bool> const& isDeleted) const
+    {
+        std::vector<ConnectionTO> result;
+        float angleToAdd = 0;
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto connection = cell.connections[i];
+            if (isDeleted[connection.cellIndex]) {
+                angleToAdd += connection.angleFromPrevious;
+                continue;
+            }
+            connection.angleFromPrevious += angleToAdd;
+            angleToAdd = 0;
+            result.emplace_back(connection);
+        }
+        if (!result.empty()) {
+            result.front().angleFromPrevious += angleToAdd;
+        }
+        return result;
+    }
+
+    void checkCompatibility(CpuObjects const& expected, CpuObjects const& actual) const
+    {
+        ASSERT_EQ(expected.getNumCells(), actual.getNumCells());
+        EXPECT_EQ(expected.cellDeleted, actual.cellDeleted);
+        for (int index = 0; index < expected.getNumCells(); ++index) {
+            auto const& expectedCell = expected.cells[index];
+            auto const& actualCell = actual.cells[index];
+            ASSERT_EQ(expectedCell.numConnections, actualCell.numConnections);
+            for (int i = 0; i < expectedCell.numConnections; ++i) {
+                EXPECT_EQ(expectedCell.connections[i].cellIndex, actualCell.connections[i].cellIndex);
+                EXPECT_EQ(expectedCell.connections[i].distance, actualCell.connections[i].distance);
+                EXPECT_EQ(expectedCell.connections[i].angleFromPrevious, actualCell.connections[i].angleFromPrevious);
+            }
+        }
+        ASSERT_EQ(expected.getNumParticles(), actual.getNumParticles());
+        EXPECT_EQ(expected.particlePositions, actual.particlePositions);
+        EXPECT_EQ(expected.particleVelocities, actual.particleVelocities);
+        for (int index = 0; index < expected.getNumParticles(); ++index) {
+            EXPECT_EQ(expected.particles[index].id, actual.particles[index].id);
+            EXPECT_EQ(expected.particles[index].energy, actual.particles[index].energy);
+        }
+    }
+};
+
+TEST_F(CpuCellConnectionProcessorTests, addConnectionPairScheduledFromBothCells)
+{
+    CpuSimulationData data;
+    initData(data, 0);
+    addCell(data, {10.0f, 10.0f});
+    addCell(data, {11.0f, 10.0f});
+
+    data.structuralOperations = {{Type::AddConnectionPair, 1, 0}, {Type::AddConnectionPair, 0, 1}};
+    CpuCellConnectionProcessor::processOperations(data);
+
+    EXPECT_TRUE(data.structuralOperations.empty());
+    ASSERT_EQ(1, data.objects.cells[0].numConnections);
+    ASSERT_EQ(1, data.objects.cells[1].numConnections);
+    EXPECT_EQ(1, data.objects.cells[0].connections[0].cellIndex);
+    EXPECT_EQ(0, data.objects.cells[1].connections[0].cellIndex);
+}
+
+//all combinations of cell deletions and one-way connection deletions on a complete graph of 4 cells
+TEST_F(CpuCellConnectionProcessorTests, allDeletionsOnCompleteGraph)
+{
+    CpuSimulationData data;
+    initData(data, 0);
+    createCompleteGraph(data);
+    auto origObjects = data.objects;
+
+    std::vector<std::pair<int, int>> connections;
+    for (int index = 0; index < 4; ++index) {
+        for (int i = 0; i < origObjects.cells[index].numConnections; ++i) {
+            connections.emplace_back(index, origObjects.cells[index].connections[i].cellIndex);
+        }
+    }
+    ASSERT_EQ(12, connections.size());
+
+    for (int cellMask = 0; cellMask < (1 << 4); ++cellMask) {
+        for (int connectionMask = 0; connectionMask < (1 << 12); ++connectionMask) {
+            data.objects = origObjects;
+
+            //operations are scheduled in reverse order and connection deletions twice
+            for (int i = 11; i >= 0; --i) {
+                if ((connectionMask >> i) & 1) {
+                    auto [index, connectedIndex] = connections[i];
+                    data.structuralOperations.emplace_back(CpuStructuralOperation{Type::DelConnection, index, connectedIndex});
+                    data.structuralOperations.emplace_back(CpuStructuralOperation{Type::DelConnection, index, connectedIndex});
+                }
+            }
+            for (int index = 3; index >= 0; --index) {
+                if ((cellMask >> index) & 1) {
+                    data.structuralOperations.emplace_back(CpuStructuralOperation{Type::DelCell, index, -1});
+                }
+            }
+            CpuCellConnectionProcessor::processOperations(data);
+
+            int numDeletedCells = 0;
+            for (int index = 0; index < 4; ++index) {
+                auto cellDeleted = (cellMask >> index) & 1;
+                ASSERT_EQ(cellDeleted, data.objects.cellDeleted[index]);
+                if (cellDeleted) {
+                    ++numDeletedCells;
+                    continue;
+                }
+                std::vector<bool> isDeleted(4);
+                for (int otherIndex = 0; otherIndex < 4; ++otherIndex) {
+                    isDeleted[otherIndex] = (cellMask >> otherIndex) & 1;
+                }
+                for (int i = 0; i < 12; ++i) {
+                    if (((connectionMask >> i) & 1) && connections[i].first == index) {
+                        isDeleted[connections[i].second] = true;
+                    }
+                }
+                auto expectedConnections = calcRemainingConnections_reference(origObjects.cells[index], isDeleted);
+                auto const& cell = data.objects.cells[index];
+                ASSERT_EQ(toInt(expectedConnections.size()), cell.numConnections);
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    EXPECT_EQ(expectedConnections[i].cellIndex, cell.connections[i].cellIndex);
+                    EXPECT_FLOAT_EQ(expectedConnections[i].angleFromPrevious, cell.connections[i].angleFromPrevious);
+                }
+            }
+            ASSERT_EQ(numDeletedCells, data.objects.getNumParticles());
+        }
+    }
+}
+
+TEST_F(CpuCellConnectionProcessorTests, resultIndependentOfSchedulingAndNumberOfThreads)
+{
+    auto size = 100;
+    CpuSimulationData data;
+    initData(data, 0);
+    createLattice(data, size);
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> distribution(0, size * size - 1);
+    std::vector<CpuStructuralOperation> operations;
+    for (int i = 0; i < 2000; ++i) {
+        auto index = distribution(generator);
+        if (index % size < size - 1 && index / size < size - 1) {
+            operations.emplace_back(CpuStructuralOperation{Type::AddConnectionPair, index, index + size + 1});
+            operations.emplace_back(CpuStructuralOperation{Type::AddConnectionPair, index + 1, index + size});
+        }
+    }
+    for (int i = 0; i < 1000; ++i) {
+        operations.emplace_back(CpuStructuralOperation{Type::DelCell, distribution(generator), -1});
+    }
+    for (int i = 0; i < 3000; ++i) {
+        auto index = distribution(generator);
+        auto const& cell = data.objects.cells[index];
+        if (cell.numConnections > 0) {
+            operations.emplace_back(CpuStructuralOperation{Type::DelConnection, index, cell.connections[i % cell.numConnections].cellIndex});
+        }
+    }
+
+    CpuSimulationData parallelData;
+    initData(parallelData, 3);
+    parallelData.objects = data.objects;
+    parallelData.structuralOperations = operations;
+    std::shuffle(parallelData.structuralOperations.begin(), parallelData.structuralOperations.end(), generator);
+
+    data.structuralOperations = operations;
+    CpuCellConnectionProcessor::processOperations(data);
+    CpuCellConnectionProcessor::processOperations(parallelData);
+
+    EXPECT_GT(data.objects.getNumParticles(), 0);
+    checkCompatibility(data.objects, parallelData.objects);
+}
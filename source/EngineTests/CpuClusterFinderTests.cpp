@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+#include "EngineCpu/CpuClusterFinder.h"
+#include "EngineInterface/FundamentalConstants.h"
+
+class CpuClusterFinderTests : public ::testing::Test
+{
+public:
+    virtual ~CpuClusterFinderTests() = default;
+
+protected:
+    struct Graph
+    {
+        std::vector<std::vector<int>> connections;
+
+        void connect(int index1, int index2)
+        {
+            connections[index1].emplace_back(index2);
+            connections[index2].emplace_back(index1);
+        }
+    };
+
+    Graph createRandomGraph(int numCells, int numConnections) const
+    {
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<int> distribution(0, numCells - 1);
+        Graph result;
+        result.connections.resize(numCells);
+        for (int i = 0; i < numConnections; ++i) {
+            auto index1 = distribution(generator);
+            auto index2 = distribution(generator);
+            if (index1 != index2 && toInt(result.connections[index1].size()) < MAX_CELL_BONDS
+                && toInt(result.connections[index2].size()) < MAX_CELL_BONDS) {
+                result.connect(index1, index2);
+            }
+        }
+        return result;
+    }
+
+    void findClusters(CpuClusterFinder& clusterFinder, Graph const& graph, ThreadPool* threadPool = nullptr) const
+    {
+        clusterFinder.findClusters(
+            toInt(graph.connections.size()),
+            [&](int index) { return toInt(graph.connections[index].size()); },
+            [&](int index, int connectionIndex) { return graph.connections[index][connectionIndex]; },
+            threadPool);
+    }
+
+    //breadth-first search, clusters are numbered in the order of their lowest cell index
+    std::vector<int> findClusters_reference(Graph const& graph) const
+    {
+        auto numCells = toInt(graph.connections.size());
+        std::vector<int> result(numCells, -1);
+        int numClusters = 0;
+        for (int index = 0; index < numCells; ++index) {
+            if (result[index] != -1) {
+                continue;
+            }
+            std::vector<int> queue{index};
+            result[index] = numClusters;
+            for (int i = 0; i < toInt(queue.size()); ++i) {
+                for (auto otherIndex : graph.connections[queue[i]]) {
+                    if (result[otherIndex] == -1) {
+                        result[otherIndex] = numClusters;
+                        queue.emplace_back(otherIndex);
+                    }
+                }
+            }
+            ++numClusters;
+        }
+        return result;
+    }
+};
+
+TEST_F(CpuClusterFinderTests, longChainWithShuffledIndices)
+{
+    auto numCells = 100000;
+    std::vector<int> order(numCells);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+
+    Graph graph;
+    graph.connections.resize(numCells + 2);
+    for (int i = 1; i < numCells; ++i) {
+        graph.connect(order[i - 1], order[i]);
+    }
+
+    CpuClusterFinder clusterFinder;
+    findClusters(clusterFinder, graph);
+
+    ASSERT_EQ(3, clusterFinder.getNumClusters());
+    for (int index = 0; index < numCells; ++index) {
+        EXPECT_EQ(0, clusterFinder.getClusterIndex(index));
+    }
+    EXPECT_EQ(1, clusterFinder.getClusterIndex(numCells));
+    EXPECT_EQ(2, clusterFinder.getClusterIndex(numCells + 1));
+}
+
+TEST_F(CpuClusterFinderTests, randomGraphMatchesReference)
+{
+    for (auto numConnections : {5000, 10000, 20000, 40000}) {
+        auto graph = createRandomGraph(20000, numConnections);
+
+        CpuClusterFinder clusterFinder;
+        findClusters(clusterFinder, graph);
+
+        auto expectedClusterIndices = findClusters_reference(graph);
+        EXPECT_EQ(expectedClusterIndices, clusterFinder.getClusterIndices());
+        EXPECT_EQ(*std::max_element(expectedClusterIndices.begin(), expectedClusterIndices.end()) + 1, clusterFinder.getNumClusters());
+    }
+}
+
+TEST_F(CpuClusterFinderTests, clusterProperties)
+{
+    Graph graph;
+    graph.connections.resize(4);
+    graph.connect(0, 1);
+    graph.connect(2, 3);
+    std::vector<RealVector2D> positions{{10.0f, 10.0f}, {12.0f, 10.0f}, {99.5f, 50.0f}, {0.5f, 50.0f}};
+    std::vector<RealVector2D> velocities{{1.0f, -1.0f}, {1.0f, 1.0f}, {0, 0.5f}, {0, 0.5f}};
+
+    CpuClusterFinder clusterFinder;
+    findClusters(clusterFinder, graph);
+    clusterFinder.calcClusterProperties(positions, velocities, {100.0f, 100.0f});
+
+    //rotating pair: r = (-1, 0) and (1, 0), relative velocities (0, -1) and (0, 1)
+    auto const& properties = clusterFinder.getClusterProperties();
+    ASSERT_EQ(2, clusterFinder.getNumClusters());
+    EXPECT_EQ(2, properties.numCells[0]);
+    EXPECT_EQ(RealVector2D(11.0f, 10.0f), properties.centers[0]);
+    EXPECT_EQ(RealVector2D(1.0f, 0), properties.velocities[0]);
+    EXPECT_FLOAT_EQ(2.0f, properties.angularMasses[0]);
+    EXPECT_FLOAT_EQ(2.0f, properties.angularMomenta[0]);
+
+    //pair crossing the world boundary
+    EXPECT_EQ(RealVector2D(0, 50.0f), properties.centers[1]);
+    EXPECT_EQ(RealVector2D(0, 0.5f), properties.velocities[1]);
+    EXPECT_FLOAT_EQ(0.5f, properties.angularMasses[1]);
+    EXPECT_FLOAT_EQ(0.0f, properties.angularMomenta[1]);
+    EXPECT_EQ(RealVector2D(-0.5f, 0), clusterFinder.getPositionFromCenter(2, positions[2], {100.0f, 100.0f}));
+}
+
+TEST_F(CpuClusterFinderTests, resultIndependentOfNumberOfThreads)
+{
+    auto numCells = 50000;
+    auto graph = createRandomGraph(numCells, 60000);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    std::vector<RealVector2D> positions(numCells);
+    std::vector<RealVector2D> velocities(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        positions[i] = {distribution(generator), distribution(generator)};
+        velocities[i] = {distribution(generator) / 100, distribution(generator) / 100};
+    }
+
+    CpuClusterFinder clusterFinder;
+    findClusters(clusterFinder, graph);
+    clusterFinder.calcClusterProperties(positions, velocities, {100.0f, 100.0f});
+
+    ThreadPool threadPool(3);
+    CpuClusterFinder parallelClusterFinder;
+    findClusters(parallelClusterFinder, graph, &threadPool);
+    parallelClusterFinder.calcClusterProperties(positions, velocities, {100.0f, 100.0f}, &threadPool);
+
+    EXPECT_EQ(clusterFinder.getClusterIndices(), parallelClusterFinder.getClusterIndices());
+    auto const& properties = clusterFinder.getClusterProperties();
+    auto const& parallelProperties = parallelClusterFinder.getClusterProperties();
+    EXPECT_EQ(properties.centers, parallelProperties.centers);
+    EXPECT_EQ(properties.velocities, parallelProperties.velocities);
+    EXPECT_EQ(properties.angularMasses, parallelProperties.angularMasses);
+    EXPECT_EQ(properties.angularMomenta, parallelProperties.angularMomenta);
+}
@@ -0,0 +1,174 @@
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+#include "EngineCpu/CpuFluidPhysics.h"
+
+class CpuFluidPhysicsTests : public ::testing::Test
+{
+public:
+    virtual ~CpuFluidPhysicsTests() = default;
+
+protected:
+    CpuFluidParameters createParameters() const
+    {
+        CpuFluidParameters result;
+        result.worldSize = {100.0f, 100.0f};
+        return result;
+    }
+
+    static float constexpr KernelFactor = 3.0f / (2.0f * Const::Pi);
+};
+
+TEST_F(CpuFluidPhysicsTests, kernel)
+{
+    EXPECT_NEAR(2.0f / 3.0f * KernelFactor, CpuFluidPhysics::calcKernel(0.0f), 1e-6);
+    EXPECT_NEAR(1.0f / 6.0f * KernelFactor, CpuFluidPhysics::calcKernel(1.0f), 1e-6);
+    EXPECT_NEAR(0.125f / 6.0f * KernelFactor, CpuFluidPhysics::calcKernel(1.5f), 1e-6);
+    EXPECT_EQ(0.0f, CpuFluidPhysics::calcKernel(2.0f));
+
+    EXPECT_EQ(0.0f, CpuFluidPhysics::calcKernel_d(0.0f));
+    EXPECT_NEAR(-0.5f * KernelFactor, CpuFluidPhysics::calcKernel_d(1.0f), 1e-6);
+    EXPECT_NEAR(-0.125f * KernelFactor, CpuFluidPhysics::calcKernel_d(1.5f), 1e-6);
+    EXPECT_EQ(0.0f, CpuFluidPhysics::calcKernel_d(2.0f));
+}
+
+TEST_F(CpuFluidPhysicsTests, pressureAndViscosity)
+{
+    auto parameters = createParameters();
+    parameters.fluidMotion.smoothingLength = 1.0f;
+
+    CpuFluidCells cells;
+    cells.addCell({10.0f, 10.0f}, {0, 1.0f});
+    cells.addCell({11.0f, 10.0f});
+
+    CpuFluidPhysics physics;
+    physics.calcForces(cells, parameters);
+
+    //kernel_d(1) = -0.5 * KernelFactor, factor = 1/1 + 1/1
+    auto pressureForce = -2.0f * 0.5f * KernelFactor * parameters.fluidMotion.pressureStrength;
+    //kernel_d(1) / (1^2 + 0.25)
+    auto viscosityForce = -0.5f * KernelFactor / 1.25f * parameters.fluidMotion.viscosityStrength;
+    EXPECT_NEAR(pressureForce, cells.forces.at(0).x, 1e-6);
+    EXPECT_NEAR(viscosityForce, cells.forces.at(0).y, 1e-6);
+    EXPECT_NEAR(-pressureForce, cells.forces.at(1).x, 1e-6);
+    EXPECT_NEAR(-viscosityForce, cells.forces.at(1).y, 1e-6);
+
+    auto density = (2.0f / 3.0f + 1.0f / 6.0f) * KernelFactor;
+    EXPECT_NEAR(density, cells.densities.at(0), 1e-6);
+    EXPECT_NEAR(density, cells.densities.at(1), 1e-6);
+}
+
+TEST_F(CpuFluidPhysicsTests, pressureAcrossWorldBoundary)
+{
+    auto parameters = createParameters();
+    parameters.fluidMotion.smoothingLength = 1.0f;
+
+    CpuFluidCells cells;
+    cells.addCell({99.5f, 50.0f});
+    cells.addCell({0.5f, 50.0f});
+
+    CpuFluidPhysics physics;
+    physics.calcForces(cells, parameters);
+
+    auto pressureForce = -2.0f * 0.5f * KernelFactor * parameters.fluidMotion.pressureStrength;
+    EXPECT_NEAR(pressureForce, cells.forces.at(0).x, 1e-6);
+    EXPECT_NEAR(-pressureForce, cells.forces.at(1).x, 1e-6);
+}
+
+TEST_F(CpuFluidPhysicsTests, springForce)
+{
+    auto parameters = createParameters();
+
+    CpuFluidCells cells;
+    cells.addCell({10.0f, 10.0f});
+    cells.addCell({11.5f, 10.0f}, {0, 0}, 2.0f);
+    cells.addConnection(0, 1, 1.0f);
+
+    CpuFluidPhysics physics;
+    physics.calcForces(cells, parameters);
+
+    //connected cells do not exert fluid forces on each other, spring force: deviation * (1^2 + 2^2) / 6
+    auto springForce = 0.5f * 5.0f / 6.0f;
+    EXPECT_NEAR(springForce, cells.forces.at(0).x, 1e-6);
+    EXPECT_NEAR(-springForce, cells.forces.at(1).x, 1e-6);
+    EXPECT_NEAR(0.0f, cells.forces.at(0).y, 1e-6);
+}
+
+TEST_F(CpuFluidPhysicsTests, overlapCorrection)
+{
+    auto parameters = createParameters();
+
+    CpuFluidCells cells;
+    cells.addCell({10.0f, 10.0f});
+    cells.addCell({10.2f, 10.0f});
+    cells.addConnection(0, 1, 0.2f);
+
+    CpuFluidPhysics physics;
+    physics.calcForces(cells, parameters);
+
+    //each cell is moved by distance * cellMinDistance / 5 away from the other cell
+    EXPECT_NEAR(10.0f - 0.2f * 0.3f / 5, cells.positions.at(0).x, 1e-5);
+    EXPECT_NEAR(10.2f + 0.2f * 0.3f / 5, cells.positions.at(1).x, 1e-5);
+}
+
+TEST_F(CpuFluidPhysicsTests, verletIntegration)
+{
+    auto parameters = createParameters();
+    parameters.timestepSize = 0.5f;
+
+    CpuFluidCells cells;
+    cells.addCell({99.5f, 10.0f}, {2.0f, 0});
+    cells.addCell({50.0f, 50.0f}, {0, 1.0f});
+    cells.addCell({51.5f, 50.0f}, {0, 1.0f});
+    cells.addConnection(1, 2, 1.0f);
+    cells.forces.at(1) = {0.1f, 0};
+
+    CpuFluidPhysics physics;
+    physics.calcTimestep(cells, parameters);
+
+    //free cell moves by vel * dt across the world boundary
+    EXPECT_NEAR(0.5f, cells.positions.at(0).x, 1e-5);
+    EXPECT_NEAR(2.0f, cells.velocities.at(0).x, 1e-6);
+
+    //pos += vel * dt + F * dt^2 / 2
+    EXPECT_NEAR(50.0f + 0.1f * 0.25f / 2, cells.positions.at(1).x, 1e-5);
+    EXPECT_NEAR(50.5f, cells.positions.at(1).y, 1e-5);
+
+    //vel += (F_new + F_old) / 2 * dt with the spring force of the new positions
+    auto deviation = 1.5f - 0.1f * 0.25f / 2 - 1.0f;
+    auto springForce = deviation * 2.0f / 6.0f;
+    EXPECT_NEAR(springForce, cells.forces.at(1).x, 1e-5);
+    EXPECT_NEAR((springForce + 0.1f) / 2 * 0.5f, cells.velocities.at(1).x, 1e-5);
+    EXPECT_NEAR(-springForce / 2 * 0.5f, cells.velocities.at(2).x, 1e-5);
+}
+
+TEST_F(CpuFluidPhysicsTests, resultIndependentOfNumberOfThreads)
+{
+    auto parameters = createParameters();
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    CpuFluidCells cells;
+    for (int i = 0; i < 10000; ++i) {
+        cells.addCell({distribution(generator), distribution(generator)}, {0.01f, 0});
+        if (i % 2 == 1) {
+            cells.addConnection(i - 1, i, 1.0f);
+        }
+    }
+    auto parallelCells = cells;
+
+    CpuFluidPhysics physics;
+    ThreadPool threadPool(3);
+    CpuFluidPhysics parallelPhysics;
+    for (int i = 0; i < 10; ++i) {
+        physics.calcTimestep(cells, parameters);
+        parallelPhysics.calcTimestep(parallelCells, parameters, &threadPool);
+    }
+    EXPECT_EQ(cells.positions, parallelCells.positions);
+    EXPECT_EQ(cells.velocities, parallelCells.velocities);
+    EXPECT_EQ(cells.densities, parallelCells.densities);
+}
@@ -0,0 +1,134 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineCpu/CpuGarbageCollector.h"
+
+class CpuGarbageCollectorTests : public ::testing::Test
+{
+public:
+    virtual ~CpuGarbageCollectorTests() = default;
+
+protected:
+    static uint64_t constexpr WeightsAndBiasesSize = sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1);
+
+    uint64_t addAuxiliaryData(CpuObjects& objects, std::vector<uint8_t> const& data) const
+    {
+        auto result = objects.auxiliaryData.size();
+        objects.auxiliaryData.insert(objects.auxiliaryData.end(), data.begin(), data.end());
+        return result;
+    }
+
+    std::vector<uint8_t> getAuxiliaryData(CpuObjects const& objects, uint64_t dataIndex, uint64_t size) const
+    {
+        return std::vector<uint8_t>(objects.auxiliaryData.begin() + dataIndex, objects.auxiliaryData.begin() + dataIndex + size);
+    }
+
+    void addCell(CpuObjects& objects, uint64_t id, std::vector<int> const& connectedCellIndices) const
+    {
+        CellTO cell{};
+        cell.id = id;
+        cell.maxConnections = MAX_CELL_BONDS;
+        cell.numConnections = toInt(connectedCellIndices.size());
+        for (int i = 0; i < cell.numConnections; ++i) {
+            cell.connections[i].cellIndex = connectedCellIndices[i];
+            cell.connections[i].distance = 1.0f;
+        }
+        cell.cellFunction = CellFunction_None;
+        objects.addCell(cell, {toFloat(id), 0}, {0, 0});
+    }
+
+    //4 cells in a row, the genomes of the first and third cell and the name of the second cell are stored in the auxiliary data
+    void createCells(CpuObjects& objects, std::vector<uint8_t> const& genome1, std::vector<uint8_t> const& name, std::vector<uint8_t> const& genome3)
+        const
+    {
+        addCell(objects, 1, {1});
+        addCell(objects, 2, {0, 2});
+        addCell(objects, 3, {1, 3});
+        addCell(objects, 4, {2});
+
+        auto& constructor = objects.cells[0].cellFunctionData.constructor;
+        objects.cells[0].cellFunction = CellFunction_Constructor;
+        constructor.genomeSize = toInt(genome1.size());
+        constructor.genomeDataIndex = addAuxiliaryData(objects, genome1);
+
+        objects.cells[1].metadata.nameSize = toInt(name.size());
+        objects.cells[1].metadata.nameDataIndex = addAuxiliaryData(objects, name);
+
+        auto& injector = objects.cells[2].cellFunctionData.injector;
+        objects.cells[2].cellFunction = CellFunction_Injector;
+        injector.genomeSize = toInt(genome3.size());
+        injector.genomeDataIndex = addAuxiliaryData(objects, genome3);
+    }
+};
+
+TEST_F(CpuGarbageCollectorTests, connectionIndicesAreFixedUp)
+{
+    CpuObjects objects;
+    createCells(objects, {1, 2}, {3}, {4, 5, 6});
+    objects.cells[1].connections[0] = objects.cells[1].connections[1];
+    objects.cells[1].numConnections = 1;
+    objects.cellDeleted[0] = 1;
+
+    Arena arena;
+    CpuGarbageCollector::removeDeletedObjects(objects, arena);
+
+    ASSERT_EQ(3, objects.getNumCells());
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 0}), objects.cellDeleted);
+    EXPECT_EQ(2, objects.cells[0].id);
+    EXPECT_EQ(RealVector2D(2.0f, 0), objects.cellPositions[0]);
+    ASSERT_EQ(1, objects.cells[0].numConnections);
+    EXPECT_EQ(1, objects.cells[0].connections[0].cellIndex);
+    ASSERT_EQ(2, objects.cells[1].numConnections);
+    EXPECT_EQ(0, objects.cells[1].connections[0].cellIndex);
+    EXPECT_EQ(2, objects.cells[1].connections[1].cellIndex);
+    ASSERT_EQ(1, objects.cells[2].numConnections);
+    EXPECT_EQ(1, objects.cells[2].connections[0].cellIndex);
+}
+
+TEST_F(CpuGarbageCollectorTests, auxiliaryDataIsRelocated)
+{
+    CpuObjects objects;
+    createCells(objects, {1, 2}, {3}, {4, 5, 6});
+    std::vector<uint8_t> weightsAndBiases(WeightsAndBiasesSize, 7);
+    objects.cells[3].cellFunction = CellFunction_Neuron;
+    objects.cells[3].cellFunctionData.neuron.weightsAndBiasesDataIndex = addAuxiliaryData(objects, weightsAndBiases);
+    objects.cells[1].connections[0] = objects.cells[1].connections[1];
+    objects.cells[1].numConnections = 1;
+    objects.cellDeleted[0] = 1;
+
+    Arena arena;
+    CpuGarbageCollector::cleanupAfterDataManipulation(objects, arena);
+
+    ASSERT_EQ(3, objects.getNumCells());
+    EXPECT_EQ(1 + 3 + WeightsAndBiasesSize, objects.auxiliaryData.size());
+    EXPECT_EQ(0, objects.cells[0].metadata.nameDataIndex);
+    EXPECT_EQ(std::vector<uint8_t>{3}, getAuxiliaryData(objects, objects.cells[0].metadata.nameDataIndex, 1));
+    auto const& injector = objects.cells[1].cellFunctionData.injector;
+    EXPECT_EQ((std::vector<uint8_t>{4, 5, 6}), getAuxiliaryData(objects, injector.genomeDataIndex, injector.genomeSize));
+    auto const& neuron = objects.cells[2].cellFunctionData.neuron;
+    EXPECT_EQ(weightsAndBiases, getAuxiliaryData(objects, neuron.weightsAndBiasesDataIndex, WeightsAndBiasesSize));
+}
+
+TEST_F(CpuGarbageCollectorTests, auxiliaryDataIsCompactedAfterTimestepIfMostlyUnreferenced)
+{
+    CpuObjects objects;
+    createCells(objects, std::vector<uint8_t>(100, 1), {2}, std::vector<uint8_t>(100, 3));
+    objects.cells[1].connections[0] = objects.cells[1].connections[1];
+    objects.cells[1].numConnections = 1;
+    objects.cellDeleted[0] = 1;
+
+    Arena arena;
+    CpuGarbageCollector::cleanupAfterTimestep(objects, arena);
+    EXPECT_EQ(201, objects.auxiliaryData.size());
+    EXPECT_EQ(101, CpuGarbageCollector::calcNumReferencedAuxiliaryData(objects));
+
+    objects.cells[0].numConnections = 0;
+    objects.cells[2].numConnections = 0;
+    objects.cellDeleted[1] = 1;
+    CpuGarbageCollector::cleanupAfterTimestep(objects, arena);
+    ASSERT_EQ(2, objects.getNumCells());
+    EXPECT_EQ(1, objects.auxiliaryData.size());
+    EXPECT_EQ(std::vector<uint8_t>{2}, getAuxiliaryData(objects, objects.cells[0].metadata.nameDataIndex, 1));
+    EXPECT_EQ(4, objects.cells[1].id);
+}
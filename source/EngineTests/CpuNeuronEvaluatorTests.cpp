@@ -0,0 +1,119 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "EngineCpu/CpuNeuronEvaluator.h"
+
+class CpuNeuronEvaluatorTests : public ::testing::Test
+{
+public:
+    virtual ~CpuNeuronEvaluatorTests() = default;
+
+protected:
+    struct Network
+    {
+        std::vector<std::vector<float>> weights;
+        std::vector<float> biases;
+    };
+
+    std::vector<Network> createRandomNetworks(int numNetworks) const
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+        std::vector<Network> result(numNetworks);
+        for (auto& network : result) {
+            network.weights.resize(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS));
+            network.biases.resize(MAX_CHANNELS);
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    network.weights[row][col] = distribution(generator);
+                }
+                network.biases[row] = distribution(generator);
+            }
+        }
+        return result;
+    }
+
+    std::vector<float> createRandomInputs(int numNetworks) const
+    {
+        std::mt19937 generator(2);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::vector<float> result(numNetworks * MAX_CHANNELS);
+        for (auto& value : result) {
+            value = distribution(generator);
+        }
+        return result;
+    }
+
+    //double precision counterpart of NeuronProcessor::processCell
+    std::vector<float> evaluate_reference(std::vector<Network> const& networks, std::vector<float> const& inputs) const
+    {
+        std::vector<float> result(inputs.size());
+        for (int i = 0; i < toInt(networks.size()); ++i) {
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                double sum = networks[i].biases[row];
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    sum += networks[i].weights[row][col] * inputs[i * MAX_CHANNELS + col];
+                }
+                result[i * MAX_CHANNELS + row] = toFloat(2.0 / (1.0 + std::exp(-sum)) - 1.0);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(CpuNeuronEvaluatorTests, scaledSigmoid)
+{
+    for (float z = -100.0f; z <= 100.0f; z += 0.01f) {
+        auto expected = 2.0 / (1.0 + std::exp(-static_cast<double>(z))) - 1.0;
+        EXPECT_NEAR(expected, CpuNeuronEvaluator::scaledSigmoid(z), 1e-6);
+    }
+    EXPECT_EQ(0.0f, CpuNeuronEvaluator::scaledSigmoid(0.0f));
+}
+
+TEST_F(CpuNeuronEvaluatorTests, allInstructionSetsMatchReference)
+{
+    auto numNetworks = 2 * CpuNeuronEvaluator::PackSize + 5;
+    auto networks = createRandomNetworks(numNetworks);
+    auto inputs = createRandomInputs(numNetworks);
+    auto expectedOutputs = evaluate_reference(networks, inputs);
+
+    CpuNeuronEvaluator evaluator;
+    for (auto const& network : networks) {
+        evaluator.addNetwork(network.weights, network.biases);
+    }
+    ASSERT_EQ(numNetworks, evaluator.getNumNetworks());
+
+    for (NeuronInstructionSet instructionSet = NeuronInstructionSet_Scalar; instructionSet <= CpuNeuronEvaluator::getSupportedInstructionSet();
+         ++instructionSet) {
+        evaluator.setInstructionSet(instructionSet);
+        std::vector<float> outputs(inputs.size(), 2.0f);
+        evaluator.evaluate(inputs.data(), outputs.data());
+        for (int i = 0; i < toInt(outputs.size()); ++i) {
+            EXPECT_NEAR(expectedOutputs[i], outputs[i], 1e-5) << CpuNeuronEvaluator::getInstructionSetName(instructionSet);
+        }
+    }
+}
+
+TEST_F(CpuNeuronEvaluatorTests, resultIndependentOfNumberOfThreads)
+{
+    auto numNetworks = 1000;
+    auto networks = createRandomNetworks(numNetworks);
+    auto inputs = createRandomInputs(numNetworks);
+
+    CpuNeuronEvaluator evaluator;
+    for (auto const& network : networks) {
+        evaluator.addNetwork(network.weights, network.biases);
+    }
+    std::vector<float> outputs(inputs.size());
+    evaluator.evaluate(inputs.data(), outputs.data());
+
+    ThreadPool threadPool(3);
+    std::vector<float> parallelOutputs(inputs.size());
+    evaluator.evaluate(inputs.data(), parallelOutputs.data(), &threadPool);
+    EXPECT_EQ(outputs, parallelOutputs);
+}
@@ -0,0 +1,163 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+#include "EngineCpu/CpuSensorScanner.h"
+
+class CpuSensorScannerTests : public ::testing::Test
+{
+public:
+    virtual ~CpuSensorScannerTests() = default;
+
+protected:
+    //clusters of cells with random colors
+    void createRandomWorld(CpuDensityMap& densityMap, IntVector2D const& worldSize, int numClusters, std::mt19937& generator, int slotSize = 8) const
+    {
+        densityMap.init(worldSize, slotSize);
+        std::uniform_real_distribution<float> xDistribution(0, toFloat(worldSize.x));
+        std::uniform_real_distribution<float> yDistribution(0, toFloat(worldSize.y));
+        std::uniform_real_distribution<float> offsetDistribution(-6.0f, 6.0f);
+        std::uniform_int_distribution<int> colorDistribution(0, MAX_COLORS - 1);
+        std::uniform_int_distribution<int> sizeDistribution(1, 30);
+        for (int i = 0; i < numClusters; ++i) {
+            RealVector2D center{xDistribution(generator), yDistribution(generator)};
+            auto color = colorDistribution(generator);
+            auto size = sizeDistribution(generator);
+            for (int j = 0; j < size; ++j) {
+                RealVector2D pos{center.x + offsetDistribution(generator), center.y + offsetDistribution(generator)};
+                if (pos.x >= 0 && pos.y >= 0 && pos.x < toFloat(worldSize.x) && pos.y < toFloat(worldSize.y)) {
+                    densityMap.addCell(pos, color);
+                }
+            }
+        }
+    }
+
+    std::vector<CpuSensorQuery> createRandomQueries(IntVector2D const& worldSize, int numQueries, std::mt19937& generator) const
+    {
+        std::uniform_real_distribution<float> xDistribution(0, toFloat(worldSize.x));
+        std::uniform_real_distribution<float> yDistribution(0, toFloat(worldSize.y));
+        std::uniform_real_distribution<float> angleDistribution(0, 360.0f);
+        std::uniform_int_distribution<int> colorDistribution(0, MAX_COLORS - 1);
+        std::uniform_real_distribution<float> rangeDistribution(0, 300.0f);
+        std::vector<float> minDensities{0, 0.01f, 0.03f, 0.05f, 0.1f, 0.2f};
+        std::uniform_int_distribution<int> minDensityDistribution(0, toInt(minDensities.size()) - 1);
+
+        std::vector<CpuSensorQuery> result(numQueries);
+        for (auto& query : result) {
+            query.pos = {xDistribution(generator), yDistribution(generator)};
+            query.refAngle = angleDistribution(generator);
+            query.cellColor = colorDistribution(generator);
+            query.scanColor = colorDistribution(generator);
+            query.minDensity = minDensities[minDensityDistribution(generator)];
+            query.range = rangeDistribution(generator);
+        }
+        return result;
+    }
+};
+
+TEST_F(CpuSensorScannerTests, densityMap)
+{
+    CpuDensityMap densityMap;
+    densityMap.init({100, 50});
+    for (int i = 0; i < 3; ++i) {
+        densityMap.addCell({17.5f, 9.0f}, 2);
+    }
+    densityMap.addCell({23.9f, 15.9f}, 2);
+    densityMap.addCell({16.0f, 8.0f}, 3);
+    densityMap.addCell({99.0f, 49.0f}, 2);  //not covered by slots
+
+    EXPECT_EQ(4, densityMap.getDensity(RealVector2D{20.0f, 12.0f}, 2));
+    EXPECT_EQ(1, densityMap.getDensity(RealVector2D{20.0f, 12.0f}, 3));
+    EXPECT_EQ(0, densityMap.getDensity(RealVector2D{20.0f, 12.0f}, 0));
+    EXPECT_EQ(4, densityMap.getDensity(2, 1, 2));
+    EXPECT_EQ(0, densityMap.getDensity(RealVector2D{99.0f, 49.0f}, 2));
+    EXPECT_EQ((uint64_t(1) << 24) | (uint64_t(4) << 16), densityMap.getSlots()[1 * 12 + 2]);
+}
+
+TEST_F(CpuSensorScannerTests, nearestHitWithRelativeAngle)
+{
+    CpuDensityMap densityMap;
+    densityMap.init({200, 200});
+    for (int i = 0; i < 10; ++i) {
+        densityMap.addCell({100.5f, 60.5f}, 1);  //40 units above the sensor
+    }
+    for (int i = 0; i < 10; ++i) {
+        densityMap.addCell({100.5f, 180.5f}, 1);  //80 units below the sensor
+    }
+
+    CpuSensorScanner scanner;
+    scanner.build(densityMap);
+    CpuSensorQuery query;
+    query.pos = {100.0f, 100.0f};
+    query.refAngle = 90.0f;
+    query.cellColor = 0;
+    query.scanColor = 1;
+    for (auto mode : {SensorScanMode_Pyramid, SensorScanMode_BruteForce}) {
+        scanner.setMode(mode);
+        auto result = scanner.scan(query);
+        EXPECT_TRUE(result.found);
+        EXPECT_EQ(10, result.density);
+        EXPECT_EQ(40, result.distance);
+        EXPECT_EQ(CpuSensorScanner::convertAngleToData(-90.0f), result.angleData);
+        EXPECT_FLOAT_EQ(-90.703125f, CpuSensorScanner::convertDataToAngle(result.angleData));
+    }
+
+    query.minDensity = 0.11f;
+    EXPECT_FALSE(scanner.scan(query).found);
+}
+
+TEST_F(CpuSensorScannerTests, pyramidMatchesBruteForce)
+{
+    //world sizes which are no multiple of the slot size and ranges exceeding the world size are included
+    std::mt19937 generator(1);
+    for (auto const& [worldSize, slotSize] : std::vector<std::pair<IntVector2D, int>>{{{203, 150}, 8}, {{512, 512}, 8}, {{1000, 377}, 8}, {{301, 299}, 5}}) {
+        for (auto numClusters : {10, 200, 2000}) {
+            CpuDensityMap densityMap;
+            createRandomWorld(densityMap, worldSize, numClusters, generator, slotSize);
+            auto queries = createRandomQueries(worldSize, 2000, generator);
+
+            CpuSensorScanner scanner;
+            scanner.build(densityMap);
+            std::vector<CpuSensorResult> results;
+            scanner.scan(queries, results);
+            scanner.setMode(SensorScanMode_BruteForce);
+            std::vector<CpuSensorResult> expectedResults;
+            scanner.scan(queries, expectedResults);
+
+            int numFound = 0;
+            for (int i = 0; i < toInt(queries.size()); ++i) {
+                ASSERT_EQ(expectedResults[i], results[i]) << "world " << worldSize.x << "x" << worldSize.y << ", query " << i;
+                if (results[i].found) {
+                    ++numFound;
+                }
+            }
+            EXPECT_GT(numFound, 0);
+            EXPECT_LT(numFound, toInt(queries.size()));
+        }
+    }
+}
+
+TEST_F(CpuSensorScannerTests, resultIndependentOfNumberOfThreads)
+{
+    std::mt19937 generator(2);
+    IntVector2D worldSize{800, 600};
+    CpuDensityMap densityMap;
+    createRandomWorld(densityMap, worldSize, 1000, generator);
+    auto queries = createRandomQueries(worldSize, 10000, generator);
+
+    CpuSensorScanner scanner;
+    scanner.build(densityMap);
+    std::vector<CpuSensorResult> results;
+    scanner.scan(queries, results);
+
+    ThreadPool threadPool(3);
+    CpuSensorScanner parallelScanner;
+    parallelScanner.build(densityMap, &threadPool);
+    std::vector<CpuSensorResult> parallelResults;
+    parallelScanner.scan(queries, parallelResults, &threadPool);
+
+    EXPECT_EQ(results, parallelResults);
+}
@@ -0,0 +1,212 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/Exceptions.h"
+#include "Base/Math.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionConverter.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineImpl/CpuSimulationControllerImpl.h"
+#include "IntegrationTestFramework.h"
+
+class CpuSimulationTests : public IntegrationTestFramework
+{
+public:
+    CpuSimulationTests()
+        : IntegrationTestFramework(std::nullopt, {1000, 1000}, SimulationBackend_Cpu)
+    {}
+
+    ~CpuSimulationTests() = default;
+
+protected:
+    DataDescription calcWithThreads(DataDescription const& data, int numThreads, int timesteps) const
+    {
+        auto simController = std::make_shared<_CpuSimulationControllerImpl>(numThreads);
+        auto generalSettings = _simController->getGeneralSettings();
+        generalSettings.randomSeed = 42;
+        simController->newSimulation(0, generalSettings, _parameters);
+        simController->setSimulationData(data);
+        simController->calcTimesteps(timesteps);
+        auto result = simController->getSimulationData();
+        simController->closeSimulation();
+        return result;
+    }
+};
+
+TEST_F(CpuSimulationTests, setAndGetData)
+{
+    DataDescription data;
+    data.addCells(
+        {CellDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(100.0f).setMaxConnections(2),
+         CellDescription().setId(2).setPos({11.0f, 10.0f}).setEnergy(100.0f).setMaxConnections(2)});
+    data.addConnection(1, 2);
+    data.addParticle(ParticleDescription().setId(3).setPos({20.0f, 10.0f}).setVel({0.5f, 1.0f}).setEnergy(50.0f).setColor(2));
+
+    _simController->setSimulationData(data);
+    auto actualData = _simController->getSimulationData();
+
+    EXPECT_TRUE(compare(data, actualData));
+}
+
+TEST_F(CpuSimulationTests, particleMovement)
+{
+    _parameters.baseValues.radiationAbsorption[0] = 0;
+    _simController->setSimulationParameters(_parameters);
+
+    DataDescription data;
+    data.addParticle(ParticleDescription().setId(1).setPos({100.0f, 100.0f}).setVel({0.5f, -0.25f}).setEnergy(1.0f));
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(10);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_TRUE(approxCompare(RealVector2D{105.0f, 97.5f}, actualData.particles.front().pos));
+}
+
+TEST_F(CpuSimulationTests, springContractsToBondDistance)
+{
+    DataDescription data;
+    data.addCells(
+        {CellDescription().setId(1).setPos({100.0f, 100.0f}).setMaxConnections(1),
+         CellDescription().setId(2).setPos({101.5f, 100.0f}).setMaxConnections(1)});
+    data.addConnection(1, 2);
+    for (auto& cell : data.cells) {
+        cell.connections.front().distance = 1.0f;
+    }
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(300);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(2, actualData.cells.size());
+    auto cell1 = getCell(actualData, 1);
+    auto cell2 = getCell(actualData, 2);
+    EXPECT_TRUE(hasConnection(actualData, 1, 2));
+    EXPECT_TRUE(std::abs(Math::length(cell2.pos - cell1.pos) - 1.0f) < 0.1f);
+}
+
+TEST_F(CpuSimulationTests, fluidMotion_overlappingCellsRepel)
+{
+    ASSERT_EQ(MotionType_Fluid, _parameters.motionType);
+
+    DataDescription data;
+    data.addCells(
+        {CellDescription().setId(1).setPos({100.0f, 100.0f}).setMaxConnections(0),
+         CellDescription().setId(2).setPos({100.5f, 100.0f}).setMaxConnections(0)});
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(20);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(2, actualData.cells.size());
+    auto cell1 = getCell(actualData, 1);
+    auto cell2 = getCell(actualData, 2);
+    EXPECT_LT(cell1.pos.x, 100.0f);
+    EXPECT_GT(cell2.pos.x, 100.5f);
+    EXPECT_TRUE(std::abs(cell1.pos.y - 100.0f) < NEAR_ZERO);
+}
+
+TEST_F(CpuSimulationTests, decay)
+{
+    _parameters.baseValues.radiationAbsorption[0] = 0;
+    _simController->setSimulationParameters(_parameters);
+    auto origData =
+        DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).energy(_parameters.baseValues.cellMinEnergy[0] / 2));
+
+    _simController->setSimulationData(origData);
+    for (int i = 0; i < 1000; ++i) {
+        _simController->calcTimesteps(1);
+    }
+
+    auto data = _simController->getSimulationData();
+    EXPECT_EQ(0, data.cells.size());
+    EXPECT_TRUE(approxCompare(getEnergy(data), getEnergy(origData)));
+}
+
+TEST_F(CpuSimulationTests, rigidity)
+{
+    _parameters.baseValues.rigidity = 1.0f;
+    _simController->setSimulationParameters(_parameters);
+
+    DataDescription data;
+    data.addCells(
+        {CellDescription().setId(1).setPos({100.0f, 100.0f}).setVel({0.1f, 0}).setMaxConnections(1),
+         CellDescription().setId(2).setPos({101.0f, 100.0f}).setVel({0.3f, 0}).setMaxConnections(1)});
+    data.addConnection(1, 2);
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(1);
+
+    //the relative motion along the connection has no angular momentum and is removed completely
+    auto actualData = _simController->getSimulationData();
+    auto cell1 = getCell(actualData, 1);
+    auto cell2 = getCell(actualData, 2);
+    EXPECT_TRUE(approxCompare(cell1.vel, cell2.vel));
+    EXPECT_TRUE(cell1.vel.x > 0.1f && cell1.vel.x < 0.3f);
+}
+
+TEST_F(CpuSimulationTests, dyingNeighborOfSelfReplicatingConstructor)
+{
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        _parameters.clusterDecayProb[i] = 0;
+    }
+    _simController->setSimulationParameters(_parameters);
+
+    auto selfReplicatingGenome = GenomeDescriptionConverter::convertDescriptionToBytes(
+        GenomeDescription()
+            .setHeader(GenomeHeaderDescription().setSeparateConstruction(false))
+            .setCells({CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy())}));
+    auto genome = GenomeDescriptionConverter::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+
+    DataDescription data;
+    data.addCells(
+        {CellDescription().setId(1).setPos({100.0f, 100.0f}).setMaxConnections(3).setLivingState(LivingState_Dying),
+         CellDescription().setId(2).setPos({101.0f, 100.0f}).setMaxConnections(1).setCellFunction(ConstructorDescription().setGenome(selfReplicatingGenome)),
+         CellDescription().setId(3).setPos({100.0f, 101.0f}).setMaxConnections(1).setCellFunction(ConstructorDescription().setGenome(genome)),
+         CellDescription().setId(4).setPos({99.0f, 100.0f}).setMaxConnections(1)});
+    data.addConnection(1, 2);
+    data.addConnection(1, 3);
+    data.addConnection(1, 4);
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(1);
+
+    auto actualData = _simController->getSimulationData();
+    EXPECT_NE(LivingState_Dying, getCell(actualData, 2).livingState);
+    EXPECT_EQ(LivingState_Dying, getCell(actualData, 3).livingState);
+    EXPECT_EQ(LivingState_Dying, getCell(actualData, 4).livingState);
+}
+
+TEST_F(CpuSimulationTests, resultsIndependentOfNumberOfThreads)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(40).height(40).center({500.0f, 500.0f}));
+    for (int i = 0; i < 1000; ++i) {
+        data.addParticle(
+            ParticleDescription()
+                .setId(100000 + i)
+                .setPos({300.0f + toFloat(i % 40) * 10.0f, 300.0f + toFloat(i / 40) * 10.0f})
+                .setVel({0.3f, 0.2f})
+                .setEnergy(10.0f));
+    }
+
+    auto singleThreadedData = calcWithThreads(data, 1, 100);
+    auto multiThreadedData = calcWithThreads(data, 4, 100);
+
+    EXPECT_EQ(singleThreadedData, multiThreadedData);
+}
+
+TEST_F(CpuSimulationTests, unsupportedOperationsThrow)
+{
+    EXPECT_THROW(_simController->applyCataclysm(1), UnsupportedOperationException);
+    EXPECT_THROW(_simController->removeSelectedObjects(false), UnsupportedOperationException);
+    EXPECT_THROW(_simController->testOnly_mutate(1, MutationType::Properties), UnsupportedOperationException);
+    EXPECT_THROW(_simController->setProfilingEnabled(true), UnsupportedOperationException);
+    EXPECT_NO_THROW(_simController->setProfilingEnabled(false));
+
+    //errors of asynchronous requests are delivered through the future
+    auto selectedData = _simController->getSelectedSimulationData_async(false);
+    EXPECT_THROW(selectedData.get(), UnsupportedOperationException);
+}
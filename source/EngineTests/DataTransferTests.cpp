@@ -146,3 +146,40 @@ TEST_F(DataTransferTests, largeData)
         EXPECT_EQ(data.particles.size() + newData.particles.size(), actualData.particles.size());
     }
 }
+
+TEST_F(DataTransferTests, inspectedData_async)
+{
+    DataDescription data;
+    data.addCell(CellDescription().setId(1).setPos({2.0f, 4.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f).setMaxConnections(1));
+    data.addCell(CellDescription().setId(2).setPos({20.0f, 4.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f).setMaxConnections(1));
+    data.addParticle(ParticleDescription().setId(3).setPos({2.0f, 10.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f));
+
+    _simController->setSimulationData(data);
+    auto actualData = _simController->getInspectedSimulationData_async({1, 3}).get();
+
+    ASSERT_EQ(1, actualData.cells.size());
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_EQ(1, actualData.cells.front().id);
+    EXPECT_EQ(3, actualData.particles.front().id);
+}
+
+TEST_F(DataTransferTests, selectedData_async)
+{
+    DataDescription data;
+    data.addCell(CellDescription().setId(1).setPos({2.0f, 4.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f).setMaxConnections(1));
+    _simController->setSimulationData(data);
+
+    DataDescription addedData;
+    addedData.addCell(CellDescription().setId(2).setPos({20.0f, 4.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f).setMaxConnections(1));
+    _simController->addAndSelectSimulationData(addedData);
+
+    auto selectionShallowData = _simController->getSelectionShallowData_async();
+    auto selectedData = _simController->getSelectedSimulationData_async(false);
+    auto clusteredData = _simController->getClusteredSimulationData_async();
+
+    EXPECT_EQ(1, selectionShallowData.get().numCells);
+    auto actualSelectedData = selectedData.get();
+    ASSERT_EQ(1, actualSelectedData.cells.size());
+    EXPECT_TRUE(approxCompare(addedData.cells.front().pos, actualSelectedData.cells.front().pos));
+    EXPECT_EQ(2, clusteredData.get().clusters.size());
+}
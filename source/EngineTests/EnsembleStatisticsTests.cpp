@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/EnsembleStatistics.h"
+#include "EngineInterface/StatisticsExporter.h"
+
+class EnsembleStatisticsTests : public ::testing::Test
+{
+public:
+    virtual ~EnsembleStatisticsTests() = default;
+
+protected:
+    TimelineStatistics createStatistics(int numCells, double totalEnergy) const
+    {
+        TimelineStatistics result;
+        result.timestep.numCells[0] = numCells;
+        result.timestep.totalEnergy[1] = totalEnergy;
+        return result;
+    }
+
+    int getColumnIndex(std::string const& columnName) const
+    {
+        auto columnNames = StatisticsExporter::getColumnNames();
+        return static_cast<int>(std::find(columnNames.begin(), columnNames.end(), columnName) - columnNames.begin());
+    }
+};
+
+TEST_F(EnsembleStatisticsTests, meanAndStandardDeviation)
+{
+    EnsembleStatistics statistics;
+    statistics.add(100, createStatistics(2, 1.0));
+    statistics.add(100, createStatistics(4, 1.0));
+    statistics.add(100, createStatistics(9, 1.0));
+
+    auto samples = statistics.getSamples();
+    ASSERT_EQ(1, samples.size());
+    EXPECT_EQ(100, samples.front().timestep);
+    EXPECT_EQ(3, samples.front().numReplicas);
+
+    auto cellsColumn = getColumnIndex("Cells (color 0)");
+    EXPECT_DOUBLE_EQ(5.0, samples.front().means.at(cellsColumn));
+    EXPECT_DOUBLE_EQ(std::sqrt(13.0), samples.front().standardDeviations.at(cellsColumn));
+
+    auto energyColumn = getColumnIndex("Total energy (color 1)");
+    EXPECT_DOUBLE_EQ(1.0, samples.front().means.at(energyColumn));
+    EXPECT_DOUBLE_EQ(0.0, samples.front().standardDeviations.at(energyColumn));
+}
+
+TEST_F(EnsembleStatisticsTests, stoppedReplicas)
+{
+    EnsembleStatistics statistics;
+    statistics.add(200, createStatistics(6, 0));
+    statistics.add(100, createStatistics(1, 0));
+    statistics.add(100, createStatistics(3, 0));
+
+    auto samples = statistics.getSamples();
+    ASSERT_EQ(2, samples.size());
+    EXPECT_EQ(100, samples.at(0).timestep);
+    EXPECT_EQ(2, samples.at(0).numReplicas);
+    EXPECT_EQ(200, samples.at(1).timestep);
+    EXPECT_EQ(1, samples.at(1).numReplicas);
+
+    auto cellsColumn = getColumnIndex("Cells (color 0)");
+    EXPECT_DOUBLE_EQ(2.0, samples.at(0).means.at(cellsColumn));
+    EXPECT_DOUBLE_EQ(6.0, samples.at(1).means.at(cellsColumn));
+    EXPECT_DOUBLE_EQ(0.0, samples.at(1).standardDeviations.at(cellsColumn));
+}
+
+TEST_F(EnsembleStatisticsTests, writeCsv)
+{
+    EnsembleStatistics statistics;
+    statistics.add(100, createStatistics(2, 0));
+    statistics.add(100, createStatistics(4, 0));
+
+    std::stringstream stream;
+    statistics.writeCsv(stream);
+
+    std::string header;
+    std::string row;
+    std::getline(stream, header);
+    std::getline(stream, row);
+    EXPECT_EQ(0, header.rfind("Time step, Replicas, Cells (color 0) (mean), Cells (color 0) (std dev), Cells (color 1) (mean)", 0));
+    EXPECT_EQ(0, row.rfind("100, 2, 3, 1.41421", 0));
+}
+
+TEST_F(EnsembleStatisticsTests, replicaFilename)
+{
+    EXPECT_EQ("stats_replica_0003.csv", EnsembleStatistics::getReplicaFilename("stats.csv", 3));
+    EXPECT_EQ((std::filesystem::path("out") / "world_replica_0012.sim").string(), EnsembleStatistics::getReplicaFilename("out/world.sim", 12));
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/EventSchedule.h"
+#include "EngineInterface/GenomeDescriptionConverter.h"
+#include "EngineInterface/GenomeDescriptions.h"
+
+class EventScheduleTests : public ::testing::Test
+{
+public:
+    virtual ~EventScheduleTests() = default;
+
+protected:
+    EventSchedule createSchedule() const
+    {
+        return EventSchedule::parse(R"({
+            "events": [
+                { "time step": 300, "type": "snapshot", "file": "snapshot_{timestep}.sim" },
+                { "time step": 100, "type": "parameters", "values": { "radiation.factor[0]": 0.001, "spots.1.pos.x": 500 } },
+                { "time step": 200, "type": "cataclysm", "power": 3 },
+                { "time step": 100, "type": "inject genome", "file": "replicator.genome", "position": [10, 20], "color": 2 },
+                { "time step": 200, "type": "inject simulation", "file": "creatures.sim" }
+            ]
+        })");
+    }
+};
+
+TEST_F(EventScheduleTests, parse)
+{
+    auto schedule = createSchedule();
+    auto events = schedule.popDueEvents(1000);
+    ASSERT_EQ(5, events.size());
+
+    EXPECT_EQ(100, events.at(0).timestep);
+    EXPECT_EQ(ScheduledEventType_Parameters, events.at(0).type);
+    ASSERT_EQ(2, events.at(0).parameterValues.size());
+    EXPECT_EQ("radiation.factor[0]", events.at(0).parameterValues.at(0).path);
+    EXPECT_EQ("0.001", events.at(0).parameterValues.at(0).value);
+    EXPECT_EQ("spots.1.pos.x", events.at(0).parameterValues.at(1).path);
+
+    EXPECT_EQ(ScheduledEventType_InjectGenome, events.at(1).type);
+    EXPECT_EQ("replicator.genome", events.at(1).filename);
+    ASSERT_TRUE(events.at(1).position.has_value());
+    EXPECT_EQ(RealVector2D(10, 20), *events.at(1).position);
+    EXPECT_EQ(2, events.at(1).color);
+
+    EXPECT_EQ(ScheduledEventType_Cataclysm, events.at(2).type);
+    EXPECT_EQ(3, events.at(2).power);
+
+    EXPECT_EQ(ScheduledEventType_InjectSimulation, events.at(3).type);
+    EXPECT_FALSE(events.at(3).position.has_value());
+
+    EXPECT_EQ(ScheduledEventType_Snapshot, events.at(4).type);
+    EXPECT_EQ(300, events.at(4).timestep);
+}
+
+TEST_F(EventScheduleTests, parse_invalid)
+{
+    EXPECT_THROW(EventSchedule::parse("{"), InvalidEventScheduleException);
+    EXPECT_THROW(EventSchedule::parse(R"({"events": [{"type": "cataclysm"}]})"), InvalidEventScheduleException);
+    EXPECT_THROW(EventSchedule::parse(R"({"events": [{"time step": 1, "type": "earthquake"}]})"), InvalidEventScheduleException);
+    EXPECT_THROW(EventSchedule::parse(R"({"events": [{"time step": 1, "type": "cataclysm", "power": 0}]})"), InvalidEventScheduleException);
+    EXPECT_THROW(EventSchedule::parse(R"({"events": [{"time step": 1, "type": "parameters", "values": {"unknown": 1}}]})"), InvalidEventScheduleException);
+    EXPECT_THROW(
+        EventSchedule::parse(R"({"events": [{"time step": 1, "type": "parameters", "values": {"radiation.probability": "high"}}]})"),
+        InvalidEventScheduleException);
+    EXPECT_THROW(EventSchedule::parse(R"({"events": [{"time step": 1, "type": "snapshot"}]})"), InvalidEventScheduleException);
+    EXPECT_THROW(
+        EventSchedule::parse(R"({"events": [{"time step": 1, "type": "inject simulation", "file": "a.sim", "position": [1]}]})"),
+        InvalidEventScheduleException);
+}
+
+TEST_F(EventScheduleTests, popDueEvents)
+{
+    auto schedule = createSchedule();
+    EXPECT_EQ(100, schedule.getNextTimestep());
+    EXPECT_TRUE(schedule.popDueEvents(99).empty());
+    EXPECT_EQ(2, schedule.popDueEvents(100).size());
+    EXPECT_EQ(200, schedule.getNextTimestep());
+    EXPECT_EQ(2, schedule.popDueEvents(250).size());
+    EXPECT_FALSE(schedule.isEmpty());
+    EXPECT_EQ(1, schedule.popDueEvents(300).size());
+    EXPECT_TRUE(schedule.isEmpty());
+    EXPECT_FALSE(schedule.getNextTimestep().has_value());
+}
+
+TEST_F(EventScheduleTests, skipUntil)
+{
+    auto schedule = createSchedule();
+    schedule.skipUntil(200);
+    EXPECT_EQ(300, schedule.getNextTimestep());
+}
+
+TEST_F(EventScheduleTests, snapshotFilename)
+{
+    EXPECT_EQ("snapshot_1200.sim", EventSchedule::getSnapshotFilename("snapshot_{timestep}.sim", 1200));
+    EXPECT_EQ("snapshot.sim", EventSchedule::getSnapshotFilename("snapshot.sim", 1200));
+}
+
+TEST_F(EventScheduleTests, createSpore)
+{
+    auto genome = GenomeDescriptionConverter::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription()}));
+    SimulationParameters parameters;
+    auto data = EventSchedule::createSpore(genome, {10, 20}, 1, parameters);
+
+    ASSERT_EQ(1, data.cells.size());
+    auto const& cell = data.cells.front();
+    EXPECT_EQ(RealVector2D(10, 20), cell.pos);
+    EXPECT_EQ(1, cell.color);
+    EXPECT_FLOAT_EQ(parameters.cellNormalEnergy[1] * 5, cell.energy);
+    ASSERT_EQ(CellFunction_Constructor, cell.getCellFunctionType());
+    EXPECT_EQ(genome, std::get<ConstructorDescription>(*cell.cellFunction).genome);
+}
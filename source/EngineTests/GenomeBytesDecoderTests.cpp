@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeBytesDecoder.h"
+#include "EngineInterface/GenomeDescriptionConverter.h"
+#include "EngineInterface/GenomeDescriptions.h"
+
+class GenomeBytesDecoderTests : public ::testing::Test
+{
+public:
+    virtual ~GenomeBytesDecoderTests() = default;
+
+protected:
+    GenomeDescription createRandomGenome(std::mt19937& generator, int maxDepth) const
+    {
+        GenomeDescription result;
+        auto numRepetitions = std::uniform_int_distribution<int>(0, 4)(generator);
+        if (numRepetitions == 0) {
+            result.header.setInfiniteRepetitions();
+        } else {
+            result.header.setNumRepetitions(numRepetitions);
+        }
+        auto numCells = std::uniform_int_distribution<int>(0, 6)(generator);
+        for (int i = 0; i < numCells; ++i) {
+            CellGenomeDescription cell;
+            switch (std::uniform_int_distribution<int>(0, CellFunction_Count - 1)(generator)) {
+            case CellFunction_Neuron:
+                cell.setCellFunction(NeuronGenomeDescription());
+                break;
+            case CellFunction_Transmitter:
+                cell.setCellFunction(TransmitterGenomeDescription());
+                break;
+            case CellFunction_Constructor:
+                if (maxDepth > 0 && std::uniform_int_distribution<int>(0, 3)(generator) > 0) {
+                    cell.setCellFunction(ConstructorGenomeDescription().setGenome(
+                        GenomeDescriptionConverter::convertDescriptionToBytes(createRandomGenome(generator, maxDepth - 1))));
+                } else {
+                    cell.setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy());
+                }
+                break;
+            case CellFunction_Sensor:
+                cell.setCellFunction(SensorGenomeDescription());
+                break;
+            case CellFunction_Nerve:
+                cell.setCellFunction(NerveGenomeDescription());
+                break;
+            case CellFunction_Attacker:
+                cell.setCellFunction(AttackerGenomeDescription());
+                break;
+            case CellFunction_Injector:
+                if (maxDepth > 0 && std::uniform_int_distribution<int>(0, 1)(generator) > 0) {
+                    cell.setCellFunction(InjectorGenomeDescription().setGenome(
+                        GenomeDescriptionConverter::convertDescriptionToBytes(createRandomGenome(generator, maxDepth - 1))));
+                } else {
+                    cell.setCellFunction(InjectorGenomeDescription().setMakeSelfCopy());
+                }
+                break;
+            case CellFunction_Muscle:
+                cell.setCellFunction(MuscleGenomeDescription());
+                break;
+            case CellFunction_Defender:
+                cell.setCellFunction(DefenderGenomeDescription());
+                break;
+            case CellFunction_Reconnector:
+                cell.setCellFunction(ReconnectorGenomeDescription());
+                break;
+            default:
+                break;
+            }
+            result.cells.emplace_back(cell);
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> createRandomBytes(std::mt19937& generator) const
+    {
+        std::vector<uint8_t> result(std::uniform_int_distribution<int>(0, 300)(generator));
+        for (auto& byte : result) {
+            byte = static_cast<uint8_t>(std::uniform_int_distribution<int>(0, 255)(generator));
+        }
+        return result;
+    }
+
+    //counting based on the genome description
+    int getNumNodesRecursively_reference(std::vector<uint8_t> const& data, bool includeRepetitions) const
+    {
+        auto genome = GenomeDescriptionConverter::convertBytesToDescription(data);
+        auto result = toInt(genome.cells.size());
+        for (auto const& node : genome.cells) {
+            if (auto subgenome = node.getGenome()) {
+                result += getNumNodesRecursively_reference(*subgenome, includeRepetitions);
+            }
+        }
+        //zero repetitions are built once by the constructor
+        auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : std::max(1, genome.header.numRepetitions);
+        return includeRepetitions ? result * numRepetitions : result;
+    }
+
+    std::vector<int> getNodeAddresses_reference(GenomeDescription const& genome) const
+    {
+        std::vector<int> result;
+        auto partialGenome = genome;
+        for (int i = 0; i < toInt(genome.cells.size()); ++i) {
+            partialGenome.cells.assign(genome.cells.begin(), genome.cells.begin() + i);
+            result.emplace_back(toInt(GenomeDescriptionConverter::convertDescriptionToBytes(partialGenome).size()));
+        }
+        return result;
+    }
+};
+
+TEST_F(GenomeBytesDecoderTests, nodeAddressesAndIndices)
+{
+    std::mt19937 generator(1);
+    for (int i = 0; i < 200; ++i) {
+        auto genome = createRandomGenome(generator, 2);
+        auto data = GenomeDescriptionConverter::convertDescriptionToBytes(genome);
+        auto genomeSize = toInt(data.size());
+        auto expectedNodeAddresses = getNodeAddresses_reference(genome);
+
+        std::vector<int> nodeAddresses;
+        for (auto nodeAddress : GenomeNodes(data.data(), genomeSize)) {
+            nodeAddresses.emplace_back(nodeAddress);
+        }
+        EXPECT_EQ(expectedNodeAddresses, nodeAddresses);
+
+        EXPECT_EQ(toInt(genome.cells.size()), GenomeBytesDecoder::getNumNodes(data.data(), genomeSize));
+        for (int index = 0; index <= toInt(genome.cells.size()); ++index) {
+            auto expectedNodeAddress = index < toInt(expectedNodeAddresses.size()) ? expectedNodeAddresses[index] : genomeSize;
+            EXPECT_EQ(expectedNodeAddress, GenomeBytesDecoder::getNodeAddress(data.data(), genomeSize, index));
+            EXPECT_EQ(index, GenomeBytesDecoder::getNodeIndex(data.data(), genomeSize, expectedNodeAddress));
+            EXPECT_EQ(expectedNodeAddress, GenomeDescriptionConverter::convertNodeIndexToNodeAddress(data, index));
+            EXPECT_EQ(index, GenomeDescriptionConverter::convertNodeAddressToNodeIndex(data, expectedNodeAddress));
+        }
+    }
+}
+
+TEST_F(GenomeBytesDecoderTests, numNodesRecursively)
+{
+    std::mt19937 generator(1);
+    for (int i = 0; i < 500; ++i) {
+        auto data = GenomeDescriptionConverter::convertDescriptionToBytes(createRandomGenome(generator, 3));
+        for (auto includeRepetitions : {false, true}) {
+            EXPECT_EQ(
+                getNumNodesRecursively_reference(data, includeRepetitions),
+                GenomeBytesDecoder::getNumNodesRecursively(data.data(), toInt(data.size()), includeRepetitions));
+        }
+    }
+}
+
+TEST_F(GenomeBytesDecoderTests, randomBytes)
+{
+    std::mt19937 generator(1);
+    for (int i = 0; i < 2000; ++i) {
+        auto data = createRandomBytes(generator);
+        auto genomeSize = toInt(data.size());
+        auto genome = GenomeDescriptionConverter::convertBytesToDescription(data);
+
+        EXPECT_EQ(toInt(genome.cells.size()), GenomeBytesDecoder::getNumNodes(data.data(), genomeSize));
+        for (auto includeRepetitions : {false, true}) {
+            EXPECT_EQ(
+                getNumNodesRecursively_reference(data, includeRepetitions),
+                GenomeBytesDecoder::getNumNodesRecursively(data.data(), genomeSize, includeRepetitions));
+        }
+    }
+}
+
+TEST_F(GenomeBytesDecoderTests, selfReplicationAndDepth)
+{
+    auto subGenome = GenomeDescriptionConverter::convertDescriptionToBytes(
+        GenomeDescription().setCells({CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy())}));
+    auto genome = GenomeDescriptionConverter::convertDescriptionToBytes(GenomeDescription().setCells(
+        {CellGenomeDescription(), CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome))}));
+
+    EXPECT_TRUE(GenomeBytesDecoder::containsSelfReplication(subGenome.data(), toInt(subGenome.size())));
+    EXPECT_FALSE(GenomeBytesDecoder::containsSelfReplication(genome.data(), toInt(genome.size())));
+    EXPECT_EQ(0, GenomeBytesDecoder::getGenomeDepth(subGenome.data(), toInt(subGenome.size())));
+    EXPECT_EQ(1, GenomeBytesDecoder::getGenomeDepth(genome.data(), toInt(genome.size())));
+    EXPECT_TRUE(GenomeBytesDecoder::isSeparating(genome.data(), toInt(genome.size())));
+}
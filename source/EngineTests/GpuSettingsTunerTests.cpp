@@ -0,0 +1,188 @@
+#include <cmath>
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/GpuSettingsTuner.h"
+
+class GpuSettingsTunerTests : public ::testing::Test
+{
+public:
+    virtual ~GpuSettingsTunerTests() = default;
+
+protected:
+    struct LaunchConfig
+    {
+        int numBlocks;
+        int numThreadsPerBlock;
+    };
+
+    //fake timing source: the duration of a phase grows with the distance of its launch configuration to the optimum
+    KernelPhaseDurations measure(GpuSettings const& settings) const
+    {
+        KernelPhaseDurations result;
+        for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+            auto phaseSettings = settings.getForPhase(phase);
+            auto const& optimum = _optimum[phase];
+            result.at(phase) = 1.0f + std::abs(std::log2(toFloat(phaseSettings.numBlocks) / toFloat(optimum.numBlocks)))
+                + std::abs(std::log2(toFloat(phaseSettings.numThreadsPerBlock) / toFloat(optimum.numThreadsPerBlock)));
+        }
+        return result;
+    }
+
+    int runUntilFinished(GpuSettingsTuner& tuner, std::function<KernelPhaseDurations(GpuSettings const&, int)> const& timingSource)
+    {
+        int timestep = 0;
+        while (!tuner.isFinished() && timestep < 10000) {
+            tuner.addMeasurement(timingSource(tuner.getCurrentSettings(), timestep));
+            ++timestep;
+        }
+        return timestep;
+    }
+
+    static float toFloat(int value) { return static_cast<float>(value); }
+
+    LaunchConfig _optimum[KernelPhase_Count] = {{8192, 64}, {32768, 16}, {1024, 256}};
+};
+
+TEST_F(GpuSettingsTunerTests, findsOptimumForEachPhase)
+{
+    GpuSettingsTuner tuner(GpuSettings{});
+    runUntilFinished(tuner, [&](GpuSettings const& settings, int) { return measure(settings); });
+
+    ASSERT_TRUE(tuner.isFinished());
+    auto bestSettings = tuner.getBestSettings();
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        EXPECT_EQ(_optimum[phase].numBlocks, bestSettings.getForPhase(phase).numBlocks);
+        EXPECT_EQ(_optimum[phase].numThreadsPerBlock, bestSettings.getForPhase(phase).numThreadsPerBlock);
+    }
+    EXPECT_EQ(bestSettings, tuner.getCurrentSettings());
+}
+
+TEST_F(GpuSettingsTunerTests, progress)
+{
+    GpuSettingsTunerParameters parameters;
+    parameters.numThreadsPerBlockCandidates = {16, 32};
+    parameters.numBlocksCandidates = {1024, 2048, 4096};
+    parameters.warmupTimesteps = 1;
+    parameters.measuredTimesteps = 4;
+
+    GpuSettingsTuner tuner(GpuSettings{}, parameters);
+    EXPECT_EQ(0.0f, tuner.getProgress());
+
+    float lastProgress = 0;
+    auto numTimesteps = runUntilFinished(tuner, [&](GpuSettings const& settings, int) {
+        auto progress = tuner.getProgress();
+        EXPECT_GE(progress, lastProgress);
+        lastProgress = progress;
+        return measure(settings);
+    });
+    EXPECT_EQ(5 * 5, numTimesteps);
+    EXPECT_EQ(1.0f, tuner.getProgress());
+}
+
+TEST_F(GpuSettingsTunerTests, warmupTimestepsAreIgnored)
+{
+    GpuSettingsTunerParameters parameters;
+    parameters.warmupTimesteps = 2;
+    parameters.measuredTimesteps = 5;
+
+    //the first time steps after a configuration change are much slower and would lead to a different result if measured
+    GpuSettingsTuner tuner(GpuSettings{}, parameters);
+    runUntilFinished(tuner, [&](GpuSettings const& settings, int timestep) {
+        auto result = measure(settings);
+        if (timestep % 7 < 2) {
+            for (auto& duration : result) {
+                *duration += 1000.0f;
+            }
+        }
+        return result;
+    });
+
+    auto bestSettings = tuner.getBestSettings();
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        EXPECT_EQ(_optimum[phase].numBlocks, bestSettings.getForPhase(phase).numBlocks);
+        EXPECT_EQ(_optimum[phase].numThreadsPerBlock, bestSettings.getForPhase(phase).numThreadsPerBlock);
+    }
+}
+
+TEST_F(GpuSettingsTunerTests, outliersAreIgnored)
+{
+    GpuSettingsTuner tuner(GpuSettings{});
+    runUntilFinished(tuner, [&](GpuSettings const& settings, int timestep) {
+        auto result = measure(settings);
+        if (timestep % 5 == 4) {
+            for (auto& duration : result) {
+                *duration *= 0.01f;
+            }
+        }
+        return result;
+    });
+
+    auto bestSettings = tuner.getBestSettings();
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        EXPECT_EQ(_optimum[phase].numBlocks, bestSettings.getForPhase(phase).numBlocks);
+        EXPECT_EQ(_optimum[phase].numThreadsPerBlock, bestSettings.getForPhase(phase).numThreadsPerBlock);
+    }
+}
+
+TEST_F(GpuSettingsTunerTests, measurementsWithoutPhasesAreIgnored)
+{
+    GpuSettingsTunerParameters parameters;
+    parameters.numThreadsPerBlockCandidates = {16};
+    parameters.numBlocksCandidates = {1024};
+    parameters.warmupTimesteps = 0;
+    parameters.measuredTimesteps = 2;
+
+    GpuSettingsTuner tuner(GpuSettings{}, parameters);
+    for (int i = 0; i < 10; ++i) {
+        tuner.addMeasurement(KernelPhaseDurations());
+    }
+    EXPECT_EQ(0.0f, tuner.getProgress());
+}
+
+TEST_F(GpuSettingsTunerTests, calcKernelPhaseDurations)
+{
+    std::vector<ProfilingScopeDuration> scopeDurations = {
+        {"Time step", 10.0f}, {"Physics", 2.0f}, {"Cell functions", 3.0f}, {"Cell functions/Nerve", 1.0f}, {"Physics", 0.5f}, {"Rendering", 4.0f}};
+    auto durations = GpuSettingsTuner::calcKernelPhaseDurations(scopeDurations);
+    EXPECT_FLOAT_EQ(2.5f, *durations.at(KernelPhase_Physics));
+    EXPECT_FLOAT_EQ(3.0f, *durations.at(KernelPhase_CellFunctions));
+    EXPECT_FALSE(durations.at(KernelPhase_StructuralOperations).has_value());
+}
+
+TEST_F(GpuSettingsTunerTests, unmeasuredPhaseKeepsInitialSettings)
+{
+    GpuSettings initialSettings;
+    initialSettings.numBlocks = 4096;
+    initialSettings.numThreadsPerBlock = 32;
+
+    GpuSettingsTuner tuner(initialSettings);
+    runUntilFinished(tuner, [&](GpuSettings const& settings, int) {
+        auto result = measure(settings);
+        result.at(KernelPhase_StructuralOperations).reset();
+        return result;
+    });
+
+    auto bestSettings = tuner.getBestSettings();
+    EXPECT_EQ(4096, bestSettings.getForPhase(KernelPhase_StructuralOperations).numBlocks);
+    EXPECT_EQ(32, bestSettings.getForPhase(KernelPhase_StructuralOperations).numThreadsPerBlock);
+    EXPECT_EQ(_optimum[KernelPhase_Physics].numBlocks, bestSettings.getForPhase(KernelPhase_Physics).numBlocks);
+}
+
+TEST_F(GpuSettingsTunerTests, saveAndLoadTunedSettings)
+{
+    GpuSettings settings;
+    for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+        settings.numBlocksByPhase[phase] = 1024 << phase;
+        settings.numThreadsPerBlockByPhase[phase] = 16 << phase;
+    }
+    GpuSettingsTuner::saveTunedSettings("Test GPU 1.0", {1000, 500}, settings);
+
+    auto loadedSettings = GpuSettingsTuner::loadTunedSettings("Test GPU 1.0", {1000, 500}, GpuSettings());
+    ASSERT_TRUE(loadedSettings.has_value());
+    EXPECT_EQ(settings, *loadedSettings);
+
+    EXPECT_FALSE(GpuSettingsTuner::loadTunedSettings("Test GPU 1.0", {500, 1000}, GpuSettings()).has_value());
+    EXPECT_FALSE(GpuSettingsTuner::loadTunedSettings("Other Test GPU", {1000, 500}, GpuSettings()).has_value());
+}
@@ -1,14 +1,48 @@
 #include "IntegrationTestFramework.h"
 
+#include <cstdlib>
+#include <set>
+#include <string>
+
 #include <boost/range/combine.hpp>
 
 #include "Base/Math.h"
+#include "EngineInterface/GeneralSettings.h"
 #include "EngineInterface/SimulationParameters.h"
-#include "EngineImpl/SimulationControllerImpl.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineImpl/SimulationControllerFactory.h"
 
-IntegrationTestFramework::IntegrationTestFramework(std::optional<SimulationParameters> const& parameters_, IntVector2D const& universeSize)
+namespace
 {
-    _simController = std::make_shared<_SimulationControllerImpl>();
+    SimulationBackend getBackendFromEnvironment()
+    {
+        auto value = std::getenv("ALIEN_TEST_BACKEND");
+        return value && std::string(value) == "cpu" ? SimulationBackend_Cpu : SimulationBackend_Gpu;
+    }
+
+    //test suites (or single tests as "Suite.test") which the CPU backend does not support:
+    //the cell functions except nerves, neurons and sensors are not executed by the host engine, selections and mutations are not implemented
+    std::set<std::string> const UnsupportedByCpuBackend = {
+        "AttackerTests",
+        "ConstructorTests",
+        "DefenderTests",
+        "InjectorTests",
+        "MuscleTests",
+        "MutationTests",
+        "ReconnectorTests",
+        "StatisticsTests",  //the tested self-replicators require constructors
+        "TransmitterTests",
+        "DataTransferTests.selectedData_async",
+    };
+}
+
+IntegrationTestFramework::IntegrationTestFramework(
+    std::optional<SimulationParameters> const& parameters_,
+    IntVector2D const& universeSize,
+    std::optional<SimulationBackend> const& backend)
+{
+    _backend = backend.value_or(getBackendFromEnvironment());
+    _simController = SimulationControllerFactory::create(_backend);
     GeneralSettings generalSettings{universeSize.x, universeSize.y};
     SimulationParameters parameters;
     if (parameters_) {
@@ -27,6 +61,23 @@ IntegrationTestFramework::~IntegrationTestFramework()
     _simController->closeSimulation();
 }
 
+void IntegrationTestFramework::SetUp()
+{
+    if (!isCpuBackend()) {
+        return;
+    }
+    auto testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string suiteName = testInfo->test_suite_name();
+    if (UnsupportedByCpuBackend.contains(suiteName) || UnsupportedByCpuBackend.contains(suiteName + "." + testInfo->name())) {
+        GTEST_SKIP() << "Not supported by the CPU backend.";
+    }
+}
+
+bool IntegrationTestFramework::isCpuBackend() const
+{
+    return _backend == SimulationBackend_Cpu;
+}
+
 double IntegrationTestFramework::getEnergy(DataDescription const& data) const
 {
     double result = 0;
@@ -5,15 +5,23 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationBackend.h"
 #include "EngineInterface/SimulationParameters.h"
 
 class IntegrationTestFramework : public ::testing::Test
 {
 public:
-    IntegrationTestFramework(std::optional<SimulationParameters> const& parameters = std::nullopt, IntVector2D const& universeSize = IntVector2D{1000, 1000});
+    //the backend defaults to the environment variable ALIEN_TEST_BACKEND ("gpu" or "cpu"), GPU if not set
+    IntegrationTestFramework(
+        std::optional<SimulationParameters> const& parameters = std::nullopt,
+        IntVector2D const& universeSize = IntVector2D{1000, 1000},
+        std::optional<SimulationBackend> const& backend = std::nullopt);
     virtual ~IntegrationTestFramework();
 
 protected:
+    void SetUp() override;  //skips the tests which the CPU backend does not support
+    bool isCpuBackend() const;
+
     double getEnergy(DataDescription const& data) const;
 
     std::unordered_map<uint64_t, CellDescription> getCellById(DataDescription const& data) const;
@@ -32,6 +40,7 @@ protected:
     bool compare(CellDescription left, CellDescription right) const;
     bool compare(ParticleDescription left, ParticleDescription right) const;
 
+    SimulationBackend _backend = SimulationBackend_Gpu;
     SimulationController _simController;
     SimulationParameters _parameters;
 };
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ParameterPatch.h"
+
+class ParameterPatchTests : public ::testing::Test
+{
+public:
+    virtual ~ParameterPatchTests() = default;
+};
+
+TEST_F(ParameterPatchTests, validate)
+{
+    EXPECT_FALSE(ParameterPatch::validate({"radiation.factor[0]", "0.5"}).has_value());
+    EXPECT_FALSE(ParameterPatch::validate({"simulation parameters.radiation.factor[0]", "0.5"}).has_value());
+    EXPECT_FALSE(ParameterPatch::validate({"spots.3.pos.x", "100"}).has_value());
+    EXPECT_TRUE(ParameterPatch::validate({"unknown", "1"}).has_value());
+    EXPECT_TRUE(ParameterPatch::validate({"spots", "1"}).has_value());
+    EXPECT_TRUE(ParameterPatch::validate({"radiation.factor[0]", "high"}).has_value());
+}
+
+TEST_F(ParameterPatchTests, apply)
+{
+    SimulationParameters parameters;
+    parameters.numSpots = 1;
+    parameters.spots[0].posX = 10.0f;
+
+    auto result = ParameterPatch::apply(parameters, {{"radiation.factor[1]", "0.25"}, {"spots.0.pos.x", "500"}});
+    EXPECT_FLOAT_EQ(0.25f, result.baseValues.radiationCellAgeStrength[1]);
+    EXPECT_FLOAT_EQ(parameters.baseValues.radiationCellAgeStrength[0], result.baseValues.radiationCellAgeStrength[0]);
+    EXPECT_FLOAT_EQ(500.0f, result.spots[0].posX);
+}
+
+TEST_F(ParameterPatchTests, apply_newSpot)
+{
+    auto result = ParameterPatch::apply(SimulationParameters(), {{"spots.num spots", "1"}, {"spots.0.pos.y", "42"}});
+    EXPECT_EQ(1, result.numSpots);
+    EXPECT_FLOAT_EQ(42.0f, result.spots[0].posY);
+}
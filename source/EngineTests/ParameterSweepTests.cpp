@@ -0,0 +1,105 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ParameterSweep.h"
+
+class ParameterSweepTests : public ::testing::Test
+{
+public:
+    virtual ~ParameterSweepTests() = default;
+
+protected:
+    SweepSpec createSpec() const
+    {
+        return ParameterSweep::parseSpec(R"({
+            "time steps": 500,
+            "parallel runs": 2,
+            "parameters": [
+                { "path": "radiation.factor[0]", "values": [0.1, 0.2] },
+                { "path": "simulation parameters.radiation.probability", "values": [0.01, 0.02, 0.03] }
+            ]
+        })");
+    }
+};
+
+TEST_F(ParameterSweepTests, parseSpec)
+{
+    auto spec = createSpec();
+    EXPECT_EQ(500, spec.timesteps);
+    EXPECT_EQ(2, spec.numParallelRuns);
+    ASSERT_EQ(2, spec.parameters.size());
+    EXPECT_EQ("radiation.factor[0]", spec.parameters.at(0).path);
+    EXPECT_EQ((std::vector<std::string>{"0.1", "0.2"}), spec.parameters.at(0).values);
+    EXPECT_EQ((std::vector<std::string>{"0.01", "0.02", "0.03"}), spec.parameters.at(1).values);
+}
+
+TEST_F(ParameterSweepTests, parseSpec_defaults)
+{
+    auto spec = ParameterSweep::parseSpec(R"({"parameters": [{"path": "radiation.probability", "values": [0.5]}]})");
+    EXPECT_FALSE(spec.timesteps.has_value());
+    EXPECT_EQ(1, spec.numParallelRuns);
+}
+
+TEST_F(ParameterSweepTests, parseSpec_invalid)
+{
+    EXPECT_THROW(ParameterSweep::parseSpec("{"), InvalidSweepSpecException);
+    EXPECT_THROW(ParameterSweep::parseSpec(R"({"parameters": []})"), InvalidSweepSpecException);
+    EXPECT_THROW(ParameterSweep::parseSpec(R"({"parameters": [{"path": "unknown parameter", "values": [1]}]})"), InvalidSweepSpecException);
+    EXPECT_THROW(ParameterSweep::parseSpec(R"({"parameters": [{"path": "radiation.probability", "values": []}]})"), InvalidSweepSpecException);
+    EXPECT_THROW(ParameterSweep::parseSpec(R"({"parameters": [{"path": "radiation.probability", "values": ["high"]}]})"), InvalidSweepSpecException);
+    EXPECT_THROW(
+        ParameterSweep::parseSpec(R"({"parallel runs": 0, "parameters": [{"path": "radiation.probability", "values": [1]}]})"), InvalidSweepSpecException);
+}
+
+TEST_F(ParameterSweepTests, expand)
+{
+    auto runs = ParameterSweep::expand(createSpec());
+    ASSERT_EQ(6, runs.size());
+    EXPECT_EQ((std::vector<std::string>{"0.1", "0.01"}), runs.at(0).values);
+    EXPECT_EQ((std::vector<std::string>{"0.1", "0.02"}), runs.at(1).values);
+    EXPECT_EQ((std::vector<std::string>{"0.1", "0.03"}), runs.at(2).values);
+    EXPECT_EQ((std::vector<std::string>{"0.2", "0.01"}), runs.at(3).values);
+    EXPECT_EQ((std::vector<std::string>{"0.2", "0.03"}), runs.at(5).values);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(i, runs.at(i).index);
+    }
+    EXPECT_EQ("run_0005", ParameterSweep::getRunName(runs.at(5)));
+}
+
+TEST_F(ParameterSweepTests, applyRun)
+{
+    auto spec = createSpec();
+    auto runs = ParameterSweep::expand(spec);
+
+    SimulationParameters baseParameters;
+    baseParameters.timestepSize = 0.5f;
+    auto parameters = ParameterSweep::applyRun(baseParameters, spec, runs.at(4));
+    EXPECT_FLOAT_EQ(0.2f, parameters.baseValues.radiationCellAgeStrength[0]);
+    EXPECT_FLOAT_EQ(baseParameters.baseValues.radiationCellAgeStrength[1], parameters.baseValues.radiationCellAgeStrength[1]);
+    EXPECT_FLOAT_EQ(0.02f, parameters.radiationProb);
+    EXPECT_FLOAT_EQ(0.5f, parameters.timestepSize);
+}
+
+TEST_F(ParameterSweepTests, writeSummaryCsv)
+{
+    auto spec = createSpec();
+    auto runs = ParameterSweep::expand(spec);
+    std::vector<SweepRunResult> results(runs.size());
+    results.at(1).succeeded = true;
+    results.at(1).timestep = 500;
+    results.at(1).stopReason = "extinct";
+    results.at(1).statistics.timestep.numCells[0] = 42;
+
+    std::stringstream stream;
+    ParameterSweep::writeSummaryCsv(stream, spec, runs, results);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.emplace_back(line);
+    }
+    ASSERT_EQ(7, lines.size());
+    EXPECT_EQ(0, lines.at(0).find("Run, radiation.factor[0], simulation parameters.radiation.probability, Succeeded, Time step, TPS, Stop reason, Cells (color 0)"));
+    EXPECT_EQ(0, lines.at(2).find("run_0001, 0.1, 0.02, true, 500, 0, extinct, 42, 0"));
+    EXPECT_EQ(0, lines.at(3).find("run_0002, 0.1, 0.03, false, 0, 0, , 0, 0"));
+}
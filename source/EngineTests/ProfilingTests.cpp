@@ -0,0 +1,129 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineImpl/ProfilingAggregator.h"
+#include "EngineInterface/ProfilingDataExporter.h"
+
+class ProfilingTests : public ::testing::Test
+{
+public:
+    virtual ~ProfilingTests() = default;
+
+protected:
+    using Clock = ProfilingAggregator::Clock;
+
+    static std::chrono::milliseconds ms(int64_t value) { return std::chrono::milliseconds(value); }
+
+    ProfilingScopeData const& getScope(ProfilingData const& data, std::string const& name) const
+    {
+        auto findResult = std::find_if(data.scopes.begin(), data.scopes.end(), [&](auto const& scope) { return scope.name == name; });
+        EXPECT_TRUE(findResult != data.scopes.end());
+        return *findResult;
+    }
+
+    Clock::time_point _now = Clock::time_point() + std::chrono::seconds(1000);
+};
+
+TEST_F(ProfilingTests, noSamples)
+{
+    ProfilingAggregator aggregator;
+    EXPECT_TRUE(aggregator.getData(_now).scopes.empty());
+}
+
+TEST_F(ProfilingTests, meanAndPercentiles)
+{
+    ProfilingAggregator aggregator;
+    for (int i = 1; i <= 100; ++i) {
+        aggregator.add(_now, {{"Time step", toFloat(i)}});
+        _now += ms(10);
+    }
+
+    auto data = aggregator.getData(_now);
+    ASSERT_EQ(1, data.scopes.size());
+    auto const& scope = data.scopes.front();
+    EXPECT_EQ("Time step", scope.name);
+    EXPECT_EQ(100, scope.numSamples);
+    EXPECT_FLOAT_EQ(50.5f, scope.mean);
+    EXPECT_FLOAT_EQ(50.0f, scope.median);
+    EXPECT_FLOAT_EQ(95.0f, scope.percentile95);
+    EXPECT_FLOAT_EQ(99.0f, scope.percentile99);
+    EXPECT_FLOAT_EQ(100.0f, scope.max);
+}
+
+TEST_F(ProfilingTests, scopesKeepOrderOfFirstOccurrence)
+{
+    ProfilingAggregator aggregator;
+    aggregator.add(_now, {{"Physics", 1.0f}, {"Cell functions", 2.0f}});
+    aggregator.add(_now, {{"Rendering", 3.0f}, {"Physics", 1.0f}});
+
+    auto data = aggregator.getData(_now);
+    ASSERT_EQ(3, data.scopes.size());
+    EXPECT_EQ("Physics", data.scopes.at(0).name);
+    EXPECT_EQ("Cell functions", data.scopes.at(1).name);
+    EXPECT_EQ("Rendering", data.scopes.at(2).name);
+    EXPECT_EQ(2, data.scopes.at(0).numSamples);
+    EXPECT_EQ(1, data.scopes.at(2).numSamples);
+}
+
+TEST_F(ProfilingTests, samplesOutsideWindowAreIgnored)
+{
+    ProfilingAggregator aggregator(std::chrono::seconds(1));
+    aggregator.add(_now, {{"Physics", 100.0f}, {"Rendering", 5.0f}});
+    _now += ms(600);
+    aggregator.add(_now, {{"Physics", 2.0f}});
+    _now += ms(600);
+    aggregator.add(_now, {{"Physics", 4.0f}});
+
+    auto data = aggregator.getData(_now);
+    ASSERT_EQ(1, data.scopes.size());
+    auto const& scope = getScope(data, "Physics");
+    EXPECT_EQ(2, scope.numSamples);
+    EXPECT_FLOAT_EQ(3.0f, scope.mean);
+    EXPECT_FLOAT_EQ(4.0f, scope.max);
+
+    //no new samples
+    _now += ms(2000);
+    EXPECT_TRUE(aggregator.getData(_now).scopes.empty());
+}
+
+TEST_F(ProfilingTests, maxSamplesPerScope)
+{
+    ProfilingAggregator aggregator(std::chrono::seconds(1000), 10);
+    for (int i = 0; i < 100; ++i) {
+        aggregator.add(_now, {{"Physics", toFloat(i)}});
+    }
+
+    auto scope = getScope(aggregator.getData(_now), "Physics");
+    EXPECT_EQ(10, scope.numSamples);
+    EXPECT_FLOAT_EQ(94.5f, scope.mean);
+}
+
+TEST_F(ProfilingTests, reset)
+{
+    ProfilingAggregator aggregator;
+    aggregator.add(_now, {{"Physics", 1.0f}});
+    aggregator.reset();
+    EXPECT_TRUE(aggregator.getData(_now).scopes.empty());
+}
+
+TEST_F(ProfilingTests, exportCsv)
+{
+    ProfilingData data;
+    data.scopes.emplace_back(ProfilingScopeData{"Physics", 3, 1.5f, 1.0f, 2.5f, 2.5f, 3.0f});
+    data.scopes.emplace_back(ProfilingScopeData{"Cell functions/Nerve", 3, 0.25f, 0.25f, 0.5f, 0.5f, 0.5f});
+
+    std::stringstream stream;
+    ProfilingDataExporter::writeCsvHeader(stream);
+    ProfilingDataExporter::writeCsvRows(stream, 1000, data);
+
+    std::string header, row1, row2, end;
+    std::getline(stream, header);
+    std::getline(stream, row1);
+    std::getline(stream, row2);
+    EXPECT_EQ("Time step, Scope, Samples, Mean [ms], Median [ms], 95th percentile [ms], 99th percentile [ms], Max [ms]", header);
+    EXPECT_EQ("1000, Physics, 3, 1.5, 1, 2.5, 2.5, 3", row1);
+    EXPECT_EQ("1000, Cell functions/Nerve, 3, 0.25, 0.25, 0.5, 0.5, 0.5", row2);
+    EXPECT_FALSE(std::getline(stream, end));
+}
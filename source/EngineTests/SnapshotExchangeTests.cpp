@@ -0,0 +1,132 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/SnapshotExchange.h"
+
+class SnapshotExchangeTests : public ::testing::Test
+{
+public:
+    virtual ~SnapshotExchangeTests() = default;
+
+protected:
+    void publish(SnapshotExchange<int>& exchange, int value)
+    {
+        auto slot = exchange.beginWrite();
+        ASSERT_TRUE(slot.has_value());
+        exchange.getSlot(*slot) = value;
+        exchange.endWrite(*slot);
+    }
+};
+
+TEST_F(SnapshotExchangeTests, nothingPublished)
+{
+    SnapshotExchange<int> exchange;
+    EXPECT_FALSE(exchange.beginRead().has_value());
+    EXPECT_TRUE(exchange.isNextSnapshotRequired());
+    EXPECT_EQ(0, exchange.getVersion());
+}
+
+TEST_F(SnapshotExchangeTests, readLastPublishedSnapshot)
+{
+    SnapshotExchange<int> exchange;
+    publish(exchange, 1);
+    publish(exchange, 2);
+    publish(exchange, 3);
+
+    auto slot = exchange.beginRead();
+    ASSERT_TRUE(slot.has_value());
+    EXPECT_EQ(3, exchange.getSlot(*slot));
+    exchange.endRead(*slot);
+    EXPECT_EQ(3, exchange.getVersion());
+}
+
+TEST_F(SnapshotExchangeTests, writeWhileReading)
+{
+    SnapshotExchange<int> exchange;
+    publish(exchange, 1);
+
+    auto readSlot = exchange.beginRead();
+    ASSERT_TRUE(readSlot.has_value());
+
+    //the other slot is free
+    publish(exchange, 2);
+    EXPECT_EQ(1, exchange.getSlot(*readSlot));
+
+    //the next slot to be written is still being read
+    EXPECT_FALSE(exchange.beginWrite().has_value());
+
+    exchange.endRead(*readSlot);
+    publish(exchange, 3);
+
+    auto slot = exchange.beginRead();
+    ASSERT_TRUE(slot.has_value());
+    EXPECT_EQ(3, exchange.getSlot(*slot));
+    exchange.endRead(*slot);
+}
+
+TEST_F(SnapshotExchangeTests, onlyOneWriter)
+{
+    SnapshotExchange<int> exchange;
+    auto slot = exchange.beginWrite();
+    ASSERT_TRUE(slot.has_value());
+    EXPECT_FALSE(exchange.beginWrite().has_value());
+
+    exchange.cancelWrite();
+    EXPECT_FALSE(exchange.beginRead().has_value());
+    EXPECT_TRUE(exchange.beginWrite().has_value());
+}
+
+TEST_F(SnapshotExchangeTests, nextSnapshotRequiredAfterRead)
+{
+    SnapshotExchange<int> exchange;
+    publish(exchange, 1);
+    EXPECT_FALSE(exchange.isNextSnapshotRequired());
+
+    auto slot = exchange.beginRead();
+    exchange.endRead(*slot);
+    EXPECT_TRUE(exchange.isNextSnapshotRequired());
+
+    publish(exchange, 2);
+    EXPECT_FALSE(exchange.isNextSnapshotRequired());
+}
+
+TEST_F(SnapshotExchangeTests, concurrentWritesAndReads)
+{
+    SnapshotExchange<std::vector<int>> exchange;
+    std::atomic<bool> finished{false};
+    int numPublished = 0;
+
+    std::thread producer([&] {
+        for (int value = 1; value <= 2000; ++value) {
+            if (auto slot = exchange.beginWrite()) {
+                auto& snapshot = exchange.getSlot(*slot);
+                snapshot.assign(100, value);
+                exchange.endWrite(*slot);
+                ++numPublished;
+            }
+        }
+        finished = true;
+    });
+
+    //a snapshot must never be modified while it is read
+    int lastValue = 0;
+    while (!finished.load()) {
+        if (auto slot = exchange.beginRead()) {
+            auto const& snapshot = exchange.getSlot(*slot);
+            auto value = snapshot.front();
+            for (auto const& element : snapshot) {
+                EXPECT_EQ(value, element);
+            }
+            EXPECT_GE(value, lastValue);
+            lastValue = value;
+            exchange.endRead(*slot);
+        }
+    }
+    producer.join();
+
+    EXPECT_GT(numPublished, 0);
+    EXPECT_EQ(numPublished, exchange.getVersion());
+}
@@ -0,0 +1,130 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "EngineInterface/FrameEncoder.h"
+#include "EngineInterface/SoftwareRasterizer.h"
+
+class SoftwareRasterizerTests : public ::testing::Test
+{
+public:
+    virtual ~SoftwareRasterizerTests() { std::remove(Filename); }
+
+protected:
+    static auto constexpr Filename = "softwareRasterizerTests.png";
+
+    SimulationParameters createParameters() const
+    {
+        SimulationParameters result;
+        result.backgroundColor = 0x000000;
+        result.cellColorization = CellColorization_CellColor;
+        return result;
+    }
+
+    int getBrightness(Frame const& frame, int x, int y) const
+    {
+        auto index = (x + y * frame.size.x) * 3;
+        return frame.pixels.at(index) + frame.pixels.at(index + 1) + frame.pixels.at(index + 2);
+    }
+
+    static uint32_t readBigEndian(std::string const& data, size_t pos)
+    {
+        return (static_cast<uint8_t>(data[pos]) << 24) | (static_cast<uint8_t>(data[pos + 1]) << 16) | (static_cast<uint8_t>(data[pos + 2]) << 8)
+            | static_cast<uint8_t>(data[pos + 3]);
+    }
+};
+
+TEST_F(SoftwareRasterizerTests, emptyWorld)
+{
+    auto parameters = createParameters();
+    parameters.backgroundColor = 0x102030;
+    auto frame = SoftwareRasterizer::draw(DataDescription(), {100, 50}, {40, 20}, parameters);
+
+    ASSERT_EQ(40, frame.size.x);
+    ASSERT_EQ(20, frame.size.y);
+    ASSERT_EQ(40 * 20 * 3, frame.pixels.size());
+    EXPECT_EQ(0x10, frame.pixels.at(0));
+    EXPECT_EQ(0x20, frame.pixels.at(1));
+    EXPECT_EQ(0x30, frame.pixels.at(2));
+}
+
+TEST_F(SoftwareRasterizerTests, cellsAndParticles)
+{
+    DataDescription data;
+    data.addCell(CellDescription().setId(1).setPos({25.0f, 25.0f}).setEnergy(200.0f).setColor(1));
+    data.addParticle(ParticleDescription().setId(2).setPos({75.0f, 25.0f}).setEnergy(100.0f));
+
+    //zoom = 2
+    auto frame = SoftwareRasterizer::draw(data, {100, 50}, {200, 100}, createParameters());
+
+    EXPECT_GT(getBrightness(frame, 50, 50), 0);
+    EXPECT_GT(getBrightness(frame, 150, 50), 0);
+    EXPECT_EQ(0, getBrightness(frame, 100, 50));
+    EXPECT_EQ(0, getBrightness(frame, 10, 10));
+
+    //cell color 1 is reddish
+    auto index = (50 + 50 * 200) * 3;
+    EXPECT_GT(frame.pixels.at(index), frame.pixels.at(index + 2));
+}
+
+TEST_F(SoftwareRasterizerTests, connections)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({20.0f, 25.0f}).setEnergy(200.0f).setMaxConnections(1),
+        CellDescription().setId(2).setPos({30.0f, 25.0f}).setEnergy(200.0f).setMaxConnections(1),
+    });
+    data.addConnection(1, 2);
+
+    auto frameWithConnection = SoftwareRasterizer::draw(data, {100, 50}, {400, 200}, createParameters());
+    data.cells.at(0).connections.clear();
+    data.cells.at(1).connections.clear();
+    auto frameWithoutConnection = SoftwareRasterizer::draw(data, {100, 50}, {400, 200}, createParameters());
+
+    //midpoint between both cells
+    EXPECT_GT(getBrightness(frameWithConnection, 100, 100), getBrightness(frameWithoutConnection, 100, 100));
+}
+
+TEST_F(SoftwareRasterizerTests, writePng)
+{
+    Frame frame{{3, 2}, {255, 0, 0, 0, 255, 0, 0, 0, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+    ASSERT_TRUE(FrameEncoder::writePng(Filename, frame));
+
+    std::ifstream file(Filename, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    auto png = content.str();
+
+    ASSERT_EQ(std::string("\x89PNG\r\n\x1a\n", 8), png.substr(0, 8));
+    EXPECT_EQ("IHDR", png.substr(12, 4));
+    EXPECT_EQ(3, readBigEndian(png, 16));
+    EXPECT_EQ(2, readBigEndian(png, 20));
+
+    //decompress image data
+    auto idatPos = png.find("IDAT");
+    ASSERT_NE(std::string::npos, idatPos);
+    auto idatSize = readBigEndian(png, idatPos - 4);
+    std::vector<uint8_t> rawData(2 * (1 + 3 * 3));
+    uLongf rawDataSize = static_cast<uLongf>(rawData.size());
+    ASSERT_EQ(Z_OK, uncompress(rawData.data(), &rawDataSize, reinterpret_cast<Bytef const*>(png.data() + idatPos + 4), idatSize));
+    ASSERT_EQ(rawData.size(), rawDataSize);
+    EXPECT_EQ(0, rawData.at(0));
+    EXPECT_EQ(255, rawData.at(1));
+    EXPECT_EQ(0, rawData.at(10));
+    EXPECT_EQ(1, rawData.at(11));
+    EXPECT_EQ(9, rawData.at(19));
+
+    EXPECT_NE(std::string::npos, png.find("IEND"));
+}
+
+TEST_F(SoftwareRasterizerTests, appendRaw)
+{
+    Frame frame{{2, 1}, {1, 2, 3, 4, 5, 6}};
+    std::stringstream stream;
+    ASSERT_TRUE(FrameEncoder::appendRaw(stream, frame));
+    ASSERT_TRUE(FrameEncoder::appendRaw(stream, frame));
+    EXPECT_EQ(std::string("\x01\x02\x03\x04\x05\x06\x01\x02\x03\x04\x05\x06", 12), stream.str());
+}
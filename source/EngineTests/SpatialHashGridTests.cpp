@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/SpatialHashGrid.h"
+#include "Base/ThreadPool.h"
+
+class SpatialHashGridTests : public ::testing::Test
+{
+public:
+    virtual ~SpatialHashGridTests() = default;
+
+protected:
+    std::vector<RealVector2D> createRandomPositions(int numPositions, RealVector2D const& lowerBound, RealVector2D const& upperBound) const
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distributionX(lowerBound.x, upperBound.x);
+        std::uniform_real_distribution<float> distributionY(lowerBound.y, upperBound.y);
+        std::vector<RealVector2D> result;
+        for (int i = 0; i < numPositions; ++i) {
+            result.push_back({distributionX(generator), distributionY(generator)});
+        }
+        return result;
+    }
+
+    std::vector<int> getIndicesWithinRadius_bruteForce(
+        std::vector<RealVector2D> const& positions,
+        RealVector2D const& pos,
+        float radius,
+        std::optional<RealVector2D> const& worldSize) const
+    {
+        std::vector<int> result;
+        for (int i = 0; i < toInt(positions.size()); ++i) {
+            auto delta = positions.at(i) - pos;
+            if (worldSize) {
+                delta.x -= std::round(delta.x / worldSize->x) * worldSize->x;
+                delta.y -= std::round(delta.y / worldSize->y) * worldSize->y;
+            }
+            if (delta.x * delta.x + delta.y * delta.y <= radius * radius) {
+                result.emplace_back(i);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(SpatialHashGridTests, radiusQueryOnTorus)
+{
+    RealVector2D worldSize{100.5f, 60.0f};
+    auto positions = createRandomPositions(5000, {0, 0}, worldSize);
+
+    SpatialHashGrid grid;
+    grid.build(positions, worldSize, 3.0f);
+
+    for (auto const& pos : createRandomPositions(200, {-10.0f, -10.0f}, {110.0f, 70.0f})) {
+        for (auto radius : {0.5f, 2.0f, 7.5f, 40.0f}) {
+            EXPECT_EQ(getIndicesWithinRadius_bruteForce(positions, pos, radius, worldSize), grid.getIndicesWithinRadius(pos, radius));
+        }
+    }
+}
+
+TEST_F(SpatialHashGridTests, radiusQueryBounded)
+{
+    auto positions = createRandomPositions(5000, {-40.0f, 10.0f}, {35.0f, 45.0f});
+
+    SpatialHashGrid grid;
+    grid.buildBounded(positions, 1.5f);
+
+    for (auto const& pos : createRandomPositions(200, {-50.0f, 0.0f}, {45.0f, 55.0f})) {
+        for (auto radius : {0.5f, 2.0f, 7.5f}) {
+            EXPECT_EQ(getIndicesWithinRadius_bruteForce(positions, pos, radius, std::nullopt), grid.getIndicesWithinRadius(pos, radius));
+        }
+    }
+}
+
+TEST_F(SpatialHashGridTests, excludedObjects)
+{
+    std::vector<RealVector2D> positions{{1.5f, 1.5f}, {1.6f, 1.5f}, {1.7f, 1.5f}, {8.0f, 8.0f}};
+    std::vector<uint8_t> excluded{1, 0, 0, 1};
+
+    SpatialHashGrid grid;
+    grid.build(positions, {10.0f, 10.0f}, 1.0f, nullptr, &excluded);
+
+    EXPECT_EQ(2, grid.getNumObjects());
+    EXPECT_EQ(1, grid.getFirstIndex({1.1f, 1.9f}));
+    EXPECT_EQ(-1, grid.getFirstIndex({8.0f, 8.0f}));
+    EXPECT_EQ((std::vector<int>{1, 2}), grid.getIndicesWithinRadius({1.5f, 1.5f}, 1.0f));
+}
+
+TEST_F(SpatialHashGridTests, resultIndependentOfNumberOfThreads)
+{
+    RealVector2D worldSize{1000.0f, 1000.0f};
+    auto positions = createRandomPositions(100000, {0, 0}, worldSize);
+
+    SpatialHashGrid grid;
+    grid.build(positions, worldSize, 1.0f);
+    auto sortedIndices = grid.getSortedIndices();
+    ASSERT_EQ(100000, sortedIndices.size());
+
+    ThreadPool threadPool(3);
+    SpatialHashGrid parallelGrid;
+    parallelGrid.build(positions, worldSize, 1.0f, &threadPool);
+    EXPECT_EQ(sortedIndices, parallelGrid.getSortedIndices());
+
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+    for (int i = 0; i < 100000; ++i) {
+        EXPECT_EQ(i, sortedIndices.at(i));
+    }
+}
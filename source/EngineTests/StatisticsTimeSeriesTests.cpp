@@ -0,0 +1,192 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/StatisticsExporter.h"
+#include "EngineInterface/StatisticsTimeSeriesWriter.h"
+
+class StatisticsTimeSeriesTests : public ::testing::Test
+{
+public:
+    virtual ~StatisticsTimeSeriesTests() { std::remove(Filename); }
+
+protected:
+    static auto constexpr Filename = "statisticsTimeSeriesTests.tmp";
+
+    TimelineStatistics createStatistics(int value) const
+    {
+        TimelineStatistics result;
+        result.timestep.numCells[0] = value;
+        result.timestep.numSelfReplicators[1] = value + 1;
+        result.timestep.totalEnergy[2] = toFloat(value) + 0.5f;
+        result.accumulated.numSensorMatches[MAX_COLORS - 1] = static_cast<uint64_t>(value) * 1000000000ull;
+        return result;
+    }
+
+    static float toFloat(int value) { return static_cast<float>(value); }
+
+    std::vector<std::string> readLines() const
+    {
+        std::ifstream file(Filename);
+        std::vector<std::string> result;
+        std::string line;
+        while (std::getline(file, line)) {
+            result.emplace_back(line);
+        }
+        return result;
+    }
+};
+
+TEST_F(StatisticsTimeSeriesTests, columnNamesAndValues)
+{
+    auto columnNames = StatisticsExporter::getColumnNames();
+    auto values = StatisticsExporter::getColumnValues(createStatistics(7));
+    ASSERT_EQ(columnNames.size(), values.size());
+    EXPECT_EQ(18 * MAX_COLORS, columnNames.size());
+
+    EXPECT_EQ("Cells (color 0)", columnNames.front());
+    EXPECT_EQ(7.0, values.front());
+    EXPECT_EQ("Self-replicators (color 1)", columnNames.at(MAX_COLORS + 1));
+    EXPECT_EQ(8.0, values.at(MAX_COLORS + 1));
+    EXPECT_EQ("Sensor matches (color " + std::to_string(MAX_COLORS - 1) + ")", columnNames.back());
+    EXPECT_EQ(7000000000.0, values.back());
+}
+
+TEST_F(StatisticsTimeSeriesTests, csvRow)
+{
+    std::stringstream stream;
+    StatisticsExporter::writeCsvRow(stream, 42, createStatistics(3));
+    auto row = stream.str();
+    EXPECT_EQ(0, row.find("42, 3, 0, "));
+    EXPECT_NE(std::string::npos, row.find(", 3.5, "));
+    EXPECT_NE(std::string::npos, row.find(", 3000000000\n"));
+}
+
+TEST_F(StatisticsTimeSeriesTests, writeCsv)
+{
+    {
+        StatisticsTimeSeriesWriter writer(2);
+        ASSERT_TRUE(writer.open(Filename, StatisticsFormat_Csv));
+        for (int i = 0; i < 5; ++i) {
+            writer.add(i * 10, createStatistics(i));
+        }
+    }
+    auto lines = readLines();
+    ASSERT_EQ(6, lines.size());
+    EXPECT_EQ(0, lines.at(0).find("Time step, Cells (color 0)"));
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(0, lines.at(i + 1).find(std::to_string(i * 10) + ", " + std::to_string(i) + ", "));
+    }
+}
+
+TEST_F(StatisticsTimeSeriesTests, writeAndReadBinary)
+{
+    StatisticsTimeSeriesWriter writer(3);
+    ASSERT_TRUE(writer.open(Filename, StatisticsFormat_Binary));
+    for (int i = 0; i < 10; ++i) {
+        writer.add(i * 100, createStatistics(i));
+    }
+    writer.close();
+
+    std::ifstream file(Filename, std::ios_base::binary);
+    auto timeSeries = StatisticsExporter::readBinary(file);
+    ASSERT_TRUE(timeSeries.has_value());
+    EXPECT_EQ(StatisticsExporter::getColumnNames(), timeSeries->columnNames);
+    ASSERT_EQ(10, timeSeries->timesteps.size());
+    ASSERT_EQ(timeSeries->columnNames.size(), timeSeries->columns.size());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i * 100, timeSeries->timesteps.at(i));
+        auto values = StatisticsExporter::getColumnValues(createStatistics(i));
+        for (size_t column = 0; column < values.size(); ++column) {
+            EXPECT_EQ(values.at(column), timeSeries->columns.at(column).at(i));
+        }
+    }
+}
+
+TEST_F(StatisticsTimeSeriesTests, resumeCsv)
+{
+    {
+        StatisticsTimeSeriesWriter writer;
+        ASSERT_TRUE(writer.open(Filename, StatisticsFormat_Csv));
+        for (int i = 0; i < 5; ++i) {
+            writer.add(i * 10, createStatistics(i));
+        }
+    }
+    {
+        StatisticsTimeSeriesWriter writer;
+        ASSERT_TRUE(writer.openForResume(Filename, StatisticsFormat_Csv, 20));
+        for (int i = 2; i < 4; ++i) {
+            writer.add(i * 10, createStatistics(i + 100));
+        }
+    }
+    auto lines = readLines();
+    ASSERT_EQ(5, lines.size());
+    EXPECT_EQ(0, lines.at(0).find("Time step, Cells (color 0)"));
+    EXPECT_EQ(0, lines.at(1).find("0, 0, "));
+    EXPECT_EQ(0, lines.at(2).find("10, 1, "));
+    EXPECT_EQ(0, lines.at(3).find("20, 102, "));
+    EXPECT_EQ(0, lines.at(4).find("30, 103, "));
+}
+
+TEST_F(StatisticsTimeSeriesTests, resumeBinary)
+{
+    {
+        StatisticsTimeSeriesWriter writer(3);
+        ASSERT_TRUE(writer.open(Filename, StatisticsFormat_Binary));
+        for (int i = 0; i < 10; ++i) {
+            writer.add(i * 100, createStatistics(i));
+        }
+    }
+    {
+        StatisticsTimeSeriesWriter writer(3);
+        ASSERT_TRUE(writer.openForResume(Filename, StatisticsFormat_Binary, 400));
+        writer.add(400, createStatistics(104));
+    }
+
+    std::ifstream file(Filename, std::ios_base::binary);
+    auto timeSeries = StatisticsExporter::readBinary(file);
+    ASSERT_TRUE(timeSeries.has_value());
+    EXPECT_EQ((std::vector<uint64_t>{0, 100, 200, 300, 400}), timeSeries->timesteps);
+    auto const& cellColumn = timeSeries->columns.front();
+    EXPECT_EQ((std::vector<double>{0.0, 1.0, 2.0, 3.0, 104.0}), cellColumn);
+}
+
+TEST_F(StatisticsTimeSeriesTests, resumeWithoutExistingFile)
+{
+    {
+        StatisticsTimeSeriesWriter writer;
+        ASSERT_TRUE(writer.openForResume(Filename, StatisticsFormat_Csv, 20));
+        writer.add(20, createStatistics(2));
+    }
+    auto lines = readLines();
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ(0, lines.at(1).find("20, 2, "));
+}
+
+TEST_F(StatisticsTimeSeriesTests, resumeFailsForDifferentFormat)
+{
+    {
+        StatisticsTimeSeriesWriter writer;
+        ASSERT_TRUE(writer.open(Filename, StatisticsFormat_Csv));
+        writer.add(0, createStatistics(0));
+    }
+    StatisticsTimeSeriesWriter writer;
+    EXPECT_FALSE(writer.openForResume(Filename, StatisticsFormat_Binary, 10));
+    EXPECT_EQ(2, readLines().size());
+}
+
+TEST_F(StatisticsTimeSeriesTests, readInvalidBinary)
+{
+    std::stringstream stream("no statistics");
+    EXPECT_FALSE(StatisticsExporter::readBinary(stream).has_value());
+}
+
+TEST_F(StatisticsTimeSeriesTests, openFails)
+{
+    StatisticsTimeSeriesWriter writer;
+    EXPECT_FALSE(writer.open("nonExistingDirectory/statistics.csv", StatisticsFormat_Csv));
+    writer.add(0, createStatistics(0));
+    writer.close();
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/StatisticsExporter.h"
+#include "EngineInterface/StopConditions.h"
+
+class StopConditionsTests : public ::testing::Test
+{
+public:
+    virtual ~StopConditionsTests() = default;
+
+protected:
+    TimelineStatistics createStatistics(int numSelfReplicators0, int numSelfReplicators1 = 0, int numCells = 1000) const
+    {
+        TimelineStatistics result;
+        result.timestep.numSelfReplicators[0] = numSelfReplicators0;
+        result.timestep.numSelfReplicators[1] = numSelfReplicators1;
+        result.timestep.numCells[0] = numCells;
+        return result;
+    }
+
+    std::chrono::milliseconds const _noTime{0};
+};
+
+TEST_F(StopConditionsTests, metricValues)
+{
+    auto statistics = createStatistics(3, 4);
+    EXPECT_EQ(3.0, StatisticsExporter::getMetricValue(statistics, "numSelfReplicators[0]"));
+    EXPECT_EQ(4.0, StatisticsExporter::getMetricValue(statistics, "numSelfReplicators[1]"));
+    EXPECT_EQ(7.0, StatisticsExporter::getMetricValue(statistics, "numSelfReplicators"));
+    EXPECT_FALSE(StatisticsExporter::getMetricValue(statistics, "numSelfReplicators[" + std::to_string(MAX_COLORS) + "]").has_value());
+    EXPECT_FALSE(StatisticsExporter::getMetricValue(statistics, "unknown").has_value());
+}
+
+TEST_F(StopConditionsTests, noConditions)
+{
+    StopConditions conditions;
+    EXPECT_TRUE(conditions.isEmpty());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(0), _noTime).has_value());
+}
+
+TEST_F(StopConditionsTests, extinction)
+{
+    StopConditions conditions;
+    conditions.addExtinction();
+    EXPECT_FALSE(conditions.evaluate(createStatistics(0, 1), _noTime).has_value());
+    EXPECT_TRUE(conditions.evaluate(createStatistics(0, 0), _noTime).has_value());
+}
+
+TEST_F(StopConditionsTests, expression)
+{
+    StopConditions conditions;
+    conditions.addExpression("numSelfReplicators[0] > 10000");
+    EXPECT_FALSE(conditions.evaluate(createStatistics(10000), _noTime).has_value());
+    EXPECT_TRUE(conditions.evaluate(createStatistics(10001), _noTime).has_value());
+}
+
+TEST_F(StopConditionsTests, combinedExpression)
+{
+    StopConditions conditions;
+    conditions.addExpression("numSelfReplicators[0] >= 10 && numSelfReplicators[1] <= 5 || numCells < 100");
+    EXPECT_TRUE(conditions.evaluate(createStatistics(10, 5), _noTime).has_value());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(10, 6), _noTime).has_value());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(9, 0), _noTime).has_value());
+    EXPECT_TRUE(conditions.evaluate(createStatistics(0, 6, 99), _noTime).has_value());
+}
+
+TEST_F(StopConditionsTests, invalidExpression)
+{
+    StopConditions conditions;
+    EXPECT_THROW(conditions.addExpression("numSelfReplicators[0]"), InvalidStopConditionException);
+    EXPECT_THROW(conditions.addExpression("unknown > 1"), InvalidStopConditionException);
+    EXPECT_THROW(conditions.addExpression("numCells > many"), InvalidStopConditionException);
+    EXPECT_THROW(conditions.addExpression("numCells > 1 &&"), InvalidStopConditionException);
+    EXPECT_THROW(conditions.addPlateau("unknown", 10, 0.1), InvalidStopConditionException);
+    EXPECT_THROW(conditions.addPlateau("numCells", 1, 0.1), InvalidStopConditionException);
+}
+
+TEST_F(StopConditionsTests, plateauReached)
+{
+    StopConditions conditions;
+    conditions.addPlateau("numCells", 3, 0.05);
+
+    EXPECT_FALSE(conditions.evaluate(createStatistics(1, 0, 1000), _noTime).has_value());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(1, 0, 2000), _noTime).has_value());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(1, 0, 2010), _noTime).has_value());  //window still contains 1000
+    EXPECT_TRUE(conditions.evaluate(createStatistics(1, 0, 2020), _noTime).has_value());
+}
+
+TEST_F(StopConditionsTests, maxDuration)
+{
+    StopConditions conditions;
+    conditions.setMaxDuration(std::chrono::seconds(10));
+    EXPECT_FALSE(conditions.isEmpty());
+    EXPECT_FALSE(conditions.evaluate(createStatistics(1), std::chrono::seconds(9)).has_value());
+    EXPECT_TRUE(conditions.evaluate(createStatistics(1), std::chrono::seconds(10)).has_value());
+}
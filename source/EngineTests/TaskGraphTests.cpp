@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/TaskGraph.h"
+#include "Base/ThreadPool.h"
+
+class TaskGraphTests : public ::testing::Test
+{
+public:
+    virtual ~TaskGraphTests() = default;
+
+protected:
+    struct RandomTask
+    {
+        std::vector<int> reads;
+        std::vector<int> writes;
+    };
+
+    std::vector<RandomTask> createRandomTasks(int numTasks, int numResources, std::mt19937& generator) const
+    {
+        std::uniform_int_distribution<int> resourceDistribution(0, numResources - 1);
+        std::uniform_int_distribution<int> numAccessesDistribution(0, 2);
+        std::vector<RandomTask> result(numTasks);
+        for (auto& task : result) {
+            for (int i = numAccessesDistribution(generator); i > 0; --i) {
+                task.reads.emplace_back(resourceDistribution(generator));
+            }
+            for (int i = numAccessesDistribution(generator); i > 0; --i) {
+                task.writes.emplace_back(resourceDistribution(generator));
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::string> getResourceNames(std::vector<int> const& resources) const
+    {
+        std::vector<std::string> result;
+        for (auto resource : resources) {
+            result.emplace_back("resource" + std::to_string(resource));
+        }
+        return result;
+    }
+
+    bool isConflicting(RandomTask const& task1, RandomTask const& task2) const
+    {
+        auto contains = [](std::vector<int> const& resources, int resource) {
+            return std::find(resources.begin(), resources.end(), resource) != resources.end();
+        };
+        for (auto resource : task1.writes) {
+            if (contains(task2.reads, resource) || contains(task2.writes, resource)) {
+                return true;
+            }
+        }
+        for (auto resource : task1.reads) {
+            if (contains(task2.writes, resource)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(TaskGraphTests, dependenciesFromAccesses)
+{
+    TaskGraph graph;
+    graph.addTask("writeA", {}, {"A"}, [] {});
+    graph.addTask("readA1", {"A"}, {}, [] {});
+    graph.addTask("readA2", {"A"}, {}, [] {});
+    graph.addTask("writeB", {}, {"B"}, [] {});
+    graph.addTask("readWriteA", {"A"}, {"A"}, [] {});
+    graph.addTask("readAB", {"A", "B"}, {}, [] {});
+    graph.addTask("readC", {"C"}, {}, [] {});
+    graph.addTask("writeC", {}, {"C"}, [] {});
+    graph.addTask("writeDTwice", {}, {"D", "D"}, [] {});
+
+    ASSERT_EQ(9, graph.getNumTasks());
+    EXPECT_EQ(std::vector<int>(), graph.getDependencies(0));
+    EXPECT_EQ(std::vector<int>{0}, graph.getDependencies(1));
+    EXPECT_EQ(std::vector<int>{0}, graph.getDependencies(2));
+    EXPECT_EQ(std::vector<int>(), graph.getDependencies(3));
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), graph.getDependencies(4));
+    EXPECT_EQ((std::vector<int>{3, 4}), graph.getDependencies(5));
+    EXPECT_EQ(std::vector<int>(), graph.getDependencies(6));
+    EXPECT_EQ(std::vector<int>{6}, graph.getDependencies(7));
+    EXPECT_EQ(std::vector<int>(), graph.getDependencies(8));
+    EXPECT_EQ("readWriteA", graph.getName(4));
+
+    graph.clear();
+    EXPECT_EQ(0, graph.getNumTasks());
+    graph.addTask("readA", {"A"}, {}, [] {});
+    EXPECT_EQ(std::vector<int>(), graph.getDependencies(0));
+}
+
+TEST_F(TaskGraphTests, sequentialOrderWithoutThreadPool)
+{
+    std::vector<int> order;
+    TaskGraph graph;
+    for (int i = 0; i < 10; ++i) {
+        graph.addTask("task" + std::to_string(i), {}, {"resource" + std::to_string(i % 3)}, [&order, i] { order.emplace_back(i); });
+    }
+    graph.run();
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), order);
+}
+
+//conflicting tasks must not overlap and must be executed in the order of addition, the results must equal the sequential execution
+TEST_F(TaskGraphTests, dependencyOrderingWithThreadPool)
+{
+    std::mt19937 generator(1);
+    ThreadPool threadPool(3);
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        auto numResources = 1 + iteration % 8;
+        auto tasks = createRandomTasks(200, numResources, generator);
+
+        auto runTasks = [&](ThreadPool* threadPool, std::vector<int>& startStamps, std::vector<int>& endStamps) {
+            std::vector<uint64_t> values(numResources, 1);
+            std::vector<uint64_t> results(tasks.size(), 0);
+            std::atomic<int> stamp{0};
+            startStamps.assign(tasks.size(), 0);
+            endStamps.assign(tasks.size(), 0);
+
+            TaskGraph graph;
+            for (int i = 0; i < toInt(tasks.size()); ++i) {
+                graph.addTask("task" + std::to_string(i), getResourceNames(tasks[i].reads), getResourceNames(tasks[i].writes), [&, i] {
+                    startStamps[i] = stamp++;
+                    for (auto resource : tasks[i].reads) {
+                        results[i] = results[i] * 7 + values[resource];
+                    }
+                    for (auto resource : tasks[i].writes) {
+                        values[resource] = values[resource] * 31 + i;
+                    }
+                    endStamps[i] = stamp++;
+                });
+            }
+            graph.run(threadPool);
+            results.insert(results.end(), values.begin(), values.end());
+            return results;
+        };
+
+        std::vector<int> startStamps;
+        std::vector<int> endStamps;
+        auto expectedResults = runTasks(nullptr, startStamps, endStamps);
+        auto results = runTasks(&threadPool, startStamps, endStamps);
+        EXPECT_EQ(expectedResults, results);
+
+        for (int i = 0; i < toInt(tasks.size()); ++i) {
+            for (int j = i + 1; j < toInt(tasks.size()); ++j) {
+                if (isConflicting(tasks[i], tasks[j])) {
+                    ASSERT_LT(endStamps[i], startStamps[j]) << "task " << i << " and task " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TaskGraphTests, independentTasksRunConcurrently)
+{
+    //each task waits until both have started, which only succeeds if they run concurrently
+    std::atomic<int> numStartedTasks{0};
+    std::atomic<int> numTasksSeeingBoth{0};
+    auto waitForOtherTask = [&] {
+        ++numStartedTasks;
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (numStartedTasks.load() < 2 && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::yield();
+        }
+        if (numStartedTasks.load() == 2) {
+            ++numTasksSeeingBoth;
+        }
+    };
+
+    TaskGraph graph;
+    graph.addTask("cells", {"cellPositions"}, {"cellVelocities"}, waitForOtherTask);
+    graph.addTask("particles", {"cellPositions"}, {"particleVelocities"}, waitForOtherTask);
+    EXPECT_TRUE(graph.getDependencies(1).empty());
+
+    ThreadPool threadPool(1);
+    graph.run(&threadPool);
+    EXPECT_EQ(2, numTasksSeeingBoth.load());
+}
+
+TEST_F(TaskGraphTests, exceptionIsRethrown)
+{
+    std::atomic<int> numExecutedTasks{0};
+    TaskGraph graph;
+    graph.addTask("first", {}, {"A"}, [&] { ++numExecutedTasks; });
+    graph.addTask("failing", {"A"}, {"B"}, [] { throw std::runtime_error("failed"); });
+    graph.addTask("dependent", {"B"}, {}, [&] { ++numExecutedTasks; });
+
+    ThreadPool threadPool(2);
+    EXPECT_THROW(graph.run(&threadPool), std::runtime_error);
+    EXPECT_EQ(1, numExecutedTasks.load());
+    EXPECT_EQ(0, threadPool.getNumPendingTasks());
+
+    numExecutedTasks = 0;
+    EXPECT_THROW(graph.run(), std::runtime_error);
+    EXPECT_EQ(1, numExecutedTasks.load());
+}
+
+TEST_F(TaskGraphTests, traceAndDot)
+{
+    TaskGraph graph;
+    graph.setTracingEnabled(true);
+    graph.addTask("updateMap", {"positions"}, {"map"}, [] {});
+    graph.addTask("collisions", {"map", "positions"}, {"forces"}, [] {});
+    graph.addTask("\"quoted\"", {}, {}, [] {});
+
+    ThreadPool threadPool(2);
+    graph.run(&threadPool);
+    auto const& events = graph.getTraceEvents();
+    ASSERT_EQ(3, events.size());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_LE(events[i].startTime, events[i].endTime);
+        if (i > 0) {
+            EXPECT_LE(events[i - 1].startTime, events[i].startTime);
+        }
+    }
+    auto getEvent = [&](int task) {
+        return *std::find_if(events.begin(), events.end(), [task](auto const& event) { return event.task == task; });
+    };
+    EXPECT_LE(getEvent(0).endTime, getEvent(1).startTime);
+
+    std::stringstream trace;
+    graph.writeTrace(trace);
+    EXPECT_NE(std::string::npos, trace.str().find("{\"traceEvents\": ["));
+    EXPECT_NE(std::string::npos, trace.str().find("\"name\": \"collisions\", \"ph\": \"X\""));
+    EXPECT_NE(std::string::npos, trace.str().find("\"name\": \"\\\"quoted\\\"\""));
+
+    std::stringstream dot;
+    graph.writeDot(dot);
+    EXPECT_NE(std::string::npos, dot.str().find("task1 [label=\"collisions\"];"));
+    EXPECT_NE(std::string::npos, dot.str().find("task0 -> task1;"));
+    EXPECT_EQ(std::string::npos, dot.str().find("-> task2"));
+
+    graph.setTracingEnabled(false);
+    graph.run(&threadPool);
+    EXPECT_TRUE(graph.getTraceEvents().empty());
+}
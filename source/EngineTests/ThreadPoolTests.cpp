@@ -0,0 +1,141 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+
+class ThreadPoolTests : public ::testing::Test
+{
+public:
+    virtual ~ThreadPoolTests() = default;
+};
+
+TEST_F(ThreadPoolTests, allTasksAreExecuted)
+{
+    std::atomic<int> sum{0};
+    {
+        ThreadPool threadPool(4);
+        for (int i = 1; i <= 1000; ++i) {
+            threadPool.submit([&sum, i] { sum += i; });
+        }
+        threadPool.waitForAll();
+        EXPECT_EQ(500500, sum.load());
+        EXPECT_EQ(0, threadPool.getNumPendingTasks());
+    }
+}
+
+TEST_F(ThreadPoolTests, singleThreadPreservesOrder)
+{
+    std::vector<int> order;
+    {
+        ThreadPool threadPool(1);
+        for (int i = 0; i < 100; ++i) {
+            threadPool.submit([&order, i] { order.emplace_back(i); });
+        }
+    }
+    ASSERT_EQ(100, order.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, order.at(i));
+    }
+}
+
+TEST_F(ThreadPoolTests, destructorWaitsForTasks)
+{
+    std::atomic<int> numExecutedTasks{0};
+    {
+        ThreadPool threadPool(2);
+        for (int i = 0; i < 10; ++i) {
+            threadPool.submit([&numExecutedTasks] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++numExecutedTasks;
+            });
+        }
+    }
+    EXPECT_EQ(10, numExecutedTasks.load());
+}
+
+TEST_F(ThreadPoolTests, parallelForVisitsEachIndexOnce)
+{
+    for (auto numThreads : {0, 1, 4}) {
+        ThreadPool threadPool(numThreads);
+        std::vector<std::atomic<int>> numVisits(1003);
+        threadPool.parallelFor(1003, 10, [&numVisits](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                ++numVisits.at(i);
+            }
+        });
+        for (auto const& visits : numVisits) {
+            EXPECT_EQ(1, visits.load());
+        }
+    }
+}
+
+TEST_F(ThreadPoolTests, parallelForRethrowsException)
+{
+    for (auto numThreads : {0, 1, 4}) {
+        ThreadPool threadPool(numThreads);
+        EXPECT_THROW(
+            threadPool.parallelFor(
+                100,
+                10,
+                [](int begin, int) {
+                    if (begin == 50) {
+                        throw std::runtime_error("chunk failed");
+                    }
+                }),
+            std::runtime_error);
+
+        //the pool remains usable afterwards
+        std::atomic<int> numVisits{0};
+        threadPool.parallelFor(100, 10, [&numVisits](int begin, int end) { numVisits += end - begin; });
+        EXPECT_EQ(100, numVisits.load());
+    }
+}
+
+TEST_F(ThreadPoolTests, concurrentParallelForsDoNotWaitForEachOther)
+{
+    ThreadPool threadPool(1);
+    std::mutex mutex;
+    std::condition_variable condition;
+    int numStartedChunks = 0;
+    bool isSecondFinished = false;
+    bool isTimedOut = false;
+
+    //both chunks of the first call block until the second call has returned, one of them on the worker thread
+    std::thread firstCaller([&] {
+        threadPool.parallelFor(2, 1, [&](int, int) {
+            std::unique_lock lock(mutex);
+            ++numStartedChunks;
+            condition.notify_all();
+            if (!condition.wait_for(lock, std::chrono::seconds(10), [&] { return isSecondFinished; })) {
+                isTimedOut = true;
+            }
+        });
+    });
+    {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&] { return numStartedChunks == 2; });
+    }
+
+    std::vector<int> numVisits(100);
+    threadPool.parallelFor(100, 10, [&numVisits](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            ++numVisits.at(i);
+        }
+    });
+    {
+        std::lock_guard lock(mutex);
+        isSecondFinished = true;
+    }
+    condition.notify_all();
+    firstCaller.join();
+
+    EXPECT_FALSE(isTimedOut);
+    EXPECT_EQ(std::vector<int>(100, 1), numVisits);
+}
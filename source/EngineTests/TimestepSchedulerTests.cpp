@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/TimestepScheduler.h"
+
+class TimestepSchedulerTests : public ::testing::Test
+{
+public:
+    virtual ~TimestepSchedulerTests() = default;
+
+protected:
+    using Clock = TimestepScheduler::Clock;
+    using Decision = TimestepScheduler::Decision;
+
+    static std::chrono::microseconds us(int64_t value) { return std::chrono::microseconds(value); }
+
+    void calcTimestep(TimestepScheduler& scheduler, std::chrono::microseconds const& duration)
+    {
+        scheduler.timestepCalculated(_now, _now + duration);
+        _now += duration;
+    }
+
+    void drawFrame(TimestepScheduler& scheduler, std::chrono::microseconds const& duration)
+    {
+        _now += duration;
+        scheduler.frameDrawn(_now, duration);
+    }
+
+    Clock::time_point _now = Clock::time_point() + std::chrono::seconds(1000);
+};
+
+TEST_F(TimestepSchedulerTests, accessRequestHasPriority)
+{
+    TimestepScheduler scheduler;
+    EXPECT_EQ(Decision::ServiceAccessRequest, scheduler.decide(_now, true, true));
+    EXPECT_EQ(Decision::ServiceAccessRequest, scheduler.decide(_now, false, true));
+}
+
+TEST_F(TimestepSchedulerTests, pausedSimulation)
+{
+    TimestepScheduler scheduler;
+    EXPECT_EQ(Decision::Wait, scheduler.decide(_now, false, false));
+}
+
+TEST_F(TimestepSchedulerTests, unrestrictedWithoutRendering)
+{
+    TimestepScheduler scheduler;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+        calcTimestep(scheduler, us(1000));
+    }
+}
+
+TEST_F(TimestepSchedulerTests, tpsRestriction)
+{
+    TimestepScheduler scheduler;
+    scheduler.setTpsRestriction(100);
+
+    ASSERT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+    calcTimestep(scheduler, us(2000));
+
+    EXPECT_EQ(Decision::Wait, scheduler.decide(_now, true, false));
+    EXPECT_EQ(us(8000), scheduler.getWaitDuration(_now));
+
+    _now += us(8000);
+    EXPECT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+}
+
+TEST_F(TimestepSchedulerTests, tpsRestriction_overshootIsCarriedOver)
+{
+    TimestepScheduler scheduler;
+    scheduler.setTpsRestriction(100);
+
+    calcTimestep(scheduler, us(2000));
+    _now += us(9000);  //1 ms too late
+    ASSERT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+    calcTimestep(scheduler, us(2000));
+
+    EXPECT_EQ(us(7000), scheduler.getWaitDuration(_now));
+}
+
+TEST_F(TimestepSchedulerTests, stepsPerFrame)
+{
+    TimestepScheduler scheduler;
+    scheduler.setStepsPerFrame(3);
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+        calcTimestep(scheduler, us(100));
+    }
+    EXPECT_EQ(Decision::Wait, scheduler.decide(_now, true, false));
+
+    drawFrame(scheduler, us(1000));
+    EXPECT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+}
+
+TEST_F(TimestepSchedulerTests, timestepIsDeferredWhenFrameIsDue)
+{
+    TimestepScheduler scheduler;
+    drawFrame(scheduler, us(2000));
+    calcTimestep(scheduler, us(5000));
+
+    //next draw is expected at 16.667 ms - 2 ms after the last frame: a step of 5 ms still fits
+    ASSERT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+    calcTimestep(scheduler, us(5000));
+
+    //a third step would collide with the frame
+    EXPECT_EQ(Decision::Wait, scheduler.decide(_now, true, false));
+
+    drawFrame(scheduler, us(2000));
+    EXPECT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+}
+
+TEST_F(TimestepSchedulerTests, lateFrameDoesNotBlockSimulation)
+{
+    TimestepScheduler scheduler;
+    drawFrame(scheduler, us(2000));
+    calcTimestep(scheduler, us(5000));
+    calcTimestep(scheduler, us(5000));
+    ASSERT_EQ(Decision::Wait, scheduler.decide(_now, true, false));
+
+    _now += scheduler.getFrameBudget();
+    EXPECT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+}
+
+TEST_F(TimestepSchedulerTests, longTimestepsAreNotDeferred)
+{
+    TimestepScheduler scheduler;
+    drawFrame(scheduler, us(2000));
+    calcTimestep(scheduler, us(40000));
+
+    EXPECT_EQ(Decision::CalcTimestep, scheduler.decide(_now, true, false));
+}
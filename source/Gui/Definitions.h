@@ -58,6 +58,9 @@ using MassOperationsDialog = std::shared_ptr<_MassOperationsDialog>;
 class _LogWindow;
 using LogWindow = std::shared_ptr<_LogWindow>;
 
+class _ProfilerWindow;
+using ProfilerWindow = std::shared_ptr<_ProfilerWindow>;
+
 class _GuiLogger;
 using GuiLogger = std::shared_ptr<_GuiLogger>;
 
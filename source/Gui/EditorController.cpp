@@ -1,6 +1,8 @@
 #include "EditorController.h"
 
 #include <memory>
+#include <unordered_set>
+
 #include <imgui.h>
 
 #include "Base/Math.h"
@@ -55,6 +57,7 @@ void _EditorController::process()
         return;
     }
 
+    _editorModel->processPendingUpdate();
     _selectionWindow->process();
     _patternEditorWindow->process();
     _creatorWindow->process();
@@ -126,8 +129,7 @@ void _EditorController::onInspectSelectedObjects()
 {
     auto selection = _editorModel->getSelectionShallowData();
     if (selection.numCells + selection.numParticles <= MaxInspectorWindowsToAdd) {
-        DataDescription selectedData = _simController->getSelectedSimulationData(false);
-        onInspectObjects(DescriptionHelper::getObjects(selectedData), false);
+        _selectedDataRequest = SelectedDataRequest{SelectedDataRequest::Type::Objects, _simController->getSelectedSimulationData_async(false)};
     } else {
         showMessage(
             "Inspection not possible",
@@ -138,12 +140,7 @@ void _EditorController::onInspectSelectedObjects()
 
 void _EditorController::onInspectSelectedGenomes()
 {
-    DataDescription selectedData = _simController->getSelectedSimulationData(true);
-    auto constructors = DescriptionHelper::getConstructorToMainGenomes(selectedData);
-    if (constructors.size() > 1) {
-        constructors = {constructors.front()};
-    }
-    onInspectObjects(constructors, true);
+    _selectedDataRequest = SelectedDataRequest{SelectedDataRequest::Type::Genomes, _simController->getSelectedSimulationData_async(true)};
 }
 
 void _EditorController::onInspectObjects(std::vector<CellOrParticleDescription> const& entities, bool selectGenomeTab)
@@ -301,7 +298,7 @@ void _EditorController::processEvents()
     }
 
     if (_simController->updateSelectionIfNecessary()) {
-        _editorModel->update();
+        _editorModel->updateAsync();
     }
     _prevMousePos = mousePos;
 }
@@ -319,6 +316,23 @@ void _EditorController::processSelectionRect()
 
 void _EditorController::processInspectorWindows()
 {
+    //open inspector windows for requested selection
+    if (_selectedDataRequest && _selectedDataRequest->data.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto selectedData = _selectedDataRequest->data.get();
+        auto type = _selectedDataRequest->type;
+        _selectedDataRequest.reset();
+
+        if (type == SelectedDataRequest::Type::Objects) {
+            onInspectObjects(DescriptionHelper::getObjects(selectedData), false);
+        } else {
+            auto constructors = DescriptionHelper::getConstructorToMainGenomes(selectedData);
+            if (constructors.size() > 1) {
+                constructors = {constructors.front()};
+            }
+            onInspectObjects(constructors, true);
+        }
+    }
+
     //process inspector windows
     for (auto const& inspectorWindow : _inspectorWindows) {
         inspectorWindow->process();
@@ -338,25 +352,43 @@ void _EditorController::processInspectorWindows()
     _inspectorWindows = inspectorWindows;
     _editorModel->setInspectedEntities(inspectedEntities);
 
-    //update inspected entities from simulation
-    if (inspectedEntities.empty()) {
-        return;
-    }
-    std::vector<uint64_t> entityIds;
-    for (auto const& entity : inspectedEntities) {
-        entityIds.emplace_back(DescriptionHelper::getId(entity));
-    }
-    auto inspectedData = _simController->getInspectedSimulationData(entityIds);
-    auto newInspectedEntities = DescriptionHelper::getObjects(inspectedData);
-    _editorModel->setInspectedEntities(newInspectedEntities);
+    //update inspected entities from simulation without waiting for the result
+    if (_inspectedDataRequest && _inspectedDataRequest->data.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto inspectedData = _inspectedDataRequest->data.get();
+        std::unordered_map<uint64_t, CellOrParticleDescription> fetchedEntityById;
+        for (auto const& entity : DescriptionHelper::getObjects(inspectedData)) {
+            fetchedEntityById.emplace(DescriptionHelper::getId(entity), entity);
+        }
+        std::unordered_set<uint64_t> requestedEntityIds(_inspectedDataRequest->entityIds.begin(), _inspectedDataRequest->entityIds.end());
+        _inspectedDataRequest.reset();
+
+        //entities which have been added after the request are kept, requested entities which no longer exist are removed
+        std::vector<CellOrParticleDescription> newInspectedEntities;
+        for (auto const& entity : inspectedEntities) {
+            auto id = DescriptionHelper::getId(entity);
+            if (!requestedEntityIds.contains(id)) {
+                newInspectedEntities.emplace_back(entity);
+            } else if (auto findResult = fetchedEntityById.find(id); findResult != fetchedEntityById.end()) {
+                newInspectedEntities.emplace_back(findResult->second);
+            }
+        }
+        _editorModel->setInspectedEntities(newInspectedEntities);
 
-    inspectorWindows.clear();
-    for (auto const& inspectorWindow : _inspectorWindows) {
-        if (_editorModel->existsInspectedEntity(inspectorWindow->getId())) {
-            inspectorWindows.emplace_back(inspectorWindow);
+        inspectorWindows.clear();
+        for (auto const& inspectorWindow : _inspectorWindows) {
+            if (_editorModel->existsInspectedEntity(inspectorWindow->getId())) {
+                inspectorWindows.emplace_back(inspectorWindow);
+            }
         }
+        _inspectorWindows = inspectorWindows;
+    }
+    if (!_inspectedDataRequest && !inspectedEntities.empty()) {
+        std::vector<uint64_t> entityIds;
+        for (auto const& entity : inspectedEntities) {
+            entityIds.emplace_back(DescriptionHelper::getId(entity));
+        }
+        _inspectedDataRequest = InspectedDataRequest{entityIds, _simController->getInspectedSimulationData_async(entityIds)};
     }
-    _inspectorWindows = inspectorWindows;
 }
 
 void _EditorController::selectObjects(RealVector2D const& viewPos, bool modifierKeyPressed)
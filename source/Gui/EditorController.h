@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "Base/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 
@@ -76,6 +78,25 @@ private:
     };
     std::optional<SelectionRect> _selectionRect;
     std::vector<InspectorWindow> _inspectorWindows;
+
+    struct InspectedDataRequest
+    {
+        std::vector<uint64_t> entityIds;
+        std::future<DataDescription> data;
+    };
+    std::optional<InspectedDataRequest> _inspectedDataRequest;
+
+    struct SelectedDataRequest
+    {
+        enum class Type
+        {
+            Objects,
+            Genomes
+        };
+        Type type;
+        std::future<DataDescription> data;
+    };
+    std::optional<SelectedDataRequest> _selectedDataRequest;
     DataDescription _drawing;
     std::optional<RealVector2D> _selectionPositionOnClick;
     std::optional<RealVector2D> _mousePosOnClick;
@@ -16,9 +16,33 @@ SelectionShallowData const& _EditorModel::getSelectionShallowData() const
 
 void _EditorModel::update()
 {
+    _pendingSelectionShallowData.reset();
+    _updateRequestedWhilePending = false;
     _selectionShallowData = _simController->getSelectionShallowData();
 }
 
+void _EditorModel::updateAsync()
+{
+    //a running request may not reflect the latest changes and is therefore followed by another one
+    if (_pendingSelectionShallowData) {
+        _updateRequestedWhilePending = true;
+        return;
+    }
+    _pendingSelectionShallowData = _simController->getSelectionShallowData_async();
+}
+
+void _EditorModel::processPendingUpdate()
+{
+    if (_pendingSelectionShallowData && _pendingSelectionShallowData->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        _selectionShallowData = _pendingSelectionShallowData->get();
+        _pendingSelectionShallowData.reset();
+        if (_updateRequestedWhilePending) {
+            _updateRequestedWhilePending = false;
+            updateAsync();
+        }
+    }
+}
+
 bool _EditorModel::isSelectionEmpty() const
 {
     return 0 == _selectionShallowData.numCells && 0 == _selectionShallowData.numClusterCells
@@ -32,6 +56,8 @@ bool _EditorModel::isCellSelectionEmpty() const
 
 void _EditorModel::clear()
 {
+    _pendingSelectionShallowData.reset();
+    _updateRequestedWhilePending = false;
     _selectionShallowData = SelectionShallowData();
 }
 
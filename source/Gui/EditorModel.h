@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/SelectionShallowData.h"
@@ -13,6 +15,8 @@ public:
 
     SelectionShallowData const& getSelectionShallowData() const;
     void update();
+    void updateAsync();  //result is applied in 'processPendingUpdate()'
+    void processPendingUpdate();
 
     bool isSelectionEmpty() const;
     bool isCellSelectionEmpty() const;
@@ -41,6 +45,8 @@ public:
 private:
     SimulationController _simController;
     SelectionShallowData _selectionShallowData;
+    std::optional<std::future<SelectionShallowData>> _pendingSelectionShallowData;
+    bool _updateRequestedWhilePending = false;
 
     std::unordered_map<uint64_t, CellOrParticleDescription> _inspectedEntityById;
 
@@ -61,6 +61,11 @@ void _GpuSettingsDialog::processIntern()
         gpuSettings.numBlocks = std::max(gpuSettings.numBlocks, 1);
         gpuSettings.numThreadsPerBlock = std::max(gpuSettings.numThreadsPerBlock, 1);
 
+        //manual changes replace tuned launch configurations
+        if (gpuSettings.numBlocks != lastGpuSettings.numBlocks || gpuSettings.numThreadsPerBlock != lastGpuSettings.numThreadsPerBlock) {
+            gpuSettings.resetPhases();
+        }
+
         ImGui::Text("Total threads");
         ImGui::PushFont(StyleRepository::getInstance().getLargeFont());
         ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
@@ -71,6 +76,30 @@ void _GpuSettingsDialog::processIntern()
 
         AlienImGui::Separator();
 
+        if (auto tuningProgress = _simController->getGpuSettingsTuningProgress()) {
+            ImGui::Text("Tuning launch configurations");
+            ImGui::ProgressBar(*tuningProgress, ImVec2(-1, 0));
+            if (!_simController->isSimulationRunning()) {
+                AlienImGui::Text("The simulation needs to run for tuning.");
+            }
+        } else {
+            for (int phase = 0; phase < KernelPhase_Count; ++phase) {
+                if (gpuSettings.numBlocksByPhase[phase] > 0 || gpuSettings.numThreadsPerBlockByPhase[phase] > 0) {
+                    auto phaseSettings = gpuSettings.getForPhase(phase);
+                    AlienImGui::Text(
+                        std::string(KernelPhaseNames[phase]) + ": " + StringHelper::format(phaseSettings.numBlocks) + " blocks, "
+                        + StringHelper::format(phaseSettings.numThreadsPerBlock) + " threads per block");
+                }
+            }
+            if (AlienImGui::Button("Auto-tune")) {
+                _simController->startGpuSettingsTuning();
+            }
+            AlienImGui::Tooltip("Measures the phases of the time steps for different launch configurations while the simulation is running. The best "
+                                "configurations are stored for the current GPU and world size.");
+        }
+
+        AlienImGui::Separator();
+
         if (AlienImGui::Button("OK")) {
             close();
         }
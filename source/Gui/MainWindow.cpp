@@ -51,6 +51,7 @@
 #include "CreatorWindow.h"
 #include "MultiplierWindow.h"
 #include "PatternAnalysisDialog.h"
+#include "ProfilerWindow.h"
 #include "MessageDialog.h"
 #include "FpsController.h"
 #include "NetworkController.h"
@@ -144,6 +145,7 @@ _MainWindow::_MainWindow(SimulationController const& simController, GuiLogger co
     _aboutDialog = std::make_shared<_AboutDialog>();
     _massOperationsDialog = std::make_shared<_MassOperationsDialog>(_simController);
     _logWindow = std::make_shared<_LogWindow>(_logger);
+    _profilerWindow = std::make_shared<_ProfilerWindow>(_simController);
     _gettingStartedWindow = std::make_shared<_GettingStartedWindow>();
     _newSimulationDialog = std::make_shared<_NewSimulationDialog>(_simController, _temporalControlWindow, _viewport, _statisticsWindow);
     _displaySettingsDialog = std::make_shared<_DisplaySettingsDialog>();
@@ -460,6 +462,9 @@ void _MainWindow::processMenubar()
             if (ImGui::MenuItem("Log", "ALT+7", _logWindow->isOn())) {
                 _logWindow->setOn(!_logWindow->isOn());
             }
+            if (ImGui::MenuItem("Profiler", "ALT+8", _profilerWindow->isOn())) {
+                _profilerWindow->setOn(!_profilerWindow->isOn());
+            }
             AlienImGui::EndMenuButton();
         }
 
@@ -639,6 +644,9 @@ void _MainWindow::processMenubar()
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_7)) {
             _logWindow->setOn(!_logWindow->isOn());
         }
+        if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_8)) {
+            _profilerWindow->setOn(!_profilerWindow->isOn());
+        }
 
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_E)) {
             _modeController->setMode(
@@ -747,6 +755,7 @@ void _MainWindow::processWindows()
     _statisticsWindow->process();
     _simulationParametersWindow->process();
     _logWindow->process();
+    _profilerWindow->process();
     _browserWindow->process();
     _gettingStartedWindow->process();
     _shaderWindow->process();
@@ -45,6 +45,7 @@ private:
     SimulationParametersWindow _simulationParametersWindow;
     StatisticsWindow _statisticsWindow;
     LogWindow _logWindow;
+    ProfilerWindow _profilerWindow;
     GettingStartedWindow _gettingStartedWindow;
     BrowserWindow _browserWindow;
     ShaderWindow _shaderWindow;
@@ -32,6 +32,14 @@ _PatternAnalysisDialog::~_PatternAnalysisDialog()
 
 void _PatternAnalysisDialog::process()
 {
+    //the simulation data is fetched in the background
+    if (_analysisRequest && _analysisRequest->data.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto data = _analysisRequest->data.get();
+        auto filename = _analysisRequest->filename;
+        _analysisRequest.reset();
+        saveRepetitiveActiveClustersToFiles(filename, data);
+    }
+
     if (!ifd::FileDialog::Instance().IsDone("PatternAnalysisDialog")) {
         return;
     }
@@ -40,7 +48,7 @@ void _PatternAnalysisDialog::process()
         auto firstFilenameCopy = firstFilename;
         _startingPath = firstFilenameCopy.remove_filename().string();
 
-        saveRepetitiveActiveClustersToFiles(firstFilename.string());
+        _analysisRequest = AnalysisRequest{firstFilename.string(), _simController->getClusteredSimulationData_async()};
     }
     ifd::FileDialog::Instance().Close();
 }
@@ -50,9 +58,9 @@ void _PatternAnalysisDialog::show()
     ifd::FileDialog::Instance().Save("PatternAnalysisDialog", "Save pattern analysis result", "Analysis result (*.txt){.txt},.*", _startingPath);
 }
 
-void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename)
+void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename, ClusteredDataDescription const& data)
 {
-    auto const partitionClassDataByDescription = calcPartitionData();
+    auto const partitionClassDataByDescription = calcPartitionData(data);
 
     std::ofstream file;
     file.open(filename, std::ios_base::out);
@@ -98,10 +106,8 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
     MessageDialog::getInstance().information("Analysis result", messageStream.str());
 }
 
-auto _PatternAnalysisDialog::calcPartitionData() const -> std::map<ClusterAnalysisDescription, PartitionClassData>
+auto _PatternAnalysisDialog::calcPartitionData(ClusteredDataDescription const& data) const -> std::map<ClusterAnalysisDescription, PartitionClassData>
 {
-    auto data = _simController->getClusteredSimulationData();
-
     std::map<ClusterAnalysisDescription, PartitionClassData> result;
 
     for (auto const& cluster : data.clusters) {
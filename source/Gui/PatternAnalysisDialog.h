@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "EngineInterface/Descriptions.h"
 #include "Definitions.h"
 
@@ -13,7 +15,7 @@ public:
     void show();
 
 private:
-    void saveRepetitiveActiveClustersToFiles(std::string const& filename);
+    void saveRepetitiveActiveClustersToFiles(std::string const& filename, ClusteredDataDescription const& data);
 
     struct CellAnalysisDescription
     {
@@ -85,7 +87,7 @@ private:
         bool operator<(PartitionClassData const& other) const { return numberOfElements < other.numberOfElements; };
     };
 
-    std::map<ClusterAnalysisDescription, PartitionClassData> calcPartitionData() const;
+    std::map<ClusterAnalysisDescription, PartitionClassData> calcPartitionData(ClusteredDataDescription const& data) const;
 
     ClusterAnalysisDescription getAnalysisDescription(ClusterDescription const& cluster) const;
 
@@ -93,4 +95,11 @@ private:
     SimulationController _simController;
 
     std::string _startingPath;
+
+    struct AnalysisRequest
+    {
+        std::string filename;
+        std::future<ClusteredDataDescription> data;
+    };
+    std::optional<AnalysisRequest> _analysisRequest;
 };
@@ -0,0 +1,77 @@
+#include "ProfilerWindow.h"
+
+#include <imgui.h>
+
+#include "Base/StringHelper.h"
+#include "EngineInterface/SimulationController.h"
+
+#include "AlienImGui.h"
+#include "StyleRepository.h"
+
+namespace
+{
+    auto const ScopeColumnWidth = 200.0f;
+    auto const ValueColumnWidth = 70.0f;
+}
+
+_ProfilerWindow::_ProfilerWindow(SimulationController const& simController)
+    : _AlienWindow("Profiler", "windows.profiler", false)
+    , _simController(simController)
+{}
+
+void _ProfilerWindow::processIntern()
+{
+    auto profilingData = _simController->getProfilingData();
+    if (profilingData.scopes.empty()) {
+        AlienImGui::Text("No measurements available. Profiling data is collected while this window is open.");
+        return;
+    }
+
+    static ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV
+        | ImGuiTableFlags_ScrollY | ImGuiTableFlags_ScrollX;
+    if (ImGui::BeginTable("Profiler", 7, flags, ImVec2(0, 0), 0.0f)) {
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthFixed, scale(ScopeColumnWidth));
+        ImGui::TableSetupColumn("Samples", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupColumn("Mean [ms]", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupColumn("Median [ms]", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupColumn("95% [ms]", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupColumn("99% [ms]", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupColumn("Max [ms]", ImGuiTableColumnFlags_WidthFixed, scale(ValueColumnWidth));
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        for (auto const& scope : profilingData.scopes) {
+            ImGui::TableNextRow();
+
+            //nested scopes are named by '<parent scope>/<scope>'
+            ImGui::TableSetColumnIndex(0);
+            auto separatorPos = scope.name.rfind('/');
+            if (separatorPos != std::string::npos) {
+                AlienImGui::Text("    " + scope.name.substr(separatorPos + 1));
+            } else {
+                AlienImGui::BoldText(scope.name);
+            }
+
+            ImGui::TableSetColumnIndex(1);
+            AlienImGui::Text(StringHelper::format(scope.numSamples));
+            ImGui::TableSetColumnIndex(2);
+            AlienImGui::Text(StringHelper::format(scope.mean, 3));
+            ImGui::TableSetColumnIndex(3);
+            AlienImGui::Text(StringHelper::format(scope.median, 3));
+            ImGui::TableSetColumnIndex(4);
+            AlienImGui::Text(StringHelper::format(scope.percentile95, 3));
+            ImGui::TableSetColumnIndex(5);
+            AlienImGui::Text(StringHelper::format(scope.percentile99, 3));
+            ImGui::TableSetColumnIndex(6);
+            AlienImGui::Text(StringHelper::format(scope.max, 3));
+        }
+        ImGui::EndTable();
+    }
+}
+
+void _ProfilerWindow::processBackground()
+{
+    if (_on != _simController->isProfilingEnabled()) {
+        _simController->setProfilingEnabled(_on);
+    }
+}
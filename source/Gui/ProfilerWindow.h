@@ -0,0 +1,18 @@
+#pragma once
+
+#include "EngineInterface/Definitions.h"
+
+#include "Definitions.h"
+#include "AlienWindow.h"
+
+class _ProfilerWindow : public _AlienWindow
+{
+public:
+    _ProfilerWindow(SimulationController const& simController);
+
+private:
+    void processIntern() override;
+    void processBackground() override;
+
+    SimulationController _simController;
+};
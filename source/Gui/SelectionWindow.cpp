@@ -13,6 +13,9 @@ _SelectionWindow::_SelectionWindow(EditorModel const& editorModel)
 
 void _SelectionWindow::processIntern()
 {
+    //selected objects may change while the simulation is running
+    _editorModel->updateAsync();
+
     auto selection = _editorModel->getSelectionShallowData();
     ImGui::Text("Cells");
     ImGui::PushFont(StyleRepository::getInstance().getLargeFont());